@@ -0,0 +1,70 @@
+'use strict';
+// Throughput of encrypting and decrypting chunks with an AEAD cipher through
+// Cipheriv/Decipheriv, through updateInto() with a reused output buffer, and
+// through the one-shot aeadSeal()/aeadOpen(), with and without an output
+// buffer.
+const common = require('../common.js');
+const crypto = require('crypto');
+const bench = common.createBenchmark(main, {
+  n: [10000],
+  cipher: ['aes-256-gcm', 'chacha20-poly1305'],
+  api: ['update', 'updateInto', 'aead', 'aeadInPlace'],
+  len: [1024, 16 * 1024, 64 * 1024],
+});
+
+function main({ n, len, cipher, api }) {
+  const message = Buffer.alloc(len, 'b');
+  const key = crypto.randomBytes(32);
+  const iv = crypto.randomBytes(12);
+  const aad = Buffer.alloc(16, 'z');
+  const options = { aad, authTagLength: 16 };
+  const output = Buffer.alloc(len + 16);
+  const sealed = crypto.aeadSeal(cipher, key, iv, message, options);
+
+  bench.start();
+  switch (api) {
+    case 'update':
+      for (let i = 0; i < n; i++) {
+        const alice = crypto.createCipheriv(cipher, key, iv, options);
+        alice.setAAD(aad);
+        const enc = alice.update(message);
+        alice.final();
+        const bob = crypto.createDecipheriv(cipher, key, iv, options);
+        bob.setAuthTag(alice.getAuthTag());
+        bob.setAAD(aad);
+        bob.update(enc);
+        bob.final();
+      }
+      break;
+    case 'updateInto':
+      for (let i = 0; i < n; i++) {
+        const alice = crypto.createCipheriv(cipher, key, iv, options);
+        alice.setAAD(aad);
+        alice.updateInto(message, output);
+        alice.finalInto(output, len);
+        const bob = crypto.createDecipheriv(cipher, key, iv, options);
+        bob.setAuthTag(alice.getAuthTag());
+        bob.setAAD(aad);
+        bob.updateInto(output.subarray(0, len), output);
+        bob.finalInto(output, len);
+      }
+      break;
+    case 'aead':
+      for (let i = 0; i < n; i++) {
+        crypto.aeadSeal(cipher, key, iv, message, options);
+        crypto.aeadOpen(cipher, key, iv, sealed, options);
+      }
+      break;
+    case 'aeadInPlace': {
+      const sealOptions = { aad, authTagLength: 16, output };
+      const openOptions = { aad, authTagLength: 16, output };
+      message.copy(output);
+      for (let i = 0; i < n; i++) {
+        crypto.aeadSeal(cipher, key, iv, output.subarray(0, len), sealOptions);
+        crypto.aeadOpen(cipher, key, iv, output, openOptions);
+      }
+      break;
+    }
+  }
+  bench.end(n);
+}
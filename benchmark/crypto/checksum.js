@@ -0,0 +1,40 @@
+'use strict';
+// Throughput in GB/s of the non-cryptographic checksums, compared to md5,
+// through crypto.hash(), crypto.createHash() and crypto.hashBatch().
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  algo: ['md5', 'crc32c', 'xxh64', 'xxh3'],
+  api: ['oneshot', 'stream', 'batch'],
+  len: [64, 4096, 1024 * 1024],
+  size: [1024 * 1024 * 1024],
+});
+
+function main({ algo, api, len, size }) {
+  const message = crypto.randomBytes(len);
+  const n = Math.ceil(size / len);
+  const gbytes = n * len / (1024 * 1024 * 1024);
+
+  bench.start();
+  switch (api) {
+    case 'oneshot':
+      for (let i = 0; i < n; i++)
+        crypto.hash(algo, message, 'buffer');
+      break;
+    case 'stream': {
+      const h = crypto.createHash(algo);
+      for (let i = 0; i < n; i++)
+        h.update(message);
+      h.digest();
+      break;
+    }
+    case 'batch': {
+      const inputs = new Array(Math.min(n, 1024)).fill(message);
+      for (let i = 0; i < n; i += inputs.length)
+        crypto.hashBatch(algo, inputs, 'buffer');
+      break;
+    }
+  }
+  bench.end(gbytes);
+}
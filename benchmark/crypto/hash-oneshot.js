@@ -0,0 +1,48 @@
+'use strict';
+// Compares crypto.hash() and crypto.hashBatch() with the Hash objects
+// returned by crypto.createHash() for small inputs.
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  algo: ['sha256', 'md5'],
+  type: ['string', 'buffer'],
+  out: ['hex', 'buffer'],
+  len: [32, 1024],
+  api: ['createHash', 'hash', 'hashBatch'],
+});
+
+function main({ n, algo, type, out, len, api }) {
+  const inputs = [];
+  for (let i = 0; i < 100; i++) {
+    const str = `${i}`.padEnd(len, 'x');
+    inputs.push(type === 'string' ? str : Buffer.from(str));
+  }
+
+  let result;
+  switch (api) {
+    case 'createHash':
+      bench.start();
+      for (let i = 0; i < n; i++) {
+        result = crypto.createHash(algo)
+          .update(inputs[i % inputs.length])
+          .digest(out);
+      }
+      bench.end(n);
+      break;
+    case 'hash':
+      bench.start();
+      for (let i = 0; i < n; i++)
+        result = crypto.hash(algo, inputs[i % inputs.length], out);
+      bench.end(n);
+      break;
+    case 'hashBatch':
+      bench.start();
+      for (let i = 0; i < n; i += inputs.length)
+        result = crypto.hashBatch(algo, inputs, out);
+      bench.end(n);
+      break;
+  }
+  return result;
+}
@@ -1,16 +1,23 @@
 'use strict';
 
 const common = require('../common.js');
-const { randomBytes } = require('crypto');
+const { randomBytes, randomFillSync } = require('crypto');
 
 const bench = common.createBenchmark(main, {
-  size: [64, 1024, 8192, 512 * 1024],
+  api: ['randomBytes', 'randomFillSync'],
+  size: [16, 64, 256, 1024, 8192, 512 * 1024],
   n: [1e3],
 });
 
-function main({ n, size }) {
+function main({ n, size, api }) {
+  const buf = Buffer.alloc(size);
   bench.start();
-  for (let i = 0; i < n; ++i)
-    randomBytes(size);
+  if (api === 'randomBytes') {
+    for (let i = 0; i < n; ++i)
+      randomBytes(size);
+  } else {
+    for (let i = 0; i < n; ++i)
+      randomFillSync(buf);
+  }
   bench.end(n);
 }
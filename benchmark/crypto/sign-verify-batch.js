@@ -0,0 +1,64 @@
+'use strict';
+// Signatures verified per second with crypto.verify() called once per input
+// and with crypto.verifyBatch(), synchronously and in the thread pool.
+const common = require('../common.js');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const fixtures_keydir = path.resolve(__dirname, '../../test/fixtures/keys/');
+
+const bench = common.createBenchmark(main, {
+  n: [10000],
+  batch: [1, 10, 100, 1000, 10000],
+  api: ['verify', 'verifyBatch', 'verifyBatchAsync'],
+  len: [64],
+});
+
+function main({ n, batch, api, len }) {
+  const privateKey = crypto.createPrivateKey(
+    fs.readFileSync(`${fixtures_keydir}/rsa_private_2048.pem`));
+  const publicKey = crypto.createPublicKey(privateKey);
+  const inputs = [];
+  for (let i = 0; i < batch; i++)
+    inputs.push(crypto.randomBytes(len));
+  const signatures = crypto.signBatch('sha256', inputs, privateKey);
+  const rounds = Math.max(1, Math.floor(n / batch));
+
+  switch (api) {
+    case 'verify':
+      bench.start();
+      for (let r = 0; r < rounds; r++) {
+        for (let i = 0; i < batch; i++) {
+          if (!crypto.verify('sha256', inputs[i], publicKey, signatures[i]))
+            throw new Error('verification failed');
+        }
+      }
+      bench.end(rounds * batch);
+      break;
+    case 'verifyBatch':
+      bench.start();
+      for (let r = 0; r < rounds; r++) {
+        const results = crypto.verifyBatch('sha256', inputs, publicKey,
+                                           signatures);
+        if (!results.every(Boolean))
+          throw new Error('verification failed');
+      }
+      bench.end(rounds * batch);
+      break;
+    case 'verifyBatchAsync': {
+      let remaining = rounds;
+      const done = (err, results) => {
+        if (err)
+          throw err;
+        if (!results.every(Boolean))
+          throw new Error('verification failed');
+        if (--remaining === 0)
+          bench.end(rounds * batch);
+      };
+      bench.start();
+      for (let r = 0; r < rounds; r++)
+        crypto.verifyBatch('sha256', inputs, publicKey, signatures, done);
+      break;
+    }
+  }
+}
@@ -0,0 +1,39 @@
+'use strict';
+// Cost of signing and verifying with keys passed as PEM strings compared to
+// KeyObjects.
+const common = require('../common.js');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const fixtures_keydir = path.resolve(__dirname, '../../test/fixtures/keys/');
+
+const bench = common.createBenchmark(main, {
+  n: [1e3],
+  keyFormat: ['pem', 'keyObject'],
+  op: ['sign', 'verify'],
+});
+
+function main({ n, keyFormat, op }) {
+  const privatePem = fs.readFileSync(
+    `${fixtures_keydir}/rsa_private_2048.pem`, 'ascii');
+  const publicPem = fs.readFileSync(
+    `${fixtures_keydir}/rsa_public_2048.pem`, 'ascii');
+  const privateKey = keyFormat === 'pem' ?
+    privatePem : crypto.createPrivateKey(privatePem);
+  const publicKey = keyFormat === 'pem' ?
+    publicPem : crypto.createPublicKey(publicPem);
+  const data = Buffer.alloc(64, 'a');
+  const signature = crypto.sign('sha256', data, privateKey);
+
+  if (op === 'sign') {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      crypto.sign('sha256', data, privateKey);
+    bench.end(n);
+  } else {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      crypto.verify('sha256', data, publicKey, signature);
+    bench.end(n);
+  }
+}
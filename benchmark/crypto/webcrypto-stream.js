@@ -0,0 +1,62 @@
+'use strict';
+// Throughput of hashing and encrypting a 1 GiB stream with
+// subtle.digestStream() and subtle.encryptStream(), compared to feeding the
+// same chunks to crypto.createHash() and crypto.createCipheriv().
+const common = require('../common.js');
+const crypto = require('crypto');
+const { subtle } = crypto.webcrypto;
+
+const bench = common.createBenchmark(main, {
+  op: ['digest', 'encrypt'],
+  api: ['webcrypto', 'legacy'],
+  chunk: [64 * 1024, 1024 * 1024],
+  size: [1024 * 1024 * 1024],
+});
+
+function* chunks(chunk, size) {
+  const data = Buffer.alloc(chunk, 'a');
+  for (let i = 0; i < size; i += chunk)
+    yield data;
+}
+
+async function run(op, api, chunk, size) {
+  const key = Buffer.alloc(32, 'k');
+  const iv = Buffer.alloc(12, 'i');
+  switch (`${op}-${api}`) {
+    case 'digest-webcrypto':
+      await subtle.digestStream('SHA-256', chunks(chunk, size));
+      break;
+    case 'digest-legacy': {
+      const hash = crypto.createHash('sha256');
+      for (const data of chunks(chunk, size))
+        hash.update(data);
+      hash.digest();
+      break;
+    }
+    case 'encrypt-webcrypto': {
+      const cryptoKey = await subtle.importKey('raw', key, 'AES-GCM', false,
+                                               ['encrypt']);
+      const ciphertext = subtle.encryptStream({ name: 'AES-GCM', iv },
+                                              cryptoKey, chunks(chunk, size));
+      // eslint-disable-next-line no-unused-vars
+      for await (const data of ciphertext);
+      break;
+    }
+    case 'encrypt-legacy': {
+      const cipher = crypto.createCipheriv('aes-256-gcm', key, iv);
+      for (const data of chunks(chunk, size))
+        cipher.update(data);
+      cipher.final();
+      cipher.getAuthTag();
+      break;
+    }
+  }
+}
+
+function main({ op, api, chunk, size }) {
+  bench.start();
+  run(op, api, chunk, size).then(() => {
+    // Reported in GiB per second.
+    bench.end(size / (1024 * 1024 * 1024));
+  });
+}
@@ -0,0 +1,65 @@
+'use strict';
+
+// Measures resolver.lookup() throughput against a local stub DNS server that
+// delays every answer. Because these lookups run on the event loop rather
+// than on the thread pool, throughput should scale with concurrency instead
+// of being capped at UV_THREADPOOL_SIZE / delay.
+
+const common = require('../common.js');
+const dgram = require('dgram');
+const { Resolver } = require('dns');
+
+const bench = common.createBenchmark(main, {
+  delay: [0, 50],
+  concurrency: [1, 4, 64],
+  n: [2e3]
+});
+
+// Answers A queries with 127.0.0.1 and AAAA queries with no records, after
+// `delay` milliseconds.
+function startServer(delay, cb) {
+  const server = dgram.createSocket('udp4');
+  server.on('message', (msg, { address, port }) => {
+    const question = msg.subarray(12);
+    const isA = msg[msg.length - 3] === 1;
+    const header = Buffer.from([
+      msg[0], msg[1], 0x81, 0x80, 0x00, 0x01, 0x00, isA ? 1 : 0, 0, 0, 0, 0,
+    ]);
+    const answer = isA ? Buffer.from([
+      0xc0, 0x0c,  // Pointer to the name in the question.
+      0x00, 0x01, 0x00, 0x01,  // Type A, class IN.
+      0x00, 0x00, 0x00, 0x3c,  // TTL 60.
+      0x00, 0x04, 127, 0, 0, 1,
+    ]) : Buffer.alloc(0);
+    const reply = Buffer.concat([header, question, answer]);
+    setTimeout(() => server.send(reply, port, address), delay);
+  });
+  server.bind(0, '127.0.0.1', () => cb(server));
+}
+
+function main({ delay, concurrency, n }) {
+  startServer(delay, (server) => {
+    const resolver = new Resolver();
+    resolver.setServers([`127.0.0.1:${server.address().port}`]);
+
+    let started = 0;
+    let done = 0;
+    function next() {
+      if (started === n)
+        return;
+      resolver.lookup(`host${started++}.example.org`, (err) => {
+        if (err) throw err;
+        if (++done === n) {
+          bench.end(n);
+          server.close();
+          return;
+        }
+        next();
+      });
+    }
+
+    bench.start();
+    for (let i = 0; i < concurrency; i++)
+      next();
+  });
+}
@@ -0,0 +1,50 @@
+'use strict';
+
+const common = require('../common.js');
+const dgram = require('dgram');
+const { Resolver } = require('dns');
+
+const bench = common.createBenchmark(main, {
+  cache: ['true', 'false'],
+  names: [1, 100],
+  n: [1e5]
+});
+
+// Answers every A query with a single record without parsing the question
+// beyond what is needed to echo it back.
+function startServer(cb) {
+  const server = dgram.createSocket('udp4');
+  server.on('message', (msg, { address, port }) => {
+    const question = msg.subarray(12);
+    const answer = Buffer.from([
+      0xc0, 0x0c,  // Pointer to the name in the question.
+      0x00, 0x01, 0x00, 0x01,  // Type A, class IN.
+      0x00, 0x00, 0x0e, 0x10,  // TTL 3600.
+      0x00, 0x04, 127, 0, 0, 1,
+    ]);
+    const header = Buffer.from([
+      msg[0], msg[1], 0x81, 0x80, 0x00, 0x01, 0x00, 0x01, 0, 0, 0, 0,
+    ]);
+    server.send(Buffer.concat([header, question, answer]), port, address);
+  });
+  server.bind(0, '127.0.0.1', () => cb(server));
+}
+
+function main({ cache, names, n }) {
+  startServer((server) => {
+    const resolver = new Resolver({ cache: cache === 'true' });
+    resolver.setServers([`127.0.0.1:${server.address().port}`]);
+
+    let i = 0;
+    bench.start();
+    (function cb(err) {
+      if (err) throw err;
+      if (i++ === n) {
+        bench.end(n);
+        server.close();
+        return;
+      }
+      resolver.resolve4(`host${i % names}.example.org`, cb);
+    })();
+  });
+}
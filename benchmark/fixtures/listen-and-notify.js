@@ -0,0 +1,7 @@
+'use strict';
+
+// Usage: listen-and-notify.js <module exporting a net.Server> <port>
+// Makes the server listen on the port and notifies the parent process once
+// it is ready.
+const [file, port] = process.argv.slice(2);
+require(file).listen(+port, () => process.send('listening'));
@@ -0,0 +1,19 @@
+'use strict';
+
+const { parentPort, workerData } = require('worker_threads');
+
+// Busy-loops for the given number of milliseconds.
+function task(ms) {
+  const end = Date.now() + ms;
+  while (Date.now() < end);
+  return ms;
+}
+
+module.exports = task;
+
+// Used as a plain Worker script for the round-robin baseline.
+if (workerData === 'round-robin') {
+  parentPort.on('message', ({ id, ms }) => {
+    parentPort.postMessage({ id, result: task(ms) });
+  });
+}
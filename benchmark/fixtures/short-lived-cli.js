@@ -0,0 +1,11 @@
+'use strict';
+
+// Does what a typical short-lived command line tool does: parse its
+// arguments, read a file synchronously, print a line and exit.
+const fs = require('fs');
+const path = require('path');
+
+const args = process.argv.slice(2);
+const file = args[0] || __filename;
+const lines = fs.readFileSync(path.resolve(file), 'utf8').split('\n').length;
+process.stdout.write(`${path.basename(file)}: ${lines} lines\n`);
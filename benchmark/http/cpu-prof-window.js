@@ -0,0 +1,41 @@
+'use strict';
+const common = require('../common.js');
+const { fork } = require('child_process');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  profile: ['none', 'continuous'],
+  interval: [10000],
+  c: [50],
+  duration: 5
+});
+
+// Overhead of keeping the CPU profiler running with --cpu-prof-window on an
+// HTTP server, writing a profile every second.
+function main({ profile, interval, c, duration }) {
+  tmpdir.refresh();
+  const execArgv = [];
+  if (profile === 'continuous') {
+    execArgv.push(
+      '--cpu-prof',
+      '--cpu-prof-dir', tmpdir.path,
+      '--cpu-prof-interval', `${interval}`,
+      '--cpu-prof-window', '1000');
+  }
+
+  const server = fork(path.join(__dirname, '../fixtures/listen-and-notify'), [
+    path.join(__dirname, '../fixtures/simple-http-server.js'),
+    `${common.PORT}`,
+  ], { execArgv });
+
+  server.on('message', () => {
+    bench.http({
+      path: '/bytes/1024/1/normal/0',
+      connections: c,
+      duration
+    }, () => {
+      server.kill();
+    });
+  });
+}
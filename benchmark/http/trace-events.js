@@ -0,0 +1,41 @@
+'use strict';
+const common = require('../common.js');
+const { fork } = require('child_process');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  tracing: ['none', 'json', 'binary'],
+  c: [50],
+  duration: 5
+});
+
+// Overhead of recording the node.async_hooks and node.http trace events on
+// an HTTP server, with each of the --trace-event-format formats.
+function main({ tracing, c, duration }) {
+  tmpdir.refresh();
+  const execArgv = [];
+  if (tracing !== 'none') {
+    execArgv.push(
+      '--trace-event-categories', 'node.async_hooks,node.http',
+      '--trace-event-format', tracing,
+      '--trace-event-file-pattern',
+      // eslint-disable-next-line no-template-curly-in-string
+      path.join(tmpdir.path, 'trace.${rotation}.log'));
+  }
+
+  const server = fork(path.join(__dirname, '../fixtures/listen-and-notify'), [
+    path.join(__dirname, '../fixtures/simple-http-server.js'),
+    `${common.PORT}`,
+  ], { execArgv });
+
+  server.on('message', () => {
+    bench.http({
+      path: '/bytes/1024/1/normal/0',
+      connections: c,
+      duration
+    }, () => {
+      server.kill();
+    });
+  });
+}
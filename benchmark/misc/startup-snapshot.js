@@ -0,0 +1,56 @@
+'use strict';
+const common = require('../common.js');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [20],
+  mode: ['snapshot', 'script'],
+});
+
+// Startup of an application that does its initialization from a script on
+// every run, compared to starting it from a snapshot built with
+// --build-snapshot that already contains the initialized heap.
+const entry = `
+  const util = require('util');
+  const table = new Map();
+  for (let i = 0; i < 1e5; i++)
+    table.set('key' + i, util.format('%s:%d', 'value', i));
+  const main = () => {
+    if (table.get('key42') !== 'value:42') throw new Error('bad state');
+  };
+  const v8 = require('v8');
+  if (v8.startupSnapshot.isBuildingSnapshot())
+    v8.startupSnapshot.setDeserializeMainFunction(main);
+  else
+    main();
+`;
+
+function main({ n, mode }) {
+  tmpdir.refresh();
+  const script = path.join(tmpdir.path, 'entry.js');
+  const blob = path.join(tmpdir.path, 'entry.blob');
+  fs.writeFileSync(script, entry);
+
+  let args;
+  if (mode === 'snapshot') {
+    const child = spawnSync(process.execPath, [
+      '--snapshot-blob', blob, '--build-snapshot', script,
+    ]);
+    if (child.status !== 0)
+      throw new Error(`Failed to build snapshot:\n${child.stderr}`);
+    args = ['--snapshot-blob', blob];
+  } else {
+    args = [script];
+  }
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const child = spawnSync(process.execPath, args);
+    if (child.status !== 0)
+      throw new Error(`Error during node startup:\n${child.stderr}`);
+  }
+  bench.end(n);
+}
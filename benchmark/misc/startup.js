@@ -10,6 +10,7 @@ const bench = common.createBenchmark(main, {
   script: [
     'benchmark/fixtures/require-builtins',
     'benchmark/fixtures/require-cachable',
+    'benchmark/fixtures/short-lived-cli',
     'test/fixtures/semicolon',
   ],
   mode: ['process', 'worker']
@@ -0,0 +1,43 @@
+'use strict';
+const common = require('../common.js');
+const { spawnSync } = require('child_process');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [1e6],
+  format: ['json', 'binary'],
+});
+
+// Measures how many trace events per second can be recorded with each of the
+// formats that --trace-event-format supports, including the time it takes to
+// write them to disk.
+function childScript(n) {
+  return `
+    const { internalBinding } = require('internal/test/binding');
+    const { trace } = internalBinding('trace_events');
+    const { TRACE_EVENT_PHASE_INSTANT } = internalBinding('constants').trace;
+    for (let i = 0; i < ${n}; i++)
+      trace(TRACE_EVENT_PHASE_INSTANT, 'bench', 'event', i, { i });
+  `;
+}
+
+function main({ n, format }) {
+  tmpdir.refresh();
+  const args = [
+    '--expose-internals',
+    '--no-warnings',
+    '--trace-event-categories', 'bench',
+    '--trace-event-format', format,
+    '--trace-event-file-pattern',
+    // eslint-disable-next-line no-template-curly-in-string
+    path.join(tmpdir.path, 'trace.${rotation}.log'),
+    '-e', childScript(n),
+  ];
+
+  bench.start();
+  const result = spawnSync(process.execPath, args);
+  bench.end(n);
+  if (result.status !== 0)
+    throw new Error(`Child process failed:\n${result.stderr}`);
+}
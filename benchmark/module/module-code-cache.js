@@ -0,0 +1,63 @@
+'use strict';
+const common = require('../common.js');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [20],
+  files: [100],
+  type: ['cjs', 'esm'],
+  cache: ['true', 'false'],
+});
+
+// Cold start of an application made of many modules, with and without
+// the code cache from --experimental-code-cache-dir. The cache is populated
+// before the measurement starts.
+function createModules(dir, files, type) {
+  const ext = type === 'esm' ? '.mjs' : '.js';
+  let entry = '';
+  for (let i = 0; i < files; i++) {
+    let body = '';
+    for (let j = 0; j < 50; j++) {
+      body += `function f${j}(a, b) {\n` +
+              '  const r = [];\n' +
+              `  for (let k = 0; k < a; k++) r.push({ k, v: b * ${j} });\n` +
+              '  return r.filter((x) => x.k % 2).map((x) => x.v);\n' +
+              '}\n';
+    }
+    if (type === 'esm') {
+      body += `export const result = f0(${i}, 1).length;\n`;
+      entry += `import { result as r${i} } from './mod${i}${ext}';\n`;
+    } else {
+      body += `module.exports = f0(${i}, 1).length;\n`;
+      entry += `require('./mod${i}${ext}');\n`;
+    }
+    fs.writeFileSync(path.join(dir, `mod${i}${ext}`), body);
+  }
+  const entryFile = path.join(dir, `entry${ext}`);
+  fs.writeFileSync(entryFile, entry);
+  return entryFile;
+}
+
+function main({ n, files, type, cache }) {
+  tmpdir.refresh();
+  const entry = createModules(tmpdir.path, files, type);
+  const args = [entry];
+  if (cache === 'true') {
+    args.unshift(`--experimental-code-cache-dir=${
+      path.join(tmpdir.path, 'cache')}`);
+    const child = spawnSync(process.execPath, args);
+    if (child.status !== 0)
+      throw new Error(`Error populating the cache:\n${child.stderr}`);
+  }
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const child = spawnSync(process.execPath, args);
+    if (child.status !== 0)
+      throw new Error(`Error during node startup:\n${child.stderr}`);
+  }
+  bench.end(n);
+}
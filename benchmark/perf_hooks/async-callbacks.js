@@ -0,0 +1,30 @@
+'use strict';
+
+const common = require('../common.js');
+const fs = require('fs');
+const { monitorAsyncCallbacks } = require('perf_hooks');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  monitor: ['true', 'false'],
+});
+
+// Overhead of monitorAsyncCallbacks() on short fs callbacks.
+function main({ n, monitor }) {
+  const m = monitorAsyncCallbacks();
+  if (monitor === 'true')
+    m.enable();
+
+  let i = 0;
+  function onStat(err) {
+    if (err) throw err;
+    if (++i === n) {
+      bench.end(n);
+      m.disable();
+      return;
+    }
+    fs.stat(__filename, onStat);
+  }
+  bench.start();
+  fs.stat(__filename, onStat);
+}
@@ -0,0 +1,29 @@
+'use strict';
+
+const common = require('../common.js');
+const { monitorEventLoopPhases } = require('perf_hooks');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  monitor: ['true', 'false'],
+});
+
+// Overhead of monitorEventLoopPhases() on an event loop that runs many short
+// iterations, each of them with one timer and one immediate.
+function main({ n, monitor }) {
+  const m = monitorEventLoopPhases();
+  if (monitor === 'true')
+    m.enable();
+
+  let i = 0;
+  function iteration() {
+    if (++i === n) {
+      bench.end(n);
+      m.disable();
+      return;
+    }
+    setImmediate(() => setTimeout(iteration, 0));
+  }
+  bench.start();
+  iteration();
+}
@@ -0,0 +1,47 @@
+'use strict';
+
+const common = require('../common.js');
+const { createHistogram } = require('perf_hooks');
+const { Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  n: [1e6],
+  workers: [0, 1, 4],
+});
+
+// Throughput of RecordableHistogram#record() on the main thread while the
+// given number of Workers record into the same histogram.
+function main({ n, workers }) {
+  const h = createHistogram();
+  const running = [];
+  for (let i = 0; i < workers; i++) {
+    running.push(new Worker(`
+      const { workerData: h, parentPort } = require('worker_threads');
+      let stop = false;
+      parentPort.once('message', () => stop = true);
+      parentPort.postMessage('ready');
+      (function loop() {
+        for (let i = 1; i <= 1e4; i++)
+          h.record(i);
+        if (!stop) setImmediate(loop);
+      })();
+    `, { eval: true, workerData: h }));
+  }
+
+  let ready = 0;
+  const start = () => {
+    bench.start();
+    for (let i = 1; i <= n; i++)
+      h.record(i);
+    bench.end(n);
+    for (const worker of running)
+      worker.postMessage('stop');
+  };
+  if (workers === 0)
+    return start();
+  for (const worker of running) {
+    worker.once('message', () => {
+      if (++ready === workers) start();
+    });
+  }
+}
@@ -0,0 +1,126 @@
+'use strict';
+// Bulk transfer over QUIC through an emulated bottleneck link, with and
+// without pacing. A UDP relay between the client and the server forwards the
+// packets of the server at `bandwidth` Mbit/s through a drop-tail queue of
+// `queue` packets, as a router in front of a slower link would, so that
+// bursts overflow the queue and get lost. The 'throughput' metric reports the
+// data received by the client in Mbit/s, the 'loss' metric the percentage of
+// the packets of the server that were dropped at the bottleneck.
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  dur: [5],
+  bandwidth: [50, 200],
+  queue: [32],
+  pacing: ['true', 'false'],
+  metric: ['throughput', 'loss'],
+}, { flags: ['--no-warnings'], test: { dur: 0.1 } });
+
+const dgram = require('dgram');
+const fixtures = require('../../test/common/fixtures');
+
+function createBottleneck(serverPort, bandwidth, queueLength, callback) {
+  const relay = dgram.createSocket('udp4');
+  const stats = { forwarded: 0, dropped: 0 };
+  // The link transmits bytesPerMs bytes per millisecond, the queue holds the
+  // packets that are waiting for it.
+  const bytesPerMs = bandwidth * 1e6 / 8 / 1000;
+  const queue = [];
+  let client;
+  let credit = 0;
+  let last = process.hrtime.bigint();
+
+  function drain() {
+    const now = process.hrtime.bigint();
+    credit += Number(now - last) / 1e6 * bytesPerMs;
+    last = now;
+    while (queue.length > 0 && credit >= queue[0].length) {
+      const packet = queue.shift();
+      credit -= packet.length;
+      relay.send(packet, client.port, client.address);
+    }
+    // The link cannot save up unused capacity for later.
+    if (queue.length === 0)
+      credit = Math.min(credit, 1500);
+  }
+
+  const timer = setInterval(drain, 1);
+
+  relay.on('message', (msg, rinfo) => {
+    if (rinfo.port !== serverPort) {
+      client = rinfo;
+      relay.send(msg, serverPort, '127.0.0.1');
+    } else if (queue.length < queueLength) {
+      stats.forwarded++;
+      queue.push(msg);
+      drain();
+    } else {
+      stats.dropped++;
+    }
+  });
+
+  relay.bind(0, '127.0.0.1', () => callback(relay.address().port));
+
+  return {
+    stats,
+    close() {
+      clearInterval(timer);
+      relay.close();
+    }
+  };
+}
+
+function main({ dur, bandwidth, queue, pacing, metric }) {
+  const { createQuicSocket } = require('net');
+  const options = {
+    key: fixtures.readKey('agent1-key.pem', 'binary'),
+    cert: fixtures.readKey('agent1-cert.pem', 'binary'),
+    ca: fixtures.readKey('ca1-cert.pem', 'binary'),
+    alpn: 'bench',
+  };
+  const disablePacing = pacing === 'false';
+  const chunk = Buffer.alloc(64 * 1024, 'b');
+
+  const server = createQuicSocket({ server: options, disablePacing });
+  const client = createQuicSocket({ client: options, disablePacing });
+
+  server.on('session', async (session) => {
+    const stream = await session.openStream({ halfOpen: true });
+    function write() {
+      while (stream.write(chunk));
+    }
+    stream.on('drain', write);
+    stream.on('error', () => {});
+    write();
+  });
+
+  server.listen().then(() => {
+    const serverPort = server.endpoints[0].address.port;
+    const bottleneck = createBottleneck(serverPort, bandwidth, queue, (p) => {
+      client.connect({ address: '127.0.0.1', port: p }).then((session) => {
+        let received = 0;
+        let start;
+        session.on('stream', (stream) => {
+          start = process.hrtime();
+          bench.start();
+          stream.on('data', (data) => received += data.length);
+          stream.on('error', () => {});
+          setTimeout(done, dur * 1000);
+        });
+
+        function done() {
+          const { forwarded, dropped } = bottleneck.stats;
+          if (metric === 'throughput') {
+            bench.end(received * 8 / (1024 * 1024));
+          } else {
+            bench.report(dropped * 100 / (forwarded + dropped || 1),
+                         process.hrtime(start));
+          }
+          bottleneck.close();
+          session.destroy();
+          client.destroy();
+          server.destroy();
+        }
+      });
+    });
+  });
+}
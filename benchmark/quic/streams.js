@@ -0,0 +1,83 @@
+'use strict';
+// Upload over many concurrent QUIC streams of one session. The client writes
+// `size` bytes in chunks of `len` bytes to each of `streams` streams at once,
+// which keeps a large number of chunks buffered until they are acknowledged.
+// The 'throughput' metric reports the data received by the server in Mbit/s,
+// the 'rss' metric the growth of the resident set size of the process in MB
+// over the run.
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  streams: [100, 1000],
+  len: [1024, 16 * 1024],
+  size: [256 * 1024],
+  metric: ['throughput', 'rss'],
+}, { flags: ['--no-warnings'] });
+
+const fixtures = require('../../test/common/fixtures');
+
+function main({ streams, len, size, metric }) {
+  const { createQuicSocket } = require('net');
+  const options = {
+    key: fixtures.readKey('agent1-key.pem', 'binary'),
+    cert: fixtures.readKey('agent1-cert.pem', 'binary'),
+    ca: fixtures.readKey('ca1-cert.pem', 'binary'),
+    alpn: 'bench',
+  };
+  const chunk = Buffer.alloc(len, 'b');
+  const writes = Math.ceil(size / len);
+
+  const server = createQuicSocket({
+    server: { ...options, maxStreamsUni: streams },
+  });
+  const client = createQuicSocket({ client: options });
+
+  let received = 0;
+  let remaining = streams;
+  let start;
+  let rss;
+  server.on('session', (session) => {
+    session.on('stream', (stream) => {
+      stream.on('data', (data) => received += data.length);
+      stream.on('end', () => {
+        if (--remaining === 0)
+          done();
+      });
+      stream.resume();
+    });
+  });
+
+  server.listen().then(() => {
+    const { port } = server.endpoints[0].address;
+    return client.connect({ address: '127.0.0.1', port });
+  }).then(async (session) => {
+    rss = process.memoryUsage().rss;
+    start = process.hrtime();
+    bench.start();
+    for (let n = 0; n < streams; n++) {
+      const stream = await session.openStream({ halfOpen: true });
+      write(stream, writes);
+    }
+  });
+
+  function write(stream, left) {
+    while (left > 0) {
+      left--;
+      if (!stream.write(chunk)) {
+        stream.once('drain', () => write(stream, left));
+        return;
+      }
+    }
+    stream.end();
+  }
+
+  function done() {
+    if (metric === 'throughput') {
+      bench.end(received * 8 / (1024 * 1024));
+    } else {
+      bench.report((process.memoryUsage().rss - rss) / (1024 * 1024),
+                   process.hrtime(start));
+    }
+    client.destroy();
+    server.destroy();
+  }
+}
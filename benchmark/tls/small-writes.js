@@ -0,0 +1,64 @@
+'use strict';
+// Throughput of a server that writes many small chunks per tick, as streamed
+// HTTP responses do, with and without the coalesceWrites and
+// dynamicRecordSizing options. Each write without coalescing results in
+// records and a write to the socket of its own; run the benchmark under
+// `strace -f -c -e trace=write,writev` to compare the number of system calls.
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  dur: [5],
+  size: [16, 256, 2048],
+  writes: [1, 16, 64],
+  coalesce: ['true', 'false'],
+  recordsizing: ['fixed', 'dynamic'],
+});
+
+const fixtures = require('../../test/common/fixtures');
+const tls = require('tls');
+
+function main({ dur, size, writes, coalesce, recordsizing }) {
+  const chunk = Buffer.alloc(size, 'b');
+  const options = {
+    key: fixtures.readKey('rsa_private.pem'),
+    cert: fixtures.readKey('rsa_cert.crt'),
+    ca: fixtures.readKey('rsa_ca.crt'),
+    ciphers: 'AES256-GCM-SHA384',
+    coalesceWrites: coalesce === 'true',
+    dynamicRecordSizing: recordsizing === 'dynamic',
+  };
+
+  let received = 0;
+  const server = tls.createServer(options, (socket) => {
+    socket.on('drain', write);
+    socket.once('data', write);
+
+    function write() {
+      for (let i = 0; i < writes; i++) {
+        if (!socket.write(chunk))
+          return;
+      }
+      setImmediate(write);
+    }
+  });
+
+  server.listen(common.PORT, () => {
+    const conn = tls.connect({
+      port: common.PORT,
+      rejectUnauthorized: false,
+    }, () => {
+      setTimeout(done, dur * 1000);
+      bench.start();
+      conn.write('hello');
+    });
+
+    conn.on('data', (data) => {
+      received += data.length;
+    });
+  });
+
+  function done() {
+    const mbits = (received * 8) / (1024 * 1024);
+    bench.end(mbits);
+    process.exit(0);
+  }
+}
@@ -7,13 +7,21 @@ const bench = common.createBenchmark(main, {
   workers: [1],
   payload: ['string', 'object'],
   sendsPerBroadcast: [1, 10],
+  // 'rate' reports round trips per second, 'p99' reports the 99th percentile
+  // of the round trip time of a broadcast in microseconds.
+  metric: ['rate', 'p99'],
   n: [1e5]
 });
 
 const workerPath = path.resolve(__dirname, '..', 'fixtures', 'echo.worker.js');
 
-function main({ n, workers, sendsPerBroadcast: sends, payload: payloadType }) {
+function main({
+  n, workers, sendsPerBroadcast: sends, payload: payloadType, metric
+}) {
   const expectedPerBroadcast = sends * workers;
+  const latencies = metric === 'p99' ? new Float64Array(n) : null;
+  let startTime;
+  let broadcastStart;
   let payload;
   let readies = 0;
   let broadcasts = 0;
@@ -42,18 +50,31 @@ function main({ n, workers, sendsPerBroadcast: sends, payload: payloadType }) {
   function onOnline() {
     if (++readies === workers) {
       bench.start();
+      startTime = process.hrtime();
       broadcast();
     }
   }
 
   function broadcast() {
+    if (latencies !== null && broadcasts > 0) {
+      const elapsed = process.hrtime.bigint() - broadcastStart;
+      latencies[broadcasts - 1] = Number(elapsed) / 1e3;
+    }
     if (broadcasts++ === n) {
-      bench.end(n);
+      if (latencies !== null) {
+        latencies.sort();
+        const p99 = latencies[Math.min(n - 1, Math.floor(n * 0.99))];
+        bench.report(p99, process.hrtime(startTime));
+      } else {
+        bench.end(n);
+      }
       for (const worker of workerObjs) {
         worker.unref();
       }
       return;
     }
+    if (latencies !== null)
+      broadcastStart = process.hrtime.bigint();
     for (const worker of workerObjs) {
       for (let i = 0; i < sends; ++i)
         worker.postMessage(payload);
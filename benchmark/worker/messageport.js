@@ -3,15 +3,19 @@
 const common = require('../common.js');
 const { MessageChannel } = require('worker_threads');
 const bench = common.createBenchmark(main, {
-  payload: ['string', 'object'],
+  payload: ['string', 'object', 'large-string', 'large-object', 'large-buffer'],
   style: ['eventtarget', 'eventemitter'],
   n: [1e6]
 });
 
 function main(conf) {
-  const n = conf.n;
+  let n = conf.n;
   let payload;
 
+  // Large payloads are sent fewer times to keep the run time reasonable.
+  if (conf.payload.startsWith('large-'))
+    n = Math.ceil(n / 1000);
+
   switch (conf.payload) {
     case 'string':
       payload = 'hello world!';
@@ -19,6 +23,16 @@ function main(conf) {
     case 'object':
       payload = { action: 'pewpewpew', powerLevel: 9001 };
       break;
+    case 'large-string':
+      payload = 'hello world!'.repeat(1024 * 1024 / 8);
+      break;
+    case 'large-object':
+      payload = Array.from({ length: 1e4 },
+                           (_, i) => ({ action: 'pewpewpew', powerLevel: i }));
+      break;
+    case 'large-buffer':
+      payload = new Uint8Array(8 * 1024 * 1024).fill(42);
+      break;
     default:
       throw new Error('Unsupported payload type');
   }
@@ -0,0 +1,95 @@
+'use strict';
+
+const common = require('../common.js');
+const { Pool, Worker } = require('worker_threads');
+const path = require('path');
+const bench = common.createBenchmark(main, {
+  // 'pool' uses worker_threads.Pool, 'round-robin' dispatches the tasks over
+  // plain Workers the way ad-hoc pools commonly do.
+  scheduler: ['pool', 'round-robin'],
+  // With 'skewed', every 16th task takes 20 times as long as the others.
+  tasks: ['uniform', 'skewed'],
+  // 'rate' reports tasks per second, 'p99' the 99th percentile of the time
+  // between submitting a task and getting its result in milliseconds, and
+  // 'utilization' the mean event loop utilization of the threads in percent.
+  metric: ['rate', 'p99', 'utilization'],
+  threads: [4],
+  n: [2e3]
+});
+
+const taskPath = path.resolve(__dirname, '..', 'fixtures', 'pool-task.js');
+
+function taskDuration(tasks, i) {
+  return tasks === 'skewed' && i % 16 === 0 ? 2 : 0.1;
+}
+
+function createPool(scheduler, threads) {
+  if (scheduler === 'pool') {
+    const pool = new Pool(taskPath, { size: threads });
+    return {
+      workers: pool.threads,
+      run: (ms) => pool.run(ms),
+      close: () => pool.close(),
+    };
+  }
+
+  const workers = [];
+  const pending = new Map();
+  let nextId = 0;
+  for (let i = 0; i < threads; i++) {
+    const worker = new Worker(taskPath, { workerData: 'round-robin' });
+    worker.on('message', ({ id, result }) => {
+      pending.get(id)(result);
+      pending.delete(id);
+    });
+    workers.push(worker);
+  }
+  return {
+    workers,
+    run: (ms) => new Promise((resolve) => {
+      const id = nextId++;
+      pending.set(id, resolve);
+      workers[id % threads].postMessage({ id, ms });
+    }),
+    close: () => Promise.all(workers.map((worker) => worker.terminate())),
+  };
+}
+
+function main({ n, scheduler, tasks, metric, threads }) {
+  const pool = createPool(scheduler, threads);
+  const latencies = new Float64Array(n);
+
+  // Warm up the threads before starting the measurement.
+  Promise.all(pool.workers.map(() => pool.run(0))).then(() => {
+    const elu = pool.workers.map((w) => w.performance.eventLoopUtilization());
+    const promises = [];
+    bench.start();
+    const start = process.hrtime();
+    for (let i = 0; i < n; i++) {
+      const submitted = process.hrtime.bigint();
+      promises.push(pool.run(taskDuration(tasks, i)).then(() => {
+        latencies[i] = Number(process.hrtime.bigint() - submitted) / 1e6;
+      }));
+    }
+    return Promise.all(promises).then(() => {
+      switch (metric) {
+        case 'rate':
+          bench.end(n);
+          break;
+        case 'p99':
+          latencies.sort();
+          bench.report(latencies[Math.floor(n * 0.99)], process.hrtime(start));
+          break;
+        case 'utilization': {
+          let sum = 0;
+          pool.workers.forEach((w, i) => {
+            sum += w.performance.eventLoopUtilization(elu[i]).utilization;
+          });
+          bench.report(sum / threads * 100, process.hrtime(start));
+          break;
+        }
+      }
+      return pool.close();
+    });
+  });
+}
@@ -77,6 +77,9 @@ const {
   getAllowUnauthorized,
 } = require('internal/options');
 const {
+  validateBoolean,
+  validateInteger,
+  validateObject,
   validateString,
   validateBuffer,
   validateUint32
@@ -93,6 +96,8 @@ const kSNICallback = Symbol('snicallback');
 const kEnableTrace = Symbol('enableTrace');
 const kPskCallback = Symbol('pskcallback');
 const kPskIdentityHint = Symbol('pskidentityhint');
+const kCoalesceWrites = Symbol('coalesceWrites');
+const kDynamicRecordSizing = Symbol('dynamicRecordSizing');
 const kPendingSession = Symbol('pendingSession');
 const kIsVerified = Symbol('verified');
 
@@ -101,6 +106,27 @@ const noop = () => {};
 let ipServernameWarned = false;
 let tlsTracingWarned = false;
 
+// Returns the settings of the dynamicRecordSizing option, or undefined if it
+// is disabled. By default, records fit into a single TCP segment until 1 MiB
+// has been written, and again after the connection has been idle for a
+// second.
+function getDynamicRecordSizing(value, name) {
+  if (value === undefined || value === false)
+    return undefined;
+  if (value === true)
+    value = {};
+  validateObject(value, name);
+  const {
+    initialRecordSize = 1369,
+    threshold = 1024 * 1024,
+    idleTimeout = 1000,
+  } = value;
+  validateInteger(initialRecordSize, `${name}.initialRecordSize`, 512, 16384);
+  validateInteger(threshold, `${name}.threshold`, 0);
+  validateInteger(idleTimeout, `${name}.idleTimeout`, 1, 2 ** 32 - 1);
+  return { initialRecordSize, threshold, idleTimeout };
+}
+
 // Server side times how long a handshake is taking to protect against slow
 // handshakes being used for DoS.
 function onhandshakestart(now) {
@@ -789,6 +815,19 @@ TLSSocket.prototype._init = function(socket, wrap) {
     }
   }
 
+  if (options.coalesceWrites !== undefined) {
+    validateBoolean(options.coalesceWrites, 'options.coalesceWrites');
+    ssl.setCoalesceWrites(options.coalesceWrites);
+  }
+
+  const recordSizing = getDynamicRecordSizing(
+    options.dynamicRecordSizing, 'options.dynamicRecordSizing');
+  if (recordSizing !== undefined && ssl.setDynamicRecordSizing) {
+    ssl.setDynamicRecordSizing(recordSizing.initialRecordSize,
+                               recordSizing.threshold,
+                               recordSizing.idleTimeout);
+  }
+
 
   if (options.handshakeTimeout > 0)
     this.setTimeout(options.handshakeTimeout, this._handleTimeout);
@@ -1076,6 +1115,8 @@ function tlsConnectionListener(rawSocket) {
     pauseOnConnect: this.pauseOnConnect,
     pskCallback: this[kPskCallback],
     pskIdentityHint: this[kPskIdentityHint],
+    coalesceWrites: this[kCoalesceWrites],
+    dynamicRecordSizing: this[kDynamicRecordSizing],
   });
 
   socket.on('secure', onServerSocketSecure);
@@ -1208,6 +1249,12 @@ function Server(options, listener) {
     );
   }
 
+  if (options.coalesceWrites !== undefined)
+    validateBoolean(options.coalesceWrites, 'options.coalesceWrites');
+  this[kCoalesceWrites] = options.coalesceWrites;
+  this[kDynamicRecordSizing] = getDynamicRecordSizing(
+    options.dynamicRecordSizing, 'options.dynamicRecordSizing');
+
   // constructor call
   net.Server.call(this, options, tlsConnectionListener);
 
@@ -1594,6 +1641,8 @@ exports.connect = function connect(...args) {
     pskCallback: options.pskCallback,
     highWaterMark: options.highWaterMark,
     onread: options.onread,
+    coalesceWrites: options.coalesceWrites,
+    dynamicRecordSizing: options.dynamicRecordSizing,
   });
 
   tlssock[kConnectOptions] = options;
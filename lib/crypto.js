@@ -77,6 +77,7 @@ const {
   createSecretKey,
   createPublicKey,
   createPrivateKey,
+  getKeyCacheStatistics,
   KeyObject,
 } = require('internal/crypto/keys');
 const {
@@ -86,6 +87,8 @@ const {
   diffieHellman
 } = require('internal/crypto/diffiehellman');
 const {
+  aeadOpen,
+  aeadSeal,
   Cipher,
   Cipheriv,
   Decipher,
@@ -98,13 +101,17 @@ const {
 } = require('internal/crypto/cipher');
 const {
   Sign,
+  signBatch,
   signOneShot,
   Verify,
+  verifyBatch,
   verifyOneShot
 } = require('internal/crypto/sig');
 const {
   Hash,
-  Hmac
+  Hmac,
+  hash,
+  hashBatch,
 } = require('internal/crypto/hash');
 const {
   getCiphers,
@@ -165,6 +172,8 @@ function createVerify(algorithm, options) {
 
 module.exports = {
   // Methods
+  aeadOpen,
+  aeadSeal,
   createCipheriv,
   createDecipheriv,
   createDiffieHellman,
@@ -183,6 +192,9 @@ module.exports = {
   getCurves,
   getDiffieHellman: createDiffieHellmanGroup,
   getHashes,
+  getKeyCacheStatistics,
+  hash,
+  hashBatch,
   hkdf,
   hkdfSync,
   pbkdf2,
@@ -202,6 +214,7 @@ module.exports = {
   scrypt,
   scryptSync,
   sign: signOneShot,
+  signBatch,
   setEngine,
   timingSafeEqual,
   getFips: !fipsMode ? getFipsDisabled :
@@ -209,6 +222,7 @@ module.exports = {
   setFips: !fipsMode ? setFipsDisabled :
     fipsForced ? setFipsForced : setFipsCrypto,
   verify: verifyOneShot,
+  verifyBatch,
 
   // Classes
   Certificate,
@@ -91,6 +91,22 @@ function onlookupall(err, addresses) {
 // Easy DNS A/AAAA look up
 // lookup(hostname, [options,] callback)
 function lookup(hostname, options, callback) {
+  return lookupWith(cares, hostname, options, callback);
+}
+
+ObjectDefineProperty(lookup, customPromisifyArgs,
+                     { value: ['address', 'family'], enumerable: false });
+
+// Same as lookup(), but resolves through the resolver's c-ares channel on the
+// event loop instead of through getaddrinfo(3) on the thread pool.
+function resolverLookup(hostname, options, callback) {
+  return lookupWith(this._handle, hostname, options, callback);
+}
+
+ObjectDefineProperty(resolverLookup, customPromisifyArgs,
+                     { value: ['address', 'family'], enumerable: false });
+
+function lookupWith(binding, hostname, options, callback) {
   let hints = 0;
   let family = -1;
   let all = false;
@@ -144,7 +160,7 @@ function lookup(hostname, options, callback) {
   req.hostname = hostname;
   req.oncomplete = all ? onlookupall : onlookup;
 
-  const err = cares.getaddrinfo(
+  const err = binding.getaddrinfo(
     req, toASCII(hostname), family, hints, verbatim
   );
   if (err) {
@@ -154,9 +170,6 @@ function lookup(hostname, options, callback) {
   return req;
 }
 
-ObjectDefineProperty(lookup, customPromisifyArgs,
-                     { value: ['address', 'family'], enumerable: false });
-
 
 function onlookupservice(err, hostname, service) {
   if (err)
@@ -246,6 +259,7 @@ Resolver.prototype.resolvePtr = resolveMap.PTR = resolver('queryPtr');
 Resolver.prototype.resolveNaptr = resolveMap.NAPTR = resolver('queryNaptr');
 Resolver.prototype.resolveSoa = resolveMap.SOA = resolver('querySoa');
 Resolver.prototype.reverse = resolver('getHostByAddr');
+Resolver.prototype.lookup = resolverLookup;
 
 Resolver.prototype.resolve = resolve;
 
@@ -49,6 +49,8 @@ function prepareMainThreadExecution(expandArgv1 = false) {
 
   initializeHeapSnapshotSignalHandlers();
 
+  initializeCpuProfileSignalHandlers();
+
   // If the process is spawned with env NODE_CHANNEL_FD, it's probably
   // spawned by our child_process module, then initialize IPC.
   // This attaches some internal event listeners and creates:
@@ -177,11 +179,13 @@ function setupStacktracePrinterOnSigint() {
 }
 
 function initializeReport() {
-  const { report } = require('internal/process/report');
+  let report;
   ObjectDefineProperty(process, 'report', {
     enumerable: false,
     configurable: true,
     get() {
+      if (report === undefined)
+        ({ report } = require('internal/process/report'));
       return report;
     }
   });
@@ -196,6 +200,9 @@ function setupDebugEnv() {
 
 // This has to be called after initializeReport() is called
 function initializeReportSignalHandlers() {
+  // Avoid loading the report binding during startup unless it is needed.
+  if (!getOptionValue('--report-on-signal'))
+    return;
   const { addSignalHandler } = require('internal/process/report');
 
   addSignalHandler();
@@ -215,6 +222,21 @@ function initializeHeapSnapshotSignalHandlers() {
   });
 }
 
+function initializeCpuProfileSignalHandlers() {
+  // Undefined when the inspector is disabled.
+  const signal = getOptionValue('--cpu-prof-signal');
+
+  if (!signal)
+    return;
+
+  require('internal/validators').validateSignalName(signal);
+  const { flushCpuProfile } = internalBinding('profiler');
+
+  process.on(signal, () => {
+    flushCpuProfile();
+  });
+}
+
 function setupTraceCategoryState() {
   const { isTraceCategoryEnabled } = internalBinding('trace_events');
   const { toggleTraceCategoryState } = require('internal/process/per_thread');
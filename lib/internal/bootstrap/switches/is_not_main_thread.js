@@ -28,13 +28,12 @@ process.removeListener('removeListener', stopListeningIfSignal);
 // ---- keep the attachment of the wrappers above so that it's easier to ----
 // ----              compare the setups side-by-side                    -----
 
-const {
-  createWorkerStdio
-} = require('internal/worker/io');
-
 let workerStdio;
 function lazyWorkerStdio() {
-  if (!workerStdio) workerStdio = createWorkerStdio();
+  if (!workerStdio) {
+    const { createWorkerStdio } = require('internal/worker/stdio');
+    workerStdio = createWorkerStdio();
+  }
   return workerStdio;
 }
 
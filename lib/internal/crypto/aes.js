@@ -6,14 +6,19 @@ const {
   ArrayFrom,
   ArrayPrototypeIncludes,
   ArrayPrototypePush,
+  FunctionPrototype,
   MathFloor,
   Promise,
+  PromisePrototypeCatch,
   SafeSet,
   TypedArrayPrototypeSlice,
+  Uint8Array,
 } = primordials;
 
 const {
   AESCipherJob,
+  AESCipherStream,
+  AESCipherStreamJob,
   KeyObjectHandle,
   kCryptoJobAsync,
   kKeyVariantAES_CTR_128,
@@ -69,6 +74,8 @@ const {
 
 const kMaxCounterLength = 128;
 const kTagLengths = [32, 64, 96, 104, 112, 120, 128];
+const kEmptyChunk = new Uint8Array(0);
+const noop = FunctionPrototype;
 
 function getAlgorithmName(name, length) {
   switch (name) {
@@ -117,7 +124,7 @@ function getVariant(name, length) {
   }
 }
 
-function asyncAesCtrCipher(mode, key, data, { counter, length }) {
+function validateAesCtrParams({ counter, length }) {
   counter = getArrayBufferOrView(counter, 'algorithm.counter');
   validateByteLength(counter, 'algorithm.counter', 16);
   // The length must specify an integer between 1 and 128. While
@@ -129,7 +136,11 @@ function asyncAesCtrCipher(mode, key, data, { counter, length }) {
       'AES-CTR algorithm.length must be between 1 and 128',
       'OperationError');
   }
+  return counter;
+}
 
+function asyncAesCtrCipher(mode, key, data, algorithm) {
+  const counter = validateAesCtrParams(algorithm);
   return jobPromise(new AESCipherJob(
     kCryptoJobAsync,
     mode,
@@ -137,7 +148,7 @@ function asyncAesCtrCipher(mode, key, data, { counter, length }) {
     data,
     getVariant('AES-CTR', key.algorithm.length),
     counter,
-    length));
+    algorithm.length));
 }
 
 function asyncAesCbcCipher(mode, key, data, { iv }) {
@@ -161,11 +172,7 @@ function asyncAesKwCipher(mode, key, data) {
     getVariant('AES-KW', key.algorithm.length)));
 }
 
-function asyncAesGcmCipher(
-  mode,
-  key,
-  data,
-  { iv, additionalData, tagLength = 128 }) {
+function validateAesGcmParams({ iv, additionalData, tagLength = 128 }) {
   if (!ArrayPrototypeIncludes(kTagLengths, tagLength)) {
     throw lazyDOMException(
       `${tagLength} is not a valid AES-GCM tag length`,
@@ -181,7 +188,11 @@ function asyncAesGcmCipher(
     validateMaxBufferLength(additionalData, 'algorithm.additionalData');
   }
 
-  const tagByteLength = MathFloor(tagLength / 8);
+  return { iv, additionalData, tagByteLength: MathFloor(tagLength / 8) };
+}
+
+function asyncAesGcmCipher(mode, key, data, algorithm) {
+  const { iv, additionalData, tagByteLength } = validateAesGcmParams(algorithm);
   let tag;
   switch (mode) {
     case kWebCryptoCipherDecrypt:
@@ -215,6 +226,62 @@ function aesCipher(mode, key, data, algorithm) {
   }
 }
 
+// Implementation for subtle.encryptStream(). Each chunk is encrypted in the
+// thread pool while the previous result is consumed and the next chunk is
+// read from the source.
+function aesEncryptStream(key, source, algorithm) {
+  const keyHandle = key[kKeyObject][kHandle];
+  const variant = getVariant(algorithm.name, key.algorithm.length);
+  let handle;
+  switch (algorithm.name) {
+    case 'AES-CTR':
+      handle = new AESCipherStream(
+        keyHandle, variant, validateAesCtrParams(algorithm), algorithm.length);
+      break;
+    case 'AES-GCM': {
+      const {
+        iv,
+        additionalData,
+        tagByteLength,
+      } = validateAesGcmParams(algorithm);
+      handle = new AESCipherStream(
+        keyHandle, variant, iv, tagByteLength, additionalData);
+      break;
+    }
+  }
+  return encryptChunks(handle, source);
+}
+
+function encryptChunk(handle, data, final) {
+  const promise = jobPromise(
+    new AESCipherStreamJob(kCryptoJobAsync, handle, data, final));
+  // The iteration can end before the job is awaited.
+  PromisePrototypeCatch(promise, noop);
+  return promise;
+}
+
+async function* encryptChunks(handle, source) {
+  let pending;
+  for await (const chunk of source) {
+    const data = getArrayBufferOrView(chunk, 'chunk');
+    validateMaxBufferLength(data, 'chunk');
+    if (pending === undefined) {
+      pending = encryptChunk(handle, data, false);
+      continue;
+    }
+    const output = await pending;
+    pending = encryptChunk(handle, data, false);
+    yield output;
+  }
+  if (pending !== undefined)
+    yield await pending;
+
+  // In GCM mode, this is the authentication tag.
+  const output = await encryptChunk(handle, kEmptyChunk, true);
+  if (output.byteLength > 0)
+    yield output;
+}
+
 async function aesGenerateKey(algorithm, extractable, keyUsages) {
   const { name, length } = algorithm;
   validateInteger(length, 'algorithm.length');
@@ -341,6 +408,7 @@ async function aesImportKey(
 
 module.exports = {
   aesCipher,
+  aesEncryptStream,
   aesGenerateKey,
   aesImportKey,
   getAlgorithmName,
@@ -4,6 +4,7 @@ const {
   ObjectSetPrototypeOf,
   ReflectApply,
   StringPrototypeToLowerCase,
+  Uint8Array,
 } = primordials;
 
 const {
@@ -27,12 +28,14 @@ const {
     ERR_CRYPTO_INVALID_STATE,
     ERR_INVALID_ARG_TYPE,
     ERR_INVALID_ARG_VALUE,
+    ERR_OUT_OF_RANGE,
   }
 } = require('internal/errors');
 
 const {
   validateEncoding,
   validateInt32,
+  validateInteger,
   validateObject,
   validateString,
 } = require('internal/validators');
@@ -51,6 +54,7 @@ const {
 } = require('internal/crypto/util');
 
 const {
+  isAnyArrayBuffer,
   isArrayBufferView,
 } = require('internal/util/types');
 
@@ -58,6 +62,8 @@ const assert = require('internal/assert');
 
 const LazyTransform = require('internal/streams/lazy_transform');
 
+const { Buffer } = require('buffer');
+
 const { normalizeEncoding } = require('internal/util');
 
 // Lazy loaded for startup performance.
@@ -204,6 +210,29 @@ Cipher.prototype.final = function final(outputEncoding) {
 };
 
 
+function validateOutput(output, outputOffset, name = 'output') {
+  if (!isArrayBufferView(output)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      name, ['Buffer', 'TypedArray', 'DataView'], output);
+  }
+  validateInteger(outputOffset, `${name}Offset`, 0, output.byteLength);
+}
+
+Cipher.prototype.updateInto = function updateInto(data, output,
+                                                  outputOffset = 0) {
+  if (!isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'data', ['Buffer', 'TypedArray', 'DataView'], data);
+  }
+  validateOutput(output, outputOffset);
+  return this[kHandle].updateInto(data, output, outputOffset);
+};
+
+Cipher.prototype.finalInto = function finalInto(output, outputOffset = 0) {
+  validateOutput(output, outputOffset);
+  return this[kHandle].finalInto(output, outputOffset);
+};
+
 Cipher.prototype.setAutoPadding = function setAutoPadding(ap) {
   if (!this[kHandle].setAutoPadding(!!ap))
     throw new ERR_CRYPTO_INVALID_STATE('setAutoPadding');
@@ -251,6 +280,8 @@ function addCipherPrototypeFunctions(constructor) {
   constructor.prototype._flush = Cipher.prototype._flush;
   constructor.prototype.update = Cipher.prototype.update;
   constructor.prototype.final = Cipher.prototype.final;
+  constructor.prototype.updateInto = Cipher.prototype.updateInto;
+  constructor.prototype.finalInto = Cipher.prototype.finalInto;
   constructor.prototype.setAutoPadding = Cipher.prototype.setAutoPadding;
   if (constructor === Cipheriv) {
     constructor.prototype.getAuthTag = Cipher.prototype.getAuthTag;
@@ -296,6 +327,84 @@ ObjectSetPrototypeOf(Decipheriv.prototype, LazyTransform.prototype);
 ObjectSetPrototypeOf(Decipheriv, LazyTransform);
 addCipherPrototypeFunctions(Decipheriv);
 
+// The handles used by aeadSeal() and aeadOpen(). They only hold state for the
+// duration of a single call, so one of each is enough.
+let sealHandle;
+let openHandle;
+
+function aead(decipher, algorithm, key, iv, data, options) {
+  validateString(algorithm, 'algorithm');
+  if (options !== undefined)
+    validateObject(options, 'options');
+  const encoding = getStringOption(options, 'encoding');
+  key = prepareSecretKey(key, encoding);
+  iv = getArrayBufferOrView(iv, 'iv');
+  data = getArrayBufferOrView(data, 'data');
+  let authTagLength = getUIntOption(options, 'authTagLength');
+  if (authTagLength === -1)
+    authTagLength = 16;
+  let aad;
+  if (options !== undefined && options.aad !== undefined)
+    aad = getArrayBufferOrView(options.aad, 'options.aad', encoding);
+
+  let authTag;
+  let outputLength;
+  if (decipher) {
+    if (data.byteLength < authTagLength) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'data', data, 'must contain the authentication tag');
+    }
+    outputLength = data.byteLength - authTagLength;
+    const buffer = isAnyArrayBuffer(data) ? data : data.buffer;
+    const byteOffset = isAnyArrayBuffer(data) ? 0 : data.byteOffset;
+    authTag = new Uint8Array(buffer, byteOffset + outputLength, authTagLength);
+    data = new Uint8Array(buffer, byteOffset, outputLength);
+  } else {
+    outputLength = data.byteLength + authTagLength;
+  }
+
+  let output;
+  let outputOffset = 0;
+  if (options !== undefined && options.output !== undefined) {
+    output = options.output;
+    if (options.outputOffset !== undefined)
+      outputOffset = options.outputOffset;
+    validateOutput(output, outputOffset, 'options.output');
+    if (output.byteLength - outputOffset < outputLength) {
+      throw new ERR_OUT_OF_RANGE(
+        'options.output.byteLength',
+        `>= ${outputOffset + outputLength}`,
+        output.byteLength);
+    }
+  } else {
+    output = Buffer.allocUnsafe(outputLength);
+  }
+
+  let handle;
+  if (decipher) {
+    if (openHandle === undefined)
+      openHandle = new CipherBase(false);
+    handle = openHandle;
+  } else {
+    if (sealHandle === undefined)
+      sealHandle = new CipherBase(true);
+    handle = sealHandle;
+  }
+
+  const written = handle.aead(algorithm, key, iv, authTagLength, data, aad,
+                              output, outputOffset, authTag);
+  return options !== undefined && options.output !== undefined ?
+    written : output;
+}
+
+function aeadSeal(algorithm, key, iv, plaintext, options) {
+  return aead(false, algorithm, key, iv, plaintext, options);
+}
+
+function aeadOpen(algorithm, key, iv, ciphertext, options) {
+  return aead(true, algorithm, key, iv, ciphertext, options);
+}
+
 function getCipherInfo(nameOrNid, options) {
   if (typeof nameOrNid !== 'string' && typeof nameOrNid !== 'number') {
     throw new ERR_INVALID_ARG_TYPE(
@@ -324,6 +433,8 @@ function getCipherInfo(nameOrNid, options) {
 }
 
 module.exports = {
+  aeadOpen,
+  aeadSeal,
   Cipher,
   Cipheriv,
   Decipher,
@@ -1,16 +1,35 @@
 'use strict';
 
 const {
+  ArrayIsArray,
+  ArrayPrototypeMap,
+  FunctionPrototypeCall,
+  FunctionPrototype,
   ObjectSetPrototypeOf,
+  PromisePrototypeCatch,
   ReflectApply,
+  SafeMap,
   Symbol,
+  Uint8Array,
 } = primordials;
 
 const {
+  Checksum: _Checksum,
+  ChecksumBatchJob,
   Hash: _Hash,
+  HashBatchJob,
   HashJob,
+  HashStreamJob,
   Hmac: _Hmac,
+  getCachedMD,
+  kChecksumCRC32C,
+  kChecksumXXH3,
+  kChecksumXXH64,
   kCryptoJobAsync,
+  oneShotChecksum,
+  oneShotChecksumBatch,
+  oneShotDigest,
+  oneShotDigestBatch,
 } = internalBinding('crypto');
 
 const {
@@ -36,7 +55,10 @@ const {
   codes: {
     ERR_CRYPTO_HASH_FINALIZED,
     ERR_CRYPTO_HASH_UPDATE_FAILED,
+    ERR_CRYPTO_INVALID_DIGEST,
     ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
+    ERR_INVALID_CALLBACK,
   }
 } = require('internal/errors');
 
@@ -55,16 +77,35 @@ const LazyTransform = require('internal/streams/lazy_transform');
 const kState = Symbol('kState');
 const kFinalized = Symbol('kFinalized');
 
+// Non-cryptographic checksums, which are computed by Node.js itself rather
+// than by OpenSSL.
+const checksums = new SafeMap([
+  ['crc32c', kChecksumCRC32C],
+  ['xxh3', kChecksumXXH3],
+  ['xxh64', kChecksumXXH64],
+]);
+
 function Hash(algorithm, options) {
   if (!(this instanceof Hash))
     return new Hash(algorithm, options);
-  if (!(algorithm instanceof _Hash))
+  if (!(algorithm instanceof _Hash) && !(algorithm instanceof _Checksum))
     validateString(algorithm, 'algorithm');
   const xofLen = typeof options === 'object' && options !== null ?
     options.outputLength : undefined;
   if (xofLen !== undefined)
     validateUint32(xofLen, 'options.outputLength');
-  this[kHandle] = new _Hash(algorithm, xofLen);
+  const checksum = checksums.get(algorithm);
+  if (checksum !== undefined) {
+    // Checksums have a fixed length.
+    const length = checksum === kChecksumCRC32C ? 4 : 8;
+    if (xofLen !== undefined && xofLen !== length)
+      throw new ERR_CRYPTO_INVALID_DIGEST(algorithm);
+    this[kHandle] = new _Checksum(checksum);
+  } else if (algorithm instanceof _Checksum) {
+    this[kHandle] = new _Checksum(algorithm);
+  } else {
+    this[kHandle] = new _Hash(algorithm, xofLen);
+  }
   this[kState] = {
     [kFinalized]: false
   };
@@ -161,6 +202,85 @@ Hmac.prototype.digest = function digest(outputEncoding) {
 Hmac.prototype._flush = Hash.prototype._flush;
 Hmac.prototype._transform = Hash.prototype._transform;
 
+// Maps the names of the digests to their native handles, so that they do
+// not have to be looked up by name for every call to hash().
+const mdCache = new SafeMap();
+
+function getMD(algorithm) {
+  let md = mdCache.get(algorithm);
+  if (md === undefined) {
+    validateString(algorithm, 'algorithm');
+    md = getCachedMD(algorithm);
+    if (md === undefined)
+      throw new ERR_CRYPTO_INVALID_DIGEST(algorithm);
+    mdCache.set(algorithm, md);
+  }
+  return md;
+}
+
+function validateOutputEncoding(outputEncoding) {
+  if (outputEncoding !== 'buffer' && !Buffer.isEncoding(outputEncoding)) {
+    throw new ERR_INVALID_ARG_VALUE('outputEncoding', outputEncoding,
+                                    'must be a valid encoding or \'buffer\'');
+  }
+}
+
+function validateHashInput(data, name) {
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      name, ['string', 'Buffer', 'TypedArray', 'DataView'], data);
+  }
+}
+
+function hash(algorithm, data, outputEncoding = 'hex') {
+  const checksum = checksums.get(algorithm);
+  const md = checksum === undefined ? getMD(algorithm) : undefined;
+  validateHashInput(data, 'data');
+  validateOutputEncoding(outputEncoding);
+  if (checksum !== undefined)
+    return oneShotChecksum(checksum, data, outputEncoding);
+  return oneShotDigest(md, data, outputEncoding);
+}
+
+function hashBatch(algorithm, inputs, outputEncoding = 'hex', callback) {
+  if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = 'hex';
+  }
+  const checksum = checksums.get(algorithm);
+  const md = checksum === undefined ? getMD(algorithm) : undefined;
+  if (!ArrayIsArray(inputs))
+    throw new ERR_INVALID_ARG_TYPE('inputs', 'Array', inputs);
+  for (let i = 0; i < inputs.length; i++)
+    validateHashInput(inputs[i], `inputs[${i}]`);
+  validateOutputEncoding(outputEncoding);
+  if (callback === undefined) {
+    return checksum === undefined ?
+      oneShotDigestBatch(md, inputs, outputEncoding) :
+      oneShotChecksumBatch(checksum, inputs, outputEncoding);
+  }
+  if (typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  // The thread pool only works on bytes.
+  const data = ArrayPrototypeMap(inputs, (input) => {
+    return typeof input === 'string' ? Buffer.from(input, 'utf8') : input;
+  });
+  const job = checksum === undefined ?
+    new HashBatchJob(kCryptoJobAsync, algorithm, data) :
+    new ChecksumBatchJob(kCryptoJobAsync, checksum, data);
+  job.ondone = (error, digests) => {
+    if (error) return FunctionPrototypeCall(callback, job, error);
+    const result = ArrayPrototypeMap(digests, (digest) => {
+      const buffer = Buffer.from(digest);
+      return outputEncoding === 'buffer' ?
+        buffer : buffer.toString(outputEncoding);
+    });
+    FunctionPrototypeCall(callback, job, null, result);
+  };
+  job.run();
+}
+
 // Implementation for WebCrypto subtle.digest()
 
 async function asyncDigest(algorithm, data) {
@@ -178,8 +298,45 @@ async function asyncDigest(algorithm, data) {
     algorithm.length));
 }
 
+// Implementation for subtle.digestStream(). Each chunk is hashed in the
+// thread pool while the next one is read from the source.
+
+const kEmptyChunk = new Uint8Array(0);
+const noop = FunctionPrototype;
+
+async function asyncDigestStream(algorithm, source) {
+  algorithm = normalizeAlgorithm(algorithm);
+
+  if (algorithm.length !== undefined)
+    validateUint32(algorithm.length, 'algorithm.length');
+
+  const handle = new _Hash(
+    normalizeHashName(algorithm.name),
+    algorithm.length === undefined ? undefined : algorithm.length >>> 3);
+
+  let pending;
+  for await (const chunk of source) {
+    const data = getArrayBufferOrView(chunk, 'chunk');
+    validateMaxBufferLength(data, 'chunk');
+    if (pending !== undefined)
+      await pending;
+    pending = jobPromise(
+      new HashStreamJob(kCryptoJobAsync, handle, data, false));
+    // The source can fail before the job is awaited.
+    PromisePrototypeCatch(pending, noop);
+  }
+  if (pending !== undefined)
+    await pending;
+
+  return jobPromise(
+    new HashStreamJob(kCryptoJobAsync, handle, kEmptyChunk, true));
+}
+
 module.exports = {
   Hash,
   Hmac,
   asyncDigest,
+  asyncDigestStream,
+  hash,
+  hashBatch,
 };
@@ -2,6 +2,7 @@
 
 const {
   ArrayFrom,
+  Float64Array,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
   Symbol,
@@ -10,6 +11,7 @@ const {
 const {
   KeyObjectHandle,
   createNativeKeyObjectClass,
+  getKeyCacheStatistics: _getKeyCacheStatistics,
   kKeyTypeSecret,
   kKeyTypePublic,
   kKeyTypePrivate,
@@ -413,6 +415,20 @@ function createPrivateKey(key) {
   return new PrivateKeyObject(handle);
 }
 
+// Keys that are passed as strings or buffers are parsed once and then kept
+// in a process-wide cache, which is shared by all threads.
+function getKeyCacheStatistics() {
+  const fields = new Float64Array(5);
+  _getKeyCacheStatistics(fields);
+  return {
+    hits: fields[0],
+    misses: fields[1],
+    evictions: fields[2],
+    size: fields[3],
+    capacity: fields[4],
+  };
+}
+
 function isKeyObject(key) {
   return key instanceof KeyObject;
 }
@@ -520,6 +536,7 @@ module.exports = {
   createSecretKey,
   createPublicKey,
   createPrivateKey,
+  getKeyCacheStatistics,
   KeyObject,
   CryptoKey,
   InternalCryptoKey,
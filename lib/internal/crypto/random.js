@@ -43,6 +43,78 @@ const { FastBuffer } = require('internal/buffer');
 const kMaxUint32 = 2 ** 32 - 1;
 const kMaxPossibleLength = MathMin(kMaxLength, kMaxUint32);
 
+// Small synchronous requests are served from a pool of random bytes that is
+// filled in bulk, which is much cheaper than running a RandomBytesJob for
+// each of them. Once less than kPoolRefillThreshold bytes are left, a spare
+// pool is filled in the thread pool, and swapped in when the current one is
+// used up. The pool only falls back to filling itself synchronously if the
+// spare pool is not ready yet.
+//
+// The pools are allocated on first use so that no random data ends up in a
+// startup snapshot, and each Environment (i.e. each Worker) has its own.
+// Bytes are zeroed as they are handed out so that they do not linger in
+// memory.
+const kPoolSize = 16 * 1024;
+const kMaxPooledSize = 1024;
+const kPoolRefillThreshold = kPoolSize / 4;
+
+let pool;
+let poolOffset = kPoolSize;
+let sparePool;
+let sparePoolState = 0;  // 0: empty, 1: filling, 2: ready.
+
+function fillSparePool() {
+  if (sparePoolState !== 0)
+    return;
+  if (sparePool === undefined)
+    sparePool = new FastBuffer(kPoolSize);
+  sparePoolState = 1;
+  const job = new RandomBytesJob(kCryptoJobAsync, sparePool, 0, kPoolSize);
+  job.ondone = (error) => {
+    sparePoolState = error ? 0 : 2;
+  };
+  job.run();
+}
+
+function refillPool() {
+  if (sparePoolState === 2) {
+    const empty = pool;
+    pool = sparePool;
+    sparePool = empty;
+    sparePoolState = 0;
+  } else {
+    if (pool === undefined)
+      pool = new FastBuffer(kPoolSize);
+    const job = new RandomBytesJob(kCryptoJobSync, pool, 0, kPoolSize);
+    const [ err ] = job.run();
+    if (err)
+      throw err;
+  }
+  poolOffset = 0;
+}
+
+// Returns the offset of |size| unused bytes in |pool|. The caller must zero
+// them after use.
+function takeFromPool(size) {
+  if (poolOffset + size > kPoolSize)
+    refillPool();
+  const offset = poolOffset;
+  poolOffset += size;
+  if (kPoolSize - poolOffset < kPoolRefillThreshold)
+    fillSparePool();
+  return offset;
+}
+
+function randomFillFromPool(buf, offset, size) {
+  const start = takeFromPool(size);
+  const end = start + size;
+  const target = isAnyArrayBuffer(buf) ?
+    new FastBuffer(buf, offset, size) :
+    new FastBuffer(buf.buffer, buf.byteOffset + offset, size);
+  pool.copy(target, 0, start, end);
+  pool.fill(0, start, end);
+}
+
 function assertOffset(offset, elementSize, length) {
   validateNumber(offset, 'offset');
   offset *= elementSize;
@@ -79,7 +151,10 @@ function randomBytes(size, callback) {
   const buf = new FastBuffer(size);
 
   if (callback === undefined) {
-    randomFillSync(buf.buffer, 0, size);
+    if (size !== 0 && size <= kMaxPooledSize)
+      randomFillFromPool(buf, 0, size);
+    else
+      randomFillSync(buf.buffer, 0, size);
     return buf;
   }
 
@@ -111,6 +186,11 @@ function randomFillSync(buf, offset = 0, size) {
   if (size === 0)
     return buf;
 
+  if (size <= kMaxPooledSize) {
+    randomFillFromPool(buf, offset, size);
+    return buf;
+  }
+
   const job = new RandomBytesJob(
     kCryptoJobSync,
     buf,
@@ -217,7 +297,9 @@ function randomInt(min, max, callback) {
   if (isSync) {
     // Sync API
     while (true) {
-      const x = randomBytes(6).readUIntBE(0, 6);
+      const offset = takeFromPool(6);
+      const x = pool.readUIntBE(offset, 6);
+      pool.fill(0, offset, offset + 6);
       // If x > (maxVal - (maxVal % range)), we will get "modulo bias"
       if (x > randLimit) {
         // Try again
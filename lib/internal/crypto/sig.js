@@ -1,15 +1,20 @@
 'use strict';
 
 const {
+  ArrayIsArray,
+  ArrayPrototypeMap,
+  FunctionPrototypeCall,
   ObjectSetPrototypeOf,
   ReflectApply,
 } = primordials;
 
 const {
   codes: {
+    ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE,
     ERR_CRYPTO_SIGN_KEY_REQUIRED,
     ERR_INVALID_ARG_TYPE,
     ERR_INVALID_ARG_VALUE,
+    ERR_INVALID_CALLBACK,
   }
 } = require('internal/errors');
 
@@ -20,11 +25,16 @@ const {
 
 const {
   Sign: _Sign,
+  SignBatchJob,
   Verify: _Verify,
   signOneShot: _signOneShot,
   verifyOneShot: _verifyOneShot,
+  kCryptoJobAsync,
+  kCryptoJobSync,
   kSigEncDER,
   kSigEncP1363,
+  kSignJobModeSign,
+  kSignJobModeVerify,
 } = internalBinding('crypto');
 
 const {
@@ -34,10 +44,15 @@ const {
 } = require('internal/crypto/util');
 
 const {
+  createPrivateKey,
+  createPublicKey,
+  isKeyObject,
   preparePublicOrPrivateKey,
   preparePrivateKey,
 } = require('internal/crypto/keys');
 
+const { Buffer } = require('buffer');
+
 const { Writable } = require('stream');
 
 const {
@@ -237,9 +252,125 @@ function verifyOneShot(algorithm, data, key, signature) {
                         data, algorithm, rsaPadding, pssSaltLength, dsaSigEnc);
 }
 
+// Returns the KeyObject to use for signBatch() or verifyBatch(), which is
+// created once for the whole batch if needed.
+function getBatchKeyObject(key, type) {
+  let keyObject = isKeyObject(key) ? key :
+    key !== null && typeof key === 'object' && isKeyObject(key.key) ?
+      key.key : undefined;
+  if (keyObject === undefined) {
+    keyObject = type === 'private' ? createPrivateKey(key) :
+      createPublicKey(key);
+  } else if (keyObject.type !== type) {
+    if (type !== 'public' || keyObject.type !== 'private')
+      throw new ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE(keyObject.type, type);
+    keyObject = createPublicKey(keyObject);
+  }
+
+  // Only the signatures of EC keys can be converted in the thread pool.
+  if (getDSASignatureEncoding(key) === kSigEncP1363 &&
+      keyObject.asymmetricKeyType === 'dsa') {
+    throw new ERR_INVALID_ARG_VALUE('key.dsaEncoding', key.dsaEncoding,
+                                    'is not supported for DSA keys');
+  }
+  return keyObject;
+}
+
+function validateBatchInputs(inputs, name) {
+  if (!ArrayIsArray(inputs))
+    throw new ERR_INVALID_ARG_TYPE(name, 'Array', inputs);
+  for (let i = 0; i < inputs.length; i++) {
+    if (!isArrayBufferView(inputs[i])) {
+      throw new ERR_INVALID_ARG_TYPE(
+        `${name}[${i}]`, ['Buffer', 'TypedArray', 'DataView'], inputs[i]);
+    }
+  }
+}
+
+// Runs the job returned by createJob(mode) synchronously if there is no
+// callback, and in the thread pool otherwise.
+function runBatchJob(createJob, callback, toResult) {
+  if (callback === undefined) {
+    const { 0: err, 1: results } = createJob(kCryptoJobSync).run();
+    if (err !== undefined)
+      throw err;
+    return toResult(results);
+  }
+
+  const job = createJob(kCryptoJobAsync);
+  job.ondone = (error, results) => {
+    if (error) return FunctionPrototypeCall(callback, job, error);
+    FunctionPrototypeCall(callback, job, null, toResult(results));
+  };
+  job.run();
+}
+
+function toBuffers(signatures) {
+  return ArrayPrototypeMap(signatures, (signature) => Buffer.from(signature));
+}
+
+function toBooleans(results) {
+  return results;
+}
+
+function signBatch(algorithm, inputs, key, callback) {
+  if (algorithm != null)
+    validateString(algorithm, 'algorithm');
+  validateBatchInputs(inputs, 'inputs');
+  if (!key)
+    throw new ERR_CRYPTO_SIGN_KEY_REQUIRED();
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  const handle = getBatchKeyObject(key, 'private')[kHandle];
+  const saltLength = getSaltLength(key);
+  const padding = getPadding(key);
+  const dsaSigEnc = getDSASignatureEncoding(key);
+  return runBatchJob((mode) => new SignBatchJob(
+    mode,
+    kSignJobModeSign,
+    handle,
+    inputs,
+    algorithm,
+    saltLength,
+    padding,
+    undefined,
+    dsaSigEnc), callback, toBuffers);
+}
+
+function verifyBatch(algorithm, inputs, key, signatures, callback) {
+  if (algorithm != null)
+    validateString(algorithm, 'algorithm');
+  validateBatchInputs(inputs, 'inputs');
+  validateBatchInputs(signatures, 'signatures');
+  if (signatures.length !== inputs.length) {
+    throw new ERR_INVALID_ARG_VALUE('signatures', signatures,
+                                    'must have the same length as inputs');
+  }
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  const handle = getBatchKeyObject(key, 'public')[kHandle];
+  const saltLength = getSaltLength(key);
+  const padding = getPadding(key);
+  const dsaSigEnc = getDSASignatureEncoding(key);
+  return runBatchJob((mode) => new SignBatchJob(
+    mode,
+    kSignJobModeVerify,
+    handle,
+    inputs,
+    algorithm,
+    saltLength,
+    padding,
+    signatures,
+    dsaSigEnc), callback, toBooleans);
+}
+
 module.exports = {
   Sign,
+  signBatch,
   signOneShot,
   Verify,
+  verifyBatch,
   verifyOneShot,
 };
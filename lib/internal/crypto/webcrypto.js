@@ -6,6 +6,8 @@ const {
   JSONStringify,
   ObjectDefineProperties,
   SafeSet,
+  SymbolAsyncIterator,
+  SymbolIterator,
   SymbolToStringTag,
   StringPrototypeRepeat,
 } = primordials;
@@ -44,6 +46,7 @@ const {
 
 const {
   asyncDigest,
+  asyncDigestStream,
 } = require('internal/crypto/hash');
 
 const {
@@ -640,6 +643,47 @@ async function decrypt(algorithm, key, data) {
   return cipherOrWrap(kWebCryptoCipherDecrypt, algorithm, key, data, 'decrypt');
 }
 
+// subtle.digestStream() and subtle.encryptStream() are Node.js-specific
+// extensions that take their input from an iterable or async iterable of
+// chunks, such as a stream.Readable, instead of a single buffer.
+
+function validateChunkSource(source) {
+  if (source === null ||
+      typeof source !== 'object' ||
+      (typeof source[SymbolAsyncIterator] !== 'function' &&
+       typeof source[SymbolIterator] !== 'function')) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'source', ['Iterable', 'AsyncIterable'], source);
+  }
+}
+
+async function digestStream(algorithm, source) {
+  validateChunkSource(source);
+  return asyncDigestStream(algorithm, source);
+}
+
+function encryptStream(algorithm, key, source) {
+  algorithm = normalizeAlgorithm(algorithm);
+  if (!isCryptoKey(key))
+    throw new ERR_INVALID_ARG_TYPE('key', 'CryptoKey', key);
+  if (key.algorithm.name !== algorithm.name ||
+      !ArrayPrototypeIncludes(key.usages, 'encrypt')) {
+    throw lazyDOMException(
+      'The requested operation is not valid for the provided key',
+      'InvalidAccessError');
+  }
+  validateChunkSource(source);
+
+  switch (algorithm.name) {
+    case 'AES-CTR':
+      // Fall through
+    case 'AES-GCM':
+      return lazyRequire('internal/crypto/aes')
+        .aesEncryptStream(key, source, algorithm);
+  }
+  throw lazyDOMException('Unrecognized name.', 'NotSupportedError');
+}
+
 // The SubtleCrypto and Crypto classes are defined as part of the
 // Web Crypto API standard: https://www.w3.org/TR/WebCryptoAPI/
 
@@ -714,6 +758,18 @@ ObjectDefineProperties(
       writable: true,
       value: asyncDigest,
     },
+    digestStream: {
+      enumerable: true,
+      configurable: true,
+      writable: true,
+      value: digestStream,
+    },
+    encryptStream: {
+      enumerable: true,
+      configurable: true,
+      writable: true,
+      value: encryptStream,
+    },
     generateKey: {
       enumerable: true,
       configurable: true,
@@ -8,22 +8,21 @@ const {
 
 const {
   bindDefaultResolver,
+  createChannel,
   Resolver: CallbackResolver,
   validateHints,
-  validateTimeout,
   emitInvalidHostnameWarning,
 } = require('internal/dns/utils');
 const { codes, dnsException } = require('internal/errors');
 const { toASCII } = require('internal/idna');
 const { isIP } = require('internal/net');
+const cares = internalBinding('cares_wrap');
 const {
-  getaddrinfo,
   getnameinfo,
-  ChannelWrap,
   GetAddrInfoReqWrap,
   GetNameInfoReqWrap,
   QueryReqWrap
-} = internalBinding('cares_wrap');
+} = cares;
 const {
   ERR_INVALID_ARG_TYPE,
   ERR_INVALID_ARG_VALUE,
@@ -65,7 +64,7 @@ function onlookupall(err, addresses) {
   this.resolve(addresses);
 }
 
-function createLookupPromise(family, hostname, all, hints, verbatim) {
+function createLookupPromise(binding, family, hostname, all, hints, verbatim) {
   return new Promise((resolve, reject) => {
     if (!hostname) {
       emitInvalidHostnameWarning(hostname);
@@ -89,7 +88,8 @@ function createLookupPromise(family, hostname, all, hints, verbatim) {
     req.resolve = resolve;
     req.reject = reject;
 
-    const err = getaddrinfo(req, toASCII(hostname), family, hints, verbatim);
+    const err = binding.getaddrinfo(
+      req, toASCII(hostname), family, hints, verbatim);
 
     if (err) {
       reject(dnsException(err, 'getaddrinfo', hostname));
@@ -98,6 +98,10 @@ function createLookupPromise(family, hostname, all, hints, verbatim) {
 }
 
 function lookup(hostname, options) {
+  return lookupWith(cares, hostname, options);
+}
+
+function lookupWith(binding, hostname, options) {
   var hints = 0;
   var family = -1;
   var all = false;
@@ -119,7 +123,7 @@ function lookup(hostname, options) {
 
   validateOneOf(family, 'family', [0, 4, 6], true);
 
-  return createLookupPromise(family, hostname, all, hints, verbatim);
+  return createLookupPromise(binding, family, hostname, all, hints, verbatim);
 }
 
 
@@ -210,14 +214,15 @@ const resolveMap = ObjectCreate(null);
 // Resolver instances correspond 1:1 to c-ares channels.
 class Resolver {
   constructor(options = undefined) {
-    const timeout = validateTimeout(options);
-    this._handle = new ChannelWrap(timeout);
+    this._handle = createChannel(options);
   }
 }
 
 Resolver.prototype.getServers = CallbackResolver.prototype.getServers;
 Resolver.prototype.setServers = CallbackResolver.prototype.setServers;
 Resolver.prototype.cancel = CallbackResolver.prototype.cancel;
+Resolver.prototype.getCacheStats = CallbackResolver.prototype.getCacheStats;
+Resolver.prototype.clearCache = CallbackResolver.prototype.clearCache;
 Resolver.prototype.setLocalAddress = CallbackResolver.prototype.setLocalAddress;
 Resolver.prototype.resolveAny = resolveMap.ANY = resolver('queryAny');
 Resolver.prototype.resolve4 = resolveMap.A = resolver('queryA');
@@ -232,6 +237,9 @@ Resolver.prototype.resolvePtr = resolveMap.PTR = resolver('queryPtr');
 Resolver.prototype.resolveNaptr = resolveMap.NAPTR = resolver('queryNaptr');
 Resolver.prototype.resolveSoa = resolveMap.SOA = resolver('querySoa');
 Resolver.prototype.reverse = resolver('getHostByAddr');
+Resolver.prototype.lookup = function lookup(hostname, options) {
+  return lookupWith(this._handle, hostname, options);
+};
 Resolver.prototype.resolve = function resolve(hostname, rrtype) {
   var resolver;
 
@@ -3,13 +3,18 @@
 const {
   ArrayIsArray,
   ArrayPrototypePush,
+  Float64Array,
   NumberParseInt,
   StringPrototypeReplace,
 } = primordials;
 
 const errors = require('internal/errors');
 const { isIP } = require('internal/net');
-const { validateInt32 } = require('internal/validators');
+const {
+  validateInt32,
+  validateObject,
+  validateUint32,
+} = require('internal/validators');
 const {
   ChannelWrap,
   strerror,
@@ -18,6 +23,8 @@ const {
   AI_V4MAPPED,
 } = internalBinding('cares_wrap');
 const IANA_DNS_PORT = 53;
+const kDefaultCacheMaxEntries = 1000;
+const kDefaultCacheMaxTtl = 3600;
 const IPv6RE = /^\[([^[\]]*)\]/;
 const addrSplitRE = /(^.+?)(?::(\d+))?$/;
 const {
@@ -33,17 +40,64 @@ function validateTimeout(options) {
   return timeout;
 }
 
+// Returns the arguments for ChannelWrap#setCacheOptions(), or null if the
+// resolver should not cache answers.
+function validateCache(options) {
+  const { cache = false } = { ...options };
+  if (typeof cache === 'boolean') {
+    if (!cache)
+      return null;
+    return [kDefaultCacheMaxEntries, kDefaultCacheMaxTtl, 0, 0];
+  }
+  validateObject(cache, 'options.cache');
+  const {
+    maxEntries = kDefaultCacheMaxEntries,
+    maxTtl = kDefaultCacheMaxTtl,
+    negativeTtl = 0,
+    staleTtl = 0,
+  } = cache;
+  validateUint32(maxEntries, 'options.cache.maxEntries', true);
+  validateUint32(maxTtl, 'options.cache.maxTtl');
+  validateUint32(negativeTtl, 'options.cache.negativeTtl');
+  validateUint32(staleTtl, 'options.cache.staleTtl');
+  return [maxEntries, maxTtl, negativeTtl, staleTtl];
+}
+
+function createChannel(options) {
+  const timeout = validateTimeout(options);
+  const cache = validateCache(options);
+  const handle = new ChannelWrap(timeout);
+  if (cache !== null)
+    handle.setCacheOptions(cache[0], cache[1], cache[2], cache[3]);
+  return handle;
+}
+
+const cacheStats = new Float64Array(4);
+
 // Resolver instances correspond 1:1 to c-ares channels.
 class Resolver {
   constructor(options = undefined) {
-    const timeout = validateTimeout(options);
-    this._handle = new ChannelWrap(timeout);
+    this._handle = createChannel(options);
   }
 
   cancel() {
     this._handle.cancel();
   }
 
+  getCacheStats() {
+    this._handle.getCacheStats(cacheStats);
+    return {
+      hits: cacheStats[0],
+      misses: cacheStats[1],
+      staleHits: cacheStats[2],
+      size: cacheStats[3],
+    };
+  }
+
+  clearCache() {
+    this._handle.clearCache();
+  }
+
   getServers() {
     return this._handle.getServers().map((val) => {
       if (!val[1] || val[1] === IANA_DNS_PORT)
@@ -184,6 +238,7 @@ function emitInvalidHostnameWarning(hostname) {
 
 module.exports = {
   bindDefaultResolver,
+  createChannel,
   getDefaultResolver,
   setDefaultResolver,
   validateHints,
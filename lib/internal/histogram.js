@@ -5,25 +5,47 @@ const {
 } = require('internal/util');
 
 const { format } = require('util');
-const { Map, Symbol } = primordials;
+const {
+  BigInt,
+  Map,
+  NumberMAX_SAFE_INTEGER,
+  ObjectSetPrototypeOf,
+  Symbol,
+} = primordials;
 
 const {
   ERR_INVALID_ARG_TYPE,
   ERR_INVALID_ARG_VALUE,
+  ERR_OPERATION_FAILED,
+  ERR_OUT_OF_RANGE,
 } = require('internal/errors').codes;
 
+const {
+  JSTransferable,
+  kClone,
+  kDeserialize,
+} = require('internal/worker/js_transferable');
+
+const {
+  createHistogram: _createHistogram,
+} = internalBinding('performance');
+
+const {
+  validateInteger,
+  validateObject,
+} = require('internal/validators');
+
 const kDestroy = Symbol('kDestroy');
 const kHandle = Symbol('kHandle');
+const kMap = Symbol('kMap');
 
 // Histograms are created internally by Node.js and used to
 // record various metrics. This Histogram class provides a
 // generally read-only view of the internal histogram.
 class Histogram {
-  #handle = undefined;
-  #map = new Map();
-
   constructor(internal) {
-    this.#handle = internal;
+    this[kHandle] = internal;
+    this[kMap] = new Map();
   }
 
   [kInspect]() {
@@ -39,23 +61,23 @@ class Histogram {
   }
 
   get min() {
-    return this.#handle ? this.#handle.min() : undefined;
+    return this[kHandle] ? this[kHandle].min() : undefined;
   }
 
   get max() {
-    return this.#handle ? this.#handle.max() : undefined;
+    return this[kHandle] ? this[kHandle].max() : undefined;
   }
 
   get mean() {
-    return this.#handle ? this.#handle.mean() : undefined;
+    return this[kHandle] ? this[kHandle].mean() : undefined;
   }
 
   get exceeds() {
-    return this.#handle ? this.#handle.exceeds() : undefined;
+    return this[kHandle] ? this[kHandle].exceeds() : undefined;
   }
 
   get stddev() {
-    return this.#handle ? this.#handle.stddev() : undefined;
+    return this[kHandle] ? this[kHandle].stddev() : undefined;
   }
 
   percentile(percentile) {
@@ -65,30 +87,98 @@ class Histogram {
     if (percentile <= 0 || percentile > 100)
       throw new ERR_INVALID_ARG_VALUE.RangeError('percentile', percentile);
 
-    return this.#handle ? this.#handle.percentile(percentile) : undefined;
+    return this[kHandle] ? this[kHandle].percentile(percentile) : undefined;
   }
 
   get percentiles() {
-    this.#map.clear();
-    if (this.#handle)
-      this.#handle.percentiles(this.#map);
-    return this.#map;
+    if (this[kMap] === undefined)
+      this[kMap] = new Map();
+    this[kMap].clear();
+    if (this[kHandle])
+      this[kHandle].percentiles(this[kMap]);
+    return this[kMap];
   }
 
   reset() {
-    if (this.#handle)
-      this.#handle.reset();
+    if (this[kHandle])
+      this[kHandle].reset();
   }
 
   [kDestroy]() {
-    this.#handle = undefined;
+    this[kHandle] = undefined;
+  }
+}
+
+// A Histogram that can be recorded from JavaScript on any thread. Cloning
+// it to a Worker with postMessage() shares the underlying histogram, so that
+// values recorded by either thread are visible to both.
+class RecordableHistogram extends Histogram {
+  constructor() {
+    throw new ERR_OPERATION_FAILED('Illegal constructor');
+  }
+
+  get count() {
+    return this[kHandle] ? this[kHandle].count() : undefined;
+  }
+
+  record(value) {
+    if (typeof value === 'bigint') {
+      if (value < 1n || value > BigInt(NumberMAX_SAFE_INTEGER)) {
+        throw new ERR_OUT_OF_RANGE(
+          'value', `>= 1 && <= ${NumberMAX_SAFE_INTEGER}`, value);
+      }
+    } else {
+      validateInteger(value, 'value', 1);
+    }
+    this[kHandle].record(value);
+  }
+
+  [kClone]() {
+    return {
+      data: { handle: this[kHandle] },
+      deserializeInfo: 'internal/histogram:InternalRecordableHistogram',
+    };
   }
 
-  get [kHandle]() { return this.#handle; }
+  [kDeserialize]({ handle }) {
+    this[kHandle] = handle;
+  }
+}
+
+// All internal code must use new InternalRecordableHistogram to create
+// RecordableHistogram instances. Like the internal CryptoKey class, it
+// extends JSTransferable so that the instances can be cloned.
+class InternalRecordableHistogram extends JSTransferable {
+  constructor(handle) {
+    super();
+    this[kHandle] = handle;
+    this[kMap] = new Map();
+  }
+}
+
+InternalRecordableHistogram.prototype.constructor = RecordableHistogram;
+ObjectSetPrototypeOf(InternalRecordableHistogram.prototype,
+                     RecordableHistogram.prototype);
+
+function createHistogram(options = {}) {
+  validateObject(options, 'options');
+  const {
+    lowest = 1,
+    highest = NumberMAX_SAFE_INTEGER,
+    figures = 3,
+  } = options;
+  validateInteger(lowest, 'options.lowest', 1);
+  validateInteger(highest, 'options.highest', 2 * lowest);
+  validateInteger(figures, 'options.figures', 1, 5);
+  return new InternalRecordableHistogram(
+    _createHistogram(lowest, highest, figures));
 }
 
 module.exports = {
   Histogram,
+  RecordableHistogram,
+  InternalRecordableHistogram,
+  createHistogram,
   kDestroy,
   kHandle,
 };
@@ -0,0 +1,60 @@
+'use strict';
+
+// Runs the entry script of `node --build-snapshot`. The C++ side spins the
+// event loop afterwards and serializes the heap once it is empty.
+
+/* global entryFilename, entryMain */
+
+const {
+  SafeSet,
+  StringPrototypeStartsWith,
+  StringPrototypeSlice,
+} = primordials;
+
+const path = require('path');
+const { NativeModule } = require('internal/bootstrap/loaders');
+const {
+  ERR_NOT_SUPPORTED_IN_SNAPSHOT,
+  ERR_UNKNOWN_BUILTIN_MODULE,
+} = require('internal/errors').codes;
+const {
+  markBuildingSnapshot,
+  runSerializeCallbacks,
+  runDeserializeMain,
+} = require('internal/v8/startup_snapshot');
+const binding = internalBinding('mksnapshot');
+
+// Built-in modules that only hold state that can be serialized. Modules
+// that create handles or native objects which cannot be captured, e.g.
+// net or child_process, are rejected instead of crashing the builder.
+const supportedModules = new SafeSet([
+  'buffer',
+  'events',
+  'fs',
+  'path',
+  'querystring',
+  'string_decoder',
+  'timers',
+  'url',
+  'util',
+  'v8',
+]);
+
+function requireForUserSnapshot(id) {
+  if (StringPrototypeStartsWith(id, 'node:'))
+    id = StringPrototypeSlice(id, 5);
+  if (!NativeModule.canBeRequiredByUsers(id))
+    throw new ERR_UNKNOWN_BUILTIN_MODULE(id);
+  if (!supportedModules.has(id))
+    throw new ERR_NOT_SUPPORTED_IN_SNAPSHOT(id);
+  return require(id);
+}
+
+markBuildingSnapshot();
+binding.setSerializeCallback(runSerializeCallbacks);
+// Once this is set, the deserialized process starts from
+// lib/internal/main/run_snapshot_main.js, which calls runDeserializeMain()
+// if the application has set a main function.
+binding.setDeserializeMainFunction(runDeserializeMain);
+
+entryMain(requireForUserSnapshot, entryFilename, path.dirname(entryFilename));
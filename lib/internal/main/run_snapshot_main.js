@@ -0,0 +1,30 @@
+'use strict';
+
+// Starts an application deserialized from a snapshot built with
+// `node --build-snapshot`.
+
+const {
+  prepareMainThreadExecution
+} = require('internal/bootstrap/pre_execution');
+const {
+  runDeserializeCallbacks,
+  isDeserializeMainFunctionSet,
+  runDeserializeMain,
+} = require('internal/v8/startup_snapshot');
+
+// Without a main function from the snapshot, the command line works as
+// usual and the entry point is loaded on top of the deserialized heap.
+const runEntryPoint =
+  !isDeserializeMainFunctionSet() && process.argv[1] !== undefined;
+
+prepareMainThreadExecution(runEntryPoint);
+
+markBootstrapComplete();
+
+runDeserializeCallbacks();
+
+if (isDeserializeMainFunctionSet()) {
+  runDeserializeMain();
+} else if (runEntryPoint) {
+  require('internal/modules/cjs/loader').Module.runMain(process.argv[1]);
+}
@@ -105,6 +105,7 @@ port.on('message', (message) => {
       doEval,
       workerData,
       publicPort,
+      poolPort,
       manifestSrc,
       manifestURL,
       hasStdin
@@ -174,7 +175,15 @@ port.on('message', (message) => {
       // runMain here might be monkey-patched by users in --require.
       // XXX: the monkey-patchability here should probably be deprecated.
       ArrayPrototypeSplice(process.argv, 1, 0, filename);
-      CJSLoader.Module.runMain(filename);
+      if (poolPort !== undefined) {
+        // This is a thread of a worker_threads.Pool, which runs the function
+        // exported by the script for every task.
+        const { setupPoolThread } = require('internal/worker/pool');
+        setupPoolThread(poolPort,
+                        CJSLoader.Module._load(filename, null, true));
+      } else {
+        CJSLoader.Module.runMain(filename);
+      }
     }
   } else if (message.type === STDIO_PAYLOAD) {
     const { stream, chunks } = message;
@@ -1035,7 +1035,8 @@ function wrapSafe(filename, content, cjsModuleInstance) {
         'module',
         '__filename',
         '__dirname',
-      ]
+      ],
+      true // Use the code cache from --experimental-code-cache-dir.
     );
   } catch (err) {
     if (process.mainModule === cjsModuleInstance)
@@ -11,13 +11,13 @@ const policy = getOptionValue('--experimental-policy') ?
 
 const { Buffer } = require('buffer');
 
-const fs = require('internal/fs/promises').exports;
 const { URL } = require('internal/url');
 const {
   ERR_INVALID_URL,
   ERR_INVALID_URL_SCHEME,
 } = require('internal/errors').codes;
-const readFileAsync = fs.readFile;
+// Loaded on first use, internal/fs/promises is not needed during bootstrap.
+let readFileAsync;
 
 const DATA_URL_PATTERN = /^[^/]+\/[^,;]+(?:[^,]*?)(;base64)?,([\s\S]*)$/;
 
@@ -25,6 +25,8 @@ async function defaultGetSource(url, { format } = {}, defaultGetSource) {
   const parsed = new URL(url);
   let source;
   if (parsed.protocol === 'file:') {
+    if (readFileAsync === undefined)
+      readFileAsync = require('internal/fs/promises').exports.readFile;
     source = await readFileAsync(parsed);
   } else if (parsed.protocol === 'data:') {
     const match = RegExpPrototypeExec(DATA_URL_PATTERN, parsed.pathname);
@@ -142,7 +142,8 @@ translators.set('module', async function moduleStrategy(url) {
   source = stringify(source);
   maybeCacheSourceMap(url, source);
   debug(`Translating StandardModule ${url}`);
-  const module = new ModuleWrap(url, undefined, source, 0, 0);
+  // Use the code cache from --experimental-code-cache-dir.
+  const module = new ModuleWrap(url, undefined, source, 0, 0, undefined, true);
   moduleWrap.callbackMap.set(module, {
     initializeImportMeta,
     importModuleDynamically,
@@ -10,6 +10,7 @@ const {
 assertCrypto();
 
 const {
+  Array,
   ArrayFrom,
   ArrayPrototypePush,
   BigInt64Array,
@@ -90,8 +91,8 @@ const {
 } = internalBinding('udp_wrap');
 
 const {
-  writeGeneric,
-  writevGeneric,
+  createWriteWrap,
+  afterWriteDispatched,
   onStreamRead,
   kAfterAsyncWrite,
   kMaybeDestroy,
@@ -153,6 +154,7 @@ const {
     IDX_QUIC_SESSION_STATS_ACK_DELAY_RETRANSMIT_COUNT,
     IDX_QUIC_SESSION_STATS_MAX_BYTES_IN_FLIGHT,
     IDX_QUIC_SESSION_STATS_BLOCK_COUNT,
+    IDX_QUIC_SESSION_STATS_PACING_DELAY_COUNT,
     IDX_QUIC_SESSION_STATS_MIN_RTT,
     IDX_QUIC_SESSION_STATS_SMOOTHED_RTT,
     IDX_QUIC_SESSION_STATS_LATEST_RTT,
@@ -177,6 +179,7 @@ const {
     IDX_QUIC_SOCKET_STATS_CLIENT_SESSIONS,
     IDX_QUIC_SOCKET_STATS_STATELESS_RESET_COUNT,
     IDX_QUIC_SOCKET_STATS_SERVER_BUSY_COUNT,
+    IDX_QUIC_SOCKET_STATS_PACKETS_SENT_BATCHED,
     ERR_FAILED_TO_CREATE_SESSION,
     ERR_INVALID_REMOTE_TRANSPORT_PARAMS,
     ERR_INVALID_TLS_SESSION_TICKET,
@@ -188,6 +191,7 @@ const {
     QUICCLIENTSESSION_OPTION_REQUEST_OCSP,
     QUICCLIENTSESSION_OPTION_VERIFY_HOSTNAME_IDENTITY,
     QUICSOCKET_OPTIONS_VALIDATE_ADDRESS,
+    QUICSOCKET_OPTIONS_DISABLE_PACING,
     QUICSTREAM_HEADERS_KIND_NONE,
     QUICSTREAM_HEADERS_KIND_INFORMATIONAL,
     QUICSTREAM_HEADERS_KIND_INITIAL,
@@ -968,6 +972,10 @@ class QuicSocket extends EventEmitter {
 
       // When true, stateless resets will not be sent (default false)
       disableStatelessReset,
+
+      // When true, packets are sent as soon as they are serialized
+      // rather than paced out (default false)
+      disablePacing,
     } = validateQuicSocketOptions(options);
     super({ captureRejections: true });
 
@@ -980,6 +988,8 @@ class QuicSocket extends EventEmitter {
     let socketOptions = 0;
     if (validateAddress)
       socketOptions |= (1 << QUICSOCKET_OPTIONS_VALIDATE_ADDRESS);
+    if (disablePacing)
+      socketOptions |= (1 << QUICSOCKET_OPTIONS_DISABLE_PACING);
 
     this[kSetHandle](
       new QuicSocketHandle(
@@ -1594,6 +1604,10 @@ class QuicSocket extends EventEmitter {
     return Number(getStats(this, IDX_QUIC_SOCKET_STATS_PACKETS_SENT));
   }
 
+  get packetsSentBatched() {
+    return Number(getStats(this, IDX_QUIC_SOCKET_STATS_PACKETS_SENT_BATCHED));
+  }
+
   get packetsIgnored() {
     return Number(getStats(this, IDX_QUIC_SOCKET_STATS_PACKETS_IGNORED));
   }
@@ -2066,6 +2080,11 @@ class QuicSession extends EventEmitter {
       this[kHandle]?.stats[IDX_QUIC_SESSION_STATS_BLOCK_COUNT] || 0);
   }
 
+  get pacingDelayCount() {
+    return Number(
+      this[kHandle]?.stats[IDX_QUIC_SESSION_STATS_PACING_DELAY_COUNT] || 0);
+  }
+
   get authenticated() {
     // Specifically check for null. Undefined means the check has not
     // been performed yet, another other value other than null means
@@ -2786,9 +2805,21 @@ class QuicStream extends Duplex {
       return;
 
     this[kUpdateTimer]();
-    const req = (writev) ?
-      writevGeneric(this, data, cb) :
-      writeGeneric(this, data, encoding, cb);
+    // Strings are decoded to Buffers before they get here, so every chunk
+    // is an ArrayBufferView. The native side retains the backing stores of
+    // the chunks until the data has been acknowledged, so they are neither
+    // copied nor kept alive by the write request.
+    let chunks;
+    if (writev) {
+      chunks = new Array(data.length);
+      for (let i = 0; i < data.length; i++)
+        chunks[i] = data[i].chunk;
+    } else {
+      chunks = [data];
+    }
+    const req = createWriteWrap(this[kHandle], cb);
+    const err = req.handle.writeViews(req, chunks);
+    afterWriteDispatched(req, err, cb);
 
     this[kTrackWriteState](this, req.bytes);
   }
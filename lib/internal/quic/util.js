@@ -529,6 +529,7 @@ function validateQuicSocketOptions(options = {}) {
 
   const {
     client = {},
+    disablePacing = false,
     disableStatelessReset = false,
     endpoint = { port: 0, type: 'udp4' },
     lookup = defaultLookup,
@@ -549,6 +550,7 @@ function validateQuicSocketOptions(options = {}) {
   validateBoolean(validateAddress, 'options.validateAddress');
   validateBoolean(qlog, 'options.qlog');
   validateBoolean(disableStatelessReset, 'options.disableStatelessReset');
+  validateBoolean(disablePacing, 'options.disablePacing');
 
   if (retryTokenTimeout !== undefined) {
     validateInteger(
@@ -599,6 +601,7 @@ function validateQuicSocketOptions(options = {}) {
     qlog,
     statelessResetSecret,
     disableStatelessReset,
+    disablePacing,
   };
 }
 
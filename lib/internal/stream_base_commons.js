@@ -277,6 +277,8 @@ function setStreamTimeout(msecs, callback) {
 }
 
 module.exports = {
+  createWriteWrap,
+  afterWriteDispatched,
   writevGeneric,
   writeGeneric,
   onStreamRead,
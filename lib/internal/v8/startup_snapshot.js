@@ -0,0 +1,97 @@
+'use strict';
+
+const {
+  ArrayPrototypePush,
+} = primordials;
+
+const {
+  validateCallback,
+} = require('internal/validators');
+const {
+  ERR_DUPLICATE_STARTUP_SNAPSHOT_MAIN_FUNCTION,
+  ERR_NOT_BUILDING_SNAPSHOT,
+} = require('internal/errors').codes;
+
+let buildingSnapshot = false;
+let serializeCallbacks = [];
+let deserializeCallbacks = [];
+let deserializeMain;
+
+function isBuildingSnapshot() {
+  return buildingSnapshot;
+}
+
+function throwIfNotBuildingSnapshot() {
+  if (!buildingSnapshot)
+    throw new ERR_NOT_BUILDING_SNAPSHOT();
+}
+
+function addSerializeCallback(callback, data) {
+  throwIfNotBuildingSnapshot();
+  validateCallback(callback);
+  ArrayPrototypePush(serializeCallbacks, [callback, data]);
+}
+
+function addDeserializeCallback(callback, data) {
+  throwIfNotBuildingSnapshot();
+  validateCallback(callback);
+  ArrayPrototypePush(deserializeCallbacks, [callback, data]);
+}
+
+function setDeserializeMainFunction(callback, data) {
+  throwIfNotBuildingSnapshot();
+  if (deserializeMain !== undefined)
+    throw new ERR_DUPLICATE_STARTUP_SNAPSHOT_MAIN_FUNCTION();
+  validateCallback(callback);
+  deserializeMain = [callback, data];
+}
+
+function markBuildingSnapshot() {
+  buildingSnapshot = true;
+}
+
+// Called once the event loop of the snapshot builder is drained, right
+// before the heap is serialized.
+function runSerializeCallbacks() {
+  const callbacks = serializeCallbacks;
+  serializeCallbacks = [];
+  for (let i = 0; i < callbacks.length; i++) {
+    const { 0: callback, 1: data } = callbacks[i];
+    callback(data);
+  }
+}
+
+// Called first thing when the application is started from the snapshot.
+function runDeserializeCallbacks() {
+  buildingSnapshot = false;
+  const callbacks = deserializeCallbacks;
+  deserializeCallbacks = [];
+  for (let i = 0; i < callbacks.length; i++) {
+    const { 0: callback, 1: data } = callbacks[i];
+    callback(data);
+  }
+}
+
+function isDeserializeMainFunctionSet() {
+  return deserializeMain !== undefined;
+}
+
+function runDeserializeMain() {
+  const { 0: callback, 1: data } = deserializeMain;
+  deserializeMain = undefined;
+  callback(data);
+}
+
+module.exports = {
+  markBuildingSnapshot,
+  runSerializeCallbacks,
+  runDeserializeCallbacks,
+  isDeserializeMainFunctionSet,
+  runDeserializeMain,
+  namespace: {
+    isBuildingSnapshot,
+    addSerializeCallback,
+    addDeserializeCallback,
+    setDeserializeMainFunction,
+  },
+};
@@ -39,14 +39,17 @@ const {
   drainMessagePort,
   MessageChannel,
   messageTypes,
+  kPoolPort,
   kPort,
   kIncrementsPortRef,
   kWaitingStreams,
   kStdioWantsMoreDataCallback,
   setupPortReferencing,
-  ReadableWorkerStdio,
-  WritableWorkerStdio
 } = workerIo;
+const {
+  ReadableWorkerStdio,
+  WritableWorkerStdio,
+} = require('internal/worker/stdio');
 const { deserializeError } = require('internal/error_serdes');
 const { fileURLToPath, isURLInstance, pathToFileURL } = require('internal/url');
 
@@ -204,6 +207,10 @@ class Worker extends EventEmitter {
     // If transferList is provided.
     if (options.transferList)
       transferList.push(...options.transferList);
+    // Set when this Worker is a thread of a worker_threads.Pool.
+    const poolPort = options[kPoolPort];
+    if (poolPort !== undefined)
+      transferList.push(poolPort);
 
     this[kPublicPort] = port1;
     for (const event of ['message', 'messageerror']) {
@@ -218,6 +225,7 @@ class Worker extends EventEmitter {
       cwdCounter: cwdCounter || workerIo.sharedCwdCounter,
       workerData: options.workerData,
       publicPort: port2,
+      poolPort,
       manifestURL: getOptionValue('--experimental-policy') ?
         require('internal/process/policy').url :
         null,
@@ -25,11 +25,6 @@ const {
   stopMessagePort,
   checkMessagePort
 } = internalBinding('messaging');
-const {
-  getEnvMessagePort
-} = internalBinding('worker');
-
-const { Readable, Writable } = require('stream');
 const {
   Event,
   NodeEventTarget,
@@ -47,14 +42,12 @@ const {
 const kData = Symbol('kData');
 const kIncrementsPortRef = Symbol('kIncrementsPortRef');
 const kLastEventId = Symbol('kLastEventId');
-const kName = Symbol('kName');
 const kOrigin = Symbol('kOrigin');
+const kPoolPort = Symbol('kPoolPort');
 const kPort = Symbol('kPort');
 const kPorts = Symbol('kPorts');
 const kWaitingStreams = Symbol('kWaitingStreams');
-const kWritableCallbacks = Symbol('kWritableCallbacks');
 const kSource = Symbol('kSource');
-const kStartedReading = Symbol('kStartedReading');
 const kStdioWantsMoreDataCallback = Symbol('kStdioWantsMoreDataCallback');
 
 const messageTypes = {
@@ -241,83 +234,6 @@ function setupPortReferencing(port, eventEmitter, eventName) {
 }
 
 
-class ReadableWorkerStdio extends Readable {
-  constructor(port, name) {
-    super();
-    this[kPort] = port;
-    this[kName] = name;
-    this[kIncrementsPortRef] = true;
-    this[kStartedReading] = false;
-    this.on('end', () => {
-      if (this[kStartedReading] && this[kIncrementsPortRef]) {
-        if (--this[kPort][kWaitingStreams] === 0)
-          this[kPort].unref();
-      }
-    });
-  }
-
-  _read() {
-    if (!this[kStartedReading] && this[kIncrementsPortRef]) {
-      this[kStartedReading] = true;
-      if (this[kPort][kWaitingStreams]++ === 0)
-        this[kPort].ref();
-    }
-
-    this[kPort].postMessage({
-      type: messageTypes.STDIO_WANTS_MORE_DATA,
-      stream: this[kName]
-    });
-  }
-}
-
-class WritableWorkerStdio extends Writable {
-  constructor(port, name) {
-    super({ decodeStrings: false });
-    this[kPort] = port;
-    this[kName] = name;
-    this[kWritableCallbacks] = [];
-  }
-
-  _writev(chunks, cb) {
-    this[kPort].postMessage({
-      type: messageTypes.STDIO_PAYLOAD,
-      stream: this[kName],
-      chunks: chunks.map(({ chunk, encoding }) => ({ chunk, encoding }))
-    });
-    this[kWritableCallbacks].push(cb);
-    if (this[kPort][kWaitingStreams]++ === 0)
-      this[kPort].ref();
-  }
-
-  _final(cb) {
-    this[kPort].postMessage({
-      type: messageTypes.STDIO_PAYLOAD,
-      stream: this[kName],
-      chunks: [ { chunk: null, encoding: '' } ]
-    });
-    cb();
-  }
-
-  [kStdioWantsMoreDataCallback]() {
-    const cbs = this[kWritableCallbacks];
-    this[kWritableCallbacks] = [];
-    for (const cb of cbs)
-      cb();
-    if ((this[kPort][kWaitingStreams] -= cbs.length) === 0)
-      this[kPort].unref();
-  }
-}
-
-function createWorkerStdio() {
-  const port = getEnvMessagePort();
-  port[kWaitingStreams] = 0;
-  return {
-    stdin: new ReadableWorkerStdio(port, 'stdin'),
-    stdout: new WritableWorkerStdio(port, 'stdout'),
-    stderr: new WritableWorkerStdio(port, 'stderr')
-  };
-}
-
 function receiveMessageOnPort(port) {
   const message = receiveMessageOnPort_(port);
   if (message === noMessageSymbol) return undefined;
@@ -327,6 +243,7 @@ function receiveMessageOnPort(port) {
 module.exports = {
   drainMessagePort,
   messageTypes,
+  kPoolPort,
   kPort,
   kIncrementsPortRef,
   kWaitingStreams,
@@ -337,7 +254,4 @@ module.exports = {
   MessageEvent,
   receiveMessageOnPort,
   setupPortReferencing,
-  ReadableWorkerStdio,
-  WritableWorkerStdio,
-  createWorkerStdio
 };
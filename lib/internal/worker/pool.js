@@ -0,0 +1,450 @@
+'use strict';
+
+const {
+  ArrayPrototypeIndexOf,
+  ArrayPrototypeMap,
+  ArrayPrototypePop,
+  ArrayPrototypePush,
+  ArrayPrototypeShift,
+  ArrayPrototypeSplice,
+  NumberIsInteger,
+  ObjectAssign,
+  Promise,
+  PromiseAll,
+  PromisePrototypeThen,
+  PromiseReject,
+  PromiseResolve,
+  SafeMap,
+  Symbol,
+} = primordials;
+
+const EventEmitter = require('events');
+const {
+  AbortError,
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
+    ERR_OUT_OF_RANGE,
+    ERR_WORKER_NOT_RUNNING,
+    ERR_WORKER_POOL_CLOSED,
+    ERR_WORKER_POOL_QUEUE_FULL,
+  },
+} = require('internal/errors');
+const {
+  validateAbortSignal,
+  validateInteger,
+  validateObject,
+} = require('internal/validators');
+const { isURLInstance } = require('internal/url');
+const { serializeError, deserializeError } = require('internal/error_serdes');
+const {
+  MessageChannel,
+  kPoolPort,
+  receiveMessageOnPort,
+} = require('internal/worker/io');
+
+let debug = require('internal/util/debuglog').debuglog('worker', (fn) => {
+  debug = fn;
+});
+
+const kThreads = Symbol('kThreads');
+const kFilename = Symbol('kFilename');
+const kWorkerOptions = Symbol('kWorkerOptions');
+const kConcurrency = Symbol('kConcurrency');
+const kMaxQueue = Symbol('kMaxQueue');
+const kQueueSize = Symbol('kQueueSize');
+const kNextTaskId = Symbol('kNextTaskId');
+const kNeedDrain = Symbol('kNeedDrain');
+const kClosed = Symbol('kClosed');
+const kStartError = Symbol('kStartError');
+const kOnClosed = Symbol('kOnClosed');
+const kAddThread = Symbol('kAddThread');
+const kEnqueue = Symbol('kEnqueue');
+const kSchedule = Symbol('kSchedule');
+const kSteal = Symbol('kSteal');
+const kDispatch = Symbol('kDispatch');
+const kCancel = Symbol('kCancel');
+const kSettle = Symbol('kSettle');
+const kOnResponse = Symbol('kOnResponse');
+const kOnThreadExit = Symbol('kOnThreadExit');
+const kMaybeFinishClose = Symbol('kMaybeFinishClose');
+
+// Lazily loaded to avoid a circular dependency with internal/worker.
+let Worker;
+
+function lazyWorker() {
+  if (Worker === undefined)
+    Worker = require('internal/worker').Worker;
+}
+
+// The main thread keeps one deque of pending tasks per thread. New tasks are
+// pushed onto the deque of the least busy thread. A thread takes tasks from
+// the head of its own deque, and once that is empty it steals from the tail
+// of the longest deque of another thread, so that uneven task sizes do not
+// leave threads idle while others still have work queued.
+// Tasks are sent to the threads using postMessage() and are only handed to
+// a thread once it has a free slot, so queued tasks stay cancellable and
+// available for stealing.
+// A thread reports that it is ready once it has loaded the module. Threads
+// that exit before that are not replaced, because the replacement would fail
+// to load the module in the same way.
+class PoolThread {
+  constructor(pool, id) {
+    this.id = id;
+    this.deque = [];
+    this.running = new SafeMap();
+    this.error = null;
+    this.ready = false;
+    this.exited = false;
+
+    const { port1, port2 } = new MessageChannel();
+    this.port = port1;
+    this.port.on('message', (message) => pool[kOnResponse](this, message));
+    this.port.unref();
+
+    const options = ObjectAssign({}, pool[kWorkerOptions]);
+    options[kPoolPort] = port2;
+    this.worker = new Worker(pool[kFilename], options);
+    this.worker.on('error', (err) => { this.error = err; });
+    this.worker.on('exit', (code) => pool[kOnThreadExit](this, code));
+    this.worker.unref();
+  }
+
+  get load() {
+    return this.deque.length + this.running.size;
+  }
+}
+
+class Pool extends EventEmitter {
+  constructor(filename, options = {}) {
+    super();
+    validateObject(options, 'options');
+    lazyWorker();
+
+    if (isURLInstance(filename) && filename.protocol === 'data:') {
+      throw new ERR_INVALID_ARG_VALUE('filename', filename,
+                                      'must be a path or a file: URL');
+    }
+
+    const workerOptions = ObjectAssign({}, options);
+    const {
+      size = require('os').cpus().length || 1,
+      maxQueue = Infinity,
+      concurrentTasksPerThread = 1,
+    } = workerOptions;
+    delete workerOptions.size;
+    delete workerOptions.maxQueue;
+    delete workerOptions.concurrentTasksPerThread;
+
+    if (workerOptions.eval) {
+      throw new ERR_INVALID_ARG_VALUE('options.eval', workerOptions.eval,
+                                      'is not supported by Pool');
+    }
+    validateInteger(size, 'options.size', 1);
+    validateInteger(concurrentTasksPerThread,
+                    'options.concurrentTasksPerThread', 1);
+    if (maxQueue !== Infinity) {
+      if (typeof maxQueue !== 'number')
+        throw new ERR_INVALID_ARG_TYPE('options.maxQueue', 'number', maxQueue);
+      if (!NumberIsInteger(maxQueue) || maxQueue < 0) {
+        throw new ERR_OUT_OF_RANGE('options.maxQueue',
+                                   'a non-negative integer or Infinity',
+                                   maxQueue);
+      }
+    }
+
+    this[kFilename] = filename;
+    this[kWorkerOptions] = workerOptions;
+    this[kConcurrency] = concurrentTasksPerThread;
+    this[kMaxQueue] = maxQueue;
+    this[kQueueSize] = 0;
+    this[kNextTaskId] = 0;
+    this[kNeedDrain] = false;
+    this[kClosed] = false;
+    this[kStartError] = null;
+    this[kOnClosed] = null;
+    this[kThreads] = [];
+    for (let i = 0; i < size; i++)
+      this[kAddThread](i);
+  }
+
+  get size() {
+    return this[kThreads].length;
+  }
+
+  // Number of tasks that have been submitted but not yet handed to a thread.
+  get queueSize() {
+    return this[kQueueSize];
+  }
+
+  get threads() {
+    return ArrayPrototypeMap(this[kThreads], (thread) => thread.worker);
+  }
+
+  run(task, options = {}) {
+    validateObject(options, 'options');
+    const { transferList, signal } = options;
+    validateAbortSignal(signal, 'options.signal');
+
+    if (this[kClosed])
+      return PromiseReject(new ERR_WORKER_POOL_CLOSED());
+    if (this[kStartError] !== null)
+      return PromiseReject(this[kStartError]);
+    if (signal !== undefined && signal.aborted)
+      return PromiseReject(new AbortError());
+    if (this[kQueueSize] >= this[kMaxQueue]) {
+      this[kNeedDrain] = true;
+      return PromiseReject(new ERR_WORKER_POOL_QUEUE_FULL());
+    }
+
+    return new Promise((resolve, reject) => {
+      const entry = {
+        id: this[kNextTaskId]++,
+        task,
+        transferList,
+        resolve,
+        reject,
+        signal,
+        onAbort: undefined,
+        thread: null,
+      };
+      if (signal !== undefined) {
+        entry.onAbort = () => this[kCancel](entry);
+        signal.addEventListener('abort', entry.onAbort, { once: true });
+      }
+
+      this[kQueueSize]++;
+      this[kEnqueue](entry);
+    });
+  }
+
+  // Stops accepting new tasks, waits for all submitted tasks to finish and
+  // terminates the threads afterwards.
+  close() {
+    if (this[kClosed])
+      return PromiseReject(new ERR_WORKER_POOL_CLOSED());
+    this[kClosed] = true;
+    return new Promise((resolve) => {
+      this[kOnClosed] = resolve;
+      this[kMaybeFinishClose]();
+    });
+  }
+
+  [kAddThread](index) {
+    const thread = new PoolThread(this, index);
+    this[kThreads][index] = thread;
+    debug(`Pool started thread ${thread.worker.threadId}`);
+    return thread;
+  }
+
+  // Queues the task for the running thread with the fewest tasks, or rejects
+  // it when no thread is running, e.g. while the pool is being closed.
+  [kEnqueue](entry) {
+    let target = null;
+    for (const thread of this[kThreads]) {
+      if (!thread.exited && (target === null || thread.load < target.load))
+        target = thread;
+    }
+    if (target === null) {
+      this[kQueueSize]--;
+      this[kSettle](entry,
+                    this[kStartError] || new ERR_WORKER_NOT_RUNNING(),
+                    undefined);
+      return;
+    }
+    entry.thread = target;
+    ArrayPrototypePush(target.deque, entry);
+    this[kSchedule](target);
+  }
+
+  [kSchedule](thread) {
+    while (thread.running.size < this[kConcurrency]) {
+      let entry = ArrayPrototypeShift(thread.deque);
+      if (entry === undefined)
+        entry = this[kSteal](thread);
+      if (entry === undefined)
+        break;
+      this[kDispatch](thread, entry);
+    }
+  }
+
+  [kSteal](thief) {
+    let victim = null;
+    for (const thread of this[kThreads]) {
+      if (thread !== thief &&
+          thread.deque.length > 0 &&
+          (victim === null || thread.deque.length > victim.deque.length)) {
+        victim = thread;
+      }
+    }
+    if (victim === null)
+      return undefined;
+    return ArrayPrototypePop(victim.deque);
+  }
+
+  [kDispatch](thread, entry) {
+    this[kQueueSize]--;
+    entry.thread = thread;
+    try {
+      thread.port.postMessage({ id: entry.id, task: entry.task },
+                              entry.transferList);
+    } catch (err) {
+      this[kSettle](entry, err, undefined);
+      return;
+    }
+    if (thread.running.size === 0)
+      thread.worker.ref();
+    thread.running.set(entry.id, entry);
+
+    if (this[kNeedDrain] && this[kQueueSize] < this[kMaxQueue]) {
+      this[kNeedDrain] = false;
+      process.nextTick(() => this.emit('drain'));
+    }
+  }
+
+  // Only tasks that are still queued can be cancelled. A task that has been
+  // sent to a thread keeps its slot until the thread responds, and settles
+  // with its result.
+  [kCancel](entry) {
+    const { deque } = entry.thread;
+    const index = ArrayPrototypeIndexOf(deque, entry);
+    if (index === -1)
+      return;
+    ArrayPrototypeSplice(deque, index, 1);
+    this[kQueueSize]--;
+    this[kSettle](entry, new AbortError(), undefined);
+  }
+
+  [kSettle](entry, error, result) {
+    if (entry.onAbort !== undefined)
+      entry.signal.removeEventListener('abort', entry.onAbort);
+    if (error !== null)
+      entry.reject(error);
+    else
+      entry.resolve(result);
+    this[kMaybeFinishClose]();
+  }
+
+  [kOnResponse](thread, { ready, id, result, error }) {
+    if (ready) {
+      thread.ready = true;
+      return;
+    }
+    const entry = thread.running.get(id);
+    // The task may have been cancelled in the meantime.
+    if (entry === undefined)
+      return;
+    thread.running.delete(id);
+    if (thread.running.size === 0)
+      thread.worker.unref();
+    this[kSchedule](thread);
+    if (error !== undefined)
+      this[kSettle](entry, deserializeError(error), undefined);
+    else
+      this[kSettle](entry, null, result);
+  }
+
+  [kOnThreadExit](thread, code) {
+    debug(`Pool thread ${thread.id} exited with code ${code}`);
+    // Handle the messages that the thread sent before it exited, which may
+    // not have been delivered yet.
+    let message;
+    while ((message = receiveMessageOnPort(thread.port)) !== undefined)
+      this[kOnResponse](thread, message.message);
+    thread.port.close();
+    thread.exited = true;
+    const error = thread.error || new ERR_WORKER_NOT_RUNNING();
+    const running = thread.running;
+    thread.running = new SafeMap();
+    for (const entry of running.values())
+      this[kSettle](entry, error, undefined);
+
+    if (this[kOnClosed] !== null && this[kQueueSize] === 0)
+      return;
+
+    const queued = thread.deque;
+    thread.deque = [];
+    if (thread.ready) {
+      // Replace the thread, taking over the tasks that were queued for it.
+      const replacement = this[kAddThread](thread.id);
+      for (const entry of queued) {
+        entry.thread = replacement;
+        ArrayPrototypePush(replacement.deque, entry);
+      }
+      this[kSchedule](replacement);
+      return;
+    }
+
+    // The thread failed to start. Hand its tasks to the other threads, or
+    // reject them, and every task submitted later, once no thread is left.
+    for (const other of this[kThreads]) {
+      if (!other.exited) {
+        for (const entry of queued)
+          this[kEnqueue](entry);
+        return;
+      }
+    }
+    this[kStartError] = error;
+    this[kQueueSize] -= queued.length;
+    for (const entry of queued)
+      this[kSettle](entry, error, undefined);
+  }
+
+  [kMaybeFinishClose]() {
+    if (!this[kClosed] || this[kOnClosed] === null || this[kQueueSize] > 0)
+      return;
+    for (const thread of this[kThreads]) {
+      if (thread.running.size > 0)
+        return;
+    }
+    const resolve = this[kOnClosed];
+    this[kOnClosed] = null;
+    const threads = this[kThreads];
+    PromisePrototypeThen(
+      PromiseAll(ArrayPrototypeMap(threads, (thread) => {
+        thread.worker.removeAllListeners('exit');
+        thread.port.close();
+        return thread.worker.terminate();
+      })),
+      () => resolve());
+  }
+}
+
+// Runs in the thread of a Pool. `mod` is the value exported by the module
+// that the Pool was created with.
+function setupPoolThread(port, mod) {
+  const fn = typeof mod === 'function' ? mod : mod && mod.default;
+  if (typeof fn !== 'function')
+    throw new ERR_INVALID_ARG_TYPE('module.exports', 'function', mod);
+  port.postMessage({ ready: true });
+
+  function reply(id, result) {
+    try {
+      port.postMessage({ id, result });
+    } catch (err) {
+      port.postMessage({ id, error: serializeError(err) });
+    }
+  }
+
+  function replyError(id, err) {
+    port.postMessage({ id, error: serializeError(err) });
+  }
+
+  port.on('message', ({ id, task }) => {
+    let result;
+    try {
+      result = fn(task);
+    } catch (err) {
+      replyError(id, err);
+      return;
+    }
+    PromisePrototypeThen(PromiseResolve(result),
+                         (value) => reply(id, value),
+                         (err) => replyError(id, err));
+  });
+}
+
+module.exports = {
+  Pool,
+  setupPoolThread,
+};
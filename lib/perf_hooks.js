@@ -18,7 +18,9 @@ const {
 } = primordials;
 
 const {
+  AsyncCallbackMonitor: _AsyncCallbackMonitor,
   ELDHistogram: _ELDHistogram,
+  EventLoopPhaseMonitor: _EventLoopPhaseMonitor,
   PerformanceEntry,
   mark: _mark,
   clearMark: _clearMark,
@@ -66,6 +68,7 @@ const {
 
 const {
   Histogram,
+  createHistogram,
   kHandle,
 } = require('internal/histogram');
 
@@ -665,10 +668,57 @@ function monitorEventLoopDelay(options = {}) {
   return new ELDHistogram(new _ELDHistogram(resolution));
 }
 
+class EventLoopPhaseMonitor {
+  #handle = undefined;
+
+  constructor(handle) {
+    this.#handle = handle;
+    const histogram = (name) => ({
+      enumerable: true,
+      value: new Histogram(handle[name]),
+    });
+    ObjectDefineProperties(this, {
+      timers: histogram('timers'),
+      poll: histogram('poll'),
+      pollWait: histogram('pollWait'),
+      check: histogram('check'),
+      other: histogram('other'),
+    });
+  }
+
+  enable() { return this.#handle.enable(); }
+  disable() { return this.#handle.disable(); }
+  reset() { this.#handle.reset(); }
+}
+
+function monitorEventLoopPhases() {
+  return new EventLoopPhaseMonitor(new _EventLoopPhaseMonitor());
+}
+
+class AsyncCallbackMonitor {
+  #handle = undefined;
+
+  constructor(handle) {
+    this.#handle = handle;
+  }
+
+  enable() { return this.#handle.enable(); }
+  disable() { return this.#handle.disable(); }
+  reset() { this.#handle.reset(); }
+  stats() { return this.#handle.stats(); }
+}
+
+function monitorAsyncCallbacks() {
+  return new AsyncCallbackMonitor(new _AsyncCallbackMonitor());
+}
+
 module.exports = {
   performance,
   PerformanceObserver,
-  monitorEventLoopDelay
+  createHistogram,
+  monitorAsyncCallbacks,
+  monitorEventLoopDelay,
+  monitorEventLoopPhases,
 };
 
 ObjectDefineProperty(module.exports, 'constants', {
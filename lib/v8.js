@@ -33,7 +33,12 @@ const {
 } = primordials;
 
 const { Buffer } = require('buffer');
-const { validateString } = require('internal/validators');
+const {
+  validateBoolean,
+  validateInt32,
+  validateObject,
+  validateString,
+} = require('internal/validators');
 const {
   Serializer: _Serializer,
   Deserializer: _Deserializer
@@ -55,13 +60,25 @@ const {
   triggerHeapSnapshot
 } = internalBinding('heap_utils');
 const { HeapSnapshotStream } = require('internal/heap_utils');
-
-function writeHeapSnapshot(filename) {
+const {
+  namespace: startupSnapshot
+} = require('internal/v8/startup_snapshot');
+
+function writeHeapSnapshot(filename, options = {}) {
+  validateObject(options, 'options');
+  const { fd, compress = false } = options;
+  validateBoolean(compress, 'options.compress');
+  if (fd !== undefined) {
+    // The filename is ignored when a file descriptor is passed, the same as
+    // in fs.createWriteStream().
+    validateInt32(fd, 'options.fd', 0);
+    return triggerHeapSnapshot(undefined, fd, compress);
+  }
   if (filename !== undefined) {
     filename = getValidatedPath(filename);
     filename = toNamespacedPath(filename);
   }
-  return triggerHeapSnapshot(filename);
+  return triggerHeapSnapshot(filename, undefined, compress);
 }
 
 function getHeapSnapshot() {
@@ -285,5 +302,6 @@ module.exports = {
   takeCoverage: profiler.takeCoverage,
   stopCoverage: profiler.stopCoverage,
   serialize,
+  startupSnapshot,
   writeHeapSnapshot,
 };
@@ -1,5 +1,9 @@
 'use strict';
 
+const {
+  ObjectDefineProperty,
+} = primordials;
+
 const {
   isMainThread,
   SHARE_ENV,
@@ -33,3 +37,16 @@ module.exports = {
   parentPort: null,
   workerData: null,
 };
+
+// The pool is loaded on first use, so that Workers that do not use it do
+// not load it during bootstrap.
+let Pool;
+ObjectDefineProperty(module.exports, 'Pool', {
+  configurable: true,
+  enumerable: true,
+  get() {
+    if (Pool === undefined)
+      Pool = require('internal/worker/pool').Pool;
+    return Pool;
+  }
+});
@@ -174,10 +174,12 @@
       'lib/internal/main/eval_string.js',
       'lib/internal/main/eval_stdin.js',
       'lib/internal/main/inspect.js',
+      'lib/internal/main/mksnapshot.js',
       'lib/internal/main/print_help.js',
       'lib/internal/main/prof_process.js',
       'lib/internal/main/repl.js',
       'lib/internal/main/run_main_module.js',
+      'lib/internal/main/run_snapshot_main.js',
       'lib/internal/main/worker_thread.js',
       'lib/internal/modules/run_main.js',
       'lib/internal/modules/package_json_reader.js',
@@ -235,6 +237,7 @@
       'lib/internal/http2/core.js',
       'lib/internal/http2/compat.js',
       'lib/internal/http2/util.js',
+      'lib/internal/v8/startup_snapshot.js',
       'lib/internal/v8_prof_polyfill.js',
       'lib/internal/v8_prof_processor.js',
       'lib/internal/validators.js',
@@ -243,6 +246,8 @@
       'lib/internal/worker.js',
       'lib/internal/worker/io.js',
       'lib/internal/worker/js_transferable.js',
+      'lib/internal/worker/pool.js',
+      'lib/internal/worker/stdio.js',
       'lib/internal/watchdog.js',
       'lib/internal/streams/lazy_transform.js',
       'lib/internal/streams/buffer_list.js',
@@ -608,6 +613,7 @@
         'src/node_api.cc',
         'src/node_binding.cc',
         'src/node_buffer.cc',
+        'src/node_compile_cache.cc',
         'src/node_config.cc',
         'src/node_constants.cc',
         'src/node_contextify.cc',
@@ -623,6 +629,7 @@
         'src/node_main_instance.cc',
         'src/node_messaging.cc',
         'src/node_metadata.cc',
+        'src/node_metrics.cc',
         'src/node_native_module.cc',
         'src/node_native_module_env.cc',
         'src/node_options.cc',
@@ -637,6 +644,7 @@
         'src/node_report_module.cc',
         'src/node_report_utils.cc',
         'src/node_serdes.cc',
+        'src/node_snapshotable.cc',
         'src/node_sockaddr.cc',
         'src/node_stat_watcher.cc',
         'src/node_symbols.cc',
@@ -706,6 +714,7 @@
         'src/node_api_types.h',
         'src/node_binding.h',
         'src/node_buffer.h',
+        'src/node_compile_cache.h',
         'src/node_constants.h',
         'src/node_context_data.h',
         'src/node_contextify.h',
@@ -725,6 +734,7 @@
         'src/node_mem-inl.h',
         'src/node_messaging.h',
         'src/node_metadata.h',
+        'src/node_metrics.h',
         'src/node_mutex.h',
         'src/node_native_module.h',
         'src/node_native_module_env.h',
@@ -738,11 +748,13 @@
         'src/node_report.h',
         'src/node_revert.h',
         'src/node_root_certs.h',
+        'src/node_snapshotable.h',
         'src/node_sockaddr.h',
         'src/node_sockaddr-inl.h',
         'src/node_stat_watcher.h',
         'src/node_union_bytes.h',
         'src/node_url.h',
+        'src/node_v8.h',
         'src/node_version.h',
         'src/node_v8_platform-inl.h',
         'src/node_wasi.h',
@@ -934,6 +946,7 @@
             'src/crypto/crypto_util.cc',
             'src/crypto/crypto_clienthello.cc',
             'src/crypto/crypto_dh.cc',
+            'src/crypto/crypto_checksum.cc',
             'src/crypto/crypto_hash.cc',
             'src/crypto/crypto_keys.cc',
             'src/crypto/crypto_keygen.cc',
@@ -951,6 +964,7 @@
             'src/crypto/crypto_cipher.h',
             'src/crypto/crypto_common.h',
             'src/crypto/crypto_dsa.h',
+            'src/crypto/crypto_checksum.h',
             'src/crypto/crypto_hash.h',
             'src/crypto/crypto_keys.h',
             'src/crypto/crypto_keygen.h',
@@ -1563,8 +1577,6 @@
         'src/node_snapshot_stub.cc',
         'src/node_code_cache_stub.cc',
         'tools/snapshot/node_mksnapshot.cc',
-        'tools/snapshot/snapshot_builder.cc',
-        'tools/snapshot/snapshot_builder.h',
       ],
 
       'conditions': [
@@ -362,6 +362,7 @@ void FreeEnvironment(Environment* env) {
   {
     HandleScope handle_scope(env->isolate());  // For env->context().
     Context::Scope context_scope(env->context());
+    env->FlushCompileCache();
     SealHandleScope seal_handle_scope(env->isolate());
 
     env->set_stopping(true);
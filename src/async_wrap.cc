@@ -22,8 +22,10 @@
 #include "async_wrap.h"  // NOLINT(build/include_inline)
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "memory_tracker-inl.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
+#include "node_perf.h"
 #include "tracing/traced_value.h"
 #include "util-inl.h"
 
@@ -929,20 +931,37 @@ MaybeLocal<Value> AsyncWrap::MakeCallback(const Local<Function> cb,
                                           Local<Value>* argv) {
   EmitTraceEventBefore();
 
+  Environment* env = this->env();
   ProviderType provider = provider_type();
   async_context context { get_async_id(), get_trigger_async_id() };
+  // Callbacks are only timed while perf_hooks.monitorAsyncCallbacks() is
+  // enabled.
+  uint64_t start =
+      env->async_callback_monitors()->empty() ? 0 : PERFORMANCE_NOW();
   MaybeLocal<Value> ret = InternalMakeCallback(
-      env(), object(), object(), cb, argc, argv, context);
+      env, object(), object(), cb, argc, argv, context);
 
   // This is a static call with cached values because the `this` object may
   // no longer be alive at this point.
   EmitTraceEventAfter(provider, context.async_id);
 
+  if (start != 0) {
+    uint64_t duration = PERFORMANCE_NOW() - start;
+    for (performance::AsyncCallbackMonitor* monitor :
+         *env->async_callback_monitors()) {
+      monitor->Record(provider, duration);
+    }
+  }
+
   return ret;
 }
 
+const char* AsyncWrap::GetProviderName(ProviderType provider) {
+  return provider_names[provider];
+}
+
 std::string AsyncWrap::MemoryInfoName() const {
-  return provider_names[provider_type()];
+  return GetProviderName(provider_type());
 }
 
 std::string AsyncWrap::diagnostic_name() const {
@@ -178,6 +178,8 @@ class AsyncWrap : public BaseObject {
 
   void EmitTraceEventBefore();
   static void EmitTraceEventAfter(ProviderType type, double async_id);
+
+  static const char* GetProviderName(ProviderType provider);
   void EmitTraceEventDestroy();
 
   static void DestroyAsyncIdsCallback(Environment* env);
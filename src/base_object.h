@@ -156,6 +156,10 @@ class BaseObject : public MemoryRetainer {
   // a clean process exit (due to an empty event loop).
   virtual bool IsNotIndicativeOfMemoryLeakAtExit() const;
 
+  // Whether the object can be serialized into a startup snapshot, see
+  // SnapshotableObject in node_snapshotable.h.
+  virtual bool is_snapshotable() const { return false; }
+
   virtual inline void OnGCCollect();
 
  private:
@@ -31,10 +31,15 @@
 #include "uv.h"
 #include "node_errors.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
+#include <limits>
+#include <list>
 #include <memory>
+#include <string>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #ifdef __POSIX__
@@ -63,8 +68,10 @@ namespace node {
 namespace cares_wrap {
 
 using v8::Array;
+using v8::ArrayBuffer;
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -75,6 +82,7 @@ using v8::Local;
 using v8::Null;
 using v8::Object;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 namespace {
@@ -148,6 +156,27 @@ struct TaskEqual {
 using node_ares_task_list =
     std::unordered_set<node_ares_task*, TaskHash, TaskEqual>;
 
+// A cached answer for a single (type, name) query. Successful answers are
+// kept for the smallest TTL found in their answer section, negative answers
+// (ENOTFOUND/ENODATA) for the configured negative TTL. Once expired, an entry
+// may still be served for up to `stale_ttl` seconds while it is refreshed in
+// the background.
+struct DnsCacheEntry {
+  int status;
+  std::vector<unsigned char> answer;
+  uint64_t expires_at;
+  uint64_t stale_until;
+  bool refreshing;
+  std::list<std::string>::iterator lru_position;
+};
+
+struct DnsCacheOptions {
+  uint32_t max_entries = 0;  // 0 disables the cache.
+  uint32_t max_ttl = 0;  // In seconds. 0 means TTLs are not capped.
+  uint32_t negative_ttl = 0;  // In seconds. 0 disables negative caching.
+  uint32_t stale_ttl = 0;  // In seconds. 0 disables stale-while-revalidate.
+};
+
 class ChannelWrap : public AsyncWrap {
  public:
   ChannelWrap(Environment* env, Local<Object> object, int timeout);
@@ -171,10 +200,36 @@ class ChannelWrap : public AsyncWrap {
   inline int active_query_count() { return active_query_count_; }
   inline node_ares_task_list* task_list() { return &task_list_; }
 
+  inline bool cache_enabled() const { return cache_options_.max_entries > 0; }
+  inline void set_cache_options(const DnsCacheOptions& options) {
+    cache_options_ = options;
+    TrimCache();
+  }
+  static std::string MakeCacheKey(const char* name, int type);
+  // Returns the cached entry for |key|, or nullptr if there is none that may
+  // be served. |stale| is set when the entry has expired but is still within
+  // the stale-while-revalidate window.
+  const DnsCacheEntry* LookupCache(const std::string& key, bool* stale);
+  void StoreInCache(const std::string& key,
+                    int status,
+                    const unsigned char* answer,
+                    int answer_len);
+  void RefreshCacheEntry(const std::string& key,
+                         const char* name,
+                         int dnsclass,
+                         int type);
+  void ClearCache();
+
+  inline uint64_t cache_hits() const { return cache_hits_; }
+  inline uint64_t cache_misses() const { return cache_misses_; }
+  inline uint64_t cache_stale_hits() const { return cache_stale_hits_; }
+  inline size_t cache_size() const { return cache_.size(); }
+
   void MemoryInfo(MemoryTracker* tracker) const override {
     if (timer_handle_ != nullptr)
       tracker->TrackField("timer_handle", *timer_handle_);
     tracker->TrackField("task_list", task_list_, "node_ares_task_list");
+    tracker->TrackFieldWithSize("cache", cache_bytes_, "DnsCache");
   }
 
   SET_MEMORY_INFO_NAME(ChannelWrap)
@@ -183,6 +238,15 @@ class ChannelWrap : public AsyncWrap {
   static void AresTimeout(uv_timer_t* handle);
 
  private:
+  static void OnCacheRefresh(void* arg,
+                             int status,
+                             int timeouts,
+                             unsigned char* answer_buf,
+                             int answer_len);
+  void EraseFromCache(
+      std::unordered_map<std::string, DnsCacheEntry>::iterator it);
+  void TrimCache();
+
   uv_timer_t* timer_handle_;
   ares_channel channel_;
   bool query_last_ok_;
@@ -191,6 +255,15 @@ class ChannelWrap : public AsyncWrap {
   int timeout_;
   int active_query_count_;
   node_ares_task_list task_list_;
+
+  DnsCacheOptions cache_options_;
+  std::unordered_map<std::string, DnsCacheEntry> cache_;
+  // Most recently used keys first.
+  std::list<std::string> cache_lru_;
+  size_t cache_bytes_ = 0;
+  uint64_t cache_hits_ = 0;
+  uint64_t cache_misses_ = 0;
+  uint64_t cache_stale_hits_ = 0;
 };
 
 ChannelWrap::ChannelWrap(Environment* env,
@@ -577,10 +650,222 @@ void ChannelWrap::EnsureServers() {
 }
 
 
+// Returns the number of bytes occupied by the (possibly compressed) domain
+// name starting at |ptr|, or -1 if it runs past |end|.
+int SkipDomainName(const unsigned char* ptr, const unsigned char* end) {
+  const unsigned char* cur = ptr;
+  while (cur < end) {
+    if (*cur == 0)
+      return cur + 1 - ptr;
+    if ((*cur & NS_CMPRSFLGS) == NS_CMPRSFLGS)
+      return cur + 2 <= end ? cur + 2 - ptr : -1;
+    cur += *cur + 1;
+  }
+  return -1;
+}
+
+// Finds the smallest TTL of the records in the answer section of a DNS
+// response. Returns false if the response is malformed or has no answers.
+bool GetAnswerMinTTL(const unsigned char* buf, int len, uint32_t* ttl) {
+  if (len < NS_HFIXEDSZ)
+    return false;
+
+  const unsigned char* end = buf + len;
+  const unsigned char* ptr = buf + NS_HFIXEDSZ;
+  const unsigned int qdcount = cares_get_16bit(buf + 4);
+  const unsigned int ancount = cares_get_16bit(buf + 6);
+  if (ancount == 0)
+    return false;
+
+  for (unsigned int i = 0; i < qdcount; i++) {
+    const int name_len = SkipDomainName(ptr, end);
+    if (name_len < 0 || ptr + name_len + NS_QFIXEDSZ > end)
+      return false;
+    ptr += name_len + NS_QFIXEDSZ;
+  }
+
+  uint32_t min_ttl = std::numeric_limits<uint32_t>::max();
+  for (unsigned int i = 0; i < ancount; i++) {
+    const int name_len = SkipDomainName(ptr, end);
+    if (name_len < 0 || ptr + name_len + NS_RRFIXEDSZ > end)
+      return false;
+    ptr += name_len;
+
+    uint32_t rr_ttl = ReadUint32BE(ptr + 4);
+    const int rr_len = cares_get_16bit(ptr + 8);
+    ptr += NS_RRFIXEDSZ + rr_len;
+    if (ptr > end)
+      return false;
+
+    // RFC 2181, section 8: TTLs with the most significant bit set are
+    // treated as zero.
+    if (rr_ttl > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()))
+      rr_ttl = 0;
+    min_ttl = std::min(min_ttl, rr_ttl);
+  }
+
+  *ttl = min_ttl;
+  return true;
+}
+
+
+std::string ChannelWrap::MakeCacheKey(const char* name, int type) {
+  std::string key = std::to_string(type);
+  key += ':';
+  for (const char* c = name; *c != '\0'; c++)
+    key += ToLower(*c);
+  return key;
+}
+
+const DnsCacheEntry* ChannelWrap::LookupCache(const std::string& key,
+                                              bool* stale) {
+  auto it = cache_.find(key);
+  if (it == cache_.end()) {
+    cache_misses_++;
+    return nullptr;
+  }
+
+  const uint64_t now = uv_now(env()->event_loop());
+  DnsCacheEntry* entry = &it->second;
+  if (now >= entry->stale_until) {
+    EraseFromCache(it);
+    cache_misses_++;
+    return nullptr;
+  }
+
+  *stale = now >= entry->expires_at;
+  if (*stale)
+    cache_stale_hits_++;
+  else
+    cache_hits_++;
+
+  cache_lru_.splice(cache_lru_.begin(), cache_lru_, entry->lru_position);
+  return entry;
+}
+
+void ChannelWrap::StoreInCache(const std::string& key,
+                               int status,
+                               const unsigned char* answer,
+                               int answer_len) {
+  if (!cache_enabled())
+    return;
+
+  uint32_t ttl;
+  switch (status) {
+    case ARES_SUCCESS:
+      if (!GetAnswerMinTTL(answer, answer_len, &ttl))
+        ttl = 0;
+      if (cache_options_.max_ttl > 0)
+        ttl = std::min(ttl, cache_options_.max_ttl);
+      break;
+    case ARES_ENODATA:
+    case ARES_ENOTFOUND:
+      ttl = cache_options_.negative_ttl;
+      answer_len = 0;
+      break;
+    default:
+      // Transient failures are not cached. A stale entry being refreshed is
+      // kept around and may be refreshed again on the next lookup.
+      ttl = 0;
+      break;
+  }
+
+  auto it = cache_.find(key);
+  if (ttl == 0) {
+    if (it != cache_.end()) {
+      if (status == ARES_SUCCESS)
+        EraseFromCache(it);
+      else
+        it->second.refreshing = false;
+    }
+    return;
+  }
+
+  const uint64_t now = uv_now(env()->event_loop());
+  if (it == cache_.end()) {
+    cache_lru_.push_front(key);
+    it = cache_.emplace(key, DnsCacheEntry()).first;
+    it->second.lru_position = cache_lru_.begin();
+    cache_bytes_ += sizeof(DnsCacheEntry) + 2 * key.size();
+  } else {
+    cache_bytes_ -= it->second.answer.size();
+    cache_lru_.splice(cache_lru_.begin(), cache_lru_, it->second.lru_position);
+  }
+
+  DnsCacheEntry* entry = &it->second;
+  entry->status = status;
+  entry->answer.assign(answer, answer + answer_len);
+  entry->expires_at = now + static_cast<uint64_t>(ttl) * 1000;
+  entry->stale_until = entry->expires_at +
+                       static_cast<uint64_t>(cache_options_.stale_ttl) * 1000;
+  entry->refreshing = false;
+  cache_bytes_ += entry->answer.size();
+
+  TrimCache();
+}
+
+struct CacheRefreshRequest {
+  ChannelWrap* channel;
+  std::string key;
+};
+
+void ChannelWrap::RefreshCacheEntry(const std::string& key,
+                                    const char* name,
+                                    int dnsclass,
+                                    int type) {
+  auto it = cache_.find(key);
+  if (it == cache_.end() || it->second.refreshing)
+    return;
+  it->second.refreshing = true;
+
+  // Background refreshes count as active queries so that setServers() does
+  // not swap the servers out from under them.
+  ModifyActivityQueryCount(1);
+  ares_query(channel_, name, dnsclass, type, OnCacheRefresh,
+             new CacheRefreshRequest { this, key });
+}
+
+void ChannelWrap::OnCacheRefresh(void* arg,
+                                 int status,
+                                 int timeouts,
+                                 unsigned char* answer_buf,
+                                 int answer_len) {
+  std::unique_ptr<CacheRefreshRequest> req {
+      static_cast<CacheRefreshRequest*>(arg) };
+  ChannelWrap* channel = req->channel;
+  // ares_destroy() runs pending callbacks before the ChannelWrap goes away,
+  // so |channel| is still valid here even for ARES_EDESTRUCTION.
+  channel->ModifyActivityQueryCount(-1);
+  channel->StoreInCache(req->key, status, answer_buf, answer_len);
+}
+
+void ChannelWrap::EraseFromCache(
+    std::unordered_map<std::string, DnsCacheEntry>::iterator it) {
+  cache_bytes_ -= sizeof(DnsCacheEntry) + 2 * it->first.size() +
+                  it->second.answer.size();
+  cache_lru_.erase(it->second.lru_position);
+  cache_.erase(it);
+}
+
+void ChannelWrap::TrimCache() {
+  while (cache_.size() > cache_options_.max_entries)
+    EraseFromCache(cache_.find(cache_lru_.back()));
+}
+
+void ChannelWrap::ClearCache() {
+  cache_.clear();
+  cache_lru_.clear();
+  cache_bytes_ = 0;
+}
+
+
 class QueryWrap : public AsyncWrap {
  public:
-  QueryWrap(ChannelWrap* channel, Local<Object> req_wrap_obj, const char* name)
-      : AsyncWrap(channel->env(), req_wrap_obj, AsyncWrap::PROVIDER_QUERYWRAP),
+  QueryWrap(ChannelWrap* channel,
+            Local<Object> req_wrap_obj,
+            const char* name,
+            ProviderType provider = AsyncWrap::PROVIDER_QUERYWRAP)
+      : AsyncWrap(channel->env(), req_wrap_obj, provider),
         channel_(channel),
         trace_name_(name) {
   }
@@ -612,6 +897,29 @@ class QueryWrap : public AsyncWrap {
     TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
       TRACING_CATEGORY_NODE2(dns, native), trace_name_, this,
       "name", TRACE_STR_COPY(name));
+
+    if (channel_->cache_enabled()) {
+      cache_key_ = ChannelWrap::MakeCacheKey(name, type);
+      bool stale = false;
+      const DnsCacheEntry* entry = channel_->LookupCache(cache_key_, &stale);
+      if (entry != nullptr) {
+        response_data_ = std::make_unique<ResponseData>();
+        response_data_->status = entry->status;
+        response_data_->is_host = false;
+        if (entry->status == ARES_SUCCESS) {
+          const size_t len = entry->answer.size();
+          unsigned char* buf_copy = node::Malloc<unsigned char>(len);
+          memcpy(buf_copy, entry->answer.data(), len);
+          response_data_->buf = MallocedBuffer<unsigned char>(buf_copy, len);
+        }
+        // |entry| may be invalidated by the refresh.
+        if (stale)
+          channel_->RefreshCacheEntry(cache_key_, name, dnsclass, type);
+        QueueResponseCallback(response_data_->status);
+        return;
+      }
+    }
+
     ares_query(channel_->cares_channel(), name, dnsclass, type, Callback,
                MakeCallbackPointer());
   }
@@ -620,6 +928,7 @@ class QueryWrap : public AsyncWrap {
     int status;
     bool is_host;
     DeleteFnPtr<hostent, safe_free_hostent> host;
+    DeleteFnPtr<ares_addrinfo, ares_freeaddrinfo> addrinfo;
     MallocedBuffer<unsigned char> buf;
   };
 
@@ -630,6 +939,8 @@ class QueryWrap : public AsyncWrap {
 
     if (status != ARES_SUCCESS) {
       ParseError(status);
+    } else if (response_data_->addrinfo) {
+      Parse(response_data_->addrinfo.get());
     } else if (!response_data_->is_host) {
       Parse(response_data_->buf.data, response_data_->buf.size);
     } else {
@@ -656,6 +967,11 @@ class QueryWrap : public AsyncWrap {
     QueryWrap* wrap = FromCallbackPointer(arg);
     if (wrap == nullptr) return;
 
+    if (!wrap->cache_key_.empty()) {
+      wrap->channel_->StoreInCache(
+          wrap->cache_key_, status, answer_buf, answer_len);
+    }
+
     unsigned char* buf_copy = nullptr;
     if (status == ARES_SUCCESS) {
       buf_copy = node::Malloc<unsigned char>(answer_len);
@@ -691,6 +1007,23 @@ class QueryWrap : public AsyncWrap {
     wrap->QueueResponseCallback(status);
   }
 
+  static void Callback(void* arg, int status, int timeouts,
+                       struct ares_addrinfo* res) {
+    // Unlike the other callbacks, ownership of |res| is passed to us.
+    DeleteFnPtr<ares_addrinfo, ares_freeaddrinfo> addrinfo { res };
+    QueryWrap* wrap = FromCallbackPointer(arg);
+    if (wrap == nullptr) return;
+
+    wrap->response_data_ = std::make_unique<ResponseData>();
+    ResponseData* data = wrap->response_data_.get();
+    data->status = status;
+    data->is_host = false;
+    if (status == ARES_SUCCESS)
+      data->addrinfo = std::move(addrinfo);
+
+    wrap->QueueResponseCallback(status);
+  }
+
   void QueueResponseCallback(int status) {
     BaseObjectPtr<QueryWrap> strong_ref{this};
     env()->SetImmediate([this, strong_ref](Environment*) {
@@ -720,7 +1053,7 @@ class QueryWrap : public AsyncWrap {
     MakeCallback(env()->oncomplete_string(), argc, argv);
   }
 
-  void ParseError(int status) {
+  virtual void ParseError(int status) {
     CHECK_NE(status, ARES_SUCCESS);
     HandleScope handle_scope(env()->isolate());
     Context::Scope context_scope(env()->context());
@@ -741,11 +1074,17 @@ class QueryWrap : public AsyncWrap {
     UNREACHABLE();
   }
 
+  virtual void Parse(struct ares_addrinfo* res) {
+    UNREACHABLE();
+  }
+
   BaseObjectPtr<ChannelWrap> channel_;
 
  private:
   std::unique_ptr<ResponseData> response_data_;
   const char* trace_name_;
+  // Set when the query may be answered from or stored in the channel's cache.
+  std::string cache_key_;
   // Pointer to pointer to 'this' that can be reset from the destructor,
   // in order to let Callback() know that 'this' no longer exists.
   QueryWrap** callback_ptr_ = nullptr;
@@ -1860,6 +2199,197 @@ class GetHostByAddrWrap: public QueryWrap {
 };
 
 
+// Emulates AI_ADDRCONFIG, which ares_getaddrinfo() does not implement:
+// reports whether a non-loopback IPv4 or IPv6 address is configured.
+void GetConfiguredFamilies(bool* has_ipv4, bool* has_ipv6) {
+  uv_interface_address_t* interfaces;
+  int count;
+
+  *has_ipv4 = *has_ipv6 = false;
+  if (uv_interface_addresses(&interfaces, &count) != 0) {
+    *has_ipv4 = *has_ipv6 = true;
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    if (interfaces[i].is_internal)
+      continue;
+    if (interfaces[i].address.address4.sin_family == AF_INET)
+      *has_ipv4 = true;
+    else if (interfaces[i].address.address6.sin6_family == AF_INET6)
+      *has_ipv6 = true;
+  }
+
+  uv_free_interface_addresses(interfaces, count);
+}
+
+// dns.lookup() implemented with ares_getaddrinfo(), so that the lookup runs
+// on the event loop instead of occupying a thread pool slot for its whole
+// duration. c-ares consults the hosts file and DNS in the order configured in
+// nsswitch.conf/host.conf and applies the resolv.conf search domains; the
+// AI_ADDRCONFIG and AI_V4MAPPED semantics are emulated here. Results are
+// reported the same way AfterGetAddrInfo() does, and errors are mapped to the
+// closest UV_EAI_* code; see ToGetAddrInfoError().
+class GetAddrInfoAresWrap: public QueryWrap {
+ public:
+  GetAddrInfoAresWrap(ChannelWrap* channel,
+                      Local<Object> req_wrap_obj,
+                      bool verbatim,
+                      int flags)
+      : QueryWrap(channel,
+                  req_wrap_obj,
+                  "lookup",
+                  AsyncWrap::PROVIDER_GETADDRINFOREQWRAP),
+        verbatim_(verbatim),
+        flags_(flags) {
+  }
+
+  int Send(const char* name, int family) override {
+    family_ = family;
+
+    int query_family = family;
+    if (family == AF_INET6 && (flags_ & AI_V4MAPPED)) {
+      query_family = AF_UNSPEC;
+    } else if (family == AF_UNSPEC && (flags_ & AI_ADDRCONFIG)) {
+      bool has_ipv4, has_ipv6;
+      GetConfiguredFamilies(&has_ipv4, &has_ipv6);
+      if (has_ipv4 && !has_ipv6)
+        query_family = AF_INET;
+      else if (has_ipv6 && !has_ipv4)
+        query_family = AF_INET6;
+    }
+
+    struct ares_addrinfo_hints hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = query_family;
+    hints.ai_socktype = SOCK_STREAM;
+
+    channel_->EnsureServers();
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN2(
+        TRACING_CATEGORY_NODE2(dns, native), "lookup", this,
+        "hostname", TRACE_STR_COPY(name),
+        "family",
+        family == AF_INET ? "ipv4" : family == AF_INET6 ? "ipv6" : "unspec");
+
+    ares_getaddrinfo(channel_->cares_channel(),
+                     name,
+                     nullptr,
+                     &hints,
+                     Callback,
+                     MakeCallbackPointer());
+    return 0;
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(GetAddrInfoAresWrap)
+  SET_SELF_SIZE(GetAddrInfoAresWrap)
+
+ protected:
+  void Parse(struct ares_addrinfo* res) override {
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    Local<Array> results = Array::New(env()->isolate());
+    uint32_t n = 0;
+
+    auto add = [&] (bool want_ipv4, bool want_ipv6, bool map_ipv4) {
+      for (auto p = res->nodes; p != nullptr; p = p->ai_next) {
+        const char* addr;
+        if (want_ipv4 && p->ai_family == AF_INET) {
+          addr = reinterpret_cast<char*>(
+              &(reinterpret_cast<struct sockaddr_in*>(p->ai_addr)->sin_addr));
+        } else if (want_ipv6 && p->ai_family == AF_INET6) {
+          addr = reinterpret_cast<char*>(
+              &(reinterpret_cast<struct sockaddr_in6*>(p->ai_addr)->sin6_addr));
+        } else {
+          continue;
+        }
+
+        // Leave room for the "::ffff:" prefix of IPv4-mapped addresses.
+        static const char kMappedPrefix[] = "::ffff:";
+        const size_t prefix_len = map_ipv4 ? sizeof(kMappedPrefix) - 1 : 0;
+        char ip[sizeof(kMappedPrefix) + INET6_ADDRSTRLEN];
+        memcpy(ip, kMappedPrefix, prefix_len);
+        if (uv_inet_ntop(p->ai_family,
+                         addr,
+                         ip + prefix_len,
+                         sizeof(ip) - prefix_len)) {
+          continue;
+        }
+
+        Local<String> s = OneByteString(env()->isolate(), ip);
+        results->Set(env()->context(), n++, s).Check();
+      }
+    };
+
+    if (family_ == AF_INET6 && (flags_ & AI_V4MAPPED)) {
+      add(false, true, false);
+      if (n == 0 || (flags_ & AI_ALL))
+        add(true, false, true);
+    } else {
+      add(true, verbatim_, false);
+      if (verbatim_ == false)
+        add(false, true, false);
+    }
+
+    // No responses were found to return
+    if (n == 0)
+      return ParseError(ARES_ENODATA);
+
+    CallOnComplete(results);
+  }
+
+  // Reports errors as the UV_EAI_* code that getaddrinfo(3) would have
+  // returned, so that dns.lookup() and Resolver#lookup() fail alike.
+  void ParseError(int status) override {
+    CHECK_NE(status, ARES_SUCCESS);
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+    Local<Value> arg = Integer::New(env()->isolate(),
+                                    ToGetAddrInfoError(status));
+    TRACE_EVENT_NESTABLE_ASYNC_END1(
+        TRACING_CATEGORY_NODE2(dns, native), "lookup", this,
+        "error", status);
+    MakeCallback(env()->oncomplete_string(), 1, &arg);
+  }
+
+  static int ToGetAddrInfoError(int status) {
+    switch (status) {
+      case ARES_ENODATA:
+        return UV_EAI_NODATA;
+      case ARES_ENOTFOUND:
+      case ARES_ENONAME:
+      case ARES_EBADNAME:
+        return UV_EAI_NONAME;
+      case ARES_ETIMEOUT:
+      case ARES_ECONNREFUSED:
+      case ARES_ESERVFAIL:
+      case ARES_EREFUSED:
+      case ARES_EOF:
+        return UV_EAI_AGAIN;
+      case ARES_EBADFAMILY:
+        return UV_EAI_FAMILY;
+      case ARES_EBADFLAGS:
+        return UV_EAI_BADFLAGS;
+      case ARES_EBADHINTS:
+        return UV_EAI_BADHINTS;
+      case ARES_ENOMEM:
+        return UV_EAI_MEMORY;
+      case ARES_ECANCELLED:
+      case ARES_EDESTRUCTION:
+        return UV_EAI_CANCELED;
+      default:
+        return UV_EAI_FAIL;
+    }
+  }
+
+ private:
+  const bool verbatim_;
+  const int flags_;
+  int family_ = AF_UNSPEC;
+};
+
+
 template <class Wrap>
 static void Query(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -2076,6 +2606,59 @@ void GetAddrInfo(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Same as GetAddrInfo(), but resolves through the channel's c-ares
+// instance on the event loop rather than through uv_getaddrinfo().
+void GetAddrInfoAres(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ChannelWrap* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsInt32());
+  CHECK(args[4]->IsBoolean());
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  node::Utf8Value hostname(env->isolate(), args[1]);
+
+  int32_t flags = 0;
+  if (args[3]->IsInt32()) {
+    flags = args[3].As<Int32>()->Value();
+  }
+
+  int family;
+
+  switch (args[2].As<Int32>()->Value()) {
+    case 0:
+      family = AF_UNSPEC;
+      break;
+    case 4:
+      family = AF_INET;
+      break;
+    case 6:
+      family = AF_INET6;
+      break;
+    default:
+      CHECK(0 && "bad address family");
+  }
+
+  auto wrap = std::make_unique<GetAddrInfoAresWrap>(channel,
+                                                    req_wrap_obj,
+                                                    args[4]->IsTrue(),
+                                                    flags);
+
+  channel->ModifyActivityQueryCount(1);
+  int err = wrap->Send(*hostname, family);
+  if (err) {
+    channel->ModifyActivityQueryCount(-1);
+  } else {
+    // Release ownership of the pointer allowing the ownership to be transferred
+    USE(wrap.release());
+  }
+
+  args.GetReturnValue().Set(err);
+}
+
+
 void GetNameInfo(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -2222,8 +2805,11 @@ void SetServers(const FunctionCallbackInfo<Value>& args) {
   else
     err = ARES_EBADSTR;
 
-  if (err == ARES_SUCCESS)
+  if (err == ARES_SUCCESS) {
     channel->set_is_servers_default(false);
+    // Answers from the previous servers must not be served any longer.
+    channel->ClearCache();
+  }
 
   args.GetReturnValue().Set(err);
 }
@@ -2302,6 +2888,47 @@ void Cancel(const FunctionCallbackInfo<Value>& args) {
   ares_cancel(channel->cares_channel());
 }
 
+void SetCacheOptions(const FunctionCallbackInfo<Value>& args) {
+  ChannelWrap* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+
+  CHECK_EQ(args.Length(), 4);
+  CHECK(args[0]->IsUint32());  // maxEntries
+  CHECK(args[1]->IsUint32());  // maxTtl
+  CHECK(args[2]->IsUint32());  // negativeTtl
+  CHECK(args[3]->IsUint32());  // staleTtl
+
+  DnsCacheOptions options;
+  options.max_entries = args[0].As<Uint32>()->Value();
+  options.max_ttl = args[1].As<Uint32>()->Value();
+  options.negative_ttl = args[2].As<Uint32>()->Value();
+  options.stale_ttl = args[3].As<Uint32>()->Value();
+  channel->set_cache_options(options);
+}
+
+// Fills the passed Float64Array with [hits, misses, staleHits, entries].
+void GetCacheStats(const FunctionCallbackInfo<Value>& args) {
+  ChannelWrap* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 4);
+  Local<ArrayBuffer> ab = array->Buffer();
+  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
+
+  fields[0] = static_cast<double>(channel->cache_hits());
+  fields[1] = static_cast<double>(channel->cache_misses());
+  fields[2] = static_cast<double>(channel->cache_stale_hits());
+  fields[3] = static_cast<double>(channel->cache_size());
+}
+
+void ClearCache(const FunctionCallbackInfo<Value>& args) {
+  ChannelWrap* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+  channel->ClearCache();
+}
+
 const char EMSG_ESETSRVPENDING[] = "There are pending queries.";
 void StrError(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -2391,11 +3018,15 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(channel_wrap, "queryNaptr", Query<QueryNaptrWrap>);
   env->SetProtoMethod(channel_wrap, "querySoa", Query<QuerySoaWrap>);
   env->SetProtoMethod(channel_wrap, "getHostByAddr", Query<GetHostByAddrWrap>);
+  env->SetProtoMethod(channel_wrap, "getaddrinfo", GetAddrInfoAres);
 
   env->SetProtoMethodNoSideEffect(channel_wrap, "getServers", GetServers);
   env->SetProtoMethod(channel_wrap, "setServers", SetServers);
   env->SetProtoMethod(channel_wrap, "setLocalAddress", SetLocalAddress);
   env->SetProtoMethod(channel_wrap, "cancel", Cancel);
+  env->SetProtoMethod(channel_wrap, "setCacheOptions", SetCacheOptions);
+  env->SetProtoMethodNoSideEffect(channel_wrap, "getCacheStats", GetCacheStats);
+  env->SetProtoMethod(channel_wrap, "clearCache", ClearCache);
 
   Local<String> channelWrapString =
       FIXED_ONE_BYTE_STRING(env->isolate(), "ChannelWrap");
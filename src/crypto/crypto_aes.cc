@@ -18,6 +18,7 @@
 namespace node {
 
 using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
 using v8::Just;
 using v8::Local;
 using v8::Maybe;
@@ -585,8 +586,262 @@ WebCryptoCipherStatus AESCipherTraits::DoCipher(
 #undef V
 }
 
+AESCipherStream::AESCipherStream(Environment* env,
+                                 Local<Object> wrap,
+                                 AESCipherConfig&& config)
+    : BaseObject(env, wrap),
+      config_(std::move(config)) {
+  MakeWeak();
+}
+
+void AESCipherStream::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("ctx", ctx_ ? kSizeOf_EVP_CIPHER_CTX : 0);
+  tracker->TrackField("config", config_);
+}
+
+void AESCipherStream::Initialize(Environment* env, Local<Object> target) {
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+
+  t->InstanceTemplate()->SetInternalFieldCount(
+      AESCipherStream::kInternalFieldCount);
+  t->Inherit(BaseObject::GetConstructorTemplate(env));
+
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "AESCipherStream"),
+              t->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  AESCipherStreamJob::Initialize(env, target);
+}
+
+// new AESCipherStream(key, variant, iv, length, additionalData), where the
+// arguments after the key are the same as those of AESCipherJob for
+// encryption.
+void AESCipherStream::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+
+  CHECK(args[0]->IsObject());  // KeyObject
+  KeyObjectHandle* key;
+  ASSIGN_OR_RETURN_UNWRAP(&key, args[0]);
+
+  AESCipherConfig config;
+  if (AESCipherTraits::AdditionalConfig(
+          kCryptoJobAsync,
+          args,
+          1,
+          kWebCryptoCipherEncrypt,
+          &config).IsNothing()) {
+    return;
+  }
+  const int mode = EVP_CIPHER_mode(config.cipher);
+  CHECK(mode == EVP_CIPH_CTR_MODE || mode == EVP_CIPH_GCM_MODE);
+
+  AESCipherStream* stream =
+      new AESCipherStream(env, args.This(), std::move(config));
+  if (!stream->Init(key->Data().get()))
+    return ThrowCryptoError(env, ERR_get_error(), "Cipher job failed.");
+}
+
+namespace {
+// Returns the value of a BIGNUM of at most 64 bits, also where BN_ULONG only
+// has 32 bits.
+uint64_t BignumToUint64(const BIGNUM* bn) {
+  unsigned char bytes[sizeof(uint64_t)];
+  CHECK_EQ(BN_bn2binpad(bn, bytes, sizeof(bytes)),
+           static_cast<int>(sizeof(bytes)));
+  uint64_t value = 0;
+  for (unsigned char byte : bytes)
+    value = (value << CHAR_BIT) | byte;
+  return value;
+}
+}  // namespace
+
+bool AESCipherStream::Init(const KeyObjectData* key_data) {
+  CHECK_NOT_NULL(key_data);
+  CHECK_EQ(key_data->GetKeyType(), kKeyTypeSecret);
+
+  const bool gcm = EVP_CIPHER_mode(config_.cipher) == EVP_CIPH_GCM_MODE;
+
+  ctx_.reset(EVP_CIPHER_CTX_new());
+  if (!ctx_ ||
+      !EVP_EncryptInit_ex(ctx_.get(), config_.cipher, nullptr, nullptr,
+                          nullptr)) {
+    return false;
+  }
+
+  if (gcm && !EVP_CIPHER_CTX_ctrl(
+        ctx_.get(),
+        EVP_CTRL_AEAD_SET_IVLEN,
+        config_.iv.size(),
+        nullptr)) {
+    return false;
+  }
+
+  if (!EVP_CIPHER_CTX_set_key_length(
+          ctx_.get(),
+          key_data->GetSymmetricKeySize()) ||
+      !EVP_EncryptInit_ex(
+          ctx_.get(),
+          nullptr,
+          nullptr,
+          reinterpret_cast<const unsigned char*>(key_data->GetSymmetricKey()),
+          config_.iv.data<unsigned char>())) {
+    return false;
+  }
+
+  if (gcm) {
+    int out_len;
+    return config_.additional_data.size() == 0 ||
+           EVP_EncryptUpdate(
+               ctx_.get(),
+               nullptr,
+               &out_len,
+               config_.additional_data.data<unsigned char>(),
+               config_.additional_data.size());
+  }
+
+  // In CTR mode, only the rightmost config_.length bits of the counter block
+  // are incremented and wrap around, while OpenSSL increments all of them.
+  // Update() restarts with a zeroed counter where it wraps around, as
+  // AES_CTR_Cipher() does. With all 128 bits, both behave the same.
+  if (config_.length >= 128)
+    return true;
+  BignumPointer current_counter = GetCounter(config_);
+  BignumPointer remaining(BN_new());
+  if (!current_counter ||
+      !remaining ||
+      !BN_lshift(remaining.get(), BN_value_one(), config_.length) ||
+      !BN_sub(remaining.get(), remaining.get(), current_counter.get())) {
+    return false;
+  }
+  // 2^60 counter values cover 2^64 bytes, which are never reached.
+  if (BN_num_bits(remaining.get()) <= 60)
+    wrap_at_ = BignumToUint64(remaining.get()) * kAesBlockSize;
+  if (config_.length < 60)
+    limit_ = (uint64_t{1} << config_.length) * kAesBlockSize;
+  return true;
+}
+
+bool AESCipherStream::Update(const char* data,
+                             size_t len,
+                             bool final,
+                             ByteSource* out) {
+  const bool gcm = EVP_CIPHER_mode(config_.cipher) == EVP_CIPH_GCM_MODE;
+  const size_t tag_len = gcm && final ? config_.length : 0;
+
+  // Just like AES_CTR_Cipher(), fail rather than reusing counter values.
+  if (len > limit_ - processed_)
+    return false;
+
+  const size_t out_len = len + tag_len;
+  if (out_len == 0)
+    return true;
+
+  char* buf = MallocOpenSSL<char>(out_len);
+  ByteSource result = ByteSource::Allocated(buf, out_len);
+  unsigned char* ptr = reinterpret_cast<unsigned char*>(buf);
+  const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+
+  auto encrypt = [&](const unsigned char* in, size_t len, unsigned char* out) {
+    int out_len = 0;
+    return EVP_EncryptUpdate(ctx_.get(), out, &out_len, in, len) &&
+           static_cast<size_t>(out_len) == len;
+  };
+
+  size_t before_wrap = len;
+  if (processed_ <= wrap_at_ && len > wrap_at_ - processed_)
+    before_wrap = wrap_at_ - processed_;
+  if (!encrypt(in, before_wrap, ptr))
+    return false;
+  if (before_wrap < len) {
+    std::vector<unsigned char> counter = BlockWithZeroedCounter(config_);
+    if (!EVP_EncryptInit_ex(ctx_.get(), nullptr, nullptr, nullptr,
+                            counter.data()) ||
+        !encrypt(in + before_wrap, len - before_wrap, ptr + before_wrap)) {
+      return false;
+    }
+  }
+  processed_ += len;
+
+  if (tag_len > 0) {
+    int final_len = 0;
+    if (!EVP_EncryptFinal_ex(ctx_.get(), ptr + len, &final_len) ||
+        !EVP_CIPHER_CTX_ctrl(
+            ctx_.get(), EVP_CTRL_AEAD_GET_TAG, tag_len, ptr + len)) {
+      return false;
+    }
+    CHECK_EQ(final_len, 0);
+  }
+
+  *out = std::move(result);
+  return true;
+}
+
+AESCipherStreamConfig::AESCipherStreamConfig(
+    AESCipherStreamConfig&& other) noexcept
+    : stream(std::move(other.stream)),
+      in(std::move(other.in)),
+      final(other.final) {}
+
+AESCipherStreamConfig& AESCipherStreamConfig::operator=(
+    AESCipherStreamConfig&& other) noexcept {
+  if (&other == this) return *this;
+  this->~AESCipherStreamConfig();
+  return *new (this) AESCipherStreamConfig(std::move(other));
+}
+
+void AESCipherStreamConfig::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("stream", stream);
+  tracker->TrackFieldWithSize("in", in.size());
+}
+
+Maybe<bool> AESCipherStreamTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    AESCipherStreamConfig* params) {
+  Environment* env = Environment::GetCurrent(args);
+
+  AESCipherStream* stream;
+  CHECK(args[offset]->IsObject());  // AESCipherStream
+  ASSIGN_OR_RETURN_UNWRAP(&stream, args[offset], Nothing<bool>());
+  params->stream.reset(stream);
+
+  // The chunk is copied, so that JavaScript may modify or transfer it while
+  // the job runs.
+  ArrayBufferOrViewContents<char> in(args[offset + 1]);
+  if (UNLIKELY(!in.CheckSizeInt32())) {
+    THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+    return Nothing<bool>();
+  }
+  params->in = in.ToCopy();
+
+  CHECK(args[offset + 2]->IsBoolean());  // Final
+  params->final = args[offset + 2]->IsTrue();
+
+  return Just(true);
+}
+
+bool AESCipherStreamTraits::DeriveBits(
+    Environment* env,
+    const AESCipherStreamConfig& params,
+    ByteSource* out) {
+  return params.stream->Update(
+      params.in.get(), params.in.size(), params.final, out);
+}
+
+Maybe<bool> AESCipherStreamTraits::EncodeOutput(
+    Environment* env,
+    const AESCipherStreamConfig& params,
+    ByteSource* out,
+    Local<Value>* result) {
+  *result = out->ToArrayBuffer(env);
+  return Just(!result->IsEmpty());
+}
+
 void AES::Initialize(Environment* env, Local<Object> target) {
   AESCryptoJob::Initialize(env, target);
+  AESCipherStream::Initialize(env, target);
 
 #define V(name, _) NODE_DEFINE_CONSTANT(target, kKeyVariantAES_ ## name);
   VARIANTS(V)
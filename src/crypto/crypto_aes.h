@@ -7,6 +7,7 @@
 #include "crypto/crypto_keys.h"
 #include "crypto/crypto_util.h"
 #include "allocated_buffer.h"
+#include "base_object.h"
 #include "env.h"
 #include "v8.h"
 
@@ -79,6 +80,84 @@ struct AESCipherTraits final {
 
 using AESCryptoJob = CipherJob<AESCipherTraits>;
 
+// The state of an AES-CTR or AES-GCM encryption whose input arrives one
+// chunk at a time. The chunks are encrypted in order by AESCipherStreamJob.
+class AESCipherStream final : public BaseObject {
+ public:
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  // Encrypts the next chunk into out, followed by the authentication tag in
+  // GCM mode if it is the last chunk. Does not use V8, so that it can run in
+  // the thread pool.
+  bool Update(const char* data, size_t len, bool final, ByteSource* out);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(AESCipherStream)
+  SET_SELF_SIZE(AESCipherStream)
+
+ protected:
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  AESCipherStream(Environment* env,
+                  v8::Local<v8::Object> wrap,
+                  AESCipherConfig&& config);
+
+ private:
+  bool Init(const KeyObjectData* key_data);
+
+  CipherCtxPointer ctx_;
+  AESCipherConfig config_;
+  // In CTR mode, the number of bytes encrypted so far, the number of bytes
+  // after which the counter wraps around, and the number of bytes after which
+  // counter values would be reused.
+  uint64_t processed_ = 0;
+  uint64_t wrap_at_ = UINT64_MAX;
+  uint64_t limit_ = UINT64_MAX;
+};
+
+struct AESCipherStreamConfig final : public MemoryRetainer {
+  BaseObjectPtr<AESCipherStream> stream;
+  ByteSource in;
+  bool final = false;
+
+  AESCipherStreamConfig() = default;
+
+  explicit AESCipherStreamConfig(AESCipherStreamConfig&& other) noexcept;
+
+  AESCipherStreamConfig& operator=(AESCipherStreamConfig&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(AESCipherStreamConfig);
+  SET_SELF_SIZE(AESCipherStreamConfig);
+};
+
+// Encrypts a copy of one chunk of an AESCipherStream in the thread pool.
+struct AESCipherStreamTraits final {
+  using AdditionalParameters = AESCipherStreamConfig;
+  static constexpr const char* JobName = "AESCipherStreamJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_CIPHERREQUEST;
+
+  static v8::Maybe<bool> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      AESCipherStreamConfig* params);
+
+  static bool DeriveBits(
+      Environment* env,
+      const AESCipherStreamConfig& params,
+      ByteSource* out);
+
+  static v8::Maybe<bool> EncodeOutput(
+      Environment* env,
+      const AESCipherStreamConfig& params,
+      ByteSource* out,
+      v8::Local<v8::Value>* result);
+};
+
+using AESCipherStreamJob = DeriveBitsJob<AESCipherStreamTraits>;
+
 namespace AES {
 void Initialize(Environment* env, v8::Local<v8::Object> target);
 }  // namespace AES
@@ -0,0 +1,1010 @@
+#include "crypto/crypto_checksum.h"
+#include "async_wrap-inl.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "string_bytes.h"
+#include "threadpoolwork-inl.h"
+#include "v8.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CHECKSUM_X64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CHECKSUM_ARM64 1
+#include <arm_neon.h>
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+#endif
+
+// Allows functions to use instructions that the rest of the binary is not
+// compiled for. They must only be called after checking that the CPU
+// supports them. MSVC does not need this.
+#if defined(__GNUC__)
+#define CHECKSUM_TARGET(features) __attribute__((target(features)))
+#else
+#define CHECKSUM_TARGET(features)
+#endif
+
+namespace node {
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::Int32;
+using v8::Just;
+using v8::Local;
+using v8::Maybe;
+using v8::MaybeLocal;
+using v8::Nothing;
+using v8::Object;
+using v8::Value;
+
+namespace crypto {
+namespace {
+constexpr uint32_t kPrime32_1 = 0x9E3779B1U;
+constexpr uint32_t kPrime32_2 = 0x85EBCA77U;
+constexpr uint32_t kPrime32_3 = 0xC2B2AE3DU;
+constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime64_5 = 0x27D4EB2F165667C5ULL;
+
+inline uint32_t ReadLE32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) |
+         static_cast<uint32_t>(p[1]) << 8 |
+         static_cast<uint32_t>(p[2]) << 16 |
+         static_cast<uint32_t>(p[3]) << 24;
+}
+
+inline uint64_t ReadLE64(const uint8_t* p) {
+  return static_cast<uint64_t>(ReadLE32(p)) |
+         static_cast<uint64_t>(ReadLE32(p + 4)) << 32;
+}
+
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t ByteSwap64(uint64_t value) {
+  value = ((value & 0x00FF00FF00FF00FFULL) << 8) |
+          ((value >> 8) & 0x00FF00FF00FF00FFULL);
+  value = ((value & 0x0000FFFF0000FFFFULL) << 16) |
+          ((value >> 16) & 0x0000FFFF0000FFFFULL);
+  return (value << 32) | (value >> 32);
+}
+
+// Folds the 128-bit product of a and b into 64 bits.
+inline uint64_t Multiply128Fold64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = static_cast<__uint128_t>(a) * b;
+  return static_cast<uint64_t>(product) ^
+         static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+  uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+  uint64_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+  uint64_t hi_hi = (a >> 32) * (b >> 32);
+  uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+  uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+  return lower ^ upper;
+#endif
+}
+
+inline void WriteBE(uint64_t value, size_t length, uint8_t* out) {
+  for (size_t i = 0; i < length; i++)
+    out[i] = static_cast<uint8_t>(value >> (8 * (length - 1 - i)));
+}
+
+#if defined(CHECKSUM_X64)
+bool CPUHasSSE42() {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 20)) != 0;
+#else
+  return __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+bool CPUHasAVX2() {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 1);
+  // The OS must save the AVX registers as well.
+  if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif  // defined(CHECKSUM_X64)
+
+// CRC32C (Castagnoli). The portable version processes 8 bytes at a time with
+// a table for each byte ("slicing-by-8").
+
+constexpr uint32_t kCRC32CPolynomial = 0x82F63B78U;
+
+struct CRC32CTables {
+  uint32_t table[8][256];
+
+  CRC32CTables() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; j++)
+        crc = (crc >> 1) ^ (kCRC32CPolynomial & (0 - (crc & 1)));
+      table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+      for (int j = 1; j < 8; j++)
+        table[j][i] = (table[j - 1][i] >> 8) ^ table[0][table[j - 1][i] & 0xFF];
+    }
+  }
+};
+
+uint32_t CRC32CPortable(uint32_t crc, const uint8_t* data, size_t len) {
+  static const CRC32CTables tables;
+  const auto& t = tables.table;
+  for (; len >= 8; len -= 8, data += 8) {
+    uint32_t lo = ReadLE32(data) ^ crc;
+    uint32_t hi = ReadLE32(data + 4);
+    crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^
+          t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+          t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^
+          t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+  }
+  for (; len > 0; len--, data++)
+    crc = (crc >> 8) ^ t[0][(crc ^ data[0]) & 0xFF];
+  return crc;
+}
+
+#if defined(CHECKSUM_X64)
+CHECKSUM_TARGET("sse4.2")
+uint32_t CRC32CSSE42(uint32_t crc, const uint8_t* data, size_t len) {
+  uint64_t crc64 = crc;
+  for (; len >= 8; len -= 8, data += 8)
+    crc64 = _mm_crc32_u64(crc64, ReadLE64(data));
+  crc = static_cast<uint32_t>(crc64);
+  for (; len > 0; len--, data++)
+    crc = _mm_crc32_u8(crc, *data);
+  return crc;
+}
+#endif
+
+#if defined(CHECKSUM_ARM64) && defined(__ARM_FEATURE_CRC32)
+uint32_t CRC32CARM64(uint32_t crc, const uint8_t* data, size_t len) {
+  for (; len >= 8; len -= 8, data += 8)
+    crc = __crc32cd(crc, ReadLE64(data));
+  for (; len > 0; len--, data++)
+    crc = __crc32cb(crc, *data);
+  return crc;
+}
+#endif
+
+using CRC32CFunction = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+CRC32CFunction GetCRC32CFunction() {
+#if defined(CHECKSUM_X64)
+  if (CPUHasSSE42())
+    return CRC32CSSE42;
+#elif defined(CHECKSUM_ARM64) && defined(__ARM_FEATURE_CRC32)
+  return CRC32CARM64;
+#endif
+  return CRC32CPortable;
+}
+
+// Continues the CRC32C checksum crc over data.
+uint32_t CRC32C(uint32_t crc, const uint8_t* data, size_t len) {
+  static const CRC32CFunction fn = GetCRC32CFunction();
+  return ~fn(~crc, data, len);
+}
+
+// XXH64 and XXH3 (64 bits), with a seed of 0. See
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md.
+
+constexpr size_t kXXH64StripeLength = 32;
+
+inline uint64_t XXH64Round(uint64_t acc, uint64_t input) {
+  acc += input * kPrime64_2;
+  acc = RotateLeft(acc, 31);
+  return acc * kPrime64_1;
+}
+
+inline uint64_t XXH64MergeRound(uint64_t acc, uint64_t value) {
+  acc ^= XXH64Round(0, value);
+  return acc * kPrime64_1 + kPrime64_4;
+}
+
+inline uint64_t XXH64Avalanche(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= kPrime64_2;
+  hash ^= hash >> 29;
+  hash *= kPrime64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+void XXH64Consume(uint64_t* acc, const uint8_t* data) {
+  for (int i = 0; i < 4; i++)
+    acc[i] = XXH64Round(acc[i], ReadLE64(data + 8 * i));
+}
+
+uint64_t XXH64Finalize(uint64_t hash, const uint8_t* data, size_t len) {
+  for (; len >= 8; len -= 8, data += 8) {
+    hash ^= XXH64Round(0, ReadLE64(data));
+    hash = RotateLeft(hash, 27) * kPrime64_1 + kPrime64_4;
+  }
+  if (len >= 4) {
+    hash ^= ReadLE32(data) * kPrime64_1;
+    hash = RotateLeft(hash, 23) * kPrime64_2 + kPrime64_3;
+    len -= 4;
+    data += 4;
+  }
+  for (; len > 0; len--, data++) {
+    hash ^= *data * kPrime64_5;
+    hash = RotateLeft(hash, 11) * kPrime64_1;
+  }
+  return XXH64Avalanche(hash);
+}
+
+constexpr size_t kXXH3StripeLength = 64;
+constexpr size_t kXXH3SecretSize = 192;
+constexpr size_t kXXH3StripesPerBlock =
+    (kXXH3SecretSize - kXXH3StripeLength) / 8;
+constexpr size_t kXXH3BlockLength = kXXH3StripeLength * kXXH3StripesPerBlock;
+constexpr size_t kXXH3MidSizeMax = 240;
+
+alignas(64) constexpr uint8_t kXXH3Secret[kXXH3SecretSize] = {
+  0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe,
+  0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+  0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+  0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+  0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78,
+  0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+  0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e,
+  0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+  0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+  0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+  0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e,
+  0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+  0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f,
+  0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+  0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+  0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+  0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3,
+  0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+  0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49,
+  0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+  0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+  0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+  0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28,
+  0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+constexpr uint64_t kXXH3InitialAccumulators[8] = {
+  kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+  kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1,
+};
+
+inline uint64_t XXH3Avalanche(uint64_t hash) {
+  hash ^= hash >> 37;
+  hash *= 0x165667919E3779F9ULL;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+inline uint64_t XXH3Rrmxmx(uint64_t hash, size_t len) {
+  hash ^= RotateLeft(hash, 49) ^ RotateLeft(hash, 24);
+  hash *= 0x9FB21C651E98DF25ULL;
+  hash ^= (hash >> 35) + len;
+  hash *= 0x9FB21C651E98DF25ULL;
+  return hash ^ (hash >> 28);
+}
+
+inline uint64_t XXH3Mix16(const uint8_t* data, const uint8_t* secret) {
+  return Multiply128Fold64(ReadLE64(data) ^ ReadLE64(secret),
+                           ReadLE64(data + 8) ^ ReadLE64(secret + 8));
+}
+
+uint64_t XXH3Short(const uint8_t* data, size_t len) {
+  const uint8_t* secret = kXXH3Secret;
+  if (len > 8) {
+    uint64_t lo = ReadLE64(data) ^ (ReadLE64(secret + 24) ^
+                                    ReadLE64(secret + 32));
+    uint64_t hi = ReadLE64(data + len - 8) ^ (ReadLE64(secret + 40) ^
+                                              ReadLE64(secret + 48));
+    return XXH3Avalanche(len + ByteSwap64(lo) + hi +
+                         Multiply128Fold64(lo, hi));
+  }
+  if (len >= 4) {
+    uint64_t input = ReadLE32(data + len - 4) +
+                     (static_cast<uint64_t>(ReadLE32(data)) << 32);
+    return XXH3Rrmxmx(
+        input ^ (ReadLE64(secret + 8) ^ ReadLE64(secret + 16)), len);
+  }
+  if (len > 0) {
+    uint32_t combined = static_cast<uint32_t>(data[0]) << 16 |
+                        static_cast<uint32_t>(data[len >> 1]) << 24 |
+                        static_cast<uint32_t>(data[len - 1]) |
+                        static_cast<uint32_t>(len) << 8;
+    return XXH64Avalanche(
+        combined ^ static_cast<uint64_t>(ReadLE32(secret) ^
+                                         ReadLE32(secret + 4)));
+  }
+  return XXH64Avalanche(ReadLE64(secret + 56) ^ ReadLE64(secret + 64));
+}
+
+uint64_t XXH3Medium(const uint8_t* data, size_t len) {
+  const uint8_t* secret = kXXH3Secret;
+  uint64_t acc = len * kPrime64_1;
+  if (len <= 128) {
+    if (len > 32) {
+      if (len > 64) {
+        if (len > 96) {
+          acc += XXH3Mix16(data + 48, secret + 96);
+          acc += XXH3Mix16(data + len - 64, secret + 112);
+        }
+        acc += XXH3Mix16(data + 32, secret + 64);
+        acc += XXH3Mix16(data + len - 48, secret + 80);
+      }
+      acc += XXH3Mix16(data + 16, secret + 32);
+      acc += XXH3Mix16(data + len - 32, secret + 48);
+    }
+    acc += XXH3Mix16(data, secret);
+    acc += XXH3Mix16(data + len - 16, secret + 16);
+    return XXH3Avalanche(acc);
+  }
+
+  for (size_t i = 0; i < 8; i++)
+    acc += XXH3Mix16(data + 16 * i, secret + 16 * i);
+  acc = XXH3Avalanche(acc);
+  for (size_t i = 8; i < len / 16; i++)
+    acc += XXH3Mix16(data + 16 * i, secret + 16 * (i - 8) + 3);
+  acc += XXH3Mix16(data + len - 16, secret + 136 - 17);
+  return XXH3Avalanche(acc);
+}
+
+// The inner loop of XXH3 for long inputs: accumulates stripes of 64 bytes,
+// moving along the secret by 8 bytes per stripe, and scrambles the
+// accumulators at the end of each block.
+
+#if !defined(CHECKSUM_X64) && !defined(CHECKSUM_ARM64)
+
+void XXH3AccumulatePortable(uint64_t* acc,
+                            const uint8_t* data,
+                            const uint8_t* secret,
+                            size_t stripes) {
+  for (size_t n = 0; n < stripes; n++) {
+    const uint8_t* stripe = data + n * kXXH3StripeLength;
+    const uint8_t* key = secret + n * 8;
+    for (size_t i = 0; i < 8; i++) {
+      uint64_t value = ReadLE64(stripe + 8 * i);
+      uint64_t keyed = value ^ ReadLE64(key + 8 * i);
+      acc[i ^ 1] += value;
+      acc[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+  }
+}
+
+void XXH3ScramblePortable(uint64_t* acc, const uint8_t* secret) {
+  for (size_t i = 0; i < 8; i++) {
+    uint64_t value = acc[i];
+    value ^= value >> 47;
+    value ^= ReadLE64(secret + 8 * i);
+    acc[i] = value * kPrime32_1;
+  }
+}
+#endif  // !defined(CHECKSUM_X64) && !defined(CHECKSUM_ARM64)
+
+#if defined(CHECKSUM_X64)
+// SSE2 is part of x86-64.
+void XXH3AccumulateSSE2(uint64_t* acc,
+                        const uint8_t* data,
+                        const uint8_t* secret,
+                        size_t stripes) {
+  __m128i* xacc = reinterpret_cast<__m128i*>(acc);
+  __m128i sums[4];
+  for (size_t i = 0; i < 4; i++)
+    sums[i] = _mm_loadu_si128(xacc + i);
+  for (size_t n = 0; n < stripes; n++) {
+    const uint8_t* stripe = data + n * kXXH3StripeLength;
+    const uint8_t* key = secret + n * 8;
+    for (size_t i = 0; i < 4; i++) {
+      __m128i value = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(stripe + 16 * i));
+      __m128i keyed = _mm_xor_si128(
+          value,
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + 16 * i)));
+      __m128i product = _mm_mul_epu32(
+          keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+      __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+      sums[i] = _mm_add_epi64(product, _mm_add_epi64(sums[i], swapped));
+    }
+  }
+  for (size_t i = 0; i < 4; i++)
+    _mm_storeu_si128(xacc + i, sums[i]);
+}
+
+void XXH3ScrambleSSE2(uint64_t* acc, const uint8_t* secret) {
+  __m128i* xacc = reinterpret_cast<__m128i*>(acc);
+  const __m128i prime = _mm_set1_epi32(static_cast<int>(kPrime32_1));
+  for (size_t i = 0; i < 4; i++) {
+    __m128i value = _mm_loadu_si128(xacc + i);
+    value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+    value = _mm_xor_si128(
+        value,
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + 16 * i)));
+    __m128i hi = _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1));
+    _mm_storeu_si128(
+        xacc + i,
+        _mm_add_epi64(_mm_mul_epu32(value, prime),
+                      _mm_slli_epi64(_mm_mul_epu32(hi, prime), 32)));
+  }
+}
+
+CHECKSUM_TARGET("avx2")
+void XXH3AccumulateAVX2(uint64_t* acc,
+                        const uint8_t* data,
+                        const uint8_t* secret,
+                        size_t stripes) {
+  __m256i* xacc = reinterpret_cast<__m256i*>(acc);
+  __m256i sums[2];
+  for (size_t i = 0; i < 2; i++)
+    sums[i] = _mm256_loadu_si256(xacc + i);
+  for (size_t n = 0; n < stripes; n++) {
+    const uint8_t* stripe = data + n * kXXH3StripeLength;
+    const uint8_t* key = secret + n * 8;
+    for (size_t i = 0; i < 2; i++) {
+      __m256i value = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(stripe + 32 * i));
+      __m256i keyed = _mm256_xor_si256(
+          value,
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + 32 * i)));
+      __m256i product = _mm256_mul_epu32(
+          keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+      __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+      sums[i] = _mm256_add_epi64(product, _mm256_add_epi64(sums[i], swapped));
+    }
+  }
+  for (size_t i = 0; i < 2; i++)
+    _mm256_storeu_si256(xacc + i, sums[i]);
+}
+
+CHECKSUM_TARGET("avx2")
+void XXH3ScrambleAVX2(uint64_t* acc, const uint8_t* secret) {
+  __m256i* xacc = reinterpret_cast<__m256i*>(acc);
+  const __m256i prime = _mm256_set1_epi32(static_cast<int>(kPrime32_1));
+  for (size_t i = 0; i < 2; i++) {
+    __m256i value = _mm256_loadu_si256(xacc + i);
+    value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+    value = _mm256_xor_si256(
+        value,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + 32 * i)));
+    __m256i hi = _mm256_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1));
+    _mm256_storeu_si256(
+        xacc + i,
+        _mm256_add_epi64(_mm256_mul_epu32(value, prime),
+                         _mm256_slli_epi64(_mm256_mul_epu32(hi, prime), 32)));
+  }
+}
+#endif  // defined(CHECKSUM_X64)
+
+#if defined(CHECKSUM_ARM64)
+// NEON is part of AArch64.
+void XXH3AccumulateNEON(uint64_t* acc,
+                        const uint8_t* data,
+                        const uint8_t* secret,
+                        size_t stripes) {
+  for (size_t n = 0; n < stripes; n++) {
+    const uint8_t* stripe = data + n * kXXH3StripeLength;
+    const uint8_t* key = secret + n * 8;
+    for (size_t i = 0; i < 4; i++) {
+      uint64x2_t value = vreinterpretq_u64_u8(vld1q_u8(stripe + 16 * i));
+      uint64x2_t keyed = veorq_u64(
+          value, vreinterpretq_u64_u8(vld1q_u8(key + 16 * i)));
+      uint64x2_t sum = vaddq_u64(vld1q_u64(acc + 2 * i),
+                                 vextq_u64(value, value, 1));
+      sum = vmlal_u32(sum, vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+      vst1q_u64(acc + 2 * i, sum);
+    }
+  }
+}
+
+void XXH3ScrambleNEON(uint64_t* acc, const uint8_t* secret) {
+  const uint32x2_t prime = vdup_n_u32(kPrime32_1);
+  for (size_t i = 0; i < 4; i++) {
+    uint64x2_t value = vld1q_u64(acc + 2 * i);
+    value = veorq_u64(value, vshrq_n_u64(value, 47));
+    value = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+    uint64x2_t hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+    vst1q_u64(acc + 2 * i, vmlal_u32(hi, vmovn_u64(value), prime));
+  }
+}
+#endif  // defined(CHECKSUM_ARM64)
+
+struct XXH3Kernel {
+  void (*accumulate)(uint64_t* acc,
+                     const uint8_t* data,
+                     const uint8_t* secret,
+                     size_t stripes);
+  void (*scramble)(uint64_t* acc, const uint8_t* secret);
+};
+
+XXH3Kernel GetXXH3Kernel() {
+#if defined(CHECKSUM_X64)
+  if (CPUHasAVX2())
+    return { XXH3AccumulateAVX2, XXH3ScrambleAVX2 };
+  return { XXH3AccumulateSSE2, XXH3ScrambleSSE2 };
+#elif defined(CHECKSUM_ARM64)
+  return { XXH3AccumulateNEON, XXH3ScrambleNEON };
+#else
+  return { XXH3AccumulatePortable, XXH3ScramblePortable };
+#endif
+}
+
+const XXH3Kernel& XXH3() {
+  static const XXH3Kernel kernel = GetXXH3Kernel();
+  return kernel;
+}
+
+// Accumulates stripes that continue a block of which *stripes_so_far
+// stripes have been accumulated already.
+void XXH3ConsumeStripes(uint64_t* acc,
+                        size_t* stripes_so_far,
+                        const uint8_t* data,
+                        size_t stripes) {
+  const XXH3Kernel& kernel = XXH3();
+  const uint8_t* secret = kXXH3Secret;
+  size_t done = *stripes_so_far;
+  if (kXXH3StripesPerBlock - done <= stripes) {
+    size_t to_end = kXXH3StripesPerBlock - done;
+    kernel.accumulate(acc, data, secret + done * 8, to_end);
+    kernel.scramble(acc, secret + kXXH3SecretSize - kXXH3StripeLength);
+    kernel.accumulate(acc, data + to_end * kXXH3StripeLength, secret,
+                      stripes - to_end);
+    *stripes_so_far = stripes - to_end;
+  } else {
+    kernel.accumulate(acc, data, secret + done * 8, stripes);
+    *stripes_so_far = done + stripes;
+  }
+}
+
+uint64_t XXH3MergeAccumulators(const uint64_t* acc, uint64_t total_length) {
+  const uint8_t* secret = kXXH3Secret + 11;
+  uint64_t result = total_length * kPrime64_1;
+  for (size_t i = 0; i < 4; i++) {
+    result += Multiply128Fold64(acc[2 * i] ^ ReadLE64(secret + 16 * i),
+                                acc[2 * i + 1] ^
+                                    ReadLE64(secret + 16 * i + 8));
+  }
+  return XXH3Avalanche(result);
+}
+
+// Accumulates the last stripe, which ends with the last byte of the input
+// and may overlap with stripes that have been accumulated already.
+void XXH3AccumulateLastStripe(uint64_t* acc, const uint8_t* stripe) {
+  XXH3().accumulate(
+      acc, stripe, kXXH3Secret + kXXH3SecretSize - kXXH3StripeLength - 7, 1);
+}
+
+uint64_t XXH3Long(const uint8_t* data, size_t len) {
+  const XXH3Kernel& kernel = XXH3();
+  alignas(32) uint64_t acc[8];
+  memcpy(acc, kXXH3InitialAccumulators, sizeof(acc));
+
+  size_t blocks = (len - 1) / kXXH3BlockLength;
+  for (size_t n = 0; n < blocks; n++) {
+    kernel.accumulate(acc, data + n * kXXH3BlockLength, kXXH3Secret,
+                      kXXH3StripesPerBlock);
+    kernel.scramble(acc, kXXH3Secret + kXXH3SecretSize - kXXH3StripeLength);
+  }
+  size_t stripes =
+      ((len - 1) - blocks * kXXH3BlockLength) / kXXH3StripeLength;
+  kernel.accumulate(acc, data + blocks * kXXH3BlockLength, kXXH3Secret,
+                    stripes);
+  XXH3AccumulateLastStripe(acc, data + len - kXXH3StripeLength);
+  return XXH3MergeAccumulators(acc, len);
+}
+
+uint64_t XXH3OneShot(const uint8_t* data, size_t len) {
+  if (len <= 16)
+    return XXH3Short(data, len);
+  if (len <= kXXH3MidSizeMax)
+    return XXH3Medium(data, len);
+  return XXH3Long(data, len);
+}
+}  // anonymous namespace
+
+ChecksumState::ChecksumState(ChecksumAlgorithm algorithm)
+    : algorithm_(algorithm) {
+  switch (algorithm) {
+    case kChecksumXXH64:
+      acc_[0] = kPrime64_1 + kPrime64_2;
+      acc_[1] = kPrime64_2;
+      acc_[2] = 0;
+      acc_[3] = 0 - kPrime64_1;
+      break;
+    case kChecksumXXH3:
+      memcpy(acc_, kXXH3InitialAccumulators, sizeof(acc_));
+      break;
+    default:
+      break;
+  }
+}
+
+size_t ChecksumState::Length(ChecksumAlgorithm algorithm) {
+  return algorithm == kChecksumCRC32C ? 4 : 8;
+}
+
+void ChecksumState::Update(const uint8_t* data, size_t len) {
+  total_length_ += len;
+  switch (algorithm_) {
+    case kChecksumCRC32C:
+      crc_ = CRC32C(crc_, data, len);
+      return;
+
+    case kChecksumXXH64: {
+      if (buffered_ + len < kXXH64StripeLength) {
+        memcpy(buffer_ + buffered_, data, len);
+        buffered_ += len;
+        return;
+      }
+      if (buffered_ > 0) {
+        size_t fill = kXXH64StripeLength - buffered_;
+        memcpy(buffer_ + buffered_, data, fill);
+        XXH64Consume(acc_, buffer_);
+        data += fill;
+        len -= fill;
+        buffered_ = 0;
+      }
+      for (; len >= kXXH64StripeLength; len -= kXXH64StripeLength) {
+        XXH64Consume(acc_, data);
+        data += kXXH64StripeLength;
+      }
+      memcpy(buffer_, data, len);
+      buffered_ = len;
+      return;
+    }
+
+    case kChecksumXXH3: {
+      // Like the reference implementation, this keeps at least one byte in
+      // the buffer, so that Digest() can accumulate the last stripe, and
+      // keeps the last stripe that was consumed at the end of the buffer.
+      constexpr size_t kBufferStripes = kBufferSize / kXXH3StripeLength;
+      if (buffered_ + len <= kBufferSize) {
+        memcpy(buffer_ + buffered_, data, len);
+        buffered_ += len;
+        return;
+      }
+      if (buffered_ > 0) {
+        size_t fill = kBufferSize - buffered_;
+        memcpy(buffer_ + buffered_, data, fill);
+        XXH3ConsumeStripes(acc_, &stripes_, buffer_, kBufferStripes);
+        data += fill;
+        len -= fill;
+        buffered_ = 0;
+      }
+      if (len > kBufferSize) {
+        do {
+          XXH3ConsumeStripes(acc_, &stripes_, data, kBufferStripes);
+          data += kBufferSize;
+          len -= kBufferSize;
+        } while (len > kBufferSize);
+        memcpy(buffer_ + kBufferSize - kXXH3StripeLength,
+               data - kXXH3StripeLength,
+               kXXH3StripeLength);
+      }
+      memcpy(buffer_, data, len);
+      buffered_ = len;
+      return;
+    }
+  }
+}
+
+void ChecksumState::Digest(uint8_t* out) const {
+  uint64_t result = 0;
+  switch (algorithm_) {
+    case kChecksumCRC32C:
+      result = crc_;
+      break;
+
+    case kChecksumXXH64:
+      if (total_length_ >= kXXH64StripeLength) {
+        result = RotateLeft(acc_[0], 1) + RotateLeft(acc_[1], 7) +
+                 RotateLeft(acc_[2], 12) + RotateLeft(acc_[3], 18);
+        for (int i = 0; i < 4; i++)
+          result = XXH64MergeRound(result, acc_[i]);
+      } else {
+        result = kPrime64_5;
+      }
+      result = XXH64Finalize(result + total_length_, buffer_, buffered_);
+      break;
+
+    case kChecksumXXH3: {
+      if (total_length_ <= kXXH3MidSizeMax) {
+        result = XXH3OneShot(buffer_, buffered_);
+        break;
+      }
+      alignas(32) uint64_t acc[8];
+      memcpy(acc, acc_, sizeof(acc));
+      if (buffered_ >= kXXH3StripeLength) {
+        size_t stripes = (buffered_ - 1) / kXXH3StripeLength;
+        size_t stripes_so_far = stripes_;
+        XXH3ConsumeStripes(acc, &stripes_so_far, buffer_, stripes);
+        XXH3AccumulateLastStripe(acc,
+                                 buffer_ + buffered_ - kXXH3StripeLength);
+      } else {
+        // The last stripe starts in the input that has been consumed.
+        uint8_t stripe[kXXH3StripeLength];
+        size_t catchup = kXXH3StripeLength - buffered_;
+        memcpy(stripe, buffer_ + kBufferSize - catchup, catchup);
+        memcpy(stripe + catchup, buffer_, buffered_);
+        XXH3AccumulateLastStripe(acc, stripe);
+      }
+      result = XXH3MergeAccumulators(acc, total_length_);
+      break;
+    }
+  }
+  WriteBE(result, Length(), out);
+}
+
+namespace {
+// Computes the checksum of a string or an ArrayBufferView and returns it
+// with the given encoding.
+MaybeLocal<Value> ChecksumValue(Environment* env,
+                                ChecksumAlgorithm algorithm,
+                                Local<Value> input,
+                                enum encoding encoding) {
+  uint8_t checksum[8];
+  if (input->IsString()) {
+    Utf8Value data(env->isolate(), input);
+    ChecksumState state(algorithm);
+    state.Update(reinterpret_cast<const uint8_t*>(*data), data.length());
+    state.Digest(checksum);
+  } else {
+    ArrayBufferOrViewContents<uint8_t> data(input);
+    if (algorithm == kChecksumXXH3) {
+      // Avoids copying the input into the buffer of ChecksumState.
+      WriteBE(XXH3OneShot(data.data(), data.size()), 8, checksum);
+    } else {
+      ChecksumState state(algorithm);
+      state.Update(data.data(), data.size());
+      state.Digest(checksum);
+    }
+  }
+
+  Local<Value> error;
+  MaybeLocal<Value> rc =
+      StringBytes::Encode(env->isolate(),
+                          reinterpret_cast<const char*>(checksum),
+                          ChecksumState::Length(algorithm),
+                          encoding,
+                          &error);
+  if (rc.IsEmpty()) {
+    CHECK(!error.IsEmpty());
+    env->isolate()->ThrowException(error);
+  }
+  return rc;
+}
+
+ChecksumAlgorithm GetChecksumAlgorithm(Local<Value> value) {
+  CHECK(value->IsInt32());
+  int32_t algorithm = value.As<Int32>()->Value();
+  CHECK(algorithm >= kChecksumCRC32C && algorithm <= kChecksumXXH3);
+  return static_cast<ChecksumAlgorithm>(algorithm);
+}
+}  // anonymous namespace
+
+Checksum::Checksum(Environment* env,
+                   Local<Object> wrap,
+                   const ChecksumState& state)
+    : BaseObject(env, wrap),
+      state_(state) {
+  MakeWeak();
+}
+
+void Checksum::MemoryInfo(MemoryTracker* tracker) const {}
+
+void Checksum::Initialize(Environment* env, Local<Object> target) {
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+
+  t->InstanceTemplate()->SetInternalFieldCount(
+      Checksum::kInternalFieldCount);
+  t->Inherit(BaseObject::GetConstructorTemplate(env));
+
+  env->SetProtoMethod(t, "update", Update);
+  env->SetProtoMethod(t, "digest", Digest);
+
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "Checksum"),
+              t->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  env->SetMethodNoSideEffect(target, "oneShotChecksum", OneShot);
+  env->SetMethodNoSideEffect(target, "oneShotChecksumBatch", OneShotBatch);
+
+  ChecksumBatchJob::Initialize(env, target);
+
+#define V(name) NODE_DEFINE_CONSTANT(target, kChecksum ## name);
+  CHECKSUM_ALGORITHMS(V)
+#undef V
+}
+
+// new Checksum(algorithm) or new Checksum(checksum), which copies the state
+// of another Checksum.
+void Checksum::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  if (args[0]->IsObject()) {
+    Checksum* orig;
+    ASSIGN_OR_RETURN_UNWRAP(&orig, args[0].As<Object>());
+    new Checksum(env, args.This(), orig->state_);
+  } else {
+    new Checksum(env, args.This(),
+                 ChecksumState(GetChecksumAlgorithm(args[0])));
+  }
+}
+
+void Checksum::Update(const FunctionCallbackInfo<Value>& args) {
+  Decode<Checksum>(args, [](Checksum* checksum,
+                            const FunctionCallbackInfo<Value>& args,
+                            const char* data, size_t size) {
+    checksum->state_.Update(reinterpret_cast<const uint8_t*>(data), size);
+    args.GetReturnValue().Set(true);
+  });
+}
+
+void Checksum::Digest(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Checksum* checksum;
+  ASSIGN_OR_RETURN_UNWRAP(&checksum, args.Holder());
+
+  enum encoding encoding = BUFFER;
+  if (args.Length() >= 1)
+    encoding = ParseEncoding(env->isolate(), args[0], BUFFER);
+
+  uint8_t value[8];
+  checksum->state_.Digest(value);
+
+  Local<Value> error;
+  MaybeLocal<Value> rc =
+      StringBytes::Encode(env->isolate(),
+                          reinterpret_cast<const char*>(value),
+                          checksum->state_.Length(),
+                          encoding,
+                          &error);
+  if (rc.IsEmpty()) {
+    CHECK(!error.IsEmpty());
+    env->isolate()->ThrowException(error);
+    return;
+  }
+  args.GetReturnValue().Set(rc.ToLocalChecked());
+}
+
+// Like Hash::OneShotDigest(), but for a checksum algorithm.
+void Checksum::OneShot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ChecksumAlgorithm algorithm = GetChecksumAlgorithm(args[0]);
+  CHECK(args[1]->IsString() || args[1]->IsArrayBufferView());
+  enum encoding encoding = ParseEncoding(env->isolate(), args[2], BUFFER);
+
+  Local<Value> result;
+  if (ChecksumValue(env, algorithm, args[1], encoding).ToLocal(&result))
+    args.GetReturnValue().Set(result);
+}
+
+// Like Hash::OneShotDigestBatch(), but for a checksum algorithm.
+void Checksum::OneShotBatch(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+  ChecksumAlgorithm algorithm = GetChecksumAlgorithm(args[0]);
+  CHECK(args[1]->IsArray());
+  Local<Array> inputs = args[1].As<Array>();
+  enum encoding encoding = ParseEncoding(env->isolate(), args[2], BUFFER);
+
+  uint32_t length = inputs->Length();
+  Local<Array> results = Array::New(env->isolate(), length);
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> input;
+    Local<Value> result;
+    if (!inputs->Get(context, i).ToLocal(&input)) return;
+    if (UNLIKELY(!input->IsString() && !input->IsArrayBufferView()))
+      return THROW_ERR_INVALID_ARG_TYPE(env, "Invalid input");
+    if (!ChecksumValue(env, algorithm, input, encoding).ToLocal(&result) ||
+        results->Set(context, i, result).IsNothing()) {
+      return;
+    }
+  }
+  args.GetReturnValue().Set(results);
+}
+
+ChecksumConfig::ChecksumConfig(ChecksumConfig&& other) noexcept
+    : mode(other.mode),
+      algorithm(other.algorithm),
+      in(std::move(other.in)) {}
+
+ChecksumConfig& ChecksumConfig::operator=(ChecksumConfig&& other) noexcept {
+  if (&other == this) return *this;
+  this->~ChecksumConfig();
+  return *new (this) ChecksumConfig(std::move(other));
+}
+
+void ChecksumConfig::MemoryInfo(MemoryTracker* tracker) const {
+  // If the Job is sync, then the ChecksumConfig does not own the data.
+  if (mode == kCryptoJobAsync)
+    tracker->TrackFieldWithSize("in", in.size());
+}
+
+Maybe<bool> ChecksumTraits::AdditionalBatchConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    std::vector<ChecksumConfig>* params) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+
+  ChecksumAlgorithm algorithm = GetChecksumAlgorithm(args[offset]);
+  CHECK(args[offset + 1]->IsArray());  // Inputs
+
+  Local<Array> inputs = args[offset + 1].As<Array>();
+  params->resize(inputs->Length());
+  for (uint32_t i = 0; i < inputs->Length(); i++) {
+    Local<Value> input;
+    if (!inputs->Get(context, i).ToLocal(&input))
+      return Nothing<bool>();
+    if (UNLIKELY(!input->IsArrayBufferView())) {
+      THROW_ERR_INVALID_ARG_TYPE(env, "Invalid input");
+      return Nothing<bool>();
+    }
+    ArrayBufferOrViewContents<char> data(input);
+    ChecksumConfig* config = &(*params)[i];
+    config->mode = mode;
+    config->algorithm = algorithm;
+    config->in = mode == kCryptoJobAsync
+        ? data.ToCopy()
+        : data.ToByteSource();
+  }
+
+  return Just(true);
+}
+
+bool ChecksumTraits::DeriveBits(
+    Environment* env,
+    const ChecksumConfig& params,
+    ByteSource* out) {
+  size_t length = ChecksumState::Length(params.algorithm);
+  char* data = MallocOpenSSL<char>(length);
+  const uint8_t* in = params.in.data<uint8_t>();
+  if (params.algorithm == kChecksumXXH3) {
+    WriteBE(XXH3OneShot(in, params.in.size()), length,
+            reinterpret_cast<uint8_t*>(data));
+  } else {
+    ChecksumState state(params.algorithm);
+    state.Update(in, params.in.size());
+    state.Digest(reinterpret_cast<uint8_t*>(data));
+  }
+  *out = ByteSource::Allocated(data, length);
+  return true;
+}
+
+Maybe<bool> ChecksumTraits::EncodeOutput(
+    Environment* env,
+    const ChecksumConfig& params,
+    ByteSource* out,
+    Local<Value>* result) {
+  *result = out->ToArrayBuffer(env);
+  return Just(!result->IsEmpty());
+}
+
+}  // namespace crypto
+}  // namespace node
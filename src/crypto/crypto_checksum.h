@@ -0,0 +1,135 @@
+#ifndef SRC_CRYPTO_CRYPTO_CHECKSUM_H_
+#define SRC_CRYPTO_CRYPTO_CHECKSUM_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "crypto/crypto_util.h"
+#include "base_object.h"
+#include "env.h"
+#include "memory_tracker.h"
+#include "v8.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace node {
+namespace crypto {
+
+// Non-cryptographic checksums. Unlike the digests in crypto_hash.h, these are
+// implemented here rather than by OpenSSL, and use the CRC32 and SIMD
+// instructions of the CPU when they are available.
+#define CHECKSUM_ALGORITHMS(V)                                                \
+  V(CRC32C)                                                                   \
+  V(XXH64)                                                                    \
+  V(XXH3)
+
+enum ChecksumAlgorithm {
+#define V(name) kChecksum ## name,
+  CHECKSUM_ALGORITHMS(V)
+#undef V
+};
+
+// The state of a checksum computation over any number of updates.
+class ChecksumState final {
+ public:
+  explicit ChecksumState(ChecksumAlgorithm algorithm);
+
+  ChecksumAlgorithm algorithm() const { return algorithm_; }
+
+  void Update(const uint8_t* data, size_t len);
+
+  // Writes the checksum in big-endian byte order to out, which must have
+  // room for Length() bytes. The state can still be updated afterwards.
+  void Digest(uint8_t* out) const;
+
+  size_t Length() const { return Length(algorithm_); }
+
+  static size_t Length(ChecksumAlgorithm algorithm);
+
+ private:
+  static constexpr size_t kBufferSize = 256;
+
+  ChecksumAlgorithm algorithm_;
+  uint64_t total_length_ = 0;
+  // The CRC32C checksum so far.
+  uint32_t crc_ = 0;
+  // The accumulators of XXH64 (4) and XXH3 (8), and the input that has not
+  // been consumed yet.
+  uint64_t acc_[8] = {};
+  uint8_t buffer_[kBufferSize];
+  size_t buffered_ = 0;
+  // The number of XXH3 stripes consumed since the last scramble.
+  size_t stripes_ = 0;
+};
+
+class Checksum final : public BaseObject {
+ public:
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(Checksum)
+  SET_SELF_SIZE(Checksum)
+
+  static void OneShot(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void OneShotBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+ protected:
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Update(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Digest(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  Checksum(Environment* env,
+           v8::Local<v8::Object> wrap,
+           const ChecksumState& state);
+
+ private:
+  ChecksumState state_;
+};
+
+struct ChecksumConfig final : public MemoryRetainer {
+  CryptoJobMode mode;
+  ChecksumAlgorithm algorithm;
+  ByteSource in;
+
+  ChecksumConfig() = default;
+
+  explicit ChecksumConfig(ChecksumConfig&& other) noexcept;
+
+  ChecksumConfig& operator=(ChecksumConfig&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(ChecksumConfig);
+  SET_SELF_SIZE(ChecksumConfig);
+};
+
+struct ChecksumTraits final {
+  using AdditionalParameters = ChecksumConfig;
+  static constexpr const char* BatchJobName = "ChecksumBatchJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_HASHREQUEST;
+
+  static v8::Maybe<bool> AdditionalBatchConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      std::vector<ChecksumConfig>* params);
+
+  static bool DeriveBits(
+      Environment* env,
+      const ChecksumConfig& params,
+      ByteSource* out);
+
+  static v8::Maybe<bool> EncodeOutput(
+      Environment* env,
+      const ChecksumConfig& params,
+      ByteSource* out,
+      v8::Local<v8::Value>* result);
+};
+
+using ChecksumBatchJob = DeriveBitsBatchJob<ChecksumTraits>;
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+#endif  // SRC_CRYPTO_CRYPTO_CHECKSUM_H_
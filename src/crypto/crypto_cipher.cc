@@ -18,6 +18,7 @@ using v8::HandleScope;
 using v8::Int32;
 using v8::Local;
 using v8::Object;
+using v8::TryCatch;
 using v8::Uint32;
 using v8::Value;
 
@@ -261,6 +262,9 @@ void CipherBase::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "initiv", InitIv);
   env->SetProtoMethod(t, "update", Update);
   env->SetProtoMethod(t, "final", Final);
+  env->SetProtoMethod(t, "updateInto", UpdateInto);
+  env->SetProtoMethod(t, "finalInto", FinalInto);
+  env->SetProtoMethod(t, "aead", AEAD);
   env->SetProtoMethod(t, "setAutoPadding", SetAutoPadding);
   env->SetProtoMethodNoSideEffect(t, "getAuthTag", GetAuthTag);
   env->SetProtoMethod(t, "setAuthTag", SetAuthTag);
@@ -714,10 +718,10 @@ void CipherBase::SetAAD(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(cipher->SetAAD(buf, plaintext_len));
 }
 
-CipherBase::UpdateResult CipherBase::Update(
+CipherBase::UpdateResult CipherBase::PrepareUpdate(
     const char* data,
     size_t len,
-    AllocatedBuffer* out) {
+    int* max_out_len) {
   if (!ctx_ || len > INT_MAX)
     return kErrorState;
   MarkPopErrorOnReturn mark_pop_error_on_return;
@@ -732,37 +736,68 @@ CipherBase::UpdateResult CipherBase::Update(
   if (kind_ == kDecipher && IsAuthenticatedMode())
     CHECK(MaybePassAuthTagToOpenSSL());
 
-  int buf_len = len + EVP_CIPHER_CTX_block_size(ctx_.get());
+  // EVP_CipherUpdate() writes at most len + block_size - 1 bytes when
+  // encrypting and len + block_size bytes when decrypting, unless the block
+  // size is 1, in which case it writes exactly len bytes.
+  const int block_size = EVP_CIPHER_CTX_block_size(ctx_.get());
+  *max_out_len = block_size == 1 ? len : len + block_size;
   // For key wrapping algorithms, get output size by calling
   // EVP_CipherUpdate() with null output.
   if (kind_ == kCipher && mode == EVP_CIPH_WRAP_MODE &&
       EVP_CipherUpdate(ctx_.get(),
                        nullptr,
-                       &buf_len,
+                       max_out_len,
                        reinterpret_cast<const unsigned char*>(data),
                        len) != 1) {
     return kErrorState;
   }
 
-  *out = AllocatedBuffer::AllocateManaged(env(), buf_len);
+  return kSuccess;
+}
+
+CipherBase::UpdateResult CipherBase::ProcessUpdate(
+    const char* data,
+    size_t len,
+    unsigned char* out,
+    int* out_len) {
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+
   int r = EVP_CipherUpdate(ctx_.get(),
-                           reinterpret_cast<unsigned char*>(out->data()),
-                           &buf_len,
+                           out,
+                           out_len,
                            reinterpret_cast<const unsigned char*>(data),
                            len);
 
-  CHECK_LE(static_cast<size_t>(buf_len), out->size());
-  out->Resize(buf_len);
-
   // When in CCM mode, EVP_CipherUpdate will fail if the authentication tag is
   // invalid. In that case, remember the error and throw in final().
-  if (!r && kind_ == kDecipher && mode == EVP_CIPH_CCM_MODE) {
+  if (!r && kind_ == kDecipher &&
+      EVP_CIPHER_CTX_mode(ctx_.get()) == EVP_CIPH_CCM_MODE) {
     pending_auth_failed_ = true;
     return kSuccess;
   }
   return r == 1 ? kSuccess : kErrorState;
 }
 
+CipherBase::UpdateResult CipherBase::Update(
+    const char* data,
+    size_t len,
+    AllocatedBuffer* out) {
+  int buf_len;
+  UpdateResult r = PrepareUpdate(data, len, &buf_len);
+  if (r != kSuccess)
+    return r;
+
+  *out = AllocatedBuffer::AllocateManaged(env(), buf_len);
+  r = ProcessUpdate(data,
+                    len,
+                    reinterpret_cast<unsigned char*>(out->data()),
+                    &buf_len);
+
+  CHECK_LE(static_cast<size_t>(buf_len), out->size());
+  out->Resize(buf_len);
+  return r;
+}
+
 void CipherBase::Update(const FunctionCallbackInfo<Value>& args) {
   Decode<CipherBase>(args, [](CipherBase* cipher,
                               const FunctionCallbackInfo<Value>& args,
@@ -803,16 +838,18 @@ void CipherBase::SetAutoPadding(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(b);  // Possibly report invalid state failure
 }
 
-bool CipherBase::Final(AllocatedBuffer* out) {
+int CipherBase::FinalOutputSize() const {
+  CHECK(ctx_);
+  const int block_size = EVP_CIPHER_CTX_block_size(ctx_.get());
+  return block_size == 1 ? 0 : block_size;
+}
+
+bool CipherBase::Final(unsigned char* out, int* out_len) {
   if (!ctx_)
     return false;
 
   const int mode = EVP_CIPHER_CTX_mode(ctx_.get());
 
-  *out = AllocatedBuffer::AllocateManaged(
-      env(),
-      static_cast<size_t>(EVP_CIPHER_CTX_block_size(ctx_.get())));
-
   if (kind_ == kDecipher && IsSupportedAuthenticatedMode(ctx_.get())) {
     MaybePassAuthTagToOpenSSL();
   }
@@ -822,17 +859,9 @@ bool CipherBase::Final(AllocatedBuffer* out) {
   bool ok;
   if (kind_ == kDecipher && mode == EVP_CIPH_CCM_MODE) {
     ok = !pending_auth_failed_;
-    *out = AllocatedBuffer::AllocateManaged(env(), 0);  // Empty buffer.
+    *out_len = 0;
   } else {
-    int out_len = out->size();
-    ok = EVP_CipherFinal_ex(ctx_.get(),
-                            reinterpret_cast<unsigned char*>(out->data()),
-                            &out_len) == 1;
-
-    if (out_len >= 0)
-      out->Resize(out_len);
-    else
-      *out = AllocatedBuffer();  // *out will not be used.
+    ok = EVP_CipherFinal_ex(ctx_.get(), out, out_len) == 1;
 
     if (ok && kind_ == kCipher && IsAuthenticatedMode()) {
       // In GCM mode, the authentication tag length can be specified in advance,
@@ -853,6 +882,25 @@ bool CipherBase::Final(AllocatedBuffer* out) {
   return ok;
 }
 
+bool CipherBase::Final(AllocatedBuffer* out) {
+  if (!ctx_)
+    return false;
+
+  *out = AllocatedBuffer::AllocateManaged(
+      env(),
+      static_cast<size_t>(EVP_CIPHER_CTX_block_size(ctx_.get())));
+
+  int out_len = out->size();
+  bool ok = Final(reinterpret_cast<unsigned char*>(out->data()), &out_len);
+
+  if (out_len >= 0)
+    out->Resize(out_len);
+  else
+    *out = AllocatedBuffer();  // *out will not be used.
+
+  return ok;
+}
+
 void CipherBase::Final(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -878,6 +926,216 @@ void CipherBase::Final(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(out.ToBuffer().FromMaybe(Local<Value>()));
 }
 
+void CipherBase::UpdateInto(const FunctionCallbackInfo<Value>& args) {
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.Holder());
+  Environment* env = cipher->env();
+
+  CHECK_EQ(args.Length(), 3);
+  ArrayBufferOrViewContents<char> data(args[0]);
+  SPREAD_BUFFER_ARG(args[1], output);
+  CHECK(args[2]->IsUint32());
+  const size_t offset = args[2].As<Uint32>()->Value();
+  CHECK_LE(offset, output_length);
+
+  if (UNLIKELY(!data.CheckSizeInt32()))
+    return THROW_ERR_OUT_OF_RANGE(env, "data is too long");
+
+  int out_len;
+  UpdateResult r = cipher->PrepareUpdate(data.data(), data.size(), &out_len);
+  if (r == kSuccess) {
+    if (static_cast<size_t>(out_len) > output_length - offset) {
+      return THROW_ERR_OUT_OF_RANGE(
+          env, "output must have room for the size of data plus one block");
+    }
+    r = cipher->ProcessUpdate(
+        data.data(),
+        data.size(),
+        reinterpret_cast<unsigned char*>(output_data + offset),
+        &out_len);
+  }
+
+  if (r != kSuccess) {
+    if (r == kErrorState) {
+      ThrowCryptoError(env, ERR_get_error(),
+                       "Trying to add data in unsupported state");
+    }
+    return;
+  }
+
+  args.GetReturnValue().Set(out_len);
+}
+
+void CipherBase::FinalInto(const FunctionCallbackInfo<Value>& args) {
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.Holder());
+  Environment* env = cipher->env();
+
+  CHECK_EQ(args.Length(), 2);
+  SPREAD_BUFFER_ARG(args[0], output);
+  CHECK(args[1]->IsUint32());
+  const size_t offset = args[1].As<Uint32>()->Value();
+  CHECK_LE(offset, output_length);
+
+  if (cipher->ctx_ == nullptr)
+    return THROW_ERR_CRYPTO_INVALID_STATE(env);
+
+  if (static_cast<size_t>(cipher->FinalOutputSize()) > output_length - offset)
+    return THROW_ERR_OUT_OF_RANGE(env, "output must have room for one block");
+
+  const bool is_auth_mode = cipher->IsAuthenticatedMode();
+  int out_len = 0;
+  if (!cipher->Final(reinterpret_cast<unsigned char*>(output_data + offset),
+                     &out_len)) {
+    const char* msg = is_auth_mode
+                          ? "Unsupported state or unable to authenticate data"
+                          : "Unsupported state";
+
+    return ThrowCryptoError(env, ERR_get_error(), msg);
+  }
+
+  args.GetReturnValue().Set(out_len);
+}
+
+// Encrypts or decrypts a whole message with an AEAD cipher in a single call,
+// reusing the CipherBase as a scratch context. The output is written to an
+// existing buffer, which may be the input itself. When encrypting, the
+// authentication tag is written directly after the ciphertext.
+//
+// Arguments: cipher, key, iv, authTagLength, input, aad or undefined,
+// output, outputOffset, and the authentication tag when decrypting.
+void CipherBase::AEAD(const FunctionCallbackInfo<Value>& args) {
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.Holder());
+  Environment* env = cipher->env();
+
+  CHECK_EQ(args.Length(), 9);
+  const Utf8Value cipher_type(env->isolate(), args[0]);
+  const ByteSource key_buf = ByteSource::FromSecretKeyBytes(env, args[1]);
+  ArrayBufferOrViewContents<unsigned char> iv_buf(args[2]);
+  CHECK(args[3]->IsUint32());
+  const unsigned int auth_tag_len = args[3].As<Uint32>()->Value();
+  ArrayBufferOrViewContents<char> input(args[4]);
+  SPREAD_BUFFER_ARG(args[6], output);
+  CHECK(args[7]->IsUint32());
+  const size_t offset = args[7].As<Uint32>()->Value();
+  CHECK_LE(offset, output_length);
+
+  if (UNLIKELY(key_buf.size() > INT_MAX))
+    return THROW_ERR_OUT_OF_RANGE(env, "key is too big");
+  if (UNLIKELY(!iv_buf.CheckSizeInt32()))
+    return THROW_ERR_OUT_OF_RANGE(env, "iv is too big");
+  if (UNLIKELY(!input.CheckSizeInt32()))
+    return THROW_ERR_OUT_OF_RANGE(env, "data is too long");
+
+  const EVP_CIPHER* const evp_cipher = EVP_get_cipherbyname(*cipher_type);
+  if (evp_cipher == nullptr)
+    return THROW_ERR_CRYPTO_UNKNOWN_CIPHER(env);
+  if (!IsSupportedAuthenticatedMode(evp_cipher)) {
+    return THROW_ERR_CRYPTO_UNSUPPORTED_OPERATION(
+        env, "The cipher is not an authenticated cipher");
+  }
+
+  // A previous call may have failed half-way through.
+  cipher->ctx_.reset();
+  cipher->auth_tag_state_ = kAuthTagUnknown;
+  cipher->auth_tag_len_ = kNoAuthTagLength;
+  cipher->pending_auth_failed_ = false;
+
+  {
+    // InitIv() reports invalid parameters only by throwing.
+    TryCatch try_catch(env->isolate());
+    cipher->InitIv(*cipher_type, key_buf, iv_buf, auth_tag_len);
+    if (try_catch.HasCaught()) {
+      try_catch.ReThrow();
+      return;
+    }
+  }
+  CHECK(cipher->ctx_);
+
+  if (cipher->kind_ == kDecipher) {
+    ArrayBufferOrViewContents<char> auth_tag(args[8]);
+    CHECK_EQ(auth_tag.size(), auth_tag_len);
+    CHECK_LE(auth_tag_len, sizeof(cipher->auth_tag_));
+    auth_tag.CopyTo(cipher->auth_tag_, auth_tag_len);
+    cipher->auth_tag_len_ = auth_tag_len;
+    cipher->auth_tag_state_ = kAuthTagKnown;
+  }
+
+  if (args[5]->IsArrayBufferView()) {
+    ArrayBufferOrViewContents<unsigned char> aad(args[5]);
+    if (UNLIKELY(!aad.CheckSizeInt32()))
+      return THROW_ERR_OUT_OF_RANGE(env, "aad is too big");
+    TryCatch try_catch(env->isolate());
+    if (!cipher->SetAAD(aad, input.size())) {
+      if (!try_catch.HasCaught())
+        THROW_ERR_CRYPTO_INVALID_STATE(env);
+      try_catch.ReThrow();
+      return;
+    }
+  }
+
+  unsigned char* const out =
+      reinterpret_cast<unsigned char*>(output_data + offset);
+  const size_t out_size = output_length - offset;
+  const size_t tag_size = cipher->kind_ == kCipher ? auth_tag_len : 0;
+
+  // Ciphers in OCB mode have a block size of 16, and update() may hold back
+  // the last partial block for final(). Their output is collected in a
+  // buffer that has room for everything update() and final() may write and
+  // then copied to the output. The other AEAD ciphers are stream ciphers and
+  // write directly to the output.
+  const int final_size = cipher->FinalOutputSize();
+  MaybeStackBuffer<unsigned char, 1024> scratch(0);
+
+  unsigned char* dest = out;
+  int out_len;
+  UpdateResult r = cipher->PrepareUpdate(input.data(), input.size(), &out_len);
+  if (r == kSuccess) {
+    if (input.size() + tag_size > out_size)
+      return THROW_ERR_OUT_OF_RANGE(env, "output is too small");
+    if (final_size > 0 || static_cast<size_t>(out_len) > out_size) {
+      scratch.AllocateSufficientStorage(out_len + final_size);
+      dest = scratch.out();
+    }
+    r = cipher->ProcessUpdate(input.data(), input.size(), dest, &out_len);
+  }
+  if (r != kSuccess) {
+    if (r == kErrorState) {
+      ThrowCryptoError(env, ERR_get_error(),
+                       "Trying to add data in unsupported state");
+    }
+    return;
+  }
+
+  int final_len = 0;
+  const bool ok = cipher->Final(dest + out_len, &final_len);
+  if (ok)
+    out_len += final_len;
+  if (!ok || out_len + tag_size > out_size) {
+    // Do not hand out plaintext that failed authentication.
+    OPENSSL_cleanse(dest, out_len);
+    if (!ok) {
+      return ThrowCryptoError(
+          env, ERR_get_error(),
+          "Unsupported state or unable to authenticate data");
+    }
+    return THROW_ERR_OUT_OF_RANGE(env, "output is too small");
+  }
+  if (dest != out) {
+    memcpy(out, dest, out_len);
+    OPENSSL_cleanse(dest, out_len);
+  }
+
+  if (cipher->kind_ == kCipher) {
+    CHECK_EQ(cipher->auth_tag_len_, auth_tag_len);
+    memcpy(out + out_len, cipher->auth_tag_, auth_tag_len);
+    out_len += auth_tag_len;
+  }
+
+  args.GetReturnValue().Set(out_len);
+}
+
 template <PublicKeyCipher::Operation operation,
           PublicKeyCipher::EVP_PKEY_cipher_init_t EVP_PKEY_cipher_init,
           PublicKeyCipher::EVP_PKEY_cipher_t EVP_PKEY_cipher>
@@ -60,7 +60,19 @@ class CipherBase : public BaseObject {
   bool InitAuthenticated(const char* cipher_type, int iv_len,
                          unsigned int auth_tag_len);
   bool CheckCCMMessageLength(int message_len);
+  // Validates the state and returns the maximum number of bytes that
+  // EVP_CipherUpdate() may write for |len| bytes of input in |max_out_len|.
+  UpdateResult PrepareUpdate(const char* data, size_t len, int* max_out_len);
+  // |out| must have room for the size returned by PrepareUpdate(). It may be
+  // equal to |data| but must not partially overlap with it.
+  UpdateResult ProcessUpdate(const char* data,
+                             size_t len,
+                             unsigned char* out,
+                             int* out_len);
   UpdateResult Update(const char* data, size_t len, AllocatedBuffer* out);
+  // |out| must have room for FinalOutputSize() bytes.
+  int FinalOutputSize() const;
+  bool Final(unsigned char* out, int* out_len);
   bool Final(AllocatedBuffer* out);
   bool SetAutoPadding(bool auto_padding);
 
@@ -75,6 +87,9 @@ class CipherBase : public BaseObject {
   static void InitIv(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Update(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Final(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void UpdateInto(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void FinalInto(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void AEAD(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetAutoPadding(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static void GetAuthTag(const v8::FunctionCallbackInfo<v8::Value>& args);
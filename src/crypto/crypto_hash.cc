@@ -12,6 +12,9 @@
 
 namespace node {
 
+using v8::Array;
+using v8::Context;
+using v8::External;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Just;
@@ -21,9 +24,58 @@ using v8::MaybeLocal;
 using v8::Nothing;
 using v8::Object;
 using v8::Uint32;
+using v8::Undefined;
 using v8::Value;
 
 namespace crypto {
+namespace {
+// Reused by all one-shot digests on the current thread, so that they do not
+// have to allocate a new context.
+EVP_MD_CTX* GetOneShotContext() {
+  static thread_local EVPMDPointer ctx(EVP_MD_CTX_new());
+  return ctx.get();
+}
+
+MaybeLocal<Value> OneShotDigestValue(Environment* env,
+                                     const EVP_MD* md,
+                                     Local<Value> input,
+                                     enum encoding encoding) {
+  unsigned char md_value[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  EVP_MD_CTX* ctx = GetOneShotContext();
+  if (ctx == nullptr || EVP_DigestInit_ex(ctx, md, nullptr) <= 0) {
+    ThrowCryptoError(env, ERR_get_error(), "Digest method not supported");
+    return MaybeLocal<Value>();
+  }
+
+  if (input->IsString()) {
+    Utf8Value data(env->isolate(), input);
+    EVP_DigestUpdate(ctx, *data, data.length());
+  } else {
+    ArrayBufferOrViewContents<char> data(input);
+    EVP_DigestUpdate(ctx, data.data(), data.size());
+  }
+
+  if (EVP_DigestFinal_ex(ctx, md_value, &md_len) != 1) {
+    ThrowCryptoError(env, ERR_get_error());
+    return MaybeLocal<Value>();
+  }
+
+  Local<Value> error;
+  MaybeLocal<Value> rc =
+      StringBytes::Encode(env->isolate(),
+                          reinterpret_cast<const char*>(md_value),
+                          md_len,
+                          encoding,
+                          &error);
+  if (rc.IsEmpty()) {
+    CHECK(!error.IsEmpty());
+    env->isolate()->ThrowException(error);
+  }
+  return rc;
+}
+}  // anonymous namespace
+
 Hash::Hash(Environment* env, Local<Object> wrap) : BaseObject(env, wrap) {
   MakeWeak();
 }
@@ -40,6 +92,62 @@ void Hash::GetHashes(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(ctx.ToJSArray());
 }
 
+// Returns the EVP_MD of the digest, which is never freed by OpenSSL, so that
+// it can be cached in JavaScript and passed to OneShotDigest() instead of
+// looking it up by name every time.
+void Hash::GetCachedMD(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());
+  const Utf8Value name(env->isolate(), args[0]);
+  const EVP_MD* md = EVP_get_digestbyname(*name);
+  if (md == nullptr) return;
+  args.GetReturnValue().Set(
+      External::New(env->isolate(), const_cast<EVP_MD*>(md)));
+}
+
+// Computes the digest of a string or an ArrayBufferView without creating a
+// Hash object, and returns it with the given encoding.
+void Hash::OneShotDigest(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsExternal());
+  CHECK(args[1]->IsString() || args[1]->IsArrayBufferView());
+  const EVP_MD* md = static_cast<EVP_MD*>(args[0].As<External>()->Value());
+  enum encoding encoding = ParseEncoding(env->isolate(), args[2], BUFFER);
+
+  Local<Value> result;
+  if (OneShotDigestValue(env, md, args[1], encoding).ToLocal(&result))
+    args.GetReturnValue().Set(result);
+}
+
+// Like OneShotDigest(), but for an array of inputs. Returns an array of the
+// digests in the same order.
+void Hash::OneShotDigestBatch(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+  CHECK(args[0]->IsExternal());
+  CHECK(args[1]->IsArray());
+  const EVP_MD* md = static_cast<EVP_MD*>(args[0].As<External>()->Value());
+  Local<Array> inputs = args[1].As<Array>();
+  enum encoding encoding = ParseEncoding(env->isolate(), args[2], BUFFER);
+
+  uint32_t length = inputs->Length();
+  Local<Array> results = Array::New(env->isolate(), length);
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> input;
+    Local<Value> result;
+    if (!inputs->Get(context, i).ToLocal(&input)) return;
+    // The inputs have been validated in JavaScript, but accessors on the
+    // array could have replaced them since then.
+    if (UNLIKELY(!input->IsString() && !input->IsArrayBufferView()))
+      return THROW_ERR_INVALID_ARG_TYPE(env, "Invalid input");
+    if (!OneShotDigestValue(env, md, input, encoding).ToLocal(&result) ||
+        results->Set(context, i, result).IsNothing()) {
+      return;
+    }
+  }
+  args.GetReturnValue().Set(results);
+}
+
 void Hash::Initialize(Environment* env, Local<Object> target) {
   Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
 
@@ -55,8 +163,13 @@ void Hash::Initialize(Environment* env, Local<Object> target) {
               t->GetFunction(env->context()).ToLocalChecked()).Check();
 
   env->SetMethodNoSideEffect(target, "getHashes", GetHashes);
+  env->SetMethodNoSideEffect(target, "getCachedMD", GetCachedMD);
+  env->SetMethodNoSideEffect(target, "oneShotDigest", OneShotDigest);
+  env->SetMethodNoSideEffect(target, "oneShotDigestBatch", OneShotDigestBatch);
 
   HashJob::Initialize(env, target);
+  HashBatchJob::Initialize(env, target);
+  HashStreamJob::Initialize(env, target);
 }
 
 void Hash::New(const FunctionCallbackInfo<Value>& args) {
@@ -119,36 +232,15 @@ bool Hash::HashUpdate(const char* data, size_t len) {
   return true;
 }
 
-void Hash::HashUpdate(const FunctionCallbackInfo<Value>& args) {
-  Decode<Hash>(args, [](Hash* hash, const FunctionCallbackInfo<Value>& args,
-                        const char* data, size_t size) {
-    Environment* env = Environment::GetCurrent(args);
-    if (UNLIKELY(size > INT_MAX))
-      return THROW_ERR_OUT_OF_RANGE(env, "data is too long");
-    bool r = hash->HashUpdate(data, size);
-    args.GetReturnValue().Set(r);
-  });
-}
-
-void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-
-  Hash* hash;
-  ASSIGN_OR_RETURN_UNWRAP(&hash, args.Holder());
-
-  enum encoding encoding = BUFFER;
-  if (args.Length() >= 1) {
-    encoding = ParseEncoding(env->isolate(), args[0], BUFFER);
-  }
-
-  unsigned int len = hash->md_len_;
+bool Hash::HashFinal() {
+  unsigned int len = md_len_;
 
   // TODO(tniessen): SHA3_squeeze does not work for zero-length outputs on all
   // platforms and will cause a segmentation fault if called. This workaround
   // causes hash.digest() to correctly return an empty buffer / string.
   // See https://github.com/openssl/openssl/issues/9431.
 
-  if (!hash->digest_ && len > 0) {
+  if (!digest_ && len > 0) {
     // Some hash algorithms such as SHA3 do not support calling
     // EVP_DigestFinal_ex more than once, however, Hash._flush
     // and Hash.digest can both be used to retrieve the digest,
@@ -158,33 +250,61 @@ void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
     char* md_value = MallocOpenSSL<char>(len);
     ByteSource digest = ByteSource::Allocated(md_value, len);
 
-    size_t default_len = EVP_MD_CTX_size(hash->mdctx_.get());
+    size_t default_len = EVP_MD_CTX_size(mdctx_.get());
     int ret;
     if (len == default_len) {
       ret = EVP_DigestFinal_ex(
-          hash->mdctx_.get(),
+          mdctx_.get(),
           reinterpret_cast<unsigned char*>(md_value),
           &len);
-      // The output length should always equal hash->md_len_
-      CHECK_EQ(len, hash->md_len_);
+      // The output length should always equal md_len_
+      CHECK_EQ(len, md_len_);
     } else {
       ret = EVP_DigestFinalXOF(
-          hash->mdctx_.get(),
+          mdctx_.get(),
           reinterpret_cast<unsigned char*>(md_value),
           len);
     }
 
     if (ret != 1)
-      return ThrowCryptoError(env, ERR_get_error());
+      return false;
+
+    digest_ = std::move(digest);
+  }
+
+  return true;
+}
+
+void Hash::HashUpdate(const FunctionCallbackInfo<Value>& args) {
+  Decode<Hash>(args, [](Hash* hash, const FunctionCallbackInfo<Value>& args,
+                        const char* data, size_t size) {
+    Environment* env = Environment::GetCurrent(args);
+    if (UNLIKELY(size > INT_MAX))
+      return THROW_ERR_OUT_OF_RANGE(env, "data is too long");
+    bool r = hash->HashUpdate(data, size);
+    args.GetReturnValue().Set(r);
+  });
+}
 
-    hash->digest_ = std::move(digest);
+void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Hash* hash;
+  ASSIGN_OR_RETURN_UNWRAP(&hash, args.Holder());
+
+  enum encoding encoding = BUFFER;
+  if (args.Length() >= 1) {
+    encoding = ParseEncoding(env->isolate(), args[0], BUFFER);
   }
 
+  if (!hash->HashFinal())
+    return ThrowCryptoError(env, ERR_get_error());
+
   Local<Value> error;
   MaybeLocal<Value> rc =
       StringBytes::Encode(env->isolate(),
                           hash->digest_.get(),
-                          len,
+                          hash->md_len_,
                           encoding,
                           &error);
   if (rc.IsEmpty()) {
@@ -268,6 +388,52 @@ Maybe<bool> HashTraits::AdditionalConfig(
   return Just(true);
 }
 
+Maybe<bool> HashTraits::AdditionalBatchConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    std::vector<HashConfig>* params) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+
+  CHECK(args[offset]->IsString());  // Hash algorithm
+  CHECK(args[offset + 1]->IsArray());  // Inputs
+
+  Utf8Value name(env->isolate(), args[offset]);
+  const EVP_MD* digest = EVP_get_digestbyname(*name);
+  if (UNLIKELY(digest == nullptr)) {
+    THROW_ERR_CRYPTO_INVALID_DIGEST(env);
+    return Nothing<bool>();
+  }
+
+  Local<Array> inputs = args[offset + 1].As<Array>();
+  params->resize(inputs->Length());
+  for (uint32_t i = 0; i < inputs->Length(); i++) {
+    Local<Value> input;
+    if (!inputs->Get(context, i).ToLocal(&input))
+      return Nothing<bool>();
+    if (UNLIKELY(!input->IsArrayBufferView())) {
+      THROW_ERR_INVALID_ARG_TYPE(env, "Invalid input");
+      return Nothing<bool>();
+    }
+    ArrayBufferOrViewContents<char> data(input);
+    if (UNLIKELY(!data.CheckSizeInt32())) {
+      THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+      return Nothing<bool>();
+    }
+
+    HashConfig* config = &(*params)[i];
+    config->mode = mode;
+    config->digest = digest;
+    config->length = EVP_MD_size(digest);
+    config->in = mode == kCryptoJobAsync
+        ? data.ToCopy()
+        : data.ToByteSource();
+  }
+
+  return Just(true);
+}
+
 bool HashTraits::DeriveBits(
     Environment* env,
     const HashConfig& params,
@@ -304,5 +470,81 @@ bool HashTraits::DeriveBits(
   return true;
 }
 
+HashStreamConfig::HashStreamConfig(HashStreamConfig&& other) noexcept
+    : hash(std::move(other.hash)),
+      in(std::move(other.in)),
+      final(other.final) {}
+
+HashStreamConfig& HashStreamConfig::operator=(
+    HashStreamConfig&& other) noexcept {
+  if (&other == this) return *this;
+  this->~HashStreamConfig();
+  return *new (this) HashStreamConfig(std::move(other));
+}
+
+void HashStreamConfig::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("hash", hash);
+  tracker->TrackFieldWithSize("in", in.size());
+}
+
+Maybe<bool> HashStreamTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    HashStreamConfig* params) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Hash* hash;
+  CHECK(args[offset]->IsObject());  // Hash
+  ASSIGN_OR_RETURN_UNWRAP(&hash, args[offset], Nothing<bool>());
+  params->hash.reset(hash);
+
+  ArrayBufferOrViewContents<char> in(args[offset + 1]);
+  if (UNLIKELY(!in.CheckSizeInt32())) {
+    THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+    return Nothing<bool>();
+  }
+  params->in = in.ToCopy();
+
+  CHECK(args[offset + 2]->IsBoolean());  // Final
+  params->final = args[offset + 2]->IsTrue();
+
+  return Just(true);
+}
+
+bool HashStreamTraits::DeriveBits(
+    Environment* env,
+    const HashStreamConfig& params,
+    ByteSource* out) {
+  Hash* hash = params.hash.get();
+  if (!hash->HashUpdate(params.in.get(), params.in.size()))
+    return false;
+  if (!params.final)
+    return true;
+
+  if (!hash->HashFinal())
+    return false;
+  unsigned int len = hash->digest_length();
+  if (len > 0) {
+    char* data = MallocOpenSSL<char>(len);
+    memcpy(data, hash->digest().get(), len);
+    *out = ByteSource::Allocated(data, len);
+  }
+  return true;
+}
+
+Maybe<bool> HashStreamTraits::EncodeOutput(
+    Environment* env,
+    const HashStreamConfig& params,
+    ByteSource* out,
+    v8::Local<v8::Value>* result) {
+  if (!params.final) {
+    *result = Undefined(env->isolate());
+    return Just(true);
+  }
+  *result = out->ToArrayBuffer(env);
+  return Just(!result->IsEmpty());
+}
+
 }  // namespace crypto
 }  // namespace node
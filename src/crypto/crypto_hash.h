@@ -23,8 +23,18 @@ class Hash final : public BaseObject {
 
   bool HashInit(const EVP_MD* md, v8::Maybe<unsigned int> xof_md_len);
   bool HashUpdate(const char* data, size_t len);
+  // Computes the digest, unless that has already been done. Does not use V8,
+  // so that it can run in the thread pool.
+  bool HashFinal();
+
+  const ByteSource& digest() const { return digest_; }
+  unsigned int digest_length() const { return md_len_; }
 
   static void GetHashes(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetCachedMD(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void OneShotDigest(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void OneShotDigestBatch(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
  protected:
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -59,6 +69,7 @@ struct HashConfig final : public MemoryRetainer {
 struct HashTraits final {
   using AdditionalParameters = HashConfig;
   static constexpr const char* JobName = "HashJob";
+  static constexpr const char* BatchJobName = "HashBatchJob";
   static constexpr AsyncWrap::ProviderType Provider =
       AsyncWrap::PROVIDER_HASHREQUEST;
 
@@ -68,6 +79,12 @@ struct HashTraits final {
       unsigned int offset,
       HashConfig* params);
 
+  static v8::Maybe<bool> AdditionalBatchConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      std::vector<HashConfig>* params);
+
   static bool DeriveBits(
       Environment* env,
       const HashConfig& params,
@@ -81,6 +98,52 @@ struct HashTraits final {
 };
 
 using HashJob = DeriveBitsJob<HashTraits>;
+using HashBatchJob = DeriveBitsBatchJob<HashTraits>;
+
+// Feeds one chunk of a streaming digest into a Hash object in the thread
+// pool, and computes the digest after the last chunk. Like other async jobs,
+// it works on a copy of the chunk.
+struct HashStreamConfig final : public MemoryRetainer {
+  BaseObjectPtr<Hash> hash;
+  ByteSource in;
+  bool final = false;
+
+  HashStreamConfig() = default;
+
+  explicit HashStreamConfig(HashStreamConfig&& other) noexcept;
+
+  HashStreamConfig& operator=(HashStreamConfig&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(HashStreamConfig);
+  SET_SELF_SIZE(HashStreamConfig);
+};
+
+struct HashStreamTraits final {
+  using AdditionalParameters = HashStreamConfig;
+  static constexpr const char* JobName = "HashStreamJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_HASHREQUEST;
+
+  static v8::Maybe<bool> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      HashStreamConfig* params);
+
+  static bool DeriveBits(
+      Environment* env,
+      const HashStreamConfig& params,
+      ByteSource* out);
+
+  static v8::Maybe<bool> EncodeOutput(
+      Environment* env,
+      const HashStreamConfig& params,
+      ByteSource* out,
+      v8::Local<v8::Value>* result);
+};
+
+using HashStreamJob = DeriveBitsJob<HashStreamTraits>;
 
 }  // namespace crypto
 }  // namespace node
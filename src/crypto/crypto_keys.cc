@@ -16,10 +16,16 @@
 #include "util-inl.h"
 #include "v8.h"
 
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
 namespace node {
 
 using v8::Array;
 using v8::Context;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -546,6 +552,142 @@ Maybe<bool> GetAsymmetricKeyDetail(
   THROW_ERR_CRYPTO_INVALID_KEYTYPE(env);
   return Nothing<bool>();
 }
+
+// Parsing an encoded key is expensive, and many applications pass the same
+// PEM string to crypto.sign() and similar functions on every call. Keys that
+// were parsed successfully are therefore kept in a small process-wide LRU
+// cache. Entries are identified by a SHA-256 digest of the encoded key, its
+// encoding and the passphrase, so that neither of them is retained. The
+// cached EVP_PKEYs are never modified and are shared between threads through
+// OpenSSL's reference counting, like the keys of transferred KeyObjects.
+class ParsedKeyCache {
+ public:
+  enum Kind : int32_t {
+    kPrivateKey,
+    kPublicOrPrivateKey
+  };
+
+  static constexpr size_t kCapacity = 128;
+
+  static ParsedKeyCache* GetInstance() {
+    static ParsedKeyCache* instance = new ParsedKeyCache();
+    return instance;
+  }
+
+  // Returns an empty string if the digest cannot be computed, in which case
+  // the key is not cached.
+  static std::string GetId(Kind kind,
+                           const PrivateKeyEncodingConfig& config,
+                           const char* data,
+                           size_t size) {
+    const ByteSource* passphrase = config.passphrase_.get();
+    const int32_t header[] = {
+      kind,
+      config.format_,
+      config.type_.IsJust() ? config.type_.FromJust() : -1,
+      passphrase == nullptr ? -1 : static_cast<int32_t>(passphrase->size())
+    };
+
+    EVPMDPointer ctx(EVP_MD_CTX_new());
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int md_len;
+    if (!ctx ||
+        EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr) != 1 ||
+        EVP_DigestUpdate(ctx.get(), header, sizeof(header)) != 1 ||
+        (passphrase != nullptr &&
+         EVP_DigestUpdate(ctx.get(),
+                          passphrase->get(),
+                          passphrase->size()) != 1) ||
+        EVP_DigestUpdate(ctx.get(), data, size) != 1 ||
+        EVP_DigestFinal_ex(ctx.get(), md, &md_len) != 1) {
+      return std::string();
+    }
+    return std::string(reinterpret_cast<const char*>(md), md_len);
+  }
+
+  ManagedEVPPKey Lookup(const std::string& id) {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+      misses_++;
+      return ManagedEVPPKey();
+    }
+    hits_++;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  void Insert(const std::string& id, const ManagedEVPPKey& pkey) {
+    Mutex::ScopedLock lock(mutex_);
+    if (index_.find(id) != index_.end())
+      return;
+    entries_.emplace_front(id, pkey);
+    index_[id] = entries_.begin();
+    if (entries_.size() > kCapacity) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+      evictions_++;
+    }
+  }
+
+  void GetStatistics(double* fields) {
+    Mutex::ScopedLock lock(mutex_);
+    fields[0] = static_cast<double>(hits_);
+    fields[1] = static_cast<double>(misses_);
+    fields[2] = static_cast<double>(evictions_);
+    fields[3] = static_cast<double>(entries_.size());
+    fields[4] = static_cast<double>(kCapacity);
+  }
+
+ private:
+  ParsedKeyCache() = default;
+
+  using Entry = std::pair<std::string, ManagedEVPPKey>;
+
+  Mutex mutex_;
+  // The most recently used entry comes first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+};
+
+// Parses a key that was passed as a string or buffer, using the cache.
+template <typename ParseFunction>
+ManagedEVPPKey GetCachedParsedKey(Environment* env,
+                                  ParsedKeyCache::Kind kind,
+                                  const PrivateKeyEncodingConfig& config,
+                                  const char* data,
+                                  size_t size,
+                                  const char* default_msg,
+                                  ParseFunction parse) {
+  ParsedKeyCache* cache = ParsedKeyCache::GetInstance();
+  const std::string id = ParsedKeyCache::GetId(kind, config, data, size);
+  if (!id.empty()) {
+    ManagedEVPPKey cached = cache->Lookup(id);
+    if (cached)
+      return cached;
+  }
+
+  EVPKeyPointer pkey;
+  ParseKeyResult ret = parse(&pkey);
+  ManagedEVPPKey key =
+      ManagedEVPPKey::GetParsedKey(env, std::move(pkey), ret, default_msg);
+  if (key && !id.empty())
+    cache->Insert(id, key);
+  return key;
+}
+
+void GetKeyCacheStatistics(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 5);
+  double* fields = static_cast<double*>(
+      array->Buffer()->GetBackingStore()->Data());
+  ParsedKeyCache::GetInstance()->GetStatistics(fields + array->ByteOffset() /
+                                               sizeof(double));
+}
 }  // namespace
 
 ManagedEVPPKey::ManagedEVPPKey(EVPKeyPointer&& pkey) : pkey_(std::move(pkey)) {}
@@ -686,16 +828,17 @@ ManagedEVPPKey ManagedEVPPKey::GetPrivateKeyFromJs(
   if (args[*offset]->IsString() || IsAnyByteSource(args[*offset])) {
     Environment* env = Environment::GetCurrent(args);
     ByteSource key = ByteSource::FromStringOrBuffer(env, args[(*offset)++]);
-    NonCopyableMaybe<PrivateKeyEncodingConfig> config =
+    NonCopyableMaybe<PrivateKeyEncodingConfig> config_ =
         GetPrivateKeyEncodingFromJs(args, offset, kKeyContextInput);
-    if (config.IsEmpty())
+    if (config_.IsEmpty())
       return ManagedEVPPKey();
 
-    EVPKeyPointer pkey;
-    ParseKeyResult ret =
-        ParsePrivateKey(&pkey, config.Release(), key.get(), key.size());
-    return GetParsedKey(env, std::move(pkey), ret,
-                        "Failed to read private key");
+    const PrivateKeyEncodingConfig config = config_.Release();
+    return GetCachedParsedKey(
+        env, ParsedKeyCache::kPrivateKey, config, key.get(), key.size(),
+        "Failed to read private key", [&](EVPKeyPointer* pkey) {
+          return ParsePrivateKey(pkey, config, key.get(), key.size());
+        });
   } else {
     CHECK(args[*offset]->IsObject() && allow_key_object);
     KeyObjectHandle* key;
@@ -721,45 +864,50 @@ ManagedEVPPKey ManagedEVPPKey::GetPublicOrPrivateKeyFromJs(
     if (config_.IsEmpty())
       return ManagedEVPPKey();
 
-    ParseKeyResult ret;
-    PrivateKeyEncodingConfig config = config_.Release();
-    EVPKeyPointer pkey;
-    if (config.format_ == kKeyFormatPEM) {
-      // For PEM, we can easily determine whether it is a public or private key
-      // by looking for the respective PEM tags.
-      ret = ParsePublicKeyPEM(&pkey, data.data(), data.size());
-      if (ret == ParseKeyResult::kParseKeyNotRecognized) {
-        ret = ParsePrivateKey(&pkey, config, data.data(), data.size());
-      }
-    } else {
-      // For DER, the type determines how to parse it. SPKI, PKCS#8 and SEC1 are
-      // easy, but PKCS#1 can be a public key or a private key.
-      bool is_public;
-      switch (config.type_.ToChecked()) {
-        case kKeyEncodingPKCS1:
-          is_public = !IsRSAPrivateKey(
-              reinterpret_cast<const unsigned char*>(data.data()), data.size());
-          break;
-        case kKeyEncodingSPKI:
-          is_public = true;
-          break;
-        case kKeyEncodingPKCS8:
-        case kKeyEncodingSEC1:
-          is_public = false;
-          break;
-        default:
-          UNREACHABLE("Invalid key encoding type");
-      }
-
-      if (is_public) {
-        ret = ParsePublicKey(&pkey, config, data.data(), data.size());
+    const PrivateKeyEncodingConfig config = config_.Release();
+    auto parse = [&](EVPKeyPointer* pkey) {
+      ParseKeyResult ret;
+      if (config.format_ == kKeyFormatPEM) {
+        // For PEM, we can easily determine whether it is a public or private
+        // key by looking for the respective PEM tags.
+        ret = ParsePublicKeyPEM(pkey, data.data(), data.size());
+        if (ret == ParseKeyResult::kParseKeyNotRecognized) {
+          ret = ParsePrivateKey(pkey, config, data.data(), data.size());
+        }
       } else {
-        ret = ParsePrivateKey(&pkey, config, data.data(), data.size());
+        // For DER, the type determines how to parse it. SPKI, PKCS#8 and SEC1
+        // are easy, but PKCS#1 can be a public key or a private key.
+        bool is_public;
+        switch (config.type_.ToChecked()) {
+          case kKeyEncodingPKCS1:
+            is_public = !IsRSAPrivateKey(
+                reinterpret_cast<const unsigned char*>(data.data()),
+                data.size());
+            break;
+          case kKeyEncodingSPKI:
+            is_public = true;
+            break;
+          case kKeyEncodingPKCS8:
+          case kKeyEncodingSEC1:
+            is_public = false;
+            break;
+          default:
+            UNREACHABLE("Invalid key encoding type");
+        }
+
+        if (is_public) {
+          ret = ParsePublicKey(pkey, config, data.data(), data.size());
+        } else {
+          ret = ParsePrivateKey(pkey, config, data.data(), data.size());
+        }
       }
-    }
 
-    return ManagedEVPPKey::GetParsedKey(
-        env, std::move(pkey), ret, "Failed to read asymmetric key");
+      return ret;
+    };
+
+    return GetCachedParsedKey(
+        env, ParsedKeyCache::kPublicOrPrivateKey, config, data.data(),
+        data.size(), "Failed to read asymmetric key", parse);
   } else {
     CHECK(args[*offset]->IsObject());
     KeyObjectHandle* key = Unwrap<KeyObjectHandle>(args[*offset].As<Object>());
@@ -1306,6 +1454,9 @@ void Initialize(Environment* env, Local<Object> target) {
               FIXED_ONE_BYTE_STRING(env->isolate(), "KeyObjectHandle"),
               KeyObjectHandle::Initialize(env)).Check();
 
+  env->SetMethodNoSideEffect(target, "getKeyCacheStatistics",
+                             GetKeyCacheStatistics);
+
   NODE_DEFINE_CONSTANT(target, kWebCryptoKeyFormatRaw);
   NODE_DEFINE_CONSTANT(target, kWebCryptoKeyFormatPKCS8);
   NODE_DEFINE_CONSTANT(target, kWebCryptoKeyFormatSPKI);
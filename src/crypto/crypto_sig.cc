@@ -12,6 +12,8 @@
 
 namespace node {
 
+using v8::Array;
+using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -283,6 +285,7 @@ void Sign::Initialize(Environment* env, Local<Object> target) {
   env->SetMethod(target, "signOneShot", Sign::SignSync);
 
   SignJob::Initialize(env, target);
+  SignBatchJob::Initialize(env, target);
 
   constexpr int kSignJobModeSign = SignConfiguration::kSign;
   constexpr int kSignJobModeVerify = SignConfiguration::kVerify;
@@ -675,7 +678,8 @@ SignConfiguration::SignConfiguration(SignConfiguration&& other) noexcept
       digest(other.digest),
       flags(other.flags),
       padding(other.padding),
-      salt_length(other.salt_length) {}
+      salt_length(other.salt_length),
+      dsa_encoding(other.dsa_encoding) {}
 
 SignConfiguration& SignConfiguration::operator=(
     SignConfiguration&& other) noexcept {
@@ -761,6 +765,112 @@ Maybe<bool> SignTraits::AdditionalConfig(
   return Just(true);
 }
 
+Maybe<bool> SignTraits::AdditionalBatchConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    std::vector<SignConfiguration>* params) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+
+  CHECK(args[offset]->IsUint32());  // Sign Mode
+  CHECK(args[offset + 1]->IsObject());  // Key
+  CHECK(args[offset + 2]->IsArray());  // Inputs
+  CHECK(args[offset + 7]->IsInt32());  // DSA signature encoding
+
+  SignConfiguration::Mode sign_mode =
+      static_cast<SignConfiguration::Mode>(args[offset].As<Uint32>()->Value());
+
+  KeyObjectHandle* key;
+  ASSIGN_OR_RETURN_UNWRAP(&key, args[offset + 1], Nothing<bool>());
+
+  const EVP_MD* digest = nullptr;
+  if (args[offset + 3]->IsString()) {
+    Utf8Value name(env->isolate(), args[offset + 3]);
+    digest = EVP_get_digestbyname(*name);
+    if (digest == nullptr) {
+      THROW_ERR_CRYPTO_INVALID_DIGEST(env);
+      return Nothing<bool>();
+    }
+  }
+
+  Local<Array> inputs = args[offset + 2].As<Array>();
+  Local<Array> signatures;
+  if (sign_mode == SignConfiguration::kVerify) {
+    CHECK(args[offset + 6]->IsArray());  // Signatures
+    signatures = args[offset + 6].As<Array>();
+    CHECK_EQ(signatures->Length(), inputs->Length());
+  }
+
+  DSASigEnc dsa_encoding =
+      static_cast<DSASigEnc>(args[offset + 7].As<Int32>()->Value());
+  bool convert_signature =
+      dsa_encoding == kSigEncP1363 &&
+      EVP_PKEY_id(key->Data()->GetAsymmetricKey().get()) == EVP_PKEY_EC;
+
+  params->resize(inputs->Length());
+  for (uint32_t i = 0; i < inputs->Length(); i++) {
+    SignConfiguration* config = &(*params)[i];
+    config->job_mode = mode;
+    config->mode = sign_mode;
+    config->key = key->Data();
+    config->digest = digest;
+    config->dsa_encoding = dsa_encoding;
+    if (args[offset + 4]->IsUint32()) {  // Salt length
+      config->flags |= SignConfiguration::kHasSaltLength;
+      config->salt_length = args[offset + 4].As<Uint32>()->Value();
+    }
+    if (args[offset + 5]->IsUint32()) {  // Padding
+      config->flags |= SignConfiguration::kHasPadding;
+      config->padding = args[offset + 5].As<Uint32>()->Value();
+    }
+
+    Local<Value> input;
+    if (!inputs->Get(context, i).ToLocal(&input))
+      return Nothing<bool>();
+    if (UNLIKELY(!input->IsArrayBufferView())) {
+      THROW_ERR_INVALID_ARG_TYPE(env, "Invalid input");
+      return Nothing<bool>();
+    }
+    ArrayBufferOrViewContents<char> data(input);
+    if (UNLIKELY(!data.CheckSizeInt32())) {
+      THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+      return Nothing<bool>();
+    }
+    config->data = mode == kCryptoJobAsync
+        ? data.ToCopy()
+        : data.ToByteSource();
+
+    if (sign_mode != SignConfiguration::kVerify)
+      continue;
+
+    Local<Value> value;
+    if (!signatures->Get(context, i).ToLocal(&value))
+      return Nothing<bool>();
+    if (UNLIKELY(!value->IsArrayBufferView())) {
+      THROW_ERR_INVALID_ARG_TYPE(env, "Invalid signature");
+      return Nothing<bool>();
+    }
+    ArrayBufferOrViewContents<char> signature(value);
+    if (UNLIKELY(!signature.CheckSizeInt32())) {
+      THROW_ERR_OUT_OF_RANGE(env, "signature is too big");
+      return Nothing<bool>();
+    }
+    if (convert_signature) {
+      config->signature =
+          ConvertFromWebCryptoSignature(
+              key->Data()->GetAsymmetricKey(),
+              signature.ToByteSource());
+    } else {
+      config->signature = mode == kCryptoJobAsync
+          ? signature.ToCopy()
+          : signature.ToByteSource();
+    }
+  }
+
+  return Just(true);
+}
+
 bool SignTraits::DeriveBits(
     Environment* env,
     const SignConfiguration& params,
@@ -810,23 +920,34 @@ bool SignTraits::DeriveBits(
 
   switch (params.mode) {
     case SignConfiguration::kSign: {
+      // EVP_DigestSign() is used instead of EVP_DigestSignUpdate() and
+      // EVP_DigestSignFinal() because EdDSA keys only support one-shot
+      // signing.
       size_t len;
-      if (!EVP_DigestSignUpdate(
+      if (!EVP_DigestSign(
               context.get(),
+              nullptr,
+              &len,
               params.data.data<unsigned char>(),
-              params.data.size()) ||
-          !EVP_DigestSignFinal(context.get(), nullptr, &len)) {
+              params.data.size())) {
         return false;
       }
       char* data = MallocOpenSSL<char>(len);
       ByteSource buf = ByteSource::Allocated(data, len);
       unsigned char* ptr = reinterpret_cast<unsigned char*>(data);
-      if (!EVP_DigestSignFinal(context.get(), ptr, &len))
+      if (!EVP_DigestSign(
+              context.get(),
+              ptr,
+              &len,
+              params.data.data<unsigned char>(),
+              params.data.size())) {
         return false;
+      }
 
       // If this is an EC key (assuming ECDSA) we have to
       // convert the signature in to the proper format.
-      if (EVP_PKEY_id(params.key->GetAsymmetricKey().get()) == EVP_PKEY_EC) {
+      if (EVP_PKEY_id(params.key->GetAsymmetricKey().get()) == EVP_PKEY_EC &&
+          params.dsa_encoding == kSigEncP1363) {
         *out = ConvertToWebCryptoSignature(params.key->GetAsymmetricKey(), buf);
       } else {
         buf.Resize(len);
@@ -838,17 +959,12 @@ bool SignTraits::DeriveBits(
       char* data = MallocOpenSSL<char>(1);
       data[0] = 0;
       *out = ByteSource::Allocated(data, 1);
-      if (!EVP_DigestVerifyUpdate(
-              context.get(),
-              params.data.data<unsigned char>(),
-              params.data.size())) {
-        return false;
-      }
-
-      if (EVP_DigestVerifyFinal(
+      if (EVP_DigestVerify(
               context.get(),
               params.signature.data<unsigned char>(),
-              params.signature.size()) == 1) {
+              params.signature.size(),
+              params.data.data<unsigned char>(),
+              params.data.size()) == 1) {
         data[0] = 1;
       }
     }
@@ -117,6 +117,7 @@ struct SignConfiguration final : public MemoryRetainer {
   int flags = SignConfiguration::kHasNone;
   int padding = 0;
   int salt_length = 0;
+  DSASigEnc dsa_encoding = kSigEncP1363;
 
   SignConfiguration() = default;
 
@@ -132,6 +133,7 @@ struct SignConfiguration final : public MemoryRetainer {
 struct SignTraits final {
   using AdditionalParameters = SignConfiguration;
   static constexpr const char* JobName = "SignJob";
+  static constexpr const char* BatchJobName = "SignBatchJob";
 
 // TODO(@jasnell): Sign request vs. Verify request
 
@@ -144,6 +146,12 @@ struct SignTraits final {
       unsigned int offset,
       SignConfiguration* params);
 
+  static v8::Maybe<bool> AdditionalBatchConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      std::vector<SignConfiguration>* params);
+
   static bool DeriveBits(
       Environment* env,
       const SignConfiguration& params,
@@ -157,6 +165,7 @@ struct SignTraits final {
 };
 
 using SignJob = DeriveBitsJob<SignTraits>;
+using SignBatchJob = DeriveBitsBatchJob<SignTraits>;
 
 }  // namespace crypto
 }  // namespace node
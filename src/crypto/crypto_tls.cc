@@ -52,6 +52,7 @@ using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
 using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::PropertyAttribute;
 using v8::ReadOnly;
@@ -878,6 +879,10 @@ void TLSWrap::ClearIn() {
   MaybeLocal<Value> arg = GetSSLError(written, &err, &error_str);
   if (!arg.IsEmpty()) {
     Debug(this, "Got SSL error (%d)", err);
+    // The data may have been left by FlushCoalescedWrites(), in which case
+    // there is no write to report the error to.
+    if (!current_write_)
+      pending_write_error_ = error_str;
     write_callback_scheduled_ = true;
     // TODO(@sam-github) Should forward an error object with
     // .code/.function/.etc, if possible.
@@ -940,7 +945,6 @@ void TLSWrap::ClearError() {
 }
 
 // Called by StreamBase::Write() to request async write of clear text into SSL.
-// TODO(@sam-github) Should there be a TLSWrap::DoTryWrite()?
 int TLSWrap::DoWrite(WriteWrap* w,
                      uv_buf_t* bufs,
                      size_t count,
@@ -954,6 +958,13 @@ int TLSWrap::DoWrite(WriteWrap* w,
     return UV_EPROTO;
   }
 
+  if (!pending_write_error_.empty()) {
+    ClearError();
+    error_ = std::move(pending_write_error_);
+    pending_write_error_.clear();
+    return UV_EPROTO;
+  }
+
   size_t length = 0;
   size_t i;
   size_t nonempty_i = 0;
@@ -966,6 +977,12 @@ int TLSWrap::DoWrite(WriteWrap* w,
     }
   }
 
+  // Data that FlushCoalescedWrites() could not pass to SSL_write() yet and
+  // small writes that DoTryWrite() has taken go first, in the same records.
+  size_t pending = pending_cleartext_input_.size();
+  size_t coalesced = coalesced_writes_.size();
+  length += pending + coalesced;
+
   // We want to trigger a Write() on the underlying stream to drive the stream
   // system, but don't want to encrypt empty buffers into a TLS frame, so see
   // if we can find something to Write().
@@ -1018,21 +1035,25 @@ int TLSWrap::DoWrite(WriteWrap* w,
   // of data supplied to end() there is no sense allocating
   // and copying it when it could just be used.
 
-  if (nonempty_count != 1) {
+  if (nonempty_count != 1 || pending != 0 || coalesced != 0) {
     data = AllocatedBuffer::AllocateManaged(env(), length);
-    size_t offset = 0;
+    if (pending != 0) {
+      memcpy(data.data(), pending_cleartext_input_.data(), pending);
+      pending_cleartext_input_ = AllocatedBuffer();
+    }
+    memcpy(data.data() + pending, coalesced_writes_.data(), coalesced);
+    coalesced_writes_.clear();
+    size_t offset = pending + coalesced;
     for (i = 0; i < count; i++) {
       memcpy(data.data() + offset, bufs[i].base, bufs[i].len);
       offset += bufs[i].len;
     }
 
-    NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(length);
-    written = SSL_write(ssl_.get(), data.data(), length);
+    written = WriteClearText(data.data(), length);
   } else {
     // Only one buffer: try to write directly, only store if it fails
     uv_buf_t* buf = &bufs[nonempty_i];
-    NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(buf->len);
-    written = SSL_write(ssl_.get(), buf->base, buf->len);
+    written = WriteClearText(buf->base, buf->len);
 
     if (written == -1) {
       data = AllocatedBuffer::AllocateManaged(env(), length);
@@ -1070,6 +1091,146 @@ int TLSWrap::DoWrite(WriteWrap* w,
   return 0;
 }
 
+// Takes writes of clear text that are small enough, so that all of the
+// writes of a tick are encrypted together by FlushCoalescedWrites() instead of
+// each going into records and a write to the underlying stream of its own.
+// The writes complete synchronously.
+int TLSWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
+  // Only application data that would be encrypted right away is taken, so
+  // that it stays in order with everything else. That is not the case during
+  // a renegotiation, in which SSL_write() may have to wait for the peer.
+  // While encrypted data is still waiting to be written to the underlying
+  // stream, the write is left to DoWrite() so that it completes only after
+  // that data has been flushed, which keeps backpressure intact.
+  if (!coalesce_writes_ || ssl_ == nullptr || !established_ || shutdown_ ||
+      current_write_ || write_size_ != 0 || BIO_pending(enc_out_) > 0 ||
+      pending_cleartext_input_.size() != 0 ||
+      !pending_write_error_.empty() ||
+      SSL_renegotiate_pending(ssl_.get()) || SSL_in_init(ssl_.get())) {
+    return 0;
+  }
+
+  size_t length = 0;
+  for (size_t i = 0; i < *count; i++)
+    length += (*bufs)[i].len;
+  if (length == 0 ||
+      coalesced_writes_.size() + length > kMaxCoalescedWriteSize) {
+    return 0;
+  }
+
+  Debug(this, "Coalescing %zu bytes", length);
+  for (size_t i = 0; i < *count; i++) {
+    const char* base = (*bufs)[i].base;
+    coalesced_writes_.insert(coalesced_writes_.end(),
+                             base,
+                             base + (*bufs)[i].len);
+  }
+  *count = 0;
+
+  if (!coalesced_flush_scheduled_) {
+    coalesced_flush_scheduled_ = true;
+    BaseObjectPtr<TLSWrap> strong_ref{this};
+    env()->SetImmediate([this, strong_ref](Environment* env) {
+      coalesced_flush_scheduled_ = false;
+      FlushCoalescedWrites();
+      EncOut();
+    });
+  }
+
+  return 0;
+}
+
+void TLSWrap::FlushCoalescedWrites() {
+  if (coalesced_writes_.empty() || ssl_ == nullptr)
+    return;
+
+  // DoWrite() takes the coalesced data along with its own, and DoTryWrite()
+  // does not take data while there is pending data, so nothing can have been
+  // queued after it.
+  CHECK_EQ(pending_cleartext_input_.size(), 0);
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+
+  size_t length = coalesced_writes_.size();
+  int written = WriteClearText(coalesced_writes_.data(), length);
+  Debug(this, "Writing %zu coalesced bytes, written = %d", length, written);
+  CHECK(written == -1 || written == static_cast<int>(length));
+
+  if (written == -1) {
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    int err;
+    std::string error_str;
+    if (GetSSLError(written, &err, &error_str).IsEmpty()) {
+      // ClearIn() or the next DoWrite() writes it, before any later data.
+      Debug(this, "Saving coalesced data for later write");
+      pending_cleartext_input_ =
+          AllocatedBuffer::AllocateManaged(env(), length);
+      memcpy(pending_cleartext_input_.data(), coalesced_writes_.data(), length);
+    } else {
+      // The writes have completed already, so the error is reported by the
+      // next write or shutdown instead.
+      Debug(this, "Got SSL error (%d), discarding coalesced data", err);
+      pending_write_error_ = std::move(error_str);
+    }
+  }
+
+  coalesced_writes_.clear();
+  if (coalesced_writes_.capacity() > static_cast<size_t>(kClearOutChunkSize))
+    coalesced_writes_.shrink_to_fit();
+}
+
+size_t TLSWrap::UpdateRecordSize(size_t length) {
+  size_t small_bytes = 0;
+#ifdef SSL_set_max_send_fragment
+  if (small_record_size_ == 0)
+    return 0;
+
+  uint64_t now = uv_now(env()->event_loop());
+  if (now - last_write_time_ >= record_idle_timeout_)
+    bytes_since_idle_ = 0;
+  last_write_time_ = now;
+
+  if (bytes_since_idle_ < large_record_threshold_) {
+    uint64_t remaining = large_record_threshold_ - bytes_since_idle_;
+    small_bytes = static_cast<size_t>(std::min<uint64_t>(remaining, length));
+    SetSendFragment(std::min(small_record_size_, max_send_fragment_));
+  } else {
+    SetSendFragment(max_send_fragment_);
+  }
+  bytes_since_idle_ += length;
+#endif  // SSL_set_max_send_fragment
+  return small_bytes;
+}
+
+void TLSWrap::SetSendFragment(int size) {
+#ifdef SSL_set_max_send_fragment
+  if (size != send_fragment_ &&
+      SSL_set_max_send_fragment(ssl_.get(), size) == 1) {
+    Debug(this, "Using records of up to %d bytes", size);
+    send_fragment_ = size;
+  }
+#endif  // SSL_set_max_send_fragment
+}
+
+int TLSWrap::WriteClearText(const char* data, size_t length) {
+  NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(length);
+  size_t small_bytes = UpdateRecordSize(length);
+  if (small_bytes == 0 || small_bytes >= length)
+    return SSL_write(ssl_.get(), data, length);
+
+  // The threshold of dynamic record sizing is reached within this write.
+  // Only the first SSL_write() can fail while the connection is still usable,
+  // during a handshake, so the data is either written entirely or not at all
+  // as far as the caller is concerned.
+  if (SSL_write(ssl_.get(), data, small_bytes) == -1)
+    return -1;
+  SetSendFragment(max_send_fragment_);
+  if (SSL_write(ssl_.get(), data + small_bytes, length - small_bytes) == -1)
+    return -1;
+  return static_cast<int>(length);
+}
+
 uv_buf_t TLSWrap::OnStreamAlloc(size_t suggested_size) {
   CHECK_NOT_NULL(ssl_);
 
@@ -1129,6 +1290,11 @@ int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
   Debug(this, "DoShutdown()");
   MarkPopErrorOnReturn mark_pop_error_on_return;
 
+  FlushCoalescedWrites();
+  if (!pending_write_error_.empty()) {
+    Debug(this, "Returning from DoShutdown(), %s", pending_write_error_);
+    return UV_EPROTO;
+  }
   if (ssl_ && SSL_shutdown(ssl_.get()) == 0)
     SSL_shutdown(ssl_.get());
 
@@ -1244,6 +1410,7 @@ void TLSWrap::Destroy() {
 
   env()->isolate()->AdjustAmountOfExternalAllocatedMemory(-kExternalSize);
   ssl_.reset();
+  coalesced_writes_.clear();
 
   enc_in_ = nullptr;
   enc_out_ = nullptr;
@@ -1490,7 +1657,8 @@ void TLSWrap::GetWriteQueueSize(const FunctionCallbackInfo<Value>& info) {
   if (!wrap->ssl_)
     return info.GetReturnValue().Set(0);
 
-  uint32_t write_queue_size = BIO_pending(wrap->enc_out_);
+  uint32_t write_queue_size =
+      BIO_pending(wrap->enc_out_) + wrap->coalesced_writes_.size();
   info.GetReturnValue().Set(write_queue_size);
 }
 
@@ -1501,6 +1669,8 @@ void TLSWrap::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("pending_cleartext_input",
                               pending_cleartext_input_.size(),
                               "AllocatedBuffer");
+  tracker->TrackFieldWithSize("coalesced_writes",
+                              coalesced_writes_.capacity());
   if (enc_in_ != nullptr)
     tracker->TrackField("enc_in", NodeBIO::FromBIO(enc_in_));
   if (enc_out_ != nullptr)
@@ -1575,6 +1745,13 @@ void TLSWrap::SetALPNProtocols(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+void TLSWrap::SetCoalesceWrites(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* w;
+  ASSIGN_OR_RETURN_UNWRAP(&w, args.Holder());
+  CHECK(args[0]->IsBoolean());
+  w->coalesce_writes_ = args[0]->IsTrue();
+}
+
 void TLSWrap::GetPeerCertificate(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.Holder());
@@ -1988,11 +2165,34 @@ void TLSWrap::SetMaxSendFragment(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   TLSWrap* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.Holder());
-  int rv = SSL_set_max_send_fragment(
-      w->ssl_.get(),
-      args[0]->Int32Value(env->context()).FromJust());
+  int size = args[0]->Int32Value(env->context()).FromJust();
+  int rv = SSL_set_max_send_fragment(w->ssl_.get(), size);
+  if (rv == 1)
+    w->max_send_fragment_ = w->send_fragment_ = size;
   args.GetReturnValue().Set(rv);
 }
+
+void TLSWrap::SetDynamicRecordSizing(
+    const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* w;
+  ASSIGN_OR_RETURN_UNWRAP(&w, args.Holder());
+  CHECK_NOT_NULL(w->ssl_);
+  CHECK(args[0]->IsUint32());  // Small record size, or 0 to disable
+  CHECK(args[1]->IsNumber());  // Threshold in bytes
+  CHECK(args[2]->IsUint32());  // Idle timeout in milliseconds
+
+  w->small_record_size_ = args[0].As<Uint32>()->Value();
+  w->large_record_threshold_ =
+      static_cast<uint64_t>(args[1].As<Number>()->Value());
+  w->record_idle_timeout_ = args[2].As<Uint32>()->Value();
+  w->bytes_since_idle_ = 0;
+
+  if (w->small_record_size_ == 0 &&
+      w->send_fragment_ != w->max_send_fragment_ &&
+      SSL_set_max_send_fragment(w->ssl_.get(), w->max_send_fragment_) == 1) {
+    w->send_fragment_ = w->max_send_fragment_;
+  }
+}
 #endif  // SSL_set_max_send_fragment
 
 void TLSWrap::Initialize(
@@ -2039,6 +2239,7 @@ void TLSWrap::Initialize(
   env->SetProtoMethod(t, "renegotiate", Renegotiate);
   env->SetProtoMethod(t, "requestOCSP", RequestOCSP);
   env->SetProtoMethod(t, "setALPNProtocols", SetALPNProtocols);
+  env->SetProtoMethod(t, "setCoalesceWrites", SetCoalesceWrites);
   env->SetProtoMethod(t, "setOCSPResponse", SetOCSPResponse);
   env->SetProtoMethod(t, "setServername", SetServername);
   env->SetProtoMethod(t, "setSession", SetSession);
@@ -2064,6 +2265,7 @@ void TLSWrap::Initialize(
   env->SetProtoMethodNoSideEffect(t, "verifyError", VerifyError);
 
 #ifdef SSL_set_max_send_fragment
+  env->SetProtoMethod(t, "setDynamicRecordSizing", SetDynamicRecordSizing);
   env->SetProtoMethod(t, "setMaxSendFragment", SetMaxSendFragment);
 #endif  // SSL_set_max_send_fragment
 
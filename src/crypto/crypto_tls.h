@@ -35,6 +35,7 @@
 #include <openssl/ssl.h>
 
 #include <string>
+#include <vector>
 
 namespace node {
 namespace crypto {
@@ -83,6 +84,8 @@ class TLSWrap : public AsyncWrap,
               uv_buf_t* bufs,
               size_t count,
               uv_stream_t* send_handle) override;
+  // Takes small writes into coalesced_writes_ if coalescing is enabled.
+  int DoTryWrite(uv_buf_t** bufs, size_t* count) override;
   // Return error_ string or nullptr if it's empty.
   const char* Error() const override;
   // Reset error_ string to empty. Not related to "clear text".
@@ -121,6 +124,10 @@ class TLSWrap : public AsyncWrap,
   // Maximum number of buffers passed to uv_write()
   static constexpr int kSimultaneousBufferCount = 10;
 
+  // Maximum number of bytes of small writes that are combined before they
+  // are encrypted, which is four full records.
+  static constexpr size_t kMaxCoalescedWriteSize = 4 * 16384;
+
   typedef void (*CertCb)(void* arg);
 
   // Alternative to StreamListener::stream(), that returns a StreamBase instead
@@ -150,6 +157,17 @@ class TLSWrap : public AsyncWrap,
   void ClearOut();  // SSL_read() clear text "out" from SSL.
   void Destroy();
 
+  // SSL_write() the data that DoTryWrite() has taken, once per tick.
+  void FlushCoalescedWrites();
+  // SSL_write() clear text with the record size that dynamic record sizing
+  // calls for. Returns length, or -1 like SSL_write().
+  int WriteClearText(const char* data, size_t length);
+  // Accounts for the next length bytes of clear text for dynamic record
+  // sizing and sets the record size for them. Returns how many of the bytes
+  // are to be written with small records, or 0 if full-size records are used.
+  size_t UpdateRecordSize(size_t length);
+  void SetSendFragment(int size);
+
   // Call Done() on outstanding WriteWrap request.
   void InvokeQueued(int status, const char* error_str = nullptr);
 
@@ -206,6 +224,8 @@ class TLSWrap : public AsyncWrap,
   static void Renegotiate(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RequestOCSP(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetALPNProtocols(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetCoalesceWrites(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetOCSPResponse(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetSession(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -215,6 +235,8 @@ class TLSWrap : public AsyncWrap,
   static void Wrap(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 #ifdef SSL_set_max_send_fragment
+  static void SetDynamicRecordSizing(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetMaxSendFragment(
       const v8::FunctionCallbackInfo<v8::Value>& args);
 #endif  // SSL_set_max_send_fragment
@@ -250,6 +272,11 @@ class TLSWrap : public AsyncWrap,
   BIO* enc_out_ = nullptr;  // SSL_write()/handshake fills this for EncOut().
   // Waiting for ClearIn() to pass to SSL_write().
   AllocatedBuffer pending_cleartext_input_;
+  // Small writes that have not been passed to SSL_write() yet.
+  std::vector<char> coalesced_writes_;
+  // The error of SSL_write() for data whose writes have completed already,
+  // reported by the next write.
+  std::string pending_write_error_;
   size_t write_size_ = 0;
   BaseObjectPtr<AsyncWrap> current_write_;
   BaseObjectPtr<AsyncWrap> current_empty_write_;
@@ -262,6 +289,8 @@ class TLSWrap : public AsyncWrap,
   bool shutdown_ = false;
   bool cert_cb_running_ = false;
   bool eof_ = false;
+  bool coalesce_writes_ = false;
+  bool coalesced_flush_scheduled_ = false;
 
   // TODO(@jasnell): These state flags should be revisited.
   // The established_ flag indicates that the handshake is
@@ -274,6 +303,18 @@ class TLSWrap : public AsyncWrap,
 
   int cycle_depth_ = 0;
 
+  // Dynamic record sizing: records are at most small_record_size_ bytes
+  // until large_record_threshold_ bytes have been written, and again after
+  // no data has been written for record_idle_timeout_ milliseconds. It is
+  // disabled if small_record_size_ is 0.
+  int small_record_size_ = 0;
+  int max_send_fragment_ = SSL3_RT_MAX_PLAIN_LENGTH;
+  int send_fragment_ = SSL3_RT_MAX_PLAIN_LENGTH;
+  uint64_t large_record_threshold_ = 0;
+  uint64_t record_idle_timeout_ = 0;
+  uint64_t bytes_since_idle_ = 0;
+  uint64_t last_write_time_ = 0;
+
   // SSL_set_cert_cb
   CertCb cert_cb_ = nullptr;
   void* cert_cb_arg_ = nullptr;
@@ -580,6 +580,18 @@ Maybe<bool> SetEncodedValue(
   return target->Set(env->context(), name, value);
 }
 
+size_t GetThreadPoolSize() {
+  // This follows the same rules as libuv when it creates the thread pool.
+  static const size_t size = []() -> size_t {
+    std::string value;
+    if (!credentials::SafeGetenv("UV_THREADPOOL_SIZE", &value))
+      return 4;
+    size_t threads = strtoul(value.c_str(), nullptr, 10);
+    return std::min<size_t>(std::max<size_t>(threads, 1), 1024);
+  }();
+  return size;
+}
+
 CryptoJobMode GetCryptoJobMode(v8::Local<v8::Value> args) {
   CHECK(args->IsUint32());
   uint32_t mode = args.As<v8::Uint32>()->Value();
@@ -454,6 +454,199 @@ class DeriveBitsJob final : public CryptoJob<DeriveBitsTraits> {
   bool success_ = false;
 };
 
+// Returns the number of threads in the libuv thread pool, which libuv does
+// not expose itself.
+size_t GetThreadPoolSize();
+
+// Runs the work of a DeriveBitsJob for an array of inputs. The inputs are
+// split into at most one chunk per thread of the thread pool, and the job
+// completes once with an array of the results when all chunks are done, or
+// with the error of the first input that failed.
+// DeriveBitsTraits::AdditionalBatchConfig() must fill in the parameters of
+// each input.
+template <typename DeriveBitsTraits>
+class DeriveBitsBatchJob final : public AsyncWrap {
+ public:
+  using AdditionalParams = typename DeriveBitsTraits::AdditionalParameters;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+
+    CryptoJobMode mode = GetCryptoJobMode(args[0]);
+
+    std::vector<AdditionalParams> params;
+    if (DeriveBitsTraits::AdditionalBatchConfig(mode, args, 1, &params)
+            .IsNothing()) {
+      return;
+    }
+
+    new DeriveBitsBatchJob(env, args.This(), mode, std::move(params));
+  }
+
+  static void Initialize(
+      Environment* env,
+      v8::Local<v8::Object> target) {
+    v8::Local<v8::FunctionTemplate> job = env->NewFunctionTemplate(New);
+    v8::Local<v8::String> class_name =
+        OneByteString(env->isolate(), DeriveBitsTraits::BatchJobName);
+    job->SetClassName(class_name);
+    job->Inherit(AsyncWrap::GetConstructorTemplate(env));
+    job->InstanceTemplate()->SetInternalFieldCount(
+        AsyncWrap::kInternalFieldCount);
+    env->SetProtoMethod(job, "run", Run);
+    target->Set(
+        env->context(),
+        class_name,
+        job->GetFunction(env->context()).ToLocalChecked()).Check();
+  }
+
+  DeriveBitsBatchJob(
+      Environment* env,
+      v8::Local<v8::Object> object,
+      CryptoJobMode mode,
+      std::vector<AdditionalParams>&& params)
+      : AsyncWrap(env, object, DeriveBitsTraits::Provider),
+        mode_(mode),
+        params_(std::move(params)),
+        results_(params_.size()) {
+    if (mode == kCryptoJobSync) MakeWeak();
+  }
+
+  bool IsNotIndicativeOfMemoryLeakAtExit() const override {
+    return true;
+  }
+
+  static void Run(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+
+    DeriveBitsBatchJob* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+    if (job->mode_ == kCryptoJobAsync)
+      return job->ScheduleWork();
+
+    v8::Local<v8::Value> ret[2];
+    env->PrintSyncTrace();
+    job->DeriveBits(0, job->params_.size());
+    if (job->ToResult(&ret[0], &ret[1]).FromJust()) {
+      args.GetReturnValue().Set(
+          v8::Array::New(env->isolate(), ret, arraysize(ret)));
+    }
+  }
+
+  std::string MemoryInfoName() const override {
+    return DeriveBitsTraits::BatchJobName;
+  }
+
+  SET_SELF_SIZE(DeriveBitsBatchJob)
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    size_t out_size = 0;
+    for (const Result& result : results_)
+      out_size += result.out.size();
+    tracker->TrackFieldWithSize("params",
+                                params_.size() * sizeof(AdditionalParams));
+    tracker->TrackFieldWithSize("out", out_size);
+  }
+
+ private:
+  struct Result {
+    ByteSource out;
+    CryptoErrorVector errors;
+    bool success = false;
+  };
+
+  class Chunk final : public ThreadPoolWork {
+   public:
+    Chunk(DeriveBitsBatchJob* job, size_t begin, size_t end)
+        : ThreadPoolWork(job->env()), job_(job), begin_(begin), end_(end) {}
+
+    void DoThreadPoolWork() override {
+      job_->DeriveBits(begin_, end_);
+    }
+
+    void AfterThreadPoolWork(int status) override {
+      job_->AfterChunk(status);
+    }
+
+   private:
+    DeriveBitsBatchJob* job_;
+    size_t begin_;
+    size_t end_;
+  };
+
+  void ScheduleWork() {
+    size_t count = params_.size();
+    size_t chunk_count = std::max<size_t>(
+        1, std::min(count, GetThreadPoolSize()));
+    size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+    for (size_t begin = 0; begin < count || chunks_.empty();
+         begin += chunk_size) {
+      chunks_.emplace_back(
+          new Chunk(this, begin, std::min(begin + chunk_size, count)));
+    }
+    pending_chunks_ = chunks_.size();
+    for (const auto& chunk : chunks_)
+      chunk->ScheduleWork();
+  }
+
+  void DeriveBits(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      Result* result = &results_[i];
+      if (DeriveBitsTraits::DeriveBits(env(), params_[i], &result->out)) {
+        result->success = true;
+        continue;
+      }
+      result->errors.Capture();
+      if (result->errors.empty())
+        result->errors.push_back("Deriving bits failed");
+    }
+  }
+
+  void AfterChunk(int status) {
+    CHECK_EQ(mode_, kCryptoJobAsync);
+    CHECK(status == 0 || status == UV_ECANCELED);
+    if (status == UV_ECANCELED) canceled_ = true;
+    if (--pending_chunks_ > 0) return;
+
+    std::unique_ptr<DeriveBitsBatchJob> ptr(this);
+    // Like CryptoJob, do not execute the callback if the job was canceled.
+    if (canceled_) return;
+    Environment* env = AsyncWrap::env();
+    v8::HandleScope handle_scope(env->isolate());
+    v8::Context::Scope context_scope(env->context());
+    v8::Local<v8::Value> args[2];
+    if (ToResult(&args[0], &args[1]).FromJust())
+      MakeCallback(env->ondone_string(), arraysize(args), args);
+  }
+
+  v8::Maybe<bool> ToResult(
+      v8::Local<v8::Value>* err,
+      v8::Local<v8::Value>* result) {
+    Environment* env = AsyncWrap::env();
+    std::vector<v8::Local<v8::Value>> values(results_.size());
+    for (size_t i = 0; i < results_.size(); i++) {
+      if (!results_[i].success) {
+        CHECK(!results_[i].errors.empty());
+        *result = v8::Undefined(env->isolate());
+        return v8::Just(results_[i].errors.ToException(env).ToLocal(err));
+      }
+      v8::Maybe<bool> ok = DeriveBitsTraits::EncodeOutput(
+          env, params_[i], &results_[i].out, &values[i]);
+      if (ok.IsNothing() || !ok.FromJust())
+        return v8::Nothing<bool>();
+    }
+    *err = v8::Undefined(env->isolate());
+    *result = v8::Array::New(env->isolate(), values.data(), values.size());
+    return v8::Just(true);
+  }
+
+  const CryptoJobMode mode_;
+  std::vector<AdditionalParams> params_;
+  std::vector<Result> results_;
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  size_t pending_chunks_ = 0;
+  bool canceled_ = false;
+};
+
 void ThrowCryptoError(Environment* env,
                       unsigned long err,  // NOLINT(runtime/int)
                       const char* message = nullptr);
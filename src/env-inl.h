@@ -366,13 +366,15 @@ inline T* Environment::GetBindingData(v8::Local<v8::Context> context) {
   return result;
 }
 
-template <typename T>
+template <typename T, typename... Args>
 inline T* Environment::AddBindingData(
     v8::Local<v8::Context> context,
-    v8::Local<v8::Object> target) {
+    v8::Local<v8::Object> target,
+    Args&&... args) {
   DCHECK_EQ(GetCurrent(context), this);
   // This won't compile if T is not a BaseObject subclass.
-  BaseObjectPtr<T> item = MakeDetachedBaseObject<T>(this, target);
+  BaseObjectPtr<T> item =
+      MakeDetachedBaseObject<T>(this, target, std::forward<Args>(args)...);
   BindingDataStore* map = static_cast<BindingDataStore*>(
       context->GetAlignedPointerFromEmbedderData(
           ContextEmbedderIndex::kBindingListIndex));
@@ -445,6 +447,10 @@ void Environment::DecreaseWaitingRequestCounter() {
   CHECK_GE(request_waiting_, 0);
 }
 
+int Environment::waiting_request_count() const {
+  return request_waiting_;
+}
+
 inline uv_loop_t* Environment::event_loop() const {
   return isolate_data()->event_loop();
 }
@@ -656,6 +662,17 @@ Environment::cpu_profiler_connection() {
   return cpu_profiler_connection_.get();
 }
 
+inline void Environment::set_continuous_cpu_profiler(
+    std::unique_ptr<profiler::V8ContinuousCpuProfiler> profiler) {
+  CHECK_NULL(continuous_cpu_profiler_);
+  std::swap(continuous_cpu_profiler_, profiler);
+}
+
+inline profiler::V8ContinuousCpuProfiler*
+Environment::continuous_cpu_profiler() {
+  return continuous_cpu_profiler_.get();
+}
+
 inline void Environment::set_cpu_prof_interval(uint64_t interval) {
   cpu_prof_interval_ = interval;
 }
@@ -883,6 +900,15 @@ inline performance::PerformanceState* Environment::performance_state() {
   return performance_state_.get();
 }
 
+inline performance::EventLoopPhaseTimer* Environment::loop_phase_timer() {
+  return &loop_phase_timer_;
+}
+
+inline std::vector<performance::AsyncCallbackMonitor*>*
+Environment::async_callback_monitors() {
+  return &async_callback_monitors_;
+}
+
 inline std::unordered_map<std::string, uint64_t>*
     Environment::performance_marks() {
   return &performance_marks_;
@@ -6,11 +6,13 @@
 #include "diagnosticfilename-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_compile_cache.h"
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "node_internals.h"
 #include "node_options-inl.h"
 #include "node_process.h"
+#include "node_snapshotable.h"
 #include "node_v8_platform-inl.h"
 #include "node_worker.h"
 #include "req_wrap-inl.h"
@@ -379,6 +381,14 @@ Environment::Environment(IsolateData* isolate_data,
   performance_state_ = std::make_unique<performance::PerformanceState>(
       isolate, MAYBE_FIELD_PTR(env_info, performance_state));
 
+  if (!options_->experimental_code_cache_dir.empty()) {
+    compile_cache_handler_ = std::make_unique<CompileCacheHandler>(this);
+    if (!compile_cache_handler_->InitializeDirectory(
+            options_->experimental_code_cache_dir)) {
+      compile_cache_handler_.reset();
+    }
+  }
+
   if (*TRACE_EVENT_API_GET_CATEGORY_GROUP_ENABLED(
           TRACING_CATEGORY_NODE1(environment)) != 0) {
     auto traced_value = tracing::TracedValue::Create();
@@ -533,6 +543,8 @@ void Environment::InitializeLibuv() {
 
   uv_check_start(immediate_check_handle(), CheckImmediate);
 
+  loop_phase_timer_.Initialize(event_loop());
+
   uv_async_init(
       event_loop(),
       &task_queues_async_,
@@ -585,6 +597,16 @@ void Environment::RegisterHandleCleanups() {
   register_handle(reinterpret_cast<uv_handle_t*>(immediate_check_handle()));
   register_handle(reinterpret_cast<uv_handle_t*>(immediate_idle_handle()));
   register_handle(reinterpret_cast<uv_handle_t*>(&task_queues_async_));
+
+  // Event loop phase monitors can be destroyed after the handles have been
+  // closed, so they are detached from the prepare handle first.
+  RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(loop_phase_timer_.prepare_handle()),
+      [](Environment* env, uv_handle_t* handle, void* arg) {
+        env->loop_phase_timer()->Stop();
+        env->CloseHandle(handle, [](uv_handle_t* handle) {});
+      },
+      nullptr);
 }
 
 void Environment::CleanupHandles() {
@@ -811,6 +833,8 @@ void Environment::RunTimers(uv_timer_t* handle) {
   if (!env->can_call_into_js())
     return;
 
+  performance::EventLoopPhaseTimer::Scope phase_scope(
+      env->loop_phase_timer(), performance::NODE_EVENT_LOOP_PHASE_TIMERS);
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
@@ -870,6 +894,9 @@ void Environment::CheckImmediate(uv_check_t* handle) {
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "CheckImmediate", env);
 
+  env->loop_phase_timer()->EndPoll();
+  performance::EventLoopPhaseTimer::Scope phase_scope(
+      env->loop_phase_timer(), performance::NODE_EVENT_LOOP_PHASE_CHECK);
   HandleScope scope(env->isolate());
   Context::Scope context_scope(env->context());
 
@@ -1137,6 +1164,11 @@ void AsyncHooks::grow_async_ids_stack() {
       async_ids_stack_.GetJSArray()).Check();
 }
 
+void Environment::FlushCompileCache() {
+  if (compile_cache_handler_)
+    compile_cache_handler_->Persist();
+}
+
 void Environment::Exit(int exit_code) {
   if (options()->trace_exit) {
     HandleScope handle_scope(isolate());
@@ -1156,6 +1188,7 @@ void Environment::Exit(int exit_code) {
                     StackTrace::CurrentStackTrace(
                         isolate(), stack_trace_limit(), StackTrace::kDetailed));
   }
+  FlushCompileCache();
   process_exit_handler_(this, exit_code);
 }
 
@@ -1232,6 +1265,27 @@ void Environment::VerifyNoStrongBaseObjects() {
   });
 }
 
+bool Environment::PrepareForSerialization(SnapshotCreator* creator) {
+  Local<Context> ctx = context();
+  bool can_serialize = true;
+  ForEachBaseObject([&](BaseObject* obj) {
+    if (!obj->is_snapshotable()) {
+      fprintf(stderr,
+              "Cannot serialize %s into the snapshot\n",
+              obj->MemoryInfoName().c_str());
+      can_serialize = false;
+      return;
+    }
+    SnapshotableObject* snapshotable = static_cast<SnapshotableObject*>(obj);
+    Debug(this,
+          DebugCategory::MKSNAPSHOT,
+          "Preparing %s for serialization\n",
+          snapshotable->GetTypeNameChars());
+    snapshotable->PrepareForSerialization(ctx, creator);
+  });
+  return can_serialize;
+}
+
 EnvSerializeInfo Environment::Serialize(SnapshotCreator* creator) {
   EnvSerializeInfo info;
   Local<Context> ctx = context();
@@ -1399,6 +1453,30 @@ void Environment::DeserializeProperties(const EnvSerializeInfo* info) {
             "Failed to deserialize context back reference from the snapshot\n");
   }
   CHECK_EQ(ctx_from_snapshot, ctx);
+
+  RunDeserializeRequests();
+}
+
+void Environment::EnqueueDeserializeRequest(DeserializeRequestCallback cb,
+                                            Local<Object> holder,
+                                            int index,
+                                            InternalFieldInfoBase* info) {
+  DeserializeRequest request{cb, {isolate(), holder}, index, info};
+  deserialize_requests_.push_back(std::move(request));
+}
+
+void Environment::RunDeserializeRequests() {
+  HandleScope scope(isolate());
+  Local<Context> ctx = context();
+  Isolate* is = isolate();
+  while (!deserialize_requests_.empty()) {
+    DeserializeRequest request(std::move(deserialize_requests_.front()));
+    deserialize_requests_.pop_front();
+    Local<Object> holder = request.holder.Get(is);
+    request.cb(ctx, holder, request.index, request.info);
+    request.holder.Reset();
+    request.info->Delete();
+  }
 }
 
 uint64_t GuessMemoryAvailableToTheProcess() {
@@ -63,6 +63,8 @@ namespace performance {
 class PerformanceState;
 }
 
+class CompileCacheHandler;
+
 namespace tracing {
 class AgentWriterHandle;
 }
@@ -70,6 +72,7 @@ class AgentWriterHandle;
 #if HAVE_INSPECTOR
 namespace profiler {
 class V8CoverageConnection;
+class V8ContinuousCpuProfiler;
 class V8CpuProfilerConnection;
 class V8HeapProfilerConnection;
 }  // namespace profiler
@@ -449,6 +452,7 @@ constexpr size_t kFsStatsBufferLength =
   V(binding_data_ctor_template, v8::FunctionTemplate)                          \
   V(blocklist_instance_template, v8::ObjectTemplate)                           \
   V(compiled_fn_entry_template, v8::ObjectTemplate)                            \
+  V(concurrent_histogram_instance_template, v8::ObjectTemplate)                \
   V(dir_instance_template, v8::ObjectTemplate)                                 \
   V(fd_constructor_template, v8::ObjectTemplate)                               \
   V(fdclose_constructor_template, v8::ObjectTemplate)                          \
@@ -548,6 +552,8 @@ constexpr size_t kFsStatsBufferLength =
   V(promise_hook_handler, v8::Function)                                        \
   V(promise_reject_callback, v8::Function)                                     \
   V(script_data_constructor_function, v8::Function)                            \
+  V(snapshot_deserialize_main, v8::Function)                                   \
+  V(snapshot_serialize_callback, v8::Function)                                 \
   V(source_map_cache_getter, v8::Function)                                     \
   V(tick_callback_function, v8::Function)                                      \
   V(timers_callback_function, v8::Function)                                    \
@@ -919,6 +925,21 @@ class CleanupHookCallback {
   uint64_t insertion_order_counter_;
 };
 
+struct InternalFieldInfoBase;  // Defined in node_snapshotable.h
+
+typedef void (*DeserializeRequestCallback)(v8::Local<v8::Context> context,
+                                           v8::Local<v8::Object> holder,
+                                           int index,
+                                           InternalFieldInfoBase* info);
+// Deserialization of embedder objects found in a context snapshot is
+// deferred until the Environment and the context are fully set up.
+struct DeserializeRequest {
+  DeserializeRequestCallback cb;
+  v8::Global<v8::Object> holder;
+  int index;
+  InternalFieldInfoBase* info = nullptr;  // Owned by the request
+};
+
 struct PropInfo {
   std::string name;     // name for debugging
   size_t id;            // In the list - in case there are any empty entires
@@ -954,9 +975,18 @@ class Environment : public MemoryRetainer {
   bool IsRootNode() const override { return true; }
   void MemoryInfo(MemoryTracker* tracker) const override;
 
+  // Lets the snapshotable BaseObjects add their state to the snapshot. Returns
+  // false and prints the offending objects if the Environment holds native
+  // objects that cannot be serialized. Must be called before Serialize().
+  bool PrepareForSerialization(v8::SnapshotCreator* creator);
   EnvSerializeInfo Serialize(v8::SnapshotCreator* creator);
   void CreateProperties();
   void DeserializeProperties(const EnvSerializeInfo* info);
+  void EnqueueDeserializeRequest(DeserializeRequestCallback cb,
+                                 v8::Local<v8::Object> holder,
+                                 int index,
+                                 InternalFieldInfoBase* info);
+  void RunDeserializeRequests();
 
   void PrintAllBaseObjects();
   void VerifyNoStrongBaseObjects();
@@ -992,9 +1022,11 @@ class Environment : public MemoryRetainer {
   // Methods created using SetMethod(), SetPrototypeMethod(), etc. inside
   // this scope can access the created T* object using
   // GetBindingData<T>(args) later.
-  template <typename T>
+  // Extra arguments are forwarded to the constructor of T.
+  template <typename T, typename... Args>
   T* AddBindingData(v8::Local<v8::Context> context,
-                    v8::Local<v8::Object> target);
+                    v8::Local<v8::Object> target,
+                    Args&&... args);
   template <typename T, typename U>
   static inline T* GetBindingData(const v8::PropertyCallbackInfo<U>& info);
   template <typename T>
@@ -1075,6 +1107,7 @@ class Environment : public MemoryRetainer {
 
   inline void IncreaseWaitingRequestCounter();
   inline void DecreaseWaitingRequestCounter();
+  inline int waiting_request_count() const;
 
   inline AsyncHooks* async_hooks();
   inline ImmediateInfo* immediate_info();
@@ -1130,9 +1163,20 @@ class Environment : public MemoryRetainer {
   inline uint32_t get_next_script_id();
   inline uint32_t get_next_function_id();
 
+  // Only set when --experimental-code-cache-dir is used.
+  CompileCacheHandler* compile_cache_handler() const {
+    return compile_cache_handler_.get();
+  }
+  // Writes the code cache of user modules that have been compiled without
+  // a usable cache, see src/node_compile_cache.h.
+  void FlushCompileCache();
+
   EnabledDebugList* enabled_debug_list() { return &enabled_debug_list_; }
 
   inline performance::PerformanceState* performance_state();
+  inline performance::EventLoopPhaseTimer* loop_phase_timer();
+  inline std::vector<performance::AsyncCallbackMonitor*>*
+      async_callback_monitors();
   inline std::unordered_map<std::string, uint64_t>* performance_marks();
 
   void CollectUVExceptionInfo(v8::Local<v8::Value> context,
@@ -1350,6 +1394,10 @@ class Environment : public MemoryRetainer {
       std::unique_ptr<profiler::V8CpuProfilerConnection> connection);
   profiler::V8CpuProfilerConnection* cpu_profiler_connection();
 
+  void set_continuous_cpu_profiler(
+      std::unique_ptr<profiler::V8ContinuousCpuProfiler> profiler);
+  profiler::V8ContinuousCpuProfiler* continuous_cpu_profiler();
+
   inline void set_cpu_prof_name(const std::string& name);
   inline const std::string& cpu_prof_name() const;
 
@@ -1397,6 +1445,8 @@ class Environment : public MemoryRetainer {
   uv_timer_t timer_handle_;
   uv_check_t immediate_check_handle_;
   uv_idle_t immediate_idle_handle_;
+  performance::EventLoopPhaseTimer loop_phase_timer_;
+  std::vector<performance::AsyncCallbackMonitor*> async_callback_monitors_;
   uv_async_t task_queues_async_;
   int64_t task_queues_async_refs_ = 0;
 
@@ -1418,6 +1468,7 @@ class Environment : public MemoryRetainer {
 #if HAVE_INSPECTOR
   std::unique_ptr<profiler::V8CoverageConnection> coverage_connection_;
   std::unique_ptr<profiler::V8CpuProfilerConnection> cpu_profiler_connection_;
+  std::unique_ptr<profiler::V8ContinuousCpuProfiler> continuous_cpu_profiler_;
   std::string coverage_directory_;
   std::string cpu_prof_dir_;
   std::string cpu_prof_name_;
@@ -1459,6 +1510,8 @@ class Environment : public MemoryRetainer {
   std::unique_ptr<performance::PerformanceState> performance_state_;
   std::unordered_map<std::string, uint64_t> performance_marks_;
 
+  std::unique_ptr<CompileCacheHandler> compile_cache_handler_;
+
   bool has_run_bootstrapping_code_ = false;
   bool has_serialized_options_ = false;
 
@@ -1502,6 +1555,8 @@ class Environment : public MemoryRetainer {
 
   std::list<ExitCallback> at_exit_functions_;
 
+  std::list<DeserializeRequest> deserialize_requests_;
+
   typedef CallbackQueue<void, Environment*> NativeImmediateQueue;
   NativeImmediateQueue native_immediates_;
   Mutex native_immediates_threadsafe_mutex_;
@@ -1,8 +1,13 @@
 #include "diagnosticfilename-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_external_reference.h"
 #include "stream_base-inl.h"
 #include "util-inl.h"
+#include "zlib.h"
+
+#include <fcntl.h>
+#include <vector>
 
 using v8::Array;
 using v8::Boolean;
@@ -14,6 +19,7 @@ using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
 using v8::HeapSnapshot;
+using v8::Int32;
 using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
@@ -203,28 +209,87 @@ void BuildEmbedderGraph(const FunctionCallbackInfo<Value>& args) {
 }
 
 namespace {
-class FileOutputStream : public v8::OutputStream {
+// Writes the serialized snapshot to a file descriptor as it is produced, so
+// that at most one chunk of it is held in memory at any time. When
+// |compress| is true, the output is gzip-compressed on the fly.
+class FdOutputStream : public v8::OutputStream {
  public:
-  explicit FileOutputStream(FILE* stream) : stream_(stream) {}
+  FdOutputStream(uv_file fd, bool compress)
+      : fd_(fd), compress_(compress) {
+    if (compress_) {
+      zstream_.zalloc = Z_NULL;
+      zstream_.zfree = Z_NULL;
+      zstream_.opaque = Z_NULL;
+      // 15 + 16 makes zlib write a gzip header and trailer. Snapshots of
+      // large heaps are big, so favour speed over the compression ratio.
+      CHECK_EQ(Z_OK, deflateInit2(&zstream_, Z_BEST_SPEED, Z_DEFLATED,
+                                  15 + 16, 8, Z_DEFAULT_STRATEGY));
+      compressed_.resize(kChunkSize);
+    }
+  }
+
+  ~FdOutputStream() override {
+    if (compress_)
+      deflateEnd(&zstream_);
+  }
 
   int GetChunkSize() override {
-    return 65536;  // big chunks == faster
+    return kChunkSize;  // big chunks == faster
   }
 
-  void EndOfStream() override {}
+  void EndOfStream() override {
+    if (compress_ && error_ == 0)
+      Deflate(nullptr, 0, Z_FINISH);
+  }
 
   WriteResult WriteAsciiChunk(char* data, int size) override {
-    const size_t len = static_cast<size_t>(size);
-    size_t off = 0;
+    bool ok = compress_ ? Deflate(data, size, Z_NO_FLUSH) : Write(data, size);
+    return ok ? kContinue : kAbort;
+  }
 
-    while (off < len && !feof(stream_) && !ferror(stream_))
-      off += fwrite(data + off, 1, len - off, stream_);
+  // Returns 0 or the first libuv error that occurred while writing.
+  int error() const { return error_; }
 
-    return off == len ? kContinue : kAbort;
+ private:
+  static const int kChunkSize = 65536;
+
+  bool Write(const char* data, size_t size) {
+    while (size > 0) {
+      uv_fs_t req;
+      uv_buf_t buf = uv_buf_init(const_cast<char*>(data), size);
+      int r = uv_fs_write(nullptr, &req, fd_, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (r < 0) {
+        error_ = r;
+        return false;
+      }
+      data += r;
+      size -= r;
+    }
+    return true;
   }
 
- private:
-  FILE* stream_;
+  bool Deflate(char* data, size_t size, int flush) {
+    zstream_.next_in = reinterpret_cast<Bytef*>(data);
+    zstream_.avail_in = size;
+    do {
+      zstream_.next_out = reinterpret_cast<Bytef*>(compressed_.data());
+      zstream_.avail_out = compressed_.size();
+      int err = deflate(&zstream_, flush);
+      CHECK_NE(err, Z_STREAM_ERROR);
+      if (!Write(compressed_.data(),
+                 compressed_.size() - zstream_.avail_out)) {
+        return false;
+      }
+    } while (zstream_.avail_out == 0);
+    return true;
+  }
+
+  uv_file fd_;
+  bool compress_;
+  z_stream zstream_;
+  std::vector<char> compressed_;
+  int error_ = 0;
 };
 
 class HeapSnapshotStream : public AsyncWrap,
@@ -315,14 +380,23 @@ inline void TakeSnapshot(Isolate* isolate, v8::OutputStream* out) {
 
 }  // namespace
 
-bool WriteSnapshot(Isolate* isolate, const char* filename) {
-  FILE* fp = fopen(filename, "w");
-  if (fp == nullptr)
-    return false;
-  FileOutputStream stream(fp);
+int WriteSnapshot(Isolate* isolate, uv_file fd, bool compress) {
+  FdOutputStream stream(fd, compress);
   TakeSnapshot(isolate, &stream);
-  fclose(fp);
-  return true;
+  return stream.error();
+}
+
+bool WriteSnapshot(Isolate* isolate, const char* filename, bool compress) {
+  uv_fs_t req;
+  uv_file fd = uv_fs_open(nullptr, &req, filename,
+                          O_WRONLY | O_CREAT | O_TRUNC, 0666, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0)
+    return false;
+  bool ok = WriteSnapshot(isolate, fd, compress) == 0;
+  CHECK_EQ(0, uv_fs_close(nullptr, &req, fd, nullptr));
+  uv_fs_req_cleanup(&req);
+  return ok;
 }
 
 void DeleteHeapSnapshot(const HeapSnapshot* snapshot) {
@@ -365,15 +439,48 @@ void CreateHeapSnapshotStream(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(stream->object());
 }
 
+// Like WriteSnapshot(), but throws an exception if the file cannot be opened
+// or written. Returns false if an exception was thrown.
+static bool WriteSnapshotOrThrow(Environment* env,
+                                 const char* filename,
+                                 bool compress) {
+  uv_fs_t req;
+  uv_file fd = uv_fs_open(nullptr, &req, filename,
+                          O_WRONLY | O_CREAT | O_TRUNC, 0666, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0) {
+    env->ThrowUVException(fd, "open", nullptr, filename);
+    return false;
+  }
+  int err = WriteSnapshot(env->isolate(), fd, compress);
+  CHECK_EQ(0, uv_fs_close(nullptr, &req, fd, nullptr));
+  uv_fs_req_cleanup(&req);
+  if (err != 0) {
+    env->ThrowUVException(err, "write", nullptr, filename);
+    return false;
+  }
+  return true;
+}
+
 void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = args.GetIsolate();
 
   Local<Value> filename_v = args[0];
+  bool compress = args[2]->IsTrue();
+
+  if (args[1]->IsInt32()) {
+    // The snapshot is written to a file descriptor owned by the caller.
+    int err = WriteSnapshot(isolate, args[1].As<Int32>()->Value(), compress);
+    if (err != 0)
+      env->ThrowUVException(err, "write");
+    return;
+  }
 
   if (filename_v->IsUndefined()) {
-    DiagnosticFilename name(env, "Heap", "heapsnapshot");
-    if (!WriteSnapshot(isolate, *name))
+    DiagnosticFilename name(env, "Heap", compress ? "heapsnapshot.gz" :
+                                                    "heapsnapshot");
+    if (!WriteSnapshotOrThrow(env, *name, compress))
       return;
     if (String::NewFromUtf8(isolate, *name).ToLocal(&filename_v)) {
       args.GetReturnValue().Set(filename_v);
@@ -383,7 +490,7 @@ void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
 
   BufferValue path(isolate, filename_v);
   CHECK_NOT_NULL(*path);
-  if (!WriteSnapshot(isolate, *path))
+  if (!WriteSnapshotOrThrow(env, *path, compress))
     return;
   return args.GetReturnValue().Set(filename_v);
 }
@@ -399,7 +506,15 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "createHeapSnapshotStream", CreateHeapSnapshotStream);
 }
 
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(BuildEmbedderGraph);
+  registry->Register(TriggerHeapSnapshot);
+  registry->Register(CreateHeapSnapshotStream);
+}
+
 }  // namespace heap
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(heap_utils, node::heap::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(heap_utils,
+                               node::heap::RegisterExternalReferences)
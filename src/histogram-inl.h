@@ -17,6 +17,14 @@ bool Histogram::Record(int64_t value) {
   return hdr_record_value(histogram_.get(), value);
 }
 
+void Histogram::Add(const Histogram& other) {
+  hdr_add(histogram_.get(), other.histogram_.get());
+}
+
+int64_t Histogram::Count() const {
+  return histogram_->total_count;
+}
+
 int64_t Histogram::Min() {
   return hdr_min(histogram_.get());
 }
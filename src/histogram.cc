@@ -1,14 +1,18 @@
 #include "histogram.h"  // NOLINT(build/include_inline)
 #include "histogram-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_errors.h"
 
 namespace node {
 
+using v8::BigInt;
+using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Local;
 using v8::Map;
 using v8::Number;
+using v8::Object;
 using v8::ObjectTemplate;
 using v8::String;
 using v8::Value;
@@ -138,4 +142,238 @@ void HistogramBase::Initialize(Environment* env) {
   env->set_histogram_instance_template(histogramt);
 }
 
+ConcurrentHistogram::ConcurrentHistogram(int64_t lowest,
+                                         int64_t highest,
+                                         int figures)
+    : lowest_(lowest), highest_(highest), figures_(figures) {}
+
+ConcurrentHistogram::~ConcurrentHistogram() {
+  for (std::atomic<Shard*>& shard : shards_)
+    delete shard.load();
+}
+
+ConcurrentHistogram::Shard* ConcurrentHistogram::GetShard() {
+  // Threads are assigned to the shards round-robin when they first record
+  // into any ConcurrentHistogram.
+  static std::atomic<size_t> next_index {0};
+  static thread_local size_t index = next_index++ % kShards;
+
+  Shard* shard = shards_[index].load(std::memory_order_acquire);
+  if (shard != nullptr) return shard;
+  Shard* created = new Shard(lowest_, highest_, figures_);
+  if (shards_[index].compare_exchange_strong(shard, created,
+                                             std::memory_order_acq_rel)) {
+    return created;
+  }
+  // Another thread with the same index was faster.
+  delete created;
+  return shard;
+}
+
+bool ConcurrentHistogram::Record(int64_t value) {
+  Shard* shard = GetShard();
+  bool recorded;
+  {
+    Mutex::ScopedLock lock(shard->mutex);
+    recorded = shard->histogram.Record(value);
+  }
+  if (!recorded) exceeds_++;
+  return recorded;
+}
+
+void ConcurrentHistogram::Reset() {
+  for (std::atomic<Shard*>& entry : shards_) {
+    Shard* shard = entry.load(std::memory_order_acquire);
+    if (shard == nullptr) continue;
+    Mutex::ScopedLock lock(shard->mutex);
+    shard->histogram.Reset();
+  }
+  exceeds_ = 0;
+}
+
+std::unique_ptr<Histogram> ConcurrentHistogram::Snapshot() {
+  auto result = std::make_unique<Histogram>(lowest_, highest_, figures_);
+  for (std::atomic<Shard*>& entry : shards_) {
+    Shard* shard = entry.load(std::memory_order_acquire);
+    if (shard == nullptr) continue;
+    Mutex::ScopedLock lock(shard->mutex);
+    result->Add(shard->histogram);
+  }
+  return result;
+}
+
+size_t ConcurrentHistogram::GetMemorySize() const {
+  size_t size = 0;
+  for (const std::atomic<Shard*>& entry : shards_) {
+    Shard* shard = entry.load(std::memory_order_acquire);
+    if (shard != nullptr)
+      size += shard->histogram.GetMemorySize();
+  }
+  return size;
+}
+
+ConcurrentHistogramBase::ConcurrentHistogramBase(
+    Environment* env,
+    Local<Object> wrap,
+    std::shared_ptr<ConcurrentHistogram> histogram)
+    : BaseObject(env, wrap),
+      histogram_(std::move(histogram)) {
+  MakeWeak();
+}
+
+void ConcurrentHistogramBase::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("histogram", histogram_->GetMemorySize());
+}
+
+void ConcurrentHistogramBase::DoRecord(
+    const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsNumber() || args[0]->IsBigInt());
+  int64_t value = args[0]->IsBigInt() ?
+      args[0].As<BigInt>()->Int64Value() :
+      static_cast<int64_t>(args[0].As<Number>()->Value());
+  histogram->histogram_->Record(value);
+}
+
+void ConcurrentHistogramBase::GetCount(
+    const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  double value =
+      static_cast<double>(histogram->histogram_->Snapshot()->Count());
+  args.GetReturnValue().Set(value);
+}
+
+void ConcurrentHistogramBase::GetMin(const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  double value =
+      static_cast<double>(histogram->histogram_->Snapshot()->Min());
+  args.GetReturnValue().Set(value);
+}
+
+void ConcurrentHistogramBase::GetMax(const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  double value =
+      static_cast<double>(histogram->histogram_->Snapshot()->Max());
+  args.GetReturnValue().Set(value);
+}
+
+void ConcurrentHistogramBase::GetMean(const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->histogram_->Snapshot()->Mean());
+}
+
+void ConcurrentHistogramBase::GetExceeds(
+    const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  double value = static_cast<double>(histogram->histogram_->Exceeds());
+  args.GetReturnValue().Set(value);
+}
+
+void ConcurrentHistogramBase::GetStddev(
+    const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->histogram_->Snapshot()->Stddev());
+}
+
+void ConcurrentHistogramBase::GetPercentile(
+    const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsNumber());
+  double percentile = args[0].As<Number>()->Value();
+  args.GetReturnValue().Set(
+      histogram->histogram_->Snapshot()->Percentile(percentile));
+}
+
+void ConcurrentHistogramBase::GetPercentiles(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsMap());
+  Local<Map> map = args[0].As<Map>();
+  histogram->histogram_->Snapshot()->Percentiles(
+      [map, env](double key, double value) {
+        map->Set(
+            env->context(),
+            Number::New(env->isolate(), key),
+            Number::New(env->isolate(), value)).IsEmpty();
+      });
+}
+
+void ConcurrentHistogramBase::DoReset(
+    const FunctionCallbackInfo<Value>& args) {
+  ConcurrentHistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  histogram->histogram_->Reset();
+}
+
+std::unique_ptr<worker::TransferData>
+ConcurrentHistogramBase::CloneForMessaging() const {
+  return std::make_unique<ConcurrentHistogramTransferData>(histogram_);
+}
+
+BaseObjectPtr<BaseObject>
+ConcurrentHistogramBase::ConcurrentHistogramTransferData::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<worker::TransferData> self) {
+  if (context != env->context()) {
+    THROW_ERR_MESSAGE_TARGET_CONTEXT_UNAVAILABLE(env);
+    return {};
+  }
+  return ConcurrentHistogramBase::New(env, std::move(histogram_));
+}
+
+BaseObjectPtr<ConcurrentHistogramBase> ConcurrentHistogramBase::New(
+    Environment* env,
+    std::shared_ptr<ConcurrentHistogram> histogram) {
+  Initialize(env);
+  Local<Object> obj;
+  if (!env->concurrent_histogram_instance_template()
+           ->NewInstance(env->context()).ToLocal(&obj)) {
+    return {};
+  }
+  return MakeBaseObject<ConcurrentHistogramBase>(
+      env, obj, std::move(histogram));
+}
+
+void ConcurrentHistogramBase::Initialize(Environment* env) {
+  // Guard against multiple initializations
+  if (!env->concurrent_histogram_instance_template().IsEmpty())
+    return;
+
+  Local<FunctionTemplate> histogram = FunctionTemplate::New(env->isolate());
+  Local<String> classname =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "ConcurrentHistogram");
+  histogram->SetClassName(classname);
+  // Inheriting from BaseObject makes postMessage() recognize the handles.
+  histogram->Inherit(BaseObject::GetConstructorTemplate(env));
+
+  Local<ObjectTemplate> histogramt =
+    histogram->InstanceTemplate();
+
+  histogramt->SetInternalFieldCount(
+      ConcurrentHistogramBase::kInternalFieldCount);
+  env->SetProtoMethod(histogram, "record", DoRecord);
+  env->SetProtoMethodNoSideEffect(histogram, "count", GetCount);
+  env->SetProtoMethodNoSideEffect(histogram, "exceeds", GetExceeds);
+  env->SetProtoMethodNoSideEffect(histogram, "min", GetMin);
+  env->SetProtoMethodNoSideEffect(histogram, "max", GetMax);
+  env->SetProtoMethodNoSideEffect(histogram, "mean", GetMean);
+  env->SetProtoMethodNoSideEffect(histogram, "stddev", GetStddev);
+  env->SetProtoMethodNoSideEffect(histogram, "percentile", GetPercentile);
+  env->SetProtoMethod(histogram, "percentiles", GetPercentiles);
+  env->SetProtoMethod(histogram, "reset", DoReset);
+
+  env->set_concurrent_histogram_instance_template(histogramt);
+}
+
 }  // namespace node
@@ -5,11 +5,15 @@
 
 #include "hdr_histogram.h"
 #include "base_object.h"
+#include "node_messaging.h"
+#include "node_mutex.h"
 #include "util.h"
 
+#include <atomic>
 #include <functional>
 #include <limits>
 #include <map>
+#include <memory>
 
 namespace node {
 
@@ -25,6 +29,9 @@ class Histogram {
 
   inline bool Record(int64_t value);
   inline void Reset();
+  // Adds the values recorded in |other|, which must cover the same range.
+  inline void Add(const Histogram& other);
+  inline int64_t Count() const;
   inline int64_t Min();
   inline int64_t Max();
   inline double Mean();
@@ -91,6 +98,110 @@ class HistogramBase : public BaseObject, public Histogram {
   uint64_t prev_ = 0;
 };
 
+// A histogram that can be recorded from any thread, e.g. from the threadpool
+// or from several Workers at once. Each recording thread is assigned one of
+// a fixed number of shards, so that threads rarely contend for the same
+// lock, and the shards are merged when the histogram is read. Shards are
+// only allocated once a thread records into them.
+class ConcurrentHistogram {
+ public:
+  static constexpr size_t kShards = 8;
+
+  ConcurrentHistogram(
+      int64_t lowest = 1,
+      int64_t highest = std::numeric_limits<int64_t>::max(),
+      int figures = kDefaultHistogramFigures);
+  ~ConcurrentHistogram();
+
+  ConcurrentHistogram(const ConcurrentHistogram&) = delete;
+  ConcurrentHistogram& operator=(const ConcurrentHistogram&) = delete;
+
+  // Returns false and counts the value as exceeding the histogram if it is
+  // out of range.
+  bool Record(int64_t value);
+  void Reset();
+  // Returns a histogram that contains the values of all shards.
+  std::unique_ptr<Histogram> Snapshot();
+
+  int64_t Exceeds() const { return exceeds_; }
+  size_t GetMemorySize() const;
+
+ private:
+  struct Shard {
+    Shard(int64_t lowest, int64_t highest, int figures)
+        : histogram(lowest, highest, figures) {}
+    Mutex mutex;
+    Histogram histogram;
+  };
+
+  Shard* GetShard();
+
+  int64_t lowest_;
+  int64_t highest_;
+  int figures_;
+  std::atomic<int64_t> exceeds_ {0};
+  std::atomic<Shard*> shards_[kShards] = {};
+};
+
+// The JS handle of a ConcurrentHistogram. It can be cloned to other threads
+// with postMessage(), which creates another handle for the same histogram.
+class ConcurrentHistogramBase : public BaseObject {
+ public:
+  static void Initialize(Environment* env);
+  static BaseObjectPtr<ConcurrentHistogramBase> New(
+      Environment* env,
+      std::shared_ptr<ConcurrentHistogram> histogram);
+
+  ConcurrentHistogramBase(
+      Environment* env,
+      v8::Local<v8::Object> wrap,
+      std::shared_ptr<ConcurrentHistogram> histogram);
+
+  static void DoRecord(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetCount(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetMin(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetMax(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetMean(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetExceeds(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetStddev(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetPercentile(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetPercentiles(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void DoReset(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  TransferMode GetTransferMode() const override {
+    return TransferMode::kCloneable;
+  }
+  std::unique_ptr<worker::TransferData> CloneForMessaging() const override;
+
+  class ConcurrentHistogramTransferData : public worker::TransferData {
+   public:
+    explicit ConcurrentHistogramTransferData(
+        std::shared_ptr<ConcurrentHistogram> histogram)
+        : histogram_(std::move(histogram)) {}
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<worker::TransferData> self) override;
+
+    SET_MEMORY_INFO_NAME(ConcurrentHistogramTransferData)
+    SET_SELF_SIZE(ConcurrentHistogramTransferData)
+    SET_NO_MEMORY_INFO()
+
+   private:
+    std::shared_ptr<ConcurrentHistogram> histogram_;
+  };
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(ConcurrentHistogramBase)
+  SET_SELF_SIZE(ConcurrentHistogramBase)
+
+ private:
+  std::shared_ptr<ConcurrentHistogram> histogram_;
+};
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
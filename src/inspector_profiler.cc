@@ -2,21 +2,27 @@
 #include "base_object-inl.h"
 #include "debug_utils-inl.h"
 #include "diagnosticfilename-inl.h"
+#include "json_utils.h"
 #include "memory_tracker-inl.h"
 #include "node_file.h"
 #include "node_errors.h"
+#include "node_external_reference.h"
 #include "node_internals.h"
 #include "util-inl.h"
 #include "v8-inspector.h"
 
 #include <cinttypes>
 #include <sstream>
+#include <vector>
 
 namespace node {
 namespace profiler {
 
 using errors::TryCatchScope;
 using v8::Context;
+using v8::CpuProfile;
+using v8::CpuProfileNode;
+using v8::CpuProfiler;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::HandleScope;
@@ -397,6 +403,130 @@ void V8HeapProfilerConnection::End() {
   DispatchMessage("HeapProfiler.stopSampling", nullptr, true);
 }
 
+V8ContinuousCpuProfiler::V8ContinuousCpuProfiler(Environment* env)
+    : env_(env) {}
+
+V8ContinuousCpuProfiler::~V8ContinuousCpuProfiler() {
+  if (profiler_ != nullptr)
+    profiler_->Dispose();
+}
+
+Local<String> V8ContinuousCpuProfiler::GetTitle(uint32_t window) const {
+  std::string title = "continuous-" + std::to_string(window);
+  return OneByteString(env_->isolate(), title.c_str(), title.size());
+}
+
+void V8ContinuousCpuProfiler::Start() {
+  HandleScope handle_scope(env_->isolate());
+  profiler_ = CpuProfiler::New(env_->isolate());
+  profiler_->SetSamplingInterval(static_cast<int>(env_->cpu_prof_interval()));
+  // Without recording the samples, V8 only updates the hit counts of the
+  // call tree.
+  profiler_->StartProfiling(GetTitle(window_), v8::kLeafNodeLineNumbers,
+                            false);
+
+  uint64_t window = env_->options()->cpu_prof_window;
+  if (window == 0) return;
+  CHECK_EQ(0, uv_timer_init(env_->event_loop(), &timer_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+  CHECK_EQ(0, uv_timer_start(&timer_, OnTimer, window, window));
+  env_->RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&timer_),
+      [](Environment* env, uv_handle_t* handle, void* arg) {
+        env->CloseHandle(handle, [](uv_handle_t* handle) {});
+      },
+      nullptr);
+}
+
+void V8ContinuousCpuProfiler::OnTimer(uv_timer_t* timer) {
+  V8ContinuousCpuProfiler* profiler =
+      ContainerOf(&V8ContinuousCpuProfiler::timer_, timer);
+  profiler->Flush();
+}
+
+void V8ContinuousCpuProfiler::Flush() {
+  if (ending_) return;
+  HandleScope handle_scope(env_->isolate());
+  Debug(env_, DebugCategory::INSPECTOR_PROFILER,
+        "V8ContinuousCpuProfiler::Flush(), window = %d\n", window_);
+  // Start the next window before stopping the current one, so that V8 keeps
+  // the sampler and its code map around instead of rebuilding them.
+  profiler_->StartProfiling(GetTitle(window_ + 1), v8::kLeafNodeLineNumbers,
+                            false);
+  CpuProfile* profile = profiler_->StopProfiling(GetTitle(window_++));
+  WriteProfile(profile);
+}
+
+void V8ContinuousCpuProfiler::End() {
+  Debug(env_, DebugCategory::INSPECTOR_PROFILER,
+        "V8ContinuousCpuProfiler::End(), ending = %d\n", ending_);
+  if (ending_) return;
+  ending_ = true;
+  if (env_->options()->cpu_prof_window > 0)
+    uv_timer_stop(&timer_);
+  HandleScope handle_scope(env_->isolate());
+  WriteProfile(profiler_->StopProfiling(GetTitle(window_)));
+}
+
+// Writes the profile in the same format as the ones from the inspector, which
+// can be loaded into Chrome DevTools. Since the samples are not recorded, the
+// `samples` and `timeDeltas` arrays are left out and only the hit counts of
+// the nodes are available.
+void V8ContinuousCpuProfiler::WriteProfile(CpuProfile* profile) {
+  if (profile == nullptr) return;
+
+  std::ostringstream out;
+  JSONWriter writer(out, true);
+  writer.json_start();
+  writer.json_arraystart("nodes");
+  std::vector<const CpuProfileNode*> pending = { profile->GetTopDownRoot() };
+  while (!pending.empty()) {
+    const CpuProfileNode* node = pending.back();
+    pending.pop_back();
+    writer.json_start();
+    writer.json_keyvalue("id", node->GetNodeId());
+    writer.json_objectstart("callFrame");
+    writer.json_keyvalue("functionName", node->GetFunctionNameStr());
+    writer.json_keyvalue("scriptId", std::to_string(node->GetScriptId()));
+    writer.json_keyvalue("url", node->GetScriptResourceNameStr());
+    // The inspector protocol uses 0-based line and column numbers.
+    writer.json_keyvalue("lineNumber", node->GetLineNumber() - 1);
+    writer.json_keyvalue("columnNumber", node->GetColumnNumber() - 1);
+    writer.json_objectend();
+    writer.json_keyvalue("hitCount", node->GetHitCount());
+    writer.json_arraystart("children");
+    for (int i = 0; i < node->GetChildrenCount(); i++) {
+      const CpuProfileNode* child = node->GetChild(i);
+      writer.json_element(child->GetNodeId());
+      pending.push_back(child);
+    }
+    writer.json_arrayend();
+    writer.json_end();
+  }
+  writer.json_arrayend();
+  writer.json_keyvalue("startTime", profile->GetStartTime());
+  writer.json_keyvalue("endTime", profile->GetEndTime());
+  writer.json_end();
+  profile->Delete();
+
+  const std::string& directory = env_->cpu_prof_dir();
+  if (!EnsureDirectory(directory, "CPU")) return;
+  DiagnosticFilename filename(env_, "CPU", "cpuprofile");
+  std::string path = directory + kPathSeparator;
+  path += *filename;
+  std::string result = out.str();
+  int ret = WriteFileSync(path.c_str(),
+                          uv_buf_init(&result[0], result.size()));
+  if (ret != 0) {
+    char err_buf[128];
+    uv_err_name_r(ret, err_buf, sizeof(err_buf));
+    fprintf(stderr, "%s: Failed to write file %s\n", err_buf, path.c_str());
+    return;
+  }
+  Debug(env_, DebugCategory::INSPECTOR_PROFILER, "Written result to %s\n",
+        path);
+}
+
 // For now, we only support coverage profiling, but we may add more
 // in the future.
 static void EndStartedProfilers(Environment* env) {
@@ -416,6 +546,12 @@ static void EndStartedProfilers(Environment* env) {
   if (connection != nullptr) {
     connection->End();
   }
+
+  V8ContinuousCpuProfiler* continuous_profiler =
+      env->continuous_cpu_profiler();
+  if (continuous_profiler != nullptr) {
+    continuous_profiler->End();
+  }
 }
 
 void StartProfilers(Environment* env) {
@@ -432,7 +568,17 @@ void StartProfilers(Environment* env) {
     env->set_coverage_connection(std::make_unique<V8CoverageConnection>(env));
     env->coverage_connection()->Start();
   }
-  if (env->options()->cpu_prof) {
+  if (env->options()->cpu_prof &&
+      (env->options()->cpu_prof_window > 0 ||
+       !env->options()->cpu_prof_signal.empty())) {
+    const std::string& dir = env->options()->cpu_prof_dir;
+    env->set_cpu_prof_interval(env->options()->cpu_prof_interval);
+    env->set_cpu_prof_dir(dir.empty() ? env->GetCwd() : dir);
+    CHECK_NULL(env->continuous_cpu_profiler());
+    env->set_continuous_cpu_profiler(
+        std::make_unique<V8ContinuousCpuProfiler>(env));
+    env->continuous_cpu_profiler()->Start();
+  } else if (env->options()->cpu_prof) {
     const std::string& dir = env->options()->cpu_prof_dir;
     env->set_cpu_prof_interval(env->options()->cpu_prof_interval);
     env->set_cpu_prof_dir(dir.empty() ? env->GetCwd() : dir);
@@ -508,6 +654,13 @@ static void StopCoverage(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+static void FlushCpuProfile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  V8ContinuousCpuProfiler* profiler = env->continuous_cpu_profiler();
+  if (profiler != nullptr)
+    profiler->Flush();
+}
+
 static void Initialize(Local<Object> target,
                        Local<Value> unused,
                        Local<Context> context,
@@ -517,9 +670,20 @@ static void Initialize(Local<Object> target,
   env->SetMethod(target, "setSourceMapCacheGetter", SetSourceMapCacheGetter);
   env->SetMethod(target, "takeCoverage", TakeCoverage);
   env->SetMethod(target, "stopCoverage", StopCoverage);
+  env->SetMethod(target, "flushCpuProfile", FlushCpuProfile);
+}
+
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(SetCoverageDirectory);
+  registry->Register(SetSourceMapCacheGetter);
+  registry->Register(TakeCoverage);
+  registry->Register(StopCoverage);
+  registry->Register(FlushCpuProfile);
 }
 
 }  // namespace profiler
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(profiler, node::profiler::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(profiler,
+                               node::profiler::RegisterExternalReferences)
@@ -9,6 +9,8 @@
 
 #include <unordered_set>
 #include "inspector_agent.h"
+#include "uv.h"
+#include "v8-profiler.h"
 
 namespace node {
 // Forward declaration to break recursive dependency chain with src/env.h.
@@ -142,6 +144,37 @@ class V8HeapProfilerConnection : public V8ProfilerConnection {
   bool ending_ = false;
 };
 
+// Used instead of V8CpuProfilerConnection when --cpu-prof-window or
+// --cpu-prof-signal is passed. Instead of recording every sample until the
+// process exits, this only keeps the aggregated call tree with the hit count
+// of every node, so that the memory usage only depends on the number of
+// distinct stacks. The profile is written and a new one is started after
+// every window, or when the signal is received.
+class V8ContinuousCpuProfiler {
+ public:
+  explicit V8ContinuousCpuProfiler(Environment* env);
+  ~V8ContinuousCpuProfiler();
+
+  void Start();
+  // Writes the profile of the current window and starts a new one.
+  void Flush();
+  // Writes the profile of the current window and stops profiling.
+  void End();
+
+  bool ending() const { return ending_; }
+
+ private:
+  static void OnTimer(uv_timer_t* timer);
+  v8::Local<v8::String> GetTitle(uint32_t window) const;
+  void WriteProfile(v8::CpuProfile* profile);
+
+  Environment* env_;
+  v8::CpuProfiler* profiler_ = nullptr;
+  uv_timer_t timer_;
+  uint32_t window_ = 0;
+  bool ending_ = false;
+};
+
 }  // namespace profiler
 }  // namespace node
 
@@ -2,6 +2,7 @@
 
 #include "env.h"
 #include "memory_tracker-inl.h"
+#include "node_compile_cache.h"
 #include "node_contextify.h"
 #include "node_errors.h"
 #include "node_internals.h"
@@ -136,7 +137,8 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
     // new ModuleWrap(url, context, exportNames, syntheticExecutionFunction)
     CHECK(args[3]->IsFunction());
   } else {
-    // new ModuleWrap(url, context, source, lineOffset, columOffset, cachedData)
+    // new ModuleWrap(url, context, source, lineOffset, columOffset, cachedData,
+    //                useCompileCache)
     CHECK(args[2]->IsString());
     CHECK(args[3]->IsNumber());
     line_offset = args[3].As<Integer>();
@@ -153,6 +155,7 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
   TryCatchScope try_catch(env);
 
   Local<Module> module;
+  CompileCacheEntry* cache_entry = nullptr;
 
   {
     Context::Scope context_scope(context);
@@ -172,6 +175,7 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
       module = Module::CreateSyntheticModule(isolate, url, export_names,
         SyntheticModuleEvaluationStepsCallback);
     } else {
+      Local<String> source_text = args[2].As<String>();
       ScriptCompiler::CachedData* cached_data = nullptr;
       if (!args[5]->IsUndefined()) {
         CHECK(args[5]->IsArrayBufferView());
@@ -181,9 +185,13 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         cached_data =
             new ScriptCompiler::CachedData(data + cached_data_buf->ByteOffset(),
                                            cached_data_buf->ByteLength());
+      } else if (args[6]->IsTrue() && contextify_context == nullptr &&
+                 env->compile_cache_handler() != nullptr) {
+        cache_entry = env->compile_cache_handler()->GetOrInsert(
+            source_text, url, CachedCodeType::kESM);
+        cached_data = cache_entry->GetCachedData();
       }
 
-      Local<String> source_text = args[2].As<String>();
       ScriptOrigin origin(url,
                           line_offset,                      // line offset
                           column_offset,                    // column offset
@@ -212,8 +220,13 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         }
         return;
       }
-      if (options == ScriptCompiler::kConsumeCodeCache &&
-          source.GetCachedData()->rejected) {
+      if (cache_entry != nullptr) {
+        // A stale cache is not an error, it is replaced on exit.
+        bool rejected = source.GetCachedData() != nullptr &&
+                        source.GetCachedData()->rejected;
+        env->compile_cache_handler()->MaybeSave(cache_entry, module, rejected);
+      } else if (options == ScriptCompiler::kConsumeCodeCache &&
+                 source.GetCachedData()->rejected) {
         THROW_ERR_VM_MODULE_CACHED_DATA_REJECTED(
             env, "cachedData buffer was rejected");
         try_catch.ReThrow();
@@ -31,12 +31,14 @@
 #include "node_internals.h"
 #include "node_main_instance.h"
 #include "node_metadata.h"
+#include "node_metrics.h"
 #include "node_native_module_env.h"
 #include "node_options-inl.h"
 #include "node_perf.h"
 #include "node_process.h"
 #include "node_report.h"
 #include "node_revert.h"
+#include "node_snapshotable.h"
 #include "node_v8_platform-inl.h"
 #include "node_version.h"
 
@@ -288,6 +290,8 @@ void Environment::InitializeDiagnostics() {
       env->isolate()->SetAtomicsWaitCallback(nullptr, nullptr);
     }, this);
   }
+  if (!options_->metrics_endpoint.empty() && is_main_thread())
+    metrics::MetricsServer::Start(this, options_->metrics_endpoint);
 
 #if defined HAVE_DTRACE || defined HAVE_ETW
   InitDTrace(this);
@@ -476,6 +480,10 @@ MaybeLocal<Value> StartExecution(Environment* env, StartExecutionCallback cb) {
     return StartExecution(env, "internal/main/worker_thread");
   }
 
+  if (!env->snapshot_deserialize_main().IsEmpty()) {
+    return StartExecution(env, "internal/main/run_snapshot_main");
+  }
+
   std::string first_argv;
   if (env->argv().size() > 1) {
     first_argv = env->argv()[1];
@@ -1059,7 +1067,30 @@ int Start(int argc, char** argv) {
     const EnvSerializeInfo* env_info = nullptr;
     bool force_no_snapshot =
         per_process::cli_options->per_isolate->no_node_snapshot;
-    if (!force_no_snapshot) {
+    // Must outlive the isolate that is deserialized from it.
+    SnapshotData snapshot_data;
+    if (per_process::cli_options->build_snapshot) {
+      result.exit_code = BuildSnapshot(result.args, result.exec_args);
+      TearDownOncePerProcess();
+      return result.exit_code;
+    } else if (!per_process::cli_options->snapshot_blob.empty()) {
+      const std::string& filename = per_process::cli_options->snapshot_blob;
+      FILE* fp = fopen(filename.c_str(), "rb");
+      if (fp == nullptr) {
+        fprintf(stderr, "Cannot open %s\n", filename.c_str());
+        TearDownOncePerProcess();
+        return 1;
+      }
+      bool ok = SnapshotData::FromFile(&snapshot_data, fp);
+      fclose(fp);
+      if (!ok) {
+        TearDownOncePerProcess();
+        return 1;
+      }
+      params.snapshot_blob = &snapshot_data.v8_snapshot_blob_data;
+      indexes = &snapshot_data.isolate_data_indexes;
+      env_info = &snapshot_data.env_info;
+    } else if (!force_no_snapshot) {
       v8::StartupData* blob = NodeMainInstance::GetEmbeddedSnapshotBlob();
       if (blob != nullptr) {
         params.snapshot_blob = blob;
@@ -0,0 +1,312 @@
+#include "node_compile_cache.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_file.h"
+#include "node_internals.h"
+#include "node_version.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#include <cstring>
+#include <vector>
+
+namespace node {
+
+using v8::Function;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Module;
+using v8::ScriptCompiler;
+using v8::String;
+using v8::UnboundModuleScript;
+
+namespace {
+
+// Every cache file starts with this header, followed by |cache_size| bytes
+// of code cache produced by V8.
+struct CacheFileHeader {
+  uint32_t code_size;
+  uint32_t code_hash;
+  uint32_t cache_size;
+  uint32_t cache_hash;
+};
+
+inline uint32_t GetHash(const char* data, size_t size) {
+  uLong crc = crc32(0L, Z_NULL, 0);
+  return crc32(crc, reinterpret_cast<const Bytef*>(data), size);
+}
+
+std::string GetCacheVersionTag() {
+  // CachedDataVersionTag() already covers the V8 version and the V8 flags
+  // that affect the generated code.
+  std::string tag = std::string(NODE_VERSION) + "-" + NODE_ARCH + "-" +
+                    std::to_string(ScriptCompiler::CachedDataVersionTag());
+  return std::to_string(GetHash(tag.data(), tag.size()));
+}
+
+std::string GetCacheFilename(const std::string& filename,
+                             CachedCodeType type) {
+  uint32_t hash = GetHash(filename.data(), filename.size());
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%08x", hash);
+  return std::string(buf) + (type == CachedCodeType::kESM ? ".mjs" : ".cjs") +
+         ".cache";
+}
+
+bool IsAbsolutePath(const std::string& path) {
+#ifdef _WIN32
+  return (path.size() > 1 && path[1] == ':') ||
+         (!path.empty() && (path[0] == '\\' || path[0] == '/'));
+#else
+  return !path.empty() && path[0] == '/';
+#endif
+}
+
+// Returns false if the file does not exist or could not be read entirely.
+bool ReadFile(uv_loop_t* loop,
+              const std::string& filename,
+              std::vector<char>* out) {
+  uv_fs_t req;
+  uv_file file = uv_fs_open(loop, &req, filename.c_str(), O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (file < 0) return false;
+
+  bool ok = true;
+  std::vector<char> result;
+  char chunk[8192];
+  while (true) {
+    uv_buf_t buf = uv_buf_init(chunk, sizeof(chunk));
+    int r = uv_fs_read(loop, &req, file, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (r < 0) ok = false;
+    if (r <= 0) break;
+    result.insert(result.end(), chunk, chunk + r);
+  }
+
+  uv_fs_close(loop, &req, file, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (ok) *out = std::move(result);
+  return ok;
+}
+
+}  // anonymous namespace
+
+ScriptCompiler::CachedData* CompileCacheEntry::GetCachedData() const {
+  if (!cache) return nullptr;
+  return new ScriptCompiler::CachedData(cache->data, cache->length);
+}
+
+CompileCacheHandler::CompileCacheHandler(Environment* env) : env_(env) {}
+
+CompileCacheHandler::~CompileCacheHandler() = default;
+
+bool CompileCacheHandler::InitializeDirectory(const std::string& dir) {
+  // Resolve relative paths now, the application may change the working
+  // directory before the caches are written.
+  std::string cache_dir = dir;
+  if (!IsAbsolutePath(cache_dir)) {
+    char buf[PATH_MAX_BYTES];
+    size_t cwd_len = sizeof(buf);
+    if (uv_cwd(buf, &cwd_len) == 0)
+      cache_dir = std::string(buf, cwd_len) + kPathSeparator + cache_dir;
+  }
+  cache_dir += kPathSeparator + GetCacheVersionTag();
+  uv_fs_t req;
+  int err = fs::MKDirpSync(env_->event_loop(), &req, cache_dir, 0777);
+  uv_fs_req_cleanup(&req);
+  if (err != 0 && err != UV_EEXIST) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "Cannot create cache directory %s: %s\n",
+          cache_dir, uv_strerror(err));
+    return false;
+  }
+  Debug(env_, DebugCategory::CODE_CACHE, "Using cache directory %s\n",
+        cache_dir);
+  cache_dir_ = std::move(cache_dir);
+  return true;
+}
+
+CompileCacheEntry* CompileCacheHandler::GetOrInsert(Local<String> code,
+                                                    Local<String> filename,
+                                                    CachedCodeType type) {
+  Isolate* isolate = env_->isolate();
+  Utf8Value filename_utf8(isolate, filename);
+  std::string key = (type == CachedCodeType::kESM ? "esm:" : "cjs:") +
+                    filename_utf8.ToString();
+
+  // Hash the UTF-16 contents so that the result does not depend on the
+  // encoding the source was read with.
+  String::Value code_value(isolate, code);
+  uint32_t code_size = code_value.length() * sizeof(**code_value);
+  uint32_t code_hash =
+      GetHash(reinterpret_cast<const char*>(*code_value), code_size);
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    CompileCacheEntry* entry = it->second.get();
+    // The same module can be loaded more than once, e.g. after it has been
+    // removed from require.cache. Only keep the cache if it still matches.
+    if (entry->code_hash == code_hash && entry->code_size == code_size)
+      return entry;
+    entry->cache.reset();
+    entry->cache_consumed = false;
+    entry->function.Reset();
+    entry->module_script.Reset();
+    entry->code_hash = code_hash;
+    entry->code_size = code_size;
+    return entry;
+  }
+
+  auto entry = std::make_unique<CompileCacheEntry>();
+  entry->source_filename = filename_utf8.ToString();
+  entry->cache_filename =
+      cache_dir_ + kPathSeparator + GetCacheFilename(key, type);
+  entry->type = type;
+  entry->code_hash = code_hash;
+  entry->code_size = code_size;
+  ReadCacheFile(entry.get());
+
+  CompileCacheEntry* result = entry.get();
+  entries_.emplace(std::move(key), std::move(entry));
+  return result;
+}
+
+void CompileCacheHandler::ReadCacheFile(CompileCacheEntry* entry) {
+  std::vector<char> contents;
+  if (!ReadFile(env_->event_loop(), entry->cache_filename, &contents)) {
+    Debug(env_, DebugCategory::CODE_CACHE, "No cache for %s at %s\n",
+          entry->source_filename, entry->cache_filename);
+    return;
+  }
+
+  CacheFileHeader header;
+  if (contents.size() < sizeof(header)) {
+    Debug(env_, DebugCategory::CODE_CACHE, "Truncated cache for %s\n",
+          entry->source_filename);
+    return;
+  }
+  memcpy(&header, contents.data(), sizeof(header));
+  const char* data = contents.data() + sizeof(header);
+  size_t data_size = contents.size() - sizeof(header);
+
+  if (header.code_size != entry->code_size ||
+      header.code_hash != entry->code_hash) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "Cache for %s was created for a different source\n",
+          entry->source_filename);
+    return;
+  }
+  if (header.cache_size != data_size ||
+      header.cache_hash != GetHash(data, data_size)) {
+    Debug(env_, DebugCategory::CODE_CACHE, "Corrupted cache for %s\n",
+          entry->source_filename);
+    return;
+  }
+
+  uint8_t* buffer = new uint8_t[data_size];
+  memcpy(buffer, data, data_size);
+  entry->cache = std::make_unique<ScriptCompiler::CachedData>(
+      buffer, data_size, ScriptCompiler::CachedData::BufferOwned);
+  Debug(env_, DebugCategory::CODE_CACHE, "Read %d bytes of cache for %s\n",
+        data_size, entry->source_filename);
+}
+
+// Returns true if V8 has accepted the cache of the entry now or when the
+// module was compiled before, in which case no new cache needs to be created.
+bool CompileCacheHandler::MarkConsumed(CompileCacheEntry* entry,
+                                       bool rejected) {
+  if (rejected || (!entry->cache && !entry->cache_consumed)) return false;
+  entry->cache.reset();
+  entry->cache_consumed = true;
+  return true;
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Function> function,
+                                    bool rejected) {
+  if (MarkConsumed(entry, rejected)) return;
+  Debug(env_, DebugCategory::CODE_CACHE, "%s cache for %s\n",
+        rejected ? "V8 rejected the" : "Will create", entry->source_filename);
+  entry->cache.reset();
+  entry->function.Reset(env_->isolate(), function);
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Module> module,
+                                    bool rejected) {
+  if (MarkConsumed(entry, rejected)) return;
+  Debug(env_, DebugCategory::CODE_CACHE, "%s cache for %s\n",
+        rejected ? "V8 rejected the" : "Will create", entry->source_filename);
+  entry->cache.reset();
+  entry->module_script.Reset(env_->isolate(),
+                             module->GetUnboundModuleScript());
+}
+
+void CompileCacheHandler::Persist() {
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+
+  for (const auto& it : entries_) {
+    CompileCacheEntry* entry = it.second.get();
+    std::unique_ptr<ScriptCompiler::CachedData> cache;
+    // The cache is only created now rather than right after compilation,
+    // so that it also contains the functions that have been compiled lazily
+    // since then.
+    if (!entry->function.IsEmpty()) {
+      cache.reset(ScriptCompiler::CreateCodeCacheForFunction(
+          entry->function.Get(isolate)));
+      entry->function.Reset();
+    } else if (!entry->module_script.IsEmpty()) {
+      cache.reset(ScriptCompiler::CreateCodeCache(
+          entry->module_script.Get(isolate)));
+      entry->module_script.Reset();
+    }
+    if (!cache || cache->length == 0) continue;
+    WriteCacheFile(entry, cache.get());
+  }
+}
+
+void CompileCacheHandler::WriteCacheFile(CompileCacheEntry* entry,
+                                         ScriptCompiler::CachedData* cache) {
+  CacheFileHeader header;
+  header.code_size = entry->code_size;
+  header.code_hash = entry->code_hash;
+  header.cache_size = cache->length;
+  header.cache_hash =
+      GetHash(reinterpret_cast<const char*>(cache->data), cache->length);
+
+  std::vector<char> contents(sizeof(header) + cache->length);
+  memcpy(contents.data(), &header, sizeof(header));
+  memcpy(contents.data() + sizeof(header), cache->data, cache->length);
+
+  // Write into a temporary file first and rename it afterwards so that
+  // other processes using the same directory never see a partial file.
+  // The name includes the thread id because the Workers of this process
+  // may flush the same entry at the same time.
+  std::string tmp_filename =
+      entry->cache_filename + "." + std::to_string(uv_os_getpid()) + "." +
+      std::to_string(env_->thread_id()) + ".tmp";
+  uv_buf_t buf = uv_buf_init(contents.data(), contents.size());
+  int err = WriteFileSync(tmp_filename.c_str(), buf);
+  if (err == 0) {
+    uv_fs_t req;
+    err = uv_fs_rename(env_->event_loop(), &req, tmp_filename.c_str(),
+                       entry->cache_filename.c_str(), nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err != 0) {
+      uv_fs_unlink(env_->event_loop(), &req, tmp_filename.c_str(), nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+  }
+
+  if (err != 0) {
+    Debug(env_, DebugCategory::CODE_CACHE, "Cannot write cache for %s: %s\n",
+          entry->source_filename, uv_strerror(err));
+    return;
+  }
+  Debug(env_, DebugCategory::CODE_CACHE, "Wrote %d bytes of cache for %s\n",
+        cache->length, entry->source_filename);
+}
+
+}  // namespace node
@@ -0,0 +1,94 @@
+#ifndef SRC_NODE_COMPILE_CACHE_H_
+#define SRC_NODE_COMPILE_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+
+enum class CachedCodeType : uint8_t {
+  kCommonJS = 0,
+  kESM,
+};
+
+// The code cache of one user module. The cache read from the disk, if any,
+// is kept until the module is compiled. If it was missing or rejected by V8,
+// the compiled module is kept so that a new cache can be created from it
+// when the cache is flushed, which then also contains the functions that
+// were lazily compiled while the application was running.
+struct CompileCacheEntry {
+  std::string source_filename;
+  std::string cache_filename;
+  CachedCodeType type;
+  uint32_t code_hash;
+  uint32_t code_size;
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cache;
+  // Whether V8 has accepted the cache read from the disk, which is released
+  // once it has been consumed.
+  bool cache_consumed = false;
+  v8::Global<v8::Function> function;
+  v8::Global<v8::UnboundModuleScript> module_script;
+
+  // Returns a CachedData that can be passed to ScriptCompiler::Source, which
+  // takes the ownership of it, or nullptr if there is no cache to consume.
+  // The returned object does not own the cache bytes, so the entry must
+  // outlive the compilation.
+  v8::ScriptCompiler::CachedData* GetCachedData() const;
+};
+
+// Stores the V8 code cache of user CommonJS and ES modules in a directory
+// that is passed with --experimental-code-cache-dir, so that they do not
+// have to be parsed and compiled from scratch on every start.
+// The caches are stored in a subdirectory that depends on the versions of
+// Node.js and V8 and the V8 flags, and each file is checked against a hash
+// of the source it was created for before it is used.
+class CompileCacheHandler {
+ public:
+  explicit CompileCacheHandler(Environment* env);
+  ~CompileCacheHandler();
+
+  // Returns false if the directory could not be created.
+  bool InitializeDirectory(const std::string& dir);
+
+  // Returns the entry of the module, reading its cache from the disk when
+  // the module is compiled for the first time in this process.
+  CompileCacheEntry* GetOrInsert(v8::Local<v8::String> code,
+                                 v8::Local<v8::String> filename,
+                                 CachedCodeType type);
+  // Called after the module has been compiled. |rejected| tells whether V8
+  // has rejected the cache that was passed to it.
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Function> function,
+                 bool rejected);
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Module> module,
+                 bool rejected);
+
+  // Writes the caches of the modules that did not have a usable one.
+  void Persist();
+
+  const std::string& cache_dir() const { return cache_dir_; }
+
+ private:
+  bool MarkConsumed(CompileCacheEntry* entry, bool rejected);
+  void ReadCacheFile(CompileCacheEntry* entry);
+  void WriteCacheFile(CompileCacheEntry* entry,
+                      v8::ScriptCompiler::CachedData* cache);
+
+  Environment* env_;
+  std::string cache_dir_;
+  std::unordered_map<std::string, std::unique_ptr<CompileCacheEntry>> entries_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_COMPILE_CACHE_H_
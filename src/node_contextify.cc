@@ -25,6 +25,7 @@
 #include "node_internals.h"
 #include "node_watchdog.h"
 #include "base_object-inl.h"
+#include "node_compile_cache.h"
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "module_wrap.h"
@@ -1078,6 +1079,16 @@ void ContextifyContext::CompileFunction(
     params_buf = args[8].As<Array>();
   }
 
+  // Argument 10: whether to use the compile cache (optional), only set
+  // for CommonJS modules.
+  CompileCacheEntry* cache_entry = nullptr;
+  if (args[9]->IsTrue() && env->compile_cache_handler() != nullptr &&
+      cached_data_buf.IsEmpty() && !produce_cached_data &&
+      parsing_context == context) {
+    cache_entry = env->compile_cache_handler()->GetOrInsert(
+        code, filename, CachedCodeType::kCommonJS);
+  }
+
   // Read cache from cached data buffer
   ScriptCompiler::CachedData* cached_data = nullptr;
   if (!cached_data_buf.IsEmpty()) {
@@ -1085,6 +1096,8 @@ void ContextifyContext::CompileFunction(
         cached_data_buf->Buffer()->GetBackingStore()->Data());
     cached_data = new ScriptCompiler::CachedData(
       data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+  } else if (cache_entry != nullptr) {
+    cached_data = cache_entry->GetCachedData();
   }
 
   // Get the function id
@@ -1159,6 +1172,12 @@ void ContextifyContext::CompileFunction(
     return;
   }
 
+  if (cache_entry != nullptr) {
+    bool rejected = source.GetCachedData() != nullptr &&
+                    source.GetCachedData()->rejected;
+    env->compile_cache_handler()->MaybeSave(cache_entry, fn, rejected);
+  }
+
   Local<Object> cache_key;
   if (!env->compiled_fn_entry_template()->NewInstance(
            context).ToLocal(&cache_key)) {
@@ -45,6 +45,7 @@ void Initialize(Local<Object> target,
   Environment* env = Environment::GetCurrent(context);
 
   AES::Initialize(env, target);
+  Checksum::Initialize(env, target);
   CipherBase::Initialize(env, target);
   DiffieHellman::Initialize(env, target);
   DSAAlg::Initialize(env, target);
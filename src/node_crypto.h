@@ -30,6 +30,7 @@
 // code should include the relevant src/crypto headers directly.
 #include "crypto/crypto_aes.h"
 #include "crypto/crypto_bio.h"
+#include "crypto/crypto_checksum.h"
 #include "crypto/crypto_cipher.h"
 #include "crypto/crypto_context.h"
 #include "crypto/crypto_dh.h"
@@ -22,6 +22,7 @@
 #include "node_file-inl.h"
 #include "aliased_buffer.h"
 #include "memory_tracker-inl.h"
+#include "node_external_reference.h"
 #include "node_buffer.h"
 #include "node_process.h"
 #include "node_stat_watcher.h"
@@ -67,6 +68,7 @@ using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::Promise;
+using v8::SnapshotCreator;
 using v8::String;
 using v8::Symbol;
 using v8::Uint32;
@@ -2391,8 +2393,56 @@ void BindingData::MemoryInfo(MemoryTracker* tracker) const {
                       file_handle_read_wrap_freelist);
 }
 
+BindingData::BindingData(Environment* env,
+                         Local<Object> wrap,
+                         const InternalFieldInfo* info)
+    : SnapshotableObject(env, wrap, EmbedderObjectType::k_fs_binding_data),
+      stats_field_array(env->isolate(),
+                        kFsStatsBufferLength,
+                        info == nullptr ? nullptr : &info->stats_field_array),
+      stats_field_bigint_array(
+          env->isolate(),
+          kFsStatsBufferLength,
+          info == nullptr ? nullptr : &info->stats_field_bigint_array) {
+  if (info != nullptr) {
+    stats_field_array.Deserialize(env->context());
+    stats_field_bigint_array.Deserialize(env->context());
+  }
+}
+
+void BindingData::PrepareForSerialization(Local<Context> context,
+                                          SnapshotCreator* creator) {
+  // The wraps in the freelist only cache memory and can be re-created.
+  file_handle_read_wrap_freelist.clear();
+  stats_field_array_index_ = stats_field_array.Serialize(context, creator);
+  stats_field_bigint_array_index_ =
+      stats_field_bigint_array.Serialize(context, creator);
+}
+
+InternalFieldInfoBase* BindingData::Serialize(int index) {
+  DCHECK_EQ(index, BaseObject::kSlot);
+  InternalFieldInfo* info =
+      InternalFieldInfoBase::New<InternalFieldInfo>(type());
+  info->stats_field_array = stats_field_array_index_;
+  info->stats_field_bigint_array = stats_field_bigint_array_index_;
+  return info;
+}
+
+void BindingData::Deserialize(Local<Context> context,
+                              Local<Object> holder,
+                              int index,
+                              InternalFieldInfoBase* info) {
+  DCHECK_EQ(index, BaseObject::kSlot);
+  HandleScope scope(context->GetIsolate());
+  Environment* env = Environment::GetCurrent(context);
+  BindingData* binding = env->AddBindingData<BindingData>(
+      context, holder, static_cast<InternalFieldInfo*>(info));
+  CHECK_NOT_NULL(binding);
+}
+
 // TODO(addaleax): Remove once we're on C++17.
 constexpr FastStringKey BindingData::binding_data_name;
+constexpr FastStringKey BindingData::type_name;
 
 void Initialize(Local<Object> target,
                 Local<Value> unused,
@@ -2537,8 +2587,55 @@ void Initialize(Local<Object> target,
 BindingData* FSReqBase::binding_data() {
   return binding_data_.get();
 }
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(Access);
+  registry->Register(Close);
+  registry->Register(Open);
+  registry->Register(OpenFileHandle);
+  registry->Register(Read);
+  registry->Register(ReadBuffers);
+  registry->Register(Fdatasync);
+  registry->Register(Fsync);
+  registry->Register(Rename);
+  registry->Register(FTruncate);
+  registry->Register(RMDir);
+  registry->Register(MKDir);
+  registry->Register(ReadDir);
+  registry->Register(InternalModuleReadJSON);
+  registry->Register(InternalModuleStat);
+  registry->Register(Stat);
+  registry->Register(LStat);
+  registry->Register(FStat);
+  registry->Register(Link);
+  registry->Register(Symlink);
+  registry->Register(ReadLink);
+  registry->Register(Unlink);
+  registry->Register(WriteBuffer);
+  registry->Register(WriteBuffers);
+  registry->Register(WriteString);
+  registry->Register(RealPath);
+  registry->Register(CopyFile);
+  registry->Register(Chmod);
+  registry->Register(FChmod);
+  registry->Register(Chown);
+  registry->Register(FChown);
+  registry->Register(LChown);
+  registry->Register(UTimes);
+  registry->Register(FUTimes);
+  registry->Register(LUTimes);
+  registry->Register(Mkdtemp);
+  registry->Register(NewFSReqCallback);
+
+  registry->Register(FileHandle::New);
+  registry->Register(FileHandle::Close);
+  registry->Register(FileHandle::ReleaseFD);
+  StreamBase::RegisterExternalReferences(registry);
+  StatWatcher::RegisterExternalReferences(registry);
+}
+
 }  // namespace fs
 
 }  // end namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(fs, node::fs::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(fs, node::fs::RegisterExternalReferences)
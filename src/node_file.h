@@ -6,6 +6,7 @@
 #include "node.h"
 #include "aliased_buffer.h"
 #include "node_messaging.h"
+#include "node_snapshotable.h"
 #include "stream_base.h"
 #include <iostream>
 
@@ -14,12 +15,16 @@ namespace fs {
 
 class FileHandleReadWrap;
 
-class BindingData : public BaseObject {
+class BindingData : public SnapshotableObject {
  public:
-  explicit BindingData(Environment* env, v8::Local<v8::Object> wrap)
-      : BaseObject(env, wrap),
-        stats_field_array(env->isolate(), kFsStatsBufferLength),
-        stats_field_bigint_array(env->isolate(), kFsStatsBufferLength) {}
+  // The snapshot indexes of the JS arrays of a deserialized BindingData.
+  struct InternalFieldInfo : public InternalFieldInfoBase {
+    AliasedBufferInfo stats_field_array;
+    AliasedBufferInfo stats_field_bigint_array;
+  };
+
+  BindingData(Environment* env, v8::Local<v8::Object> wrap,
+              const InternalFieldInfo* info = nullptr);
 
   AliasedFloat64Array stats_field_array;
   AliasedBigUint64Array stats_field_bigint_array;
@@ -27,11 +32,17 @@ class BindingData : public BaseObject {
   std::vector<BaseObjectPtr<FileHandleReadWrap>>
       file_handle_read_wrap_freelist;
 
+  SERIALIZABLE_OBJECT_METHODS()
   static constexpr FastStringKey binding_data_name { "fs" };
+  static constexpr FastStringKey type_name { "node::fs::BindingData" };
 
   void MemoryInfo(MemoryTracker* tracker) const override;
   SET_SELF_SIZE(BindingData)
   SET_MEMORY_INFO_NAME(BindingData)
+
+ private:
+  AliasedBufferInfo stats_field_array_index_ = 0;
+  AliasedBufferInfo stats_field_bigint_array_index_ = 0;
 };
 
 // structure used to store state during a complex operation, e.g., mkdirp.
@@ -364,7 +364,11 @@ class DiagnosticFilename {
 };
 
 namespace heap {
-bool WriteSnapshot(v8::Isolate* isolate, const char* filename);
+bool WriteSnapshot(v8::Isolate* isolate,
+                   const char* filename,
+                   bool compress = false);
+// Returns 0 or the libuv error that occurred while writing to fd.
+int WriteSnapshot(v8::Isolate* isolate, uv_file fd, bool compress = false);
 }
 
 class TraceEventScope {
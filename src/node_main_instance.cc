@@ -5,6 +5,7 @@
 #include "node_external_reference.h"
 #include "node_internals.h"
 #include "node_options-inl.h"
+#include "node_snapshotable.h"
 #include "node_v8_platform-inl.h"
 #include "util-inl.h"
 #if defined(LEAK_SANITIZER)
@@ -167,18 +168,6 @@ int NodeMainInstance::Run(const EnvSerializeInfo* env_info) {
   return exit_code;
 }
 
-void DeserializeNodeInternalFields(Local<Object> holder,
-                                   int index,
-                                   v8::StartupData payload,
-                                   void* env) {
-  if (payload.raw_size == 0) {
-    holder->SetAlignedPointerInInternalField(index, nullptr);
-    return;
-  }
-  // No embedder object in the builtin snapshot yet.
-  UNREACHABLE();
-}
-
 DeleteFnPtr<Environment, FreeEnvironment>
 NodeMainInstance::CreateMainEnvironment(int* exit_code,
                                         const EnvSerializeInfo* env_info) {
@@ -70,9 +70,61 @@ Maybe<bool> TransferData::FinalizeTransferWrite(
   return Just(true);
 }
 
+MallocedBuffer<char> MessageArena::Acquire(size_t size) {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    // Use the smallest cached chunk that is large enough, if any.
+    auto best = free_chunks_.end();
+    for (auto it = free_chunks_.begin(); it != free_chunks_.end(); ++it) {
+      if (it->size >= size &&
+          (best == free_chunks_.end() || it->size < best->size)) {
+        best = it;
+      }
+    }
+    if (best != free_chunks_.end()) {
+      MallocedBuffer<char> chunk = std::move(*best);
+      free_chunks_.erase(best);
+      cached_bytes_ -= chunk.size;
+      return chunk;
+    }
+    size = std::max(size, size_hint_);
+  }
+
+  size = RoundUp(size, static_cast<size_t>(4096));
+  char* data = UncheckedMalloc<char>(size);
+  return MallocedBuffer<char>(data, data != nullptr ? size : 0);
+}
+
+void MessageArena::Release(MallocedBuffer<char>&& chunk, size_t used) {
+  Mutex::ScopedLock lock(mutex_);
+  // Leave some slack so that messages of similar size fit into one chunk.
+  size_hint_ = std::min(used + used / 4, kMaxCachedBytes);
+  if (free_chunks_.size() >= kMaxCachedChunks ||
+      cached_bytes_ + chunk.size > kMaxCachedBytes) {
+    return;  // `chunk` is freed by the caller.
+  }
+  cached_bytes_ += chunk.size;
+  free_chunks_.emplace_back(std::move(chunk));
+}
+
+void MessageArena::MemoryInfo(MemoryTracker* tracker) const {
+  Mutex::ScopedLock lock(mutex_);
+  tracker->TrackFieldWithSize("free_chunks", cached_bytes_);
+}
+
 Message::Message(MallocedBuffer<char>&& buffer)
     : main_message_buf_(std::move(buffer)) {}
 
+Message::~Message() {
+  if (arena_ && !main_message_buf_.is_empty()) {
+    size_t used = main_message_buf_.size;
+    arena_->Release(
+        MallocedBuffer<char>(main_message_buf_.release(),
+                             main_message_capacity_),
+        used);
+  }
+}
+
 bool Message::IsCloseMessage() const {
   return main_message_buf_.data == nullptr;
 }
@@ -259,8 +311,34 @@ void ThrowDataCloneException(Local<Context> context, Local<String> message) {
 // DeserializerDelegate understands how to unpack.
 class SerializerDelegate : public ValueSerializer::Delegate {
  public:
-  SerializerDelegate(Environment* env, Local<Context> context, Message* m)
-      : env_(env), context_(context), msg_(m) {}
+  SerializerDelegate(Environment* env,
+                     Local<Context> context,
+                     Message* m,
+                     MessageArena* arena)
+      : env_(env), context_(context), msg_(m), arena_(arena) {}
+
+  // Large output buffers are taken from the arena, so that the serializer
+  // writes the message directly into memory that the receiving side can
+  // deserialize from and then recycle.
+  void* ReallocateBufferMemory(void* old_buffer,
+                               size_t size,
+                               size_t* actual_size) override {
+    if (arena_ == nullptr || size < MessageArena::kMinChunkSize) {
+      void* buffer = realloc(old_buffer, size);
+      if (buffer != nullptr)
+        buffer_capacity_ = *actual_size = size;
+      return buffer;
+    }
+
+    MallocedBuffer<char> chunk = arena_->Acquire(size);
+    if (chunk.is_empty()) return nullptr;
+    if (old_buffer != nullptr) {
+      memcpy(chunk.data, old_buffer, buffer_capacity_);
+      free(old_buffer);
+    }
+    buffer_capacity_ = *actual_size = chunk.size;
+    return chunk.release();
+  }
 
   void ThrowDataCloneError(Local<String> message) override {
     ThrowDataCloneException(context_, message);
@@ -373,6 +451,8 @@ class SerializerDelegate : public ValueSerializer::Delegate {
   Environment* env_;
   Local<Context> context_;
   Message* msg_;
+  MessageArena* arena_;
+  size_t buffer_capacity_ = 0;
   std::vector<Global<SharedArrayBuffer>> seen_shared_array_buffers_;
   std::vector<BaseObjectPtr<BaseObject>> host_objects_;
   size_t first_cloned_object_index_ = SIZE_MAX;
@@ -386,14 +466,15 @@ Maybe<bool> Message::Serialize(Environment* env,
                                Local<Context> context,
                                Local<Value> input,
                                const TransferList& transfer_list_v,
-                               Local<Object> source_port) {
+                               Local<Object> source_port,
+                               std::shared_ptr<MessageArena> arena) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(context);
 
   // Verify that we're not silently overwriting an existing message.
   CHECK(main_message_buf_.is_empty());
 
-  SerializerDelegate delegate(env, context, this);
+  SerializerDelegate delegate(env, context, this, arena.get());
   ValueSerializer serializer(env->isolate(), &delegate);
   delegate.serializer = &serializer;
 
@@ -503,11 +584,16 @@ Maybe<bool> Message::Serialize(Environment* env,
   if (delegate.Finish(context).IsNothing())
     return Nothing<bool>();
 
-  // The serializer gave us a buffer allocated using `malloc()`.
+  // The serializer gave us a buffer allocated using `malloc()`, possibly
+  // taken from the arena.
   std::pair<uint8_t*, size_t> data = serializer.Release();
   CHECK_NOT_NULL(data.first);
   main_message_buf_ =
       MallocedBuffer<char>(reinterpret_cast<char*>(data.first), data.second);
+  if (arena && delegate.buffer_capacity_ >= MessageArena::kMinChunkSize) {
+    arena_ = std::move(arena);
+    main_message_capacity_ = delegate.buffer_capacity_;
+  }
   return Just(true);
 }
 
@@ -527,6 +613,8 @@ MessagePortData::~MessagePortData() {
 void MessagePortData::MemoryInfo(MemoryTracker* tracker) const {
   Mutex::ScopedLock lock(mutex_);
   tracker->TrackField("incoming_messages", incoming_messages_);
+  tracker->TrackField("received_messages", received_messages_);
+  tracker->TrackField("arena", arena_);
 }
 
 void MessagePortData::AddToIncomingQueue(Message&& message) {
@@ -534,8 +622,11 @@ void MessagePortData::AddToIncomingQueue(Message&& message) {
   Mutex::ScopedLock lock(mutex_);
   incoming_messages_.emplace_back(std::move(message));
 
-  if (owner_ != nullptr) {
+  // If the owner has already been notified and has not drained the queue
+  // yet, it will pick up this message without another uv_async_send() call.
+  if (owner_ != nullptr && !wakeup_pending_) {
     Debug(owner_, "Adding message to incoming queue");
+    wakeup_pending_ = true;
     owner_->TriggerAsync();
   }
 }
@@ -546,6 +637,7 @@ void MessagePortData::Entangle(MessagePortData* a, MessagePortData* b) {
   a->sibling_ = b;
   b->sibling_ = a;
   a->sibling_mutex_ = b->sibling_mutex_;
+  a->arena_ = b->arena_;
 }
 
 void MessagePortData::Disentangle() {
@@ -674,6 +766,7 @@ MessagePort* MessagePort::New(
     port->data_->owner_ = port;
     // If the existing MessagePortData object had pending messages, this is
     // the easiest way to run that queue.
+    port->data_->wakeup_pending_ = true;
     port->TriggerAsync();
   }
   return port;
@@ -681,28 +774,34 @@ MessagePort* MessagePort::New(
 
 MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
                                               bool only_if_receiving) {
-  Message received;
-  {
-    // Get the head of the message queue.
+  std::list<Message>& received_messages = data_->received_messages_;
+  if (received_messages.empty()) {
+    // Take all currently queued messages at once, so that the lock is
+    // acquired once per batch rather than once per message.
     Mutex::ScopedLock lock(data_->mutex_);
-
-    Debug(this, "MessagePort has message");
-
-    bool wants_message = receiving_messages_ || !only_if_receiving;
-    // We have nothing to do if:
-    // - There are no pending messages
-    // - We are not intending to receive messages, and the message we would
-    //   receive is not the final "close" message.
-    if (data_->incoming_messages_.empty() ||
-        (!wants_message &&
-         !data_->incoming_messages_.front().IsCloseMessage())) {
-      return env()->no_message_symbol();
-    }
-
-    received = std::move(data_->incoming_messages_.front());
-    data_->incoming_messages_.pop_front();
+    received_messages.splice(received_messages.end(),
+                             data_->incoming_messages_);
+    // Once the queue has been drained, the next incoming message needs to
+    // wake us up again.
+    if (received_messages.empty())
+      data_->wakeup_pending_ = false;
+  }
+
+  Debug(this, "MessagePort has message");
+
+  bool wants_message = receiving_messages_ || !only_if_receiving;
+  // We have nothing to do if:
+  // - There are no pending messages
+  // - We are not intending to receive messages, and the message we would
+  //   receive is not the final "close" message.
+  if (received_messages.empty() ||
+      (!wants_message && !received_messages.front().IsCloseMessage())) {
+    return env()->no_message_symbol();
   }
 
+  Message received = std::move(received_messages.front());
+  received_messages.pop_front();
+
   if (received.IsCloseMessage()) {
     Close();
     return env()->no_message_symbol();
@@ -720,8 +819,9 @@ void MessagePort::OnMessage() {
 
   size_t processing_limit;
   {
-    Mutex::ScopedLock(data_->mutex_);
-    processing_limit = std::max(data_->incoming_messages_.size(),
+    Mutex::ScopedLock lock(data_->mutex_);
+    processing_limit = std::max(data_->incoming_messages_.size() +
+                                    data_->received_messages_.size(),
                                 static_cast<size_t>(1000));
   }
 
@@ -799,6 +899,7 @@ std::unique_ptr<MessagePortData> MessagePort::Detach() {
   CHECK(data_);
   Mutex::ScopedLock lock(data_->mutex_);
   data_->owner_ = nullptr;
+  data_->wakeup_pending_ = false;
   return std::move(data_);
 }
 
@@ -835,7 +936,8 @@ Maybe<bool> MessagePort::PostMessage(Environment* env,
   // serialize the input message, even if the MessagePort is closed or detached.
 
   Maybe<bool> serialization_maybe =
-      msg.Serialize(env, context, message_v, transfer_v, obj);
+      msg.Serialize(env, context, message_v, transfer_v, obj,
+                    data_ ? data_->arena_ : nullptr);
   if (data_ == nullptr) {
     return serialization_maybe;
   }
@@ -976,8 +1078,11 @@ void MessagePort::Start() {
   Debug(this, "Start receiving messages");
   receiving_messages_ = true;
   Mutex::ScopedLock lock(data_->mutex_);
-  if (!data_->incoming_messages_.empty())
+  if (!data_->incoming_messages_.empty() ||
+      !data_->received_messages_.empty()) {
+    data_->wakeup_pending_ = true;
     TriggerAsync();
+  }
 }
 
 void MessagePort::Stop() {
@@ -6,6 +6,8 @@
 #include "env.h"
 #include "node_mutex.h"
 #include <list>
+#include <memory>
+#include <vector>
 
 namespace node {
 namespace worker {
@@ -38,6 +40,42 @@ class TransferData : public MemoryRetainer {
       v8::Local<v8::Context> context, v8::ValueSerializer* serializer);
 };
 
+// A pool of serialization buffers that is shared by the two MessagePortData
+// objects of an entangled pair. Large messages are serialized directly into a
+// chunk taken from the arena, which is sized after previous large messages so
+// that the serializer does not have to grow (and copy) its output buffer.
+// The receiving side deserializes straight out of that chunk and hands it
+// back to the arena afterwards, so that the sending side can re-use it
+// without paying for fresh allocations and page faults every time.
+// This may be used from any thread.
+class MessageArena : public MemoryRetainer {
+ public:
+  // Serialization buffers smaller than this are allocated using plain
+  // malloc() and are not recycled.
+  static constexpr size_t kMinChunkSize = 64 * 1024;
+  // Upper bound for the amount of memory kept around for re-use.
+  static constexpr size_t kMaxCachedBytes = 64 * 1024 * 1024;
+  static constexpr size_t kMaxCachedChunks = 4;
+
+  // Returns a chunk of at least `size` bytes. The `size` field of the
+  // returned buffer is set to its actual capacity.
+  MallocedBuffer<char> Acquire(size_t size);
+  // Returns a chunk obtained from Acquire() to the arena. `used` is the number
+  // of bytes that the message stored in it took up, and is used for sizing
+  // future chunks.
+  void Release(MallocedBuffer<char>&& chunk, size_t used);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(MessageArena)
+  SET_SELF_SIZE(MessageArena)
+
+ private:
+  mutable Mutex mutex_;
+  std::vector<MallocedBuffer<char>> free_chunks_;
+  size_t cached_bytes_ = 0;
+  size_t size_hint_ = 0;
+};
+
 // Represents a single communication message.
 class Message : public MemoryRetainer {
  public:
@@ -46,6 +84,8 @@ class Message : public MemoryRetainer {
   // that the receiving message port should close itself.
   explicit Message(MallocedBuffer<char>&& payload = MallocedBuffer<char>());
 
+  ~Message() override;
+
   Message(Message&& other) = default;
   Message& operator=(Message&& other) = default;
   Message& operator=(const Message&) = delete;
@@ -65,12 +105,15 @@ class Message : public MemoryRetainer {
   // deserialization.
   // The source_port parameter, if provided, will make Serialize() throw a
   // "DataCloneError" DOMException if source_port is found in transfer_list.
+  // If `arena` is provided, large messages are serialized into memory taken
+  // from it, and that memory is returned to it once this Message is gone.
   v8::Maybe<bool> Serialize(Environment* env,
                             v8::Local<v8::Context> context,
                             v8::Local<v8::Value> input,
                             const TransferList& transfer_list,
                             v8::Local<v8::Object> source_port =
-                                v8::Local<v8::Object>());
+                                v8::Local<v8::Object>(),
+                            std::shared_ptr<MessageArena> arena = nullptr);
 
   // Internal method of Message that is called when a new SharedArrayBuffer
   // object is encountered in the incoming value's structure.
@@ -97,6 +140,10 @@ class Message : public MemoryRetainer {
 
  private:
   MallocedBuffer<char> main_message_buf_;
+  // If set, main_message_buf_ is a chunk of `main_message_capacity_` bytes
+  // that belongs to this arena.
+  std::shared_ptr<MessageArena> arena_;
+  size_t main_message_capacity_ = 0;
   std::vector<std::shared_ptr<v8::BackingStore>> array_buffers_;
   std::vector<std::shared_ptr<v8::BackingStore>> shared_array_buffers_;
   std::vector<std::unique_ptr<TransferData>> transferables_;
@@ -142,15 +189,27 @@ class MessagePortData : public TransferData {
 
  private:
   // This mutex protects all fields below it, with the exception of
-  // sibling_.
+  // sibling_, arena_ and received_messages_.
   mutable Mutex mutex_;
   std::list<Message> incoming_messages_;
   MessagePort* owner_ = nullptr;
+  // Whether the owner has been notified about incoming messages that it has
+  // not yet picked up. While this is set, adding further messages does not
+  // trigger additional wakeups, because the owner will find them when it
+  // drains the queue.
+  bool wakeup_pending_ = false;
   // This mutex protects the sibling_ field and is shared between two entangled
   // MessagePorts. If both mutexes are acquired, this one needs to be
   // acquired first.
   std::shared_ptr<Mutex> sibling_mutex_ = std::make_shared<Mutex>();
   MessagePortData* sibling_ = nullptr;
+  // Serialization buffers shared with the sibling; see MessageArena. This is
+  // only set up through Entangle() and thread-safe by itself.
+  std::shared_ptr<MessageArena> arena_ = std::make_shared<MessageArena>();
+  // Messages that the owner has taken out of incoming_messages_ in a single
+  // batch and not processed yet. This is only accessed by the thread that
+  // currently owns this object, and does not require locking.
+  std::list<Message> received_messages_;
 
   friend class MessagePort;
 };
@@ -0,0 +1,507 @@
+#include "node_metrics.h"
+#include "env-inl.h"
+#include "node_internals.h"
+#include "util-inl.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace node {
+namespace metrics {
+
+using v8::GCCallbackFlags;
+using v8::GCType;
+using v8::HeapSpaceStatistics;
+using v8::Isolate;
+
+namespace {
+
+// How long a scrape waits for the main thread to refresh the snapshot
+// before the previous one is served.
+constexpr uint64_t kSnapshotTimeout = 100 * 1000 * 1000;  // 100 ms.
+// Requests are only expected to contain a request line and a few headers.
+constexpr size_t kMaxRequestSize = 8 * 1024;
+
+constexpr char kContentType[] =
+    "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+#define GC_KINDS(V)                                                            \
+  V(kGCTypeScavenge, "scavenge")                                               \
+  V(kGCTypeMarkSweepCompact, "mark_sweep_compact")                             \
+  V(kGCTypeIncrementalMarking, "incremental_marking")                          \
+  V(kGCTypeProcessWeakCallbacks, "process_weak_callbacks")
+
+enum GCKindIndex {
+#define V(type, _) k_##type,
+  GC_KINDS(V)
+#undef V
+  kGCKindCount
+};
+
+int GetGCKindIndex(GCType type) {
+#define V(gc_type, _) if (type & v8::gc_type) return k_##gc_type;
+  GC_KINDS(V)
+#undef V
+  return -1;
+}
+
+void AppendHeader(std::string* out,
+                  const char* name,
+                  const char* type,
+                  const char* help) {
+  *out += "# TYPE ";
+  *out += name;
+  *out += ' ';
+  *out += type;
+  *out += "\n# HELP ";
+  *out += name;
+  *out += ' ';
+  *out += help;
+  *out += '\n';
+}
+
+void AppendSample(std::string* out,
+                  const std::string& name,
+                  const std::string& labels,
+                  const std::string& value) {
+  *out += name;
+  if (!labels.empty()) {
+    *out += '{';
+    *out += labels;
+    *out += '}';
+  }
+  *out += ' ';
+  *out += value;
+  *out += '\n';
+}
+
+void AppendSample(std::string* out,
+                  const std::string& name,
+                  const std::string& labels,
+                  uint64_t value) {
+  AppendSample(out, name, labels, std::to_string(value));
+}
+
+void AppendSample(std::string* out,
+                  const std::string& name,
+                  const std::string& labels,
+                  double value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.9g", value);
+  AppendSample(out, name, labels, std::string(buf));
+}
+
+inline double ToSeconds(uint64_t nanoseconds) {
+  return nanoseconds / 1e9;
+}
+
+inline double ToSeconds(const uv_timeval_t& tv) {
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+}  // anonymous namespace
+
+struct MetricsServer::Connection {
+  MetricsServer* server;
+  union {
+    uv_handle_t handle;
+    uv_stream_t stream;
+    uv_tcp_t tcp;
+    uv_pipe_t pipe;
+  };
+  uv_write_t write_req;
+  std::string request;
+  std::string response;
+  char buffer[1024];
+
+  static void Close(Connection* connection) {
+    if (uv_is_closing(&connection->handle)) return;
+    uv_close(&connection->handle, [](uv_handle_t* handle) {
+      delete static_cast<Connection*>(handle->data);
+    });
+  }
+
+  static void OnAlloc(uv_handle_t* handle, size_t size, uv_buf_t* buf) {
+    Connection* connection = static_cast<Connection*>(handle->data);
+    *buf = uv_buf_init(connection->buffer, sizeof(connection->buffer));
+  }
+
+  static void OnRead(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf) {
+    Connection* connection = static_cast<Connection*>(stream->data);
+    if (nread < 0) return Close(connection);
+    connection->request.append(buf->base, nread);
+    if (connection->request.find("\r\n\r\n") != std::string::npos) {
+      uv_read_stop(stream);
+      connection->server->HandleRequest(connection);
+    } else if (connection->request.size() > kMaxRequestSize) {
+      Close(connection);
+    }
+  }
+
+  static void OnWrite(uv_write_t* req, int status) {
+    Close(static_cast<Connection*>(req->data));
+  }
+};
+
+MetricsServer::MetricsServer(Environment* env) : env_(env) {
+  gc_.resize(kGCKindCount);
+#define V(type, name) gc_[k_##type] = { name, 0, 0 };
+  GC_KINDS(V)
+#undef V
+}
+
+MetricsServer::~MetricsServer() = default;
+
+MetricsServer* MetricsServer::Start(Environment* env,
+                                    const std::string& endpoint) {
+  MetricsServer* server = new MetricsServer(env);
+  int err = server->Bind(endpoint);
+  if (err != 0) {
+    fprintf(stderr, "Starting metrics server on %s failed: %s\n",
+            endpoint.c_str(), uv_strerror(err));
+    fflush(stderr);
+    delete server;
+    return nullptr;
+  }
+
+  CHECK_EQ(0, uv_async_init(env->event_loop(),
+                            &server->refresh_async_,
+                            [](uv_async_t* handle) {
+    MetricsServer* server =
+        ContainerOf(&MetricsServer::refresh_async_, handle);
+    server->TakeSnapshot();
+  }));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&server->refresh_async_));
+
+  Isolate* isolate = env->isolate();
+  isolate->AddGCPrologueCallback(OnGCPrologue, server);
+  isolate->AddGCEpilogueCallback(OnGCEpilogue, server);
+  server->TakeSnapshot();
+
+  CHECK_EQ(0, uv_thread_create(&server->thread_, ThreadMain, server));
+  env->AddCleanupHook(Cleanup, server);
+  return server;
+}
+
+int MetricsServer::Bind(const std::string& endpoint) {
+  CHECK_EQ(0, uv_loop_init(&loop_));
+  CHECK_EQ(0, uv_async_init(&loop_, &stop_async_, [](uv_async_t* handle) {
+    uv_walk(handle->loop, [](uv_handle_t* handle, void* arg) {
+      if (uv_is_closing(handle)) return;
+      // Connections own themselves, the other handles are owned by the
+      // MetricsServer.
+      if (handle->data != arg) {
+        Connection::Close(static_cast<Connection*>(handle->data));
+      } else {
+        uv_close(handle, nullptr);
+      }
+    }, handle->data);
+  }));
+  stop_async_.data = this;
+
+  int err;
+  uv_stream_t* stream = reinterpret_cast<uv_stream_t*>(&server_);
+  if (endpoint.compare(0, 5, "unix:") == 0) {
+    CHECK_EQ(0, uv_pipe_init(&loop_, &server_.pipe, 0));
+    err = uv_pipe_bind(&server_.pipe, endpoint.c_str() + 5);
+  } else {
+    // Accept `port`, `host:port` and `[ipv6]:port`.
+    std::string host = "127.0.0.1";
+    std::string port = endpoint;
+    size_t colon = endpoint.rfind(':');
+    if (colon != std::string::npos) {
+      host = endpoint.substr(0, colon);
+      port = endpoint.substr(colon + 1);
+      if (host.size() >= 2 && host.front() == '[' && host.back() == ']')
+        host = host.substr(1, host.size() - 2);
+    }
+    char* end;
+    unsigned long port_number = strtoul(port.c_str(), &end, 10);  // NOLINT
+    struct sockaddr_storage addr;
+    CHECK_EQ(0, uv_tcp_init(&loop_, &server_.tcp));
+    if (port.empty() || *end != '\0' || port_number > 65535) {
+      err = UV_EINVAL;
+    } else {
+      err = uv_ip4_addr(host.c_str(), port_number,
+                        reinterpret_cast<sockaddr_in*>(&addr));
+      if (err != 0) {
+        err = uv_ip6_addr(host.c_str(), port_number,
+                          reinterpret_cast<sockaddr_in6*>(&addr));
+      }
+      if (err == 0) {
+        err = uv_tcp_bind(&server_.tcp,
+                          reinterpret_cast<sockaddr*>(&addr), 0);
+      }
+    }
+  }
+  stream->data = this;
+  if (err == 0)
+    err = uv_listen(stream, 128, OnConnection);
+
+  if (err != 0) {
+    uv_close(reinterpret_cast<uv_handle_t*>(stream), nullptr);
+    uv_close(reinterpret_cast<uv_handle_t*>(&stop_async_), nullptr);
+    uv_run(&loop_, UV_RUN_DEFAULT);
+    CheckedUvLoopClose(&loop_);
+    return err;
+  }
+  endpoint_ = endpoint;
+  return 0;
+}
+
+void MetricsServer::Cleanup(void* data) {
+  MetricsServer* server = static_cast<MetricsServer*>(data);
+  CHECK_EQ(0, uv_async_send(&server->stop_async_));
+  CHECK_EQ(0, uv_thread_join(&server->thread_));
+  CheckedUvLoopClose(&server->loop_);
+
+  Environment* env = server->env_;
+  env->isolate()->RemoveGCPrologueCallback(OnGCPrologue, server);
+  env->isolate()->RemoveGCEpilogueCallback(OnGCEpilogue, server);
+  env->CloseHandle(&server->refresh_async_, [](uv_async_t* handle) {
+    MetricsServer* server =
+        ContainerOf(&MetricsServer::refresh_async_, handle);
+    delete server;
+  });
+}
+
+void MetricsServer::OnGCPrologue(Isolate* isolate,
+                                 GCType type,
+                                 GCCallbackFlags flags,
+                                 void* data) {
+  static_cast<MetricsServer*>(data)->gc_start_ = uv_hrtime();
+}
+
+void MetricsServer::OnGCEpilogue(Isolate* isolate,
+                                 GCType type,
+                                 GCCallbackFlags flags,
+                                 void* data) {
+  MetricsServer* server = static_cast<MetricsServer*>(data);
+  int index = GetGCKindIndex(type);
+  if (index < 0 || server->gc_start_ == 0) return;
+  RuntimeSnapshot::GCKind* kind = &server->gc_[index];
+  kind->count++;
+  kind->total_time += uv_hrtime() - server->gc_start_;
+  server->gc_start_ = 0;
+}
+
+void MetricsServer::TakeSnapshot() {
+  Isolate* isolate = env_->isolate();
+  uv_loop_t* loop = env_->event_loop();
+  RuntimeSnapshot snapshot;
+
+  isolate->GetHeapStatistics(&snapshot.heap);
+  size_t spaces = isolate->NumberOfHeapSpaces();
+  snapshot.heap_spaces.reserve(spaces);
+  for (size_t i = 0; i < spaces; i++) {
+    HeapSpaceStatistics s;
+    isolate->GetHeapSpaceStatistics(&s, i);
+    snapshot.heap_spaces.push_back({ s.space_name(),
+                                     s.space_size(),
+                                     s.space_used_size(),
+                                     s.space_available_size() });
+  }
+  snapshot.gc = gc_;
+
+  // The utilization covers the time since the previous snapshot, which
+  // usually is the time since the previous scrape.
+  snapshot.time = uv_hrtime();
+  snapshot.loop_idle_time = uv_metrics_idle_time(loop);
+  if (last_snapshot_time_ != 0 && snapshot.time > last_snapshot_time_) {
+    double elapsed = snapshot.time - last_snapshot_time_;
+    double idle = snapshot.loop_idle_time - last_idle_time_;
+    snapshot.loop_utilization = std::max(0.0, 1 - idle / elapsed);
+  }
+  last_snapshot_time_ = snapshot.time;
+  last_idle_time_ = snapshot.loop_idle_time;
+
+  snapshot.active_handles = loop->active_handles;
+  snapshot.active_requests = loop->active_reqs.count;
+  snapshot.pending_native_requests = env_->waiting_request_count();
+
+  Mutex::ScopedLock lock(mutex_);
+  snapshot.generation = snapshot_.generation + 1;
+  snapshot_ = std::move(snapshot);
+  snapshot_updated_.Broadcast(lock);
+}
+
+void MetricsServer::ThreadMain(void* data) {
+  MetricsServer* server = static_cast<MetricsServer*>(data);
+  uv_run(&server->loop_, UV_RUN_DEFAULT);
+}
+
+void MetricsServer::OnConnection(uv_stream_t* stream, int status) {
+  if (status != 0) return;
+  MetricsServer* server = static_cast<MetricsServer*>(stream->data);
+  Connection* connection = new Connection();
+  connection->server = server;
+  if (stream->type == UV_NAMED_PIPE)
+    CHECK_EQ(0, uv_pipe_init(stream->loop, &connection->pipe, 0));
+  else
+    CHECK_EQ(0, uv_tcp_init(stream->loop, &connection->tcp));
+  connection->handle.data = connection;
+  if (uv_accept(stream, &connection->stream) != 0 ||
+      uv_read_start(&connection->stream,
+                    Connection::OnAlloc,
+                    Connection::OnRead) != 0) {
+    Connection::Close(connection);
+  }
+}
+
+void MetricsServer::HandleRequest(Connection* connection) {
+  const std::string& request = connection->request;
+  std::string method;
+  std::string path;
+  size_t method_end = request.find(' ');
+  if (method_end != std::string::npos) {
+    size_t path_end = request.find_first_of(" ?\r", method_end + 1);
+    method = request.substr(0, method_end);
+    path = request.substr(method_end + 1, path_end - method_end - 1);
+  }
+
+  const char* status;
+  const char* content_type;
+  std::string body;
+  if ((method == "GET" || method == "HEAD") &&
+      (path == "/metrics" || path == "/")) {
+    status = "200 OK";
+    content_type = kContentType;
+    body = Collect();
+  } else {
+    status = "404 Not Found";
+    content_type = "text/plain; charset=utf-8";
+    body = "Not Found\n";
+  }
+
+  std::string& response = connection->response;
+  response = "HTTP/1.1 ";
+  response += status;
+  response += "\r\nContent-Type: ";
+  response += content_type;
+  response += "\r\nContent-Length: " + std::to_string(body.size());
+  response += "\r\nConnection: close\r\n\r\n";
+  if (method != "HEAD")
+    response += body;
+
+  uv_buf_t buf = uv_buf_init(&response[0], response.size());
+  connection->write_req.data = connection;
+  if (uv_write(&connection->write_req, &connection->stream, &buf, 1,
+               Connection::OnWrite) != 0) {
+    Connection::Close(connection);
+  }
+}
+
+std::string MetricsServer::Collect() {
+  RuntimeSnapshot snapshot;
+  {
+    Mutex::ScopedLock lock(mutex_);
+    uint64_t generation = snapshot_.generation;
+    uint64_t deadline = uv_hrtime() + kSnapshotTimeout;
+    CHECK_EQ(0, uv_async_send(&refresh_async_));
+    while (snapshot_.generation == generation) {
+      uint64_t now = uv_hrtime();
+      if (now >= deadline || !snapshot_updated_.TimedWait(lock, deadline - now))
+        break;
+    }
+    snapshot = snapshot_;
+  }
+
+  std::string out;
+  const RuntimeSnapshot::HeapSpace* space;
+  const std::string none;
+
+  AppendHeader(&out, "nodejs_heap_size_bytes", "gauge",
+               "Total size of the V8 heap.");
+  AppendSample(&out, "nodejs_heap_size_bytes", none,
+               static_cast<uint64_t>(snapshot.heap.total_heap_size()));
+  AppendHeader(&out, "nodejs_heap_used_bytes", "gauge",
+               "Used size of the V8 heap.");
+  AppendSample(&out, "nodejs_heap_used_bytes", none,
+               static_cast<uint64_t>(snapshot.heap.used_heap_size()));
+  AppendHeader(&out, "nodejs_heap_limit_bytes", "gauge",
+               "Maximum size of the V8 heap.");
+  AppendSample(&out, "nodejs_heap_limit_bytes", none,
+               static_cast<uint64_t>(snapshot.heap.heap_size_limit()));
+  AppendHeader(&out, "nodejs_external_memory_bytes", "gauge",
+               "Memory of objects outside of the V8 heap that are kept alive "
+               "by JavaScript objects.");
+  AppendSample(&out, "nodejs_external_memory_bytes", none,
+               static_cast<uint64_t>(snapshot.heap.external_memory()));
+
+#define V(suffix, field, help)                                                 \
+  AppendHeader(&out, "nodejs_heap_space_" suffix "_bytes", "gauge", help);     \
+  for (size_t i = 0; i < snapshot.heap_spaces.size(); i++) {                   \
+    space = &snapshot.heap_spaces[i];                                          \
+    AppendSample(&out, "nodejs_heap_space_" suffix "_bytes",                   \
+                 "space=\"" + space->name + "\"",                              \
+                 static_cast<uint64_t>(space->field));                         \
+  }
+  V("size", size, "Size of the V8 heap space.")
+  V("used", used_size, "Used size of the V8 heap space.")
+  V("available", available_size, "Available size of the V8 heap space.")
+#undef V
+
+  AppendHeader(&out, "nodejs_gc_duration_seconds", "summary",
+               "Time spent in garbage collection, by kind.");
+  for (const RuntimeSnapshot::GCKind& kind : snapshot.gc) {
+    std::string labels = std::string("kind=\"") + kind.name + "\"";
+    AppendSample(&out, "nodejs_gc_duration_seconds_count", labels, kind.count);
+    AppendSample(&out, "nodejs_gc_duration_seconds_sum", labels,
+                 ToSeconds(kind.total_time));
+  }
+
+  AppendHeader(&out, "nodejs_eventloop_utilization", "gauge",
+               "Ratio of time the event loop was not idle since the "
+               "previous scrape.");
+  AppendSample(&out, "nodejs_eventloop_utilization", none,
+               snapshot.loop_utilization);
+  AppendHeader(&out, "nodejs_eventloop_idle_seconds", "counter",
+               "Time the event loop spent idle in the event provider.");
+  AppendSample(&out, "nodejs_eventloop_idle_seconds_total", none,
+               ToSeconds(snapshot.loop_idle_time));
+  AppendHeader(&out, "nodejs_active_handles", "gauge",
+               "Number of active libuv handles that keep the event loop "
+               "alive.");
+  AppendSample(&out, "nodejs_active_handles", none,
+               static_cast<uint64_t>(snapshot.active_handles));
+  AppendHeader(&out, "nodejs_active_requests", "gauge",
+               "Number of active libuv requests.");
+  AppendSample(&out, "nodejs_active_requests", none,
+               static_cast<uint64_t>(snapshot.active_requests));
+  AppendHeader(&out, "nodejs_pending_native_requests", "gauge",
+               "Number of native requests and thread pool tasks that have "
+               "not completed yet.");
+  AppendSample(&out, "nodejs_pending_native_requests", none,
+               static_cast<uint64_t>(snapshot.pending_native_requests));
+
+  uv_rusage_t rusage;
+  if (uv_getrusage(&rusage) == 0) {
+    AppendHeader(&out, "process_cpu_user_seconds", "counter",
+                 "User CPU time spent by the process.");
+    AppendSample(&out, "process_cpu_user_seconds_total", none,
+                 ToSeconds(rusage.ru_utime));
+    AppendHeader(&out, "process_cpu_system_seconds", "counter",
+                 "System CPU time spent by the process.");
+    AppendSample(&out, "process_cpu_system_seconds_total", none,
+                 ToSeconds(rusage.ru_stime));
+  }
+  size_t rss;
+  if (uv_resident_set_memory(&rss) == 0) {
+    AppendHeader(&out, "process_resident_memory_bytes", "gauge",
+                 "Resident set size of the process.");
+    AppendSample(&out, "process_resident_memory_bytes", none,
+                 static_cast<uint64_t>(rss));
+  }
+
+  AppendHeader(&out, "nodejs_metrics_snapshot_age_seconds", "gauge",
+               "Time since the main thread values were collected. It is "
+               "high when the main thread is blocked.");
+  AppendSample(&out, "nodejs_metrics_snapshot_age_seconds", none,
+               ToSeconds(uv_hrtime() - snapshot.time));
+  out += "# EOF\n";
+  return out;
+}
+
+}  // namespace metrics
+}  // namespace node
@@ -0,0 +1,123 @@
+#ifndef SRC_NODE_METRICS_H_
+#define SRC_NODE_METRICS_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "node_mutex.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace node {
+
+class Environment;
+
+namespace metrics {
+
+// The values exported by the metrics endpoint that can only be read on the
+// thread of the Environment.
+struct RuntimeSnapshot {
+  struct HeapSpace {
+    std::string name;
+    size_t size;
+    size_t used_size;
+    size_t available_size;
+  };
+
+  struct GCKind {
+    const char* name;
+    uint64_t count;
+    uint64_t total_time;  // In nanoseconds.
+  };
+
+  uint64_t generation = 0;
+  uint64_t time = 0;  // uv_hrtime() when the snapshot was taken.
+  v8::HeapStatistics heap;
+  std::vector<HeapSpace> heap_spaces;
+  std::vector<GCKind> gc;
+  uint64_t loop_idle_time = 0;
+  double loop_utilization = 0;
+  unsigned int active_handles = 0;
+  unsigned int active_requests = 0;
+  int pending_native_requests = 0;
+};
+
+// Serves the runtime metrics of the main thread in the OpenMetrics text
+// format on the endpoint passed with --metrics-endpoint, e.g. for Prometheus.
+//
+// The HTTP server runs on its own thread and event loop, so that scrapes
+// are answered even while the main thread is busy. On each scrape, the
+// server asks the main thread to refresh a snapshot of the values that can
+// only be read there, which happens in C++ on the next iteration of the main
+// event loop without running any JavaScript, and waits for it for a short
+// time. If the main thread is blocked, the previous snapshot is served
+// together with its age.
+class MetricsServer {
+ public:
+  // Returns nullptr and prints a message if the endpoint cannot be bound.
+  // |endpoint| is either `[host:]port` or `unix:<path>`.
+  static MetricsServer* Start(Environment* env, const std::string& endpoint);
+
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+ private:
+  struct Connection;
+
+  explicit MetricsServer(Environment* env);
+  ~MetricsServer();
+
+  int Bind(const std::string& endpoint);
+  // Stops the server thread, unregisters the GC callbacks and deletes the
+  // object once the handles on the main event loop are closed.
+  static void Cleanup(void* data);
+
+  // Main thread.
+  static void OnGCPrologue(v8::Isolate* isolate,
+                           v8::GCType type,
+                           v8::GCCallbackFlags flags,
+                           void* data);
+  static void OnGCEpilogue(v8::Isolate* isolate,
+                           v8::GCType type,
+                           v8::GCCallbackFlags flags,
+                           void* data);
+  void TakeSnapshot();
+
+  // Server thread.
+  static void ThreadMain(void* data);
+  static void OnConnection(uv_stream_t* server, int status);
+  void HandleRequest(Connection* connection);
+  std::string Collect();
+
+  Environment* env_;
+  uv_async_t refresh_async_;
+
+  // Only used on the main thread.
+  uint64_t gc_start_ = 0;
+  std::vector<RuntimeSnapshot::GCKind> gc_;
+  uint64_t last_snapshot_time_ = 0;
+  uint64_t last_idle_time_ = 0;
+
+  Mutex mutex_;
+  ConditionVariable snapshot_updated_;
+  RuntimeSnapshot snapshot_;
+
+  uv_thread_t thread_;
+  uv_loop_t loop_;
+  uv_async_t stop_async_;
+  union {
+    uv_tcp_t tcp;
+    uv_pipe_t pipe;
+  } server_;
+  std::string endpoint_;
+};
+
+}  // namespace metrics
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_METRICS_H_
@@ -1,4 +1,5 @@
 #include "node_native_module_env.h"
+#include "debug_utils-inl.h"
 #include "env-inl.h"
 #include "node_external_reference.h"
 
@@ -123,23 +124,36 @@ void NativeModuleEnv::ConfigStringGetter(
 
 void NativeModuleEnv::RecordResult(const char* id,
                                    NativeModuleLoader::Result result,
-                                   Environment* env) {
-  if (result == NativeModuleLoader::Result::kWithCache) {
+                                   Environment* env,
+                                   uint64_t start_time) {
+  bool with_cache = result == NativeModuleLoader::Result::kWithCache;
+  if (with_cache) {
     env->native_modules_with_cache.insert(id);
   } else {
     env->native_modules_without_cache.insert(id);
   }
+  // Lists the built-ins that are compiled while the process runs, and when,
+  // so that the ones that end up being compiled during startup can be
+  // spotted with NODE_DEBUG_NATIVE=CODE_CACHE.
+  Debug(env, DebugCategory::CODE_CACHE,
+        "Compiled %s %s code cache in %d us%s\n",
+        id,
+        with_cache ? "with" : "without",
+        (uv_hrtime() - start_time) / 1000,
+        env->has_run_bootstrapping_code() ? "" : " during bootstrap");
 }
+
 void NativeModuleEnv::CompileFunction(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK(args[0]->IsString());
   node::Utf8Value id_v(env->isolate(), args[0].As<String>());
   const char* id = *id_v;
+  uint64_t start_time = uv_hrtime();
   NativeModuleLoader::Result result;
   MaybeLocal<Function> maybe =
       NativeModuleLoader::GetInstance()->CompileAsModule(
           env->context(), id, &result);
-  RecordResult(id, result, env);
+  RecordResult(id, result, env, start_time);
   Local<Function> fn;
   if (maybe.ToLocal(&fn)) {
     args.GetReturnValue().Set(fn);
@@ -154,12 +168,13 @@ MaybeLocal<Function> NativeModuleEnv::LookupAndCompile(
     const char* id,
     std::vector<Local<String>>* parameters,
     Environment* optional_env) {
+  uint64_t start_time = uv_hrtime();
   NativeModuleLoader::Result result;
   MaybeLocal<Function> maybe =
       NativeModuleLoader::GetInstance()->LookupAndCompile(
           context, id, parameters, &result);
   if (optional_env != nullptr) {
-    RecordResult(id, result, optional_env);
+    RecordResult(id, result, optional_env, start_time);
   }
   return maybe;
 }
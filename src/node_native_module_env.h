@@ -42,7 +42,8 @@ class NativeModuleEnv {
  private:
   static void RecordResult(const char* id,
                            NativeModuleLoader::Result result,
-                           Environment* env);
+                           Environment* env,
+                           uint64_t start_time);
   static void GetModuleCategories(
       v8::Local<v8::Name> property,
       const v8::PropertyCallbackInfo<v8::Value>& info);
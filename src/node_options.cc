@@ -70,6 +70,9 @@ void PerProcessOptions::CheckOptions(std::vector<std::string>* errors) {
       use_largepages != "silent") {
     errors->push_back("invalid value for --use-largepages");
   }
+  if (trace_event_format != "json" && trace_event_format != "binary") {
+    errors->push_back("invalid value for --trace-event-format");
+  }
   per_isolate->CheckOptions(errors);
 }
 
@@ -135,6 +138,16 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors) {
     if (cpu_prof_interval != kDefaultCpuProfInterval) {
       errors->push_back("--cpu-prof-interval must be used with --cpu-prof");
     }
+    if (cpu_prof_window != 0) {
+      errors->push_back("--cpu-prof-window must be used with --cpu-prof");
+    }
+    if (!cpu_prof_signal.empty()) {
+      errors->push_back("--cpu-prof-signal must be used with --cpu-prof");
+    }
+  } else if (!cpu_prof_name.empty() &&
+             (cpu_prof_window != 0 || !cpu_prof_signal.empty())) {
+    errors->push_back("--cpu-prof-name cannot be used with --cpu-prof-window "
+                      "or --cpu-prof-signal");
   }
 
   if (cpu_prof && cpu_prof_dir.empty() && !diagnostic_dir.empty()) {
@@ -304,6 +317,10 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "experimental ES Module support for webassembly modules",
             &EnvironmentOptions::experimental_wasm_modules,
             kAllowedInEnvironment);
+  AddOption("--experimental-code-cache-dir",
+            "store the code cache of user modules in the specified directory",
+            &EnvironmentOptions::experimental_code_cache_dir,
+            kAllowedInEnvironment);
   AddOption("--experimental-import-meta-resolve",
             "experimental ES Module import.meta.resolve() support",
             &EnvironmentOptions::experimental_import_meta_resolve,
@@ -421,6 +438,14 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "Directory where the V8 profiles generated by --cpu-prof will be "
             "placed. Does not affect --prof.",
             &EnvironmentOptions::cpu_prof_dir);
+  AddOption("--cpu-prof-window",
+            "write the CPU profile generated with --cpu-prof every <window> "
+            "milliseconds and start a new one",
+            &EnvironmentOptions::cpu_prof_window);
+  AddOption("--cpu-prof-signal",
+            "write the CPU profile generated with --cpu-prof and start a new "
+            "one when receiving the signal",
+            &EnvironmentOptions::cpu_prof_signal);
   AddOption(
       "--heap-prof",
       "Start the V8 heap profiler on start up, and write the heap profile "
@@ -440,6 +465,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "profile generated with --heap-prof. (default: 512 * 1024)",
             &EnvironmentOptions::heap_prof_interval);
 #endif  // HAVE_INSPECTOR
+  AddOption("--metrics-endpoint",
+            "serve runtime metrics in the OpenMetrics text format on "
+            "[host:]port or unix:path",
+            &EnvironmentOptions::metrics_endpoint,
+            kAllowedInEnvironment);
   AddOption("--max-http-header-size",
             "set the maximum size of HTTP headers (default: 16384 (16KB))",
             &EnvironmentOptions::max_http_header_size,
@@ -647,6 +677,11 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "data, it supports ${rotation} and ${pid}.",
             &PerProcessOptions::trace_event_file_pattern,
             kAllowedInEnvironment);
+  AddOption("--trace-event-format",
+            "format of the trace-events data, either json (default) or "
+            "binary",
+            &PerProcessOptions::trace_event_format,
+            kAllowedInEnvironment);
   AddAlias("--trace-events-enabled", {
     "--trace-event-categories", "v8,node,node.async_hooks" });
   AddOption("--v8-pool-size",
@@ -666,6 +701,14 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "disable Object.prototype.__proto__",
             &PerProcessOptions::disable_proto,
             kAllowedInEnvironment);
+  AddOption("--build-snapshot",
+            "run the entry point script and write the resulting heap into "
+            "a startup snapshot blob",
+            &PerProcessOptions::build_snapshot);
+  AddOption("--snapshot-blob",
+            "path of the startup snapshot blob to write with "
+            "--build-snapshot or to start from otherwise",
+            &PerProcessOptions::snapshot_blob);
 
   // 12.x renamed this inadvertently, so alias it for consistency within the
   // release line, while using the original name for consistency with older
@@ -107,6 +107,7 @@ class EnvironmentOptions : public Options {
   std::string experimental_specifier_resolution;
   bool experimental_wasm_modules = false;
   bool experimental_import_meta_resolve = false;
+  std::string experimental_code_cache_dir;
   std::string module_type;
   std::string experimental_policy;
   std::string experimental_policy_integrity;
@@ -118,6 +119,7 @@ class EnvironmentOptions : public Options {
   int64_t heap_snapshot_near_heap_limit = 0;
   std::string heap_snapshot_signal;
   uint64_t max_http_header_size = 16 * 1024;
+  std::string metrics_endpoint;
   bool no_deprecation = false;
   bool no_force_async_hooks_checks = false;
   bool no_warnings = false;
@@ -131,6 +133,8 @@ class EnvironmentOptions : public Options {
   static const uint64_t kDefaultCpuProfInterval = 1000;
   uint64_t cpu_prof_interval = kDefaultCpuProfInterval;
   std::string cpu_prof_name;
+  uint64_t cpu_prof_window = 0;
+  std::string cpu_prof_signal;
   bool cpu_prof = false;
   std::string heap_prof_dir;
   std::string heap_prof_name;
@@ -216,10 +220,13 @@ class PerProcessOptions : public Options {
   std::string title;
   std::string trace_event_categories;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
+  std::string trace_event_format = "json";
   int64_t v8_thread_pool_size = 4;
   bool zero_fill_all_buffers = false;
   bool debug_arraybuffer_allocations = false;
   std::string disable_proto;
+  bool build_snapshot = false;
+  std::string snapshot_blob;
 
   std::vector<std::string> security_reverts;
   bool print_bash_completion = false;
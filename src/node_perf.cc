@@ -6,6 +6,7 @@
 #include "node_process.h"
 #include "util-inl.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 namespace node {
@@ -19,6 +20,7 @@ using v8::FunctionTemplate;
 using v8::GCCallbackFlags;
 using v8::GCType;
 using v8::HandleScope;
+using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -448,6 +450,24 @@ void LoopIdleTime(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Creates a histogram that can be recorded from any thread.
+void CreateHistogram(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsNumber());
+  CHECK(args[2]->IsInt32());
+  int64_t lowest = args[0]->IntegerValue(env->context()).FromJust();
+  int64_t highest = args[1]->IntegerValue(env->context()).FromJust();
+  int figures = args[2].As<Int32>()->Value();
+  BaseObjectPtr<ConcurrentHistogramBase> histogram =
+      ConcurrentHistogramBase::New(
+          env,
+          std::make_shared<ConcurrentHistogram>(lowest, highest, figures));
+  if (histogram)
+    args.GetReturnValue().Set(histogram->object());
+}
+
+
 // Event Loop Timing Histogram
 namespace {
 static void ELDHistogramMin(const FunctionCallbackInfo<Value>& args) {
@@ -599,6 +619,271 @@ bool ELDHistogram::Disable() {
   return true;
 }
 
+void EventLoopPhaseTimer::Initialize(uv_loop_t* loop) {
+  CHECK_EQ(0, uv_prepare_init(loop, &prepare_handle_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&prepare_handle_));
+}
+
+void EventLoopPhaseTimer::AddMonitor(EventLoopPhaseMonitor* monitor) {
+  if (monitors_.empty())
+    uv_prepare_start(&prepare_handle_, OnPrepare);
+  monitors_.push_back(monitor);
+}
+
+void EventLoopPhaseTimer::RemoveMonitor(EventLoopPhaseMonitor* monitor) {
+  auto it = std::find(monitors_.begin(), monitors_.end(), monitor);
+  if (it == monitors_.end()) return;
+  monitors_.erase(it);
+  if (monitors_.empty())
+    Stop();
+}
+
+void EventLoopPhaseTimer::Stop() {
+  monitors_.clear();
+  uv_prepare_stop(&prepare_handle_);
+  Reset();
+  prepare_time_ = 0;
+}
+
+void EventLoopPhaseTimer::Reset() {
+  for (size_t n = 0; n < NODE_EVENT_LOOP_PHASE_INVALID; n++) {
+    durations_[n] = 0;
+    measured_[n] = false;
+  }
+  poll_end_time_ = 0;
+}
+
+void EventLoopPhaseTimer::OnPrepare(uv_prepare_t* handle) {
+  EventLoopPhaseTimer* timer =
+      ContainerOf(&EventLoopPhaseTimer::prepare_handle_, handle);
+  uint64_t now = PERFORMANCE_NOW();
+
+  // The iteration that ends here is only complete if it started with this
+  // prepare phase and its poll phase has ended.
+  if (timer->prepare_time_ != 0 && timer->poll_end_time_ != 0) {
+    uint64_t* durations = timer->durations_;
+    uint64_t known = (timer->poll_end_time_ - timer->prepare_time_) +
+                     durations[NODE_EVENT_LOOP_PHASE_CHECK] +
+                     durations[NODE_EVENT_LOOP_PHASE_TIMERS];
+    uint64_t total = now - timer->prepare_time_;
+    durations[NODE_EVENT_LOOP_PHASE_OTHER] = total > known ? total - known : 0;
+    timer->measured_[NODE_EVENT_LOOP_PHASE_OTHER] = true;
+
+    for (size_t n = 0; n < NODE_EVENT_LOOP_PHASE_INVALID; n++) {
+      if (!timer->measured_[n]) continue;
+      for (EventLoopPhaseMonitor* monitor : timer->monitors_)
+        monitor->Record(static_cast<EventLoopPhase>(n), durations[n]);
+    }
+  }
+
+  timer->Reset();
+  timer->prepare_time_ = now;
+  timer->prepare_idle_time_ = uv_metrics_idle_time(handle->loop);
+}
+
+// Event Loop Phase Monitor
+namespace {
+static void EventLoopPhaseMonitorEnable(
+    const FunctionCallbackInfo<Value>& args) {
+  EventLoopPhaseMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  args.GetReturnValue().Set(monitor->Enable());
+}
+
+static void EventLoopPhaseMonitorDisable(
+    const FunctionCallbackInfo<Value>& args) {
+  EventLoopPhaseMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  args.GetReturnValue().Set(monitor->Disable());
+}
+
+static void EventLoopPhaseMonitorReset(
+    const FunctionCallbackInfo<Value>& args) {
+  EventLoopPhaseMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  monitor->Reset();
+}
+
+static void EventLoopPhaseMonitorNew(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  new EventLoopPhaseMonitor(env, args.This());
+}
+}  // namespace
+
+EventLoopPhaseMonitor::EventLoopPhaseMonitor(Environment* env,
+                                             Local<Object> wrap)
+    : BaseObject(env, wrap) {
+  MakeWeak();
+  PropertyAttribute attr =
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete);
+#define V(name, label)                                                        \
+  {                                                                           \
+    BaseObjectPtr<HistogramBase> histogram =                                  \
+        HistogramBase::New(env, 1, 3.6e12);                                   \
+    CHECK(histogram);                                                         \
+    wrap->DefineOwnProperty(env->context(),                                   \
+                            FIXED_ONE_BYTE_STRING(env->isolate(), label),     \
+                            histogram->object(),                              \
+                            attr).Check();                                    \
+    histograms_[NODE_EVENT_LOOP_PHASE_##name] = std::move(histogram);         \
+  }
+  NODE_EVENT_LOOP_PHASES(V)
+#undef V
+}
+
+EventLoopPhaseMonitor::~EventLoopPhaseMonitor() {
+  Disable();
+}
+
+bool EventLoopPhaseMonitor::Enable() {
+  if (enabled_) return false;
+  enabled_ = true;
+  env()->loop_phase_timer()->AddMonitor(this);
+  return true;
+}
+
+bool EventLoopPhaseMonitor::Disable() {
+  if (!enabled_) return false;
+  enabled_ = false;
+  env()->loop_phase_timer()->RemoveMonitor(this);
+  return true;
+}
+
+void EventLoopPhaseMonitor::Reset() {
+  for (const BaseObjectPtr<HistogramBase>& histogram : histograms_)
+    histogram->ResetState();
+}
+
+void EventLoopPhaseMonitor::MemoryInfo(MemoryTracker* tracker) const {
+#define V(name, label)                                                        \
+  tracker->TrackField(label, histograms_[NODE_EVENT_LOOP_PHASE_##name]);
+  NODE_EVENT_LOOP_PHASES(V)
+#undef V
+}
+
+// Async Callback Monitor
+namespace {
+static void AsyncCallbackMonitorEnable(
+    const FunctionCallbackInfo<Value>& args) {
+  AsyncCallbackMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  args.GetReturnValue().Set(monitor->Enable());
+}
+
+static void AsyncCallbackMonitorDisable(
+    const FunctionCallbackInfo<Value>& args) {
+  AsyncCallbackMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  args.GetReturnValue().Set(monitor->Disable());
+}
+
+static void AsyncCallbackMonitorReset(
+    const FunctionCallbackInfo<Value>& args) {
+  AsyncCallbackMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  monitor->Reset();
+}
+
+// Returns an object with one property per provider type that has made
+// callbacks, in the order of the provider types.
+static void AsyncCallbackMonitorStats(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  AsyncCallbackMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+
+  Local<Object> result = Object::New(isolate);
+  for (int n = 0; n < AsyncWrap::PROVIDERS_LENGTH; n++) {
+    AsyncWrap::ProviderType provider = static_cast<AsyncWrap::ProviderType>(n);
+    AsyncCallbackMonitor::Entry* entry = monitor->entry(provider);
+    if (entry->count == 0) continue;
+    Histogram* histogram = entry->histogram.get();
+
+    Local<Map> percentiles = Map::New(isolate);
+    histogram->Percentiles([&](double key, double value) {
+      USE(percentiles->Set(context,
+                           Number::New(isolate, key),
+                           Number::New(isolate, value)));
+    });
+
+    Local<Object> stats = Object::New(isolate);
+    if (stats->Set(context, FIXED_ONE_BYTE_STRING(isolate, "count"),
+                   Number::New(isolate, entry->count)).IsNothing() ||
+        stats->Set(context, FIXED_ONE_BYTE_STRING(isolate, "totalTime"),
+                   Number::New(isolate, entry->total_time)).IsNothing() ||
+        stats->Set(context, FIXED_ONE_BYTE_STRING(isolate, "min"),
+                   Number::New(isolate, histogram->Min())).IsNothing() ||
+        stats->Set(context, FIXED_ONE_BYTE_STRING(isolate, "max"),
+                   Number::New(isolate, histogram->Max())).IsNothing() ||
+        stats->Set(context, FIXED_ONE_BYTE_STRING(isolate, "mean"),
+                   Number::New(isolate, histogram->Mean())).IsNothing() ||
+        stats->Set(context, FIXED_ONE_BYTE_STRING(isolate, "stddev"),
+                   Number::New(isolate, histogram->Stddev())).IsNothing() ||
+        stats->Set(context, FIXED_ONE_BYTE_STRING(isolate, "percentiles"),
+                   percentiles).IsNothing() ||
+        result->Set(context,
+                    OneByteString(isolate,
+                                  AsyncWrap::GetProviderName(provider)),
+                    stats).IsNothing()) {
+      return;
+    }
+  }
+  args.GetReturnValue().Set(result);
+}
+
+static void AsyncCallbackMonitorNew(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  new AsyncCallbackMonitor(env, args.This());
+}
+}  // namespace
+
+AsyncCallbackMonitor::AsyncCallbackMonitor(Environment* env,
+                                           Local<Object> wrap)
+    : BaseObject(env, wrap) {
+  MakeWeak();
+}
+
+AsyncCallbackMonitor::~AsyncCallbackMonitor() {
+  Disable();
+}
+
+bool AsyncCallbackMonitor::Enable() {
+  if (enabled_) return false;
+  enabled_ = true;
+  env()->async_callback_monitors()->push_back(this);
+  return true;
+}
+
+bool AsyncCallbackMonitor::Disable() {
+  if (!enabled_) return false;
+  enabled_ = false;
+  std::vector<AsyncCallbackMonitor*>* monitors =
+      env()->async_callback_monitors();
+  monitors->erase(std::find(monitors->begin(), monitors->end(), this));
+  return true;
+}
+
+void AsyncCallbackMonitor::Reset() {
+  for (Entry& entry : entries_) {
+    entry.count = 0;
+    entry.total_time = 0;
+    entry.histogram.reset();
+  }
+}
+
+void AsyncCallbackMonitor::MemoryInfo(MemoryTracker* tracker) const {
+  size_t size = 0;
+  for (const Entry& entry : entries_) {
+    if (entry.histogram)
+      size += entry.histogram->GetMemorySize();
+  }
+  tracker->TrackFieldWithSize("histograms", size);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -637,6 +922,7 @@ void Initialize(Local<Object> target,
                  RemoveGarbageCollectionTracking);
   env->SetMethod(target, "notify", Notify);
   env->SetMethod(target, "loopIdleTime", LoopIdleTime);
+  env->SetMethod(target, "createHistogram", CreateHistogram);
 
   Local<Object> constants = Object::New(isolate);
 
@@ -708,6 +994,36 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(eldh, "reset", ELDHistogramReset);
   target->Set(context, eldh_classname,
               eldh->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  HistogramBase::Initialize(env);
+  Local<String> elpm_classname =
+      FIXED_ONE_BYTE_STRING(isolate, "EventLoopPhaseMonitor");
+  Local<FunctionTemplate> elpm =
+      env->NewFunctionTemplate(EventLoopPhaseMonitorNew);
+  elpm->SetClassName(elpm_classname);
+  elpm->InstanceTemplate()->SetInternalFieldCount(
+      EventLoopPhaseMonitor::kInternalFieldCount);
+  elpm->Inherit(BaseObject::GetConstructorTemplate(env));
+  env->SetProtoMethod(elpm, "enable", EventLoopPhaseMonitorEnable);
+  env->SetProtoMethod(elpm, "disable", EventLoopPhaseMonitorDisable);
+  env->SetProtoMethod(elpm, "reset", EventLoopPhaseMonitorReset);
+  target->Set(context, elpm_classname,
+              elpm->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  Local<String> acm_classname =
+      FIXED_ONE_BYTE_STRING(isolate, "AsyncCallbackMonitor");
+  Local<FunctionTemplate> acm =
+      env->NewFunctionTemplate(AsyncCallbackMonitorNew);
+  acm->SetClassName(acm_classname);
+  acm->InstanceTemplate()->SetInternalFieldCount(
+      AsyncCallbackMonitor::kInternalFieldCount);
+  acm->Inherit(BaseObject::GetConstructorTemplate(env));
+  env->SetProtoMethod(acm, "enable", AsyncCallbackMonitorEnable);
+  env->SetProtoMethod(acm, "disable", AsyncCallbackMonitorDisable);
+  env->SetProtoMethod(acm, "reset", AsyncCallbackMonitorReset);
+  env->SetProtoMethod(acm, "stats", AsyncCallbackMonitorStats);
+  target->Set(context, acm_classname,
+              acm->GetFunction(env->context()).ToLocalChecked()).Check();
 }
 
 }  // namespace performance
@@ -5,6 +5,7 @@
 
 #include "node.h"
 #include "node_perf_common.h"
+#include "async_wrap.h"
 #include "base_object-inl.h"
 #include "histogram-inl.h"
 
@@ -173,6 +174,72 @@ class ELDHistogram : public HandleWrap, public Histogram {
   uv_timer_t timer_;
 };
 
+// Collects the durations of the event loop phases measured by the
+// EventLoopPhaseTimer of the Environment into one histogram per phase.
+class EventLoopPhaseMonitor : public BaseObject {
+ public:
+  EventLoopPhaseMonitor(Environment* env, v8::Local<v8::Object> wrap);
+  ~EventLoopPhaseMonitor() override;
+
+  bool Enable();
+  bool Disable();
+  void Reset();
+
+  void Record(EventLoopPhase phase, uint64_t duration) {
+    histograms_[phase]->Record(duration);
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(EventLoopPhaseMonitor)
+  SET_SELF_SIZE(EventLoopPhaseMonitor)
+
+ private:
+  bool enabled_ = false;
+  BaseObjectPtr<HistogramBase> histograms_[NODE_EVENT_LOOP_PHASE_INVALID];
+};
+
+// Accounts the callbacks made through AsyncWrap::MakeCallback() per provider
+// type: how many there were, the total time spent in them and a histogram
+// of their durations. The durations include nested callbacks and the
+// microtasks and nextTick callbacks that run when the callback returns.
+class AsyncCallbackMonitor : public BaseObject {
+ public:
+  struct Entry {
+    uint64_t count = 0;
+    uint64_t total_time = 0;
+    // Only allocated for the providers that have made callbacks.
+    std::unique_ptr<Histogram> histogram;
+  };
+
+  AsyncCallbackMonitor(Environment* env, v8::Local<v8::Object> wrap);
+  ~AsyncCallbackMonitor() override;
+
+  bool Enable();
+  bool Disable();
+  void Reset();
+
+  void Record(AsyncWrap::ProviderType provider, uint64_t duration) {
+    Entry* entry = &entries_[provider];
+    if (!entry->histogram)
+      entry->histogram = std::make_unique<Histogram>(1, 3.6e12);
+    entry->count++;
+    entry->total_time += duration;
+    entry->histogram->Record(duration);
+  }
+
+  Entry* entry(AsyncWrap::ProviderType provider) {
+    return &entries_[provider];
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(AsyncCallbackMonitor)
+  SET_SELF_SIZE(AsyncCallbackMonitor)
+
+ private:
+  bool enabled_ = false;
+  Entry entries_[AsyncWrap::PROVIDERS_LENGTH];
+};
+
 }  // namespace performance
 }  // namespace node
 
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace node {
 namespace performance {
@@ -40,6 +41,16 @@ extern uint64_t performance_v8_start;
   V(HTTP2, "http2")                                                           \
   V(HTTP, "http")
 
+// The phases of an event loop iteration that are measured by
+// perf_hooks.monitorEventLoopPhases(). `other` covers the pending, idle,
+// prepare and close callbacks, and native timers.
+#define NODE_EVENT_LOOP_PHASES(V)                                             \
+  V(TIMERS, "timers")                                                         \
+  V(POLL, "poll")                                                             \
+  V(POLL_WAIT, "pollWait")                                                    \
+  V(CHECK, "check")                                                           \
+  V(OTHER, "other")
+
 enum PerformanceMilestone {
 #define V(name, _) NODE_PERFORMANCE_MILESTONE_##name,
   NODE_PERFORMANCE_MILESTONES(V)
@@ -54,6 +65,92 @@ enum PerformanceEntryType {
   NODE_PERFORMANCE_ENTRY_TYPE_INVALID
 };
 
+enum EventLoopPhase {
+#define V(name, _) NODE_EVENT_LOOP_PHASE_##name,
+  NODE_EVENT_LOOP_PHASES(V)
+#undef V
+  NODE_EVENT_LOOP_PHASE_INVALID
+};
+
+class AsyncCallbackMonitor;
+class EventLoopPhaseMonitor;
+
+// Measures how long the phases of every event loop iteration take while at
+// least one EventLoopPhaseMonitor is enabled, and reports them to the
+// monitors once the iteration is complete. An iteration starts and ends
+// with the prepare phase that precedes polling for I/O, and the poll phase
+// ends when the check handle of the Environment runs. The time spent
+// blocking for I/O is taken from the idle time metrics of libuv.
+class EventLoopPhaseTimer {
+ public:
+  // Measures a phase that the Environment runs itself. Nothing is measured
+  // unless a monitor is enabled.
+  class Scope {
+   public:
+    inline Scope(EventLoopPhaseTimer* timer, EventLoopPhase phase);
+    inline ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    EventLoopPhaseTimer* timer_;
+    EventLoopPhase phase_;
+    uint64_t start_ = 0;
+  };
+
+  void Initialize(uv_loop_t* loop);
+  uv_prepare_t* prepare_handle() { return &prepare_handle_; }
+
+  void AddMonitor(EventLoopPhaseMonitor* monitor);
+  void RemoveMonitor(EventLoopPhaseMonitor* monitor);
+  // Detaches all monitors and stops measuring.
+  void Stop();
+  bool enabled() const { return !monitors_.empty(); }
+
+  // Called when the check handle of the Environment runs.
+  inline void EndPoll();
+
+ private:
+  static void OnPrepare(uv_prepare_t* handle);
+  void Reset();
+
+  uv_prepare_t prepare_handle_;
+  std::vector<EventLoopPhaseMonitor*> monitors_;
+  uint64_t durations_[NODE_EVENT_LOOP_PHASE_INVALID] = {};
+  bool measured_[NODE_EVENT_LOOP_PHASE_INVALID] = {};
+  uint64_t prepare_time_ = 0;
+  uint64_t prepare_idle_time_ = 0;
+  uint64_t poll_end_time_ = 0;
+};
+
+EventLoopPhaseTimer::Scope::Scope(EventLoopPhaseTimer* timer,
+                                  EventLoopPhase phase)
+    : timer_(timer), phase_(phase) {
+  if (timer_->enabled())
+    start_ = PERFORMANCE_NOW();
+}
+
+EventLoopPhaseTimer::Scope::~Scope() {
+  if (start_ == 0 || timer_->prepare_time_ == 0) return;
+  timer_->durations_[phase_] += PERFORMANCE_NOW() - start_;
+  timer_->measured_[phase_] = true;
+}
+
+void EventLoopPhaseTimer::EndPoll() {
+  // Nothing to do until the first iteration after a monitor was enabled
+  // has reached the prepare phase.
+  if (prepare_time_ == 0 || poll_end_time_ != 0) return;
+  poll_end_time_ = PERFORMANCE_NOW();
+  uint64_t idle_time = uv_metrics_idle_time(prepare_handle_.loop);
+  uint64_t wait = idle_time - prepare_idle_time_;
+  uint64_t poll = poll_end_time_ - prepare_time_;
+  durations_[NODE_EVENT_LOOP_PHASE_POLL_WAIT] = wait;
+  durations_[NODE_EVENT_LOOP_PHASE_POLL] = poll > wait ? poll - wait : 0;
+  measured_[NODE_EVENT_LOOP_PHASE_POLL_WAIT] = true;
+  measured_[NODE_EVENT_LOOP_PHASE_POLL] = true;
+}
+
 class PerformanceState {
  public:
   struct SerializeInfo {
@@ -5,7 +5,9 @@
 #include "diagnosticfilename-inl.h"
 #include "node_internals.h"
 #include "node_metadata.h"
+#include "memory_tracker-inl.h"
 #include "node_mutex.h"
+#include "node_perf.h"
 #include "node_worker.h"
 #include "util.h"
 
@@ -77,6 +79,7 @@ static void PrintComponentVersions(JSONWriter* writer);
 static void PrintRelease(JSONWriter* writer);
 static void PrintCpuInfo(JSONWriter* writer);
 static void PrintNetworkInterfaceInfo(JSONWriter* writer);
+static void PrintAsyncCallbacks(JSONWriter* writer, Environment* env);
 
 // External function to trigger a report, writing to file.
 std::string TriggerNodeReport(Isolate* isolate,
@@ -303,6 +306,10 @@ static void WriteNodeReport(Isolate* isolate,
 
   writer.json_arrayend();
 
+  // Report the callbacks accounted by perf_hooks.monitorAsyncCallbacks()
+  if (env != nullptr && !env->async_callback_monitors()->empty())
+    PrintAsyncCallbacks(&writer, env);
+
   writer.json_arraystart("workers");
   if (env != nullptr) {
     Mutex workers_mutex;
@@ -565,6 +572,35 @@ static void PrintNativeStack(JSONWriter* writer) {
   writer->json_arrayend();
 }
 
+// Report the time spent in the callbacks of each async resource type.
+static void PrintAsyncCallbacks(JSONWriter* writer, Environment* env) {
+  using node::AsyncWrap;
+  using node::Histogram;
+  using node::performance::AsyncCallbackMonitor;
+
+  writer->json_arraystart("asyncCallbacks");
+  for (AsyncCallbackMonitor* monitor : *env->async_callback_monitors()) {
+    writer->json_start();
+    for (int n = 0; n < AsyncWrap::PROVIDERS_LENGTH; n++) {
+      AsyncWrap::ProviderType provider =
+          static_cast<AsyncWrap::ProviderType>(n);
+      AsyncCallbackMonitor::Entry* entry = monitor->entry(provider);
+      if (entry->count == 0) continue;
+      Histogram* histogram = entry->histogram.get();
+      writer->json_objectstart(AsyncWrap::GetProviderName(provider));
+      writer->json_keyvalue("count", entry->count);
+      writer->json_keyvalue("totalTime", entry->total_time);
+      writer->json_keyvalue("min", histogram->Min());
+      writer->json_keyvalue("max", histogram->Max());
+      writer->json_keyvalue("mean", histogram->Mean());
+      writer->json_keyvalue("p99", histogram->Percentile(99));
+      writer->json_objectend();
+    }
+    writer->json_end();
+  }
+  writer->json_arrayend();
+}
+
 // Report V8 JavaScript heap information.
 // This uses the existing V8 HeapStatistics and HeapSpaceStatistics APIs.
 // The isolate->GetGCStatistics(&heap_stats) internal V8 API could potentially
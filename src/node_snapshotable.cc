@@ -0,0 +1,648 @@
+#include "node_snapshotable.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "base_object-inl.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_errors.h"
+#include "node_external_reference.h"
+#include "node_file.h"
+#include "node_internals.h"
+#include "node_main_instance.h"
+#include "node_options-inl.h"
+#include "node_v8.h"
+#include "node_v8_platform-inl.h"
+#include "node_version.h"
+
+namespace node {
+
+using v8::Context;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::MaybeLocal;
+using v8::Object;
+using v8::ScriptCompiler;
+using v8::ScriptOrigin;
+using v8::SnapshotCreator;
+using v8::StartupData;
+using v8::String;
+using v8::TryCatch;
+using v8::Value;
+
+template <typename T>
+void WriteVector(std::stringstream* ss, const T* vec, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    *ss << std::to_string(vec[i]) << (i == size - 1 ? '\n' : ',');
+  }
+}
+
+static std::string FormatBlob(const SnapshotData& data) {
+  std::stringstream ss;
+
+  ss << R"(#include <cstddef>
+#include "env.h"
+#include "node_main_instance.h"
+#include "v8.h"
+
+// This file is generated by tools/snapshot. Do not edit.
+
+namespace node {
+
+static const char blob_data[] = {
+)";
+  WriteVector(&ss, data.blob.data(), data.blob.size());
+  ss << R"(};
+
+static const int blob_size = )"
+     << data.blob.size() << R"(;
+static v8::StartupData blob = { blob_data, blob_size };
+)";
+
+  ss << R"(v8::StartupData* NodeMainInstance::GetEmbeddedSnapshotBlob() {
+  return &blob;
+}
+
+static const std::vector<size_t> isolate_data_indexes {
+)";
+  WriteVector(&ss,
+              data.isolate_data_indexes.data(),
+              data.isolate_data_indexes.size());
+  ss << R"(};
+
+const std::vector<size_t>* NodeMainInstance::GetIsolateDataIndexes() {
+  return &isolate_data_indexes;
+}
+
+static const EnvSerializeInfo env_info )"
+     << data.env_info << R"(;
+
+const EnvSerializeInfo* NodeMainInstance::GetEnvSerializeInfo() {
+  return &env_info;
+}
+
+}  // namespace node
+)";
+
+  return ss.str();
+}
+
+// The snapshot file starts with a magic number and the versions of Node.js
+// and V8 that produced it, since V8 refuses to deserialize snapshots created
+// by another version and would crash instead of reporting an error.
+static constexpr size_t kSnapshotFileMagic = 0x143da19;
+
+class SnapshotFileWriter {
+ public:
+  explicit SnapshotFileWriter(FILE* out) : out_(out) {}
+
+  bool ok() const { return ok_; }
+
+  void Write(const void* data, size_t size) {
+    if (ok_ && size > 0 && fwrite(data, 1, size, out_) != size) ok_ = false;
+  }
+
+  void Write(size_t value) { Write(&value, sizeof(value)); }
+
+  void Write(const std::string& str) {
+    Write(str.size());
+    Write(str.data(), str.size());
+  }
+
+  void Write(const PropInfo& info) {
+    Write(info.name);
+    Write(info.id);
+    Write(info.index);
+  }
+
+  template <typename T>
+  void Write(const std::vector<T>& vec) {
+    Write(vec.size());
+    for (const T& item : vec) Write(item);
+  }
+
+  void Write(const AsyncHooks::SerializeInfo& info) {
+    Write(info.async_ids_stack);
+    Write(info.fields);
+    Write(info.async_id_fields);
+    Write(info.js_execution_async_resources);
+    Write(info.native_execution_async_resources);
+  }
+
+  void Write(const performance::PerformanceState::SerializeInfo& info) {
+    Write(info.root);
+    Write(info.milestones);
+    Write(info.observers);
+  }
+
+  void Write(const EnvSerializeInfo& info) {
+    Write(info.native_modules);
+    Write(info.async_hooks);
+    Write(info.tick_info.fields);
+    Write(info.immediate_info.fields);
+    Write(info.performance_state);
+    Write(info.stream_base_state);
+    Write(info.should_abort_on_uncaught_toggle);
+    Write(info.persistent_templates);
+    Write(info.persistent_values);
+    Write(info.context);
+  }
+
+ private:
+  FILE* out_;
+  bool ok_ = true;
+};
+
+class SnapshotFileReader {
+ public:
+  SnapshotFileReader(FILE* in, size_t size) : in_(in), remaining_(size) {}
+
+  bool ok() const { return ok_; }
+
+  void Read(void* data, size_t size) {
+    if (!ok_ || size == 0) return;
+    if (size > remaining_ || fread(data, 1, size, in_) != size) {
+      ok_ = false;
+      return;
+    }
+    remaining_ -= size;
+  }
+
+  void Read(size_t* value) {
+    *value = 0;
+    Read(value, sizeof(*value));
+  }
+
+  // Reads a length prefix, making sure that it does not exceed what is left
+  // in the file so that a corrupted file cannot trigger huge allocations.
+  size_t ReadLength(size_t item_size) {
+    size_t length;
+    Read(&length);
+    if (ok_ && length > remaining_ / item_size) ok_ = false;
+    return ok_ ? length : 0;
+  }
+
+  void Read(std::string* str) {
+    str->resize(ReadLength(1));
+    Read(&(*str)[0], str->size());
+  }
+
+  void Read(PropInfo* info) {
+    Read(&info->name);
+    Read(&info->id);
+    Read(&info->index);
+  }
+
+  template <typename T>
+  void Read(std::vector<T>* vec) {
+    vec->resize(ReadLength(sizeof(size_t)));
+    for (T& item : *vec) Read(&item);
+  }
+
+  void Read(AsyncHooks::SerializeInfo* info) {
+    Read(&info->async_ids_stack);
+    Read(&info->fields);
+    Read(&info->async_id_fields);
+    Read(&info->js_execution_async_resources);
+    Read(&info->native_execution_async_resources);
+  }
+
+  void Read(performance::PerformanceState::SerializeInfo* info) {
+    Read(&info->root);
+    Read(&info->milestones);
+    Read(&info->observers);
+  }
+
+  void Read(EnvSerializeInfo* info) {
+    Read(&info->native_modules);
+    Read(&info->async_hooks);
+    Read(&info->tick_info.fields);
+    Read(&info->immediate_info.fields);
+    Read(&info->performance_state);
+    Read(&info->stream_base_state);
+    Read(&info->should_abort_on_uncaught_toggle);
+    Read(&info->persistent_templates);
+    Read(&info->persistent_values);
+    Read(&info->context);
+  }
+
+ private:
+  FILE* in_;
+  size_t remaining_;
+  bool ok_ = true;
+};
+
+bool SnapshotData::ToFile(FILE* out) const {
+  SnapshotFileWriter writer(out);
+  writer.Write(kSnapshotFileMagic);
+  writer.Write(std::string(NODE_VERSION));
+  writer.Write(std::string(v8::V8::GetVersion()));
+  writer.Write(blob.size());
+  writer.Write(blob.data(), blob.size());
+  writer.Write(isolate_data_indexes);
+  writer.Write(env_info);
+  return writer.ok() && fflush(out) == 0;
+}
+
+bool SnapshotData::FromFile(SnapshotData* out, FILE* in) {
+  if (fseek(in, 0, SEEK_END) != 0) return false;
+  long size = ftell(in);  // NOLINT(runtime/int)
+  if (size < 0 || fseek(in, 0, SEEK_SET) != 0) return false;
+
+  SnapshotFileReader reader(in, static_cast<size_t>(size));
+  size_t magic;
+  std::string node_version;
+  std::string v8_version;
+  reader.Read(&magic);
+  if (!reader.ok() || magic != kSnapshotFileMagic) {
+    fprintf(stderr, "The file is not a Node.js snapshot blob\n");
+    return false;
+  }
+  reader.Read(&node_version);
+  reader.Read(&v8_version);
+  if (!reader.ok() ||
+      node_version != NODE_VERSION ||
+      v8_version != v8::V8::GetVersion()) {
+    fprintf(stderr,
+            "The snapshot blob was built by Node.js %s (V8 %s), which is "
+            "incompatible with Node.js %s (V8 %s)\n",
+            node_version.c_str(),
+            v8_version.c_str(),
+            NODE_VERSION,
+            v8::V8::GetVersion());
+    return false;
+  }
+  out->blob.resize(reader.ReadLength(1));
+  reader.Read(out->blob.data(), out->blob.size());
+  reader.Read(&out->isolate_data_indexes);
+  reader.Read(&out->env_info);
+  if (!reader.ok()) {
+    fprintf(stderr, "The snapshot blob is truncated or corrupted\n");
+    return false;
+  }
+  out->v8_snapshot_blob_data.data = out->blob.data();
+  out->v8_snapshot_blob_data.raw_size = static_cast<int>(out->blob.size());
+  return true;
+}
+
+SnapshotableObject::SnapshotableObject(Environment* env,
+                                       Local<Object> wrap,
+                                       EmbedderObjectType type)
+    : BaseObject(env, wrap), type_(type) {
+}
+
+const char* SnapshotableObject::GetTypeNameChars() const {
+  switch (type_) {
+#define V(PropertyName, NativeTypeName)                                        \
+  case EmbedderObjectType::k_##PropertyName: {                                 \
+    return NativeTypeName::type_name.c_str();                                  \
+  }
+    SERIALIZABLE_OBJECT_TYPES(V)
+#undef V
+    default: { UNREACHABLE(); }
+  }
+}
+
+StartupData SerializeNodeContextInternalFields(Local<Object> holder,
+                                               int index,
+                                               void* env) {
+  void* ptr = holder->GetAlignedPointerFromInternalField(index);
+  if (ptr == nullptr || ptr == env || index != BaseObject::kSlot) {
+    return StartupData{nullptr, 0};
+  }
+
+  // Environment::PrepareForSerialization() has made sure that all the
+  // BaseObjects that are still alive are snapshotable.
+  BaseObject* base_object = static_cast<BaseObject*>(ptr);
+  CHECK(base_object->is_snapshotable());
+  SnapshotableObject* obj = static_cast<SnapshotableObject*>(base_object);
+  per_process::Debug(DebugCategory::MKSNAPSHOT,
+                     "Serializing %s with index %d at %p\n",
+                     obj->GetTypeNameChars(),
+                     index,
+                     ptr);
+  InternalFieldInfoBase* info = obj->Serialize(index);
+  // V8 takes ownership of the data.
+  return StartupData{reinterpret_cast<const char*>(info),
+                     static_cast<int>(info->length)};
+}
+
+void DeserializeNodeInternalFields(Local<Object> holder,
+                                   int index,
+                                   StartupData payload,
+                                   void* env) {
+  if (payload.raw_size == 0) {
+    holder->SetAlignedPointerInInternalField(index, nullptr);
+    return;
+  }
+
+  Environment* env_ptr = static_cast<Environment*>(env);
+  // The payload is not guaranteed to be aligned, so copy it out.
+  size_t length = static_cast<size_t>(payload.raw_size);
+  CHECK_GE(length, sizeof(InternalFieldInfoBase));
+  InternalFieldInfoBase* info =
+      InternalFieldInfoBase::New(EmbedderObjectType::k_default, length);
+  memcpy(info, payload.data, length);
+  CHECK_EQ(info->length, length);
+
+  // The BaseObject is re-created once the context is fully deserialized,
+  // see Environment::RunDeserializeRequests().
+  holder->SetAlignedPointerInInternalField(index, nullptr);
+  switch (info->type) {
+#define V(PropertyName, NativeTypeName)                                        \
+  case EmbedderObjectType::k_##PropertyName: {                                 \
+    per_process::Debug(DebugCategory::MKSNAPSHOT,                              \
+                       "Object %p is %s\n",                                    \
+                       (*holder),                                              \
+                       NativeTypeName::type_name.c_str());                     \
+    env_ptr->EnqueueDeserializeRequest(                                       \
+        NativeTypeName::Deserialize, holder, index, info);                     \
+    break;                                                                     \
+  }
+    SERIALIZABLE_OBJECT_TYPES(V)
+#undef V
+    default: { UNREACHABLE(); }
+  }
+}
+
+static bool ReadEntryScript(const std::string& filename, std::string* out) {
+  std::ifstream file(filename, std::ios::in | std::ios::binary);
+  if (!file.is_open()) return false;
+  std::stringstream ss;
+  ss << file.rdbuf();
+  *out = ss.str();
+  return !file.bad();
+}
+
+// Compiles the entry script into a function that takes
+// (require, __filename, __dirname), similar to a CommonJS module.
+static MaybeLocal<Function> CompileEntryScript(Environment* env,
+                                               const std::string& filename,
+                                               const std::string& source) {
+  Isolate* isolate = env->isolate();
+  Local<String> filename_string;
+  Local<String> source_string;
+  if (!String::NewFromUtf8(isolate, filename.c_str()).ToLocal(
+          &filename_string) ||
+      !String::NewFromUtf8(isolate, source.data(),
+                           v8::NewStringType::kNormal,
+                           static_cast<int>(source.size()))
+           .ToLocal(&source_string)) {
+    return MaybeLocal<Function>();
+  }
+  Local<String> parameters[] = {
+      env->require_string(),
+      FIXED_ONE_BYTE_STRING(isolate, "__filename"),
+      FIXED_ONE_BYTE_STRING(isolate, "__dirname"),
+  };
+  ScriptOrigin origin(filename_string);
+  ScriptCompiler::Source script_source(source_string, origin);
+  return ScriptCompiler::CompileFunctionInContext(env->context(),
+                                                  &script_source,
+                                                  arraysize(parameters),
+                                                  parameters,
+                                                  0,
+                                                  nullptr);
+}
+
+static void SpinEventLoopForSnapshot(Environment* env) {
+  MultiIsolatePlatform* platform = per_process::v8_platform.Platform();
+  do {
+    uv_run(env->event_loop(), UV_RUN_DEFAULT);
+    platform->DrainTasks(env->isolate());
+  } while (uv_loop_alive(env->event_loop()) && !env->is_stopping());
+}
+
+// Runs the entry script through lib/internal/main/mksnapshot.js and waits
+// until the event loop is empty, so that no handles or requests are left.
+static int RunEntryScript(Environment* env, const std::string& entry_file) {
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  std::string source;
+  if (!ReadEntryScript(entry_file, &source)) {
+    fprintf(stderr, "Cannot read the snapshot entry %s\n", entry_file.c_str());
+    return 1;
+  }
+
+  env->InitializeLibuv();
+  {
+    InternalCallbackScope callback_scope(
+        env,
+        Object::New(isolate),
+        { 1, 0 },
+        InternalCallbackScope::kSkipAsyncHooks);
+    TryCatch try_catch(isolate);
+    Local<Function> entry_main;
+    if (!CompileEntryScript(env, entry_file, source).ToLocal(&entry_main)) {
+      PrintCaughtException(isolate, context, try_catch);
+      return 1;
+    }
+
+    std::vector<Local<String>> parameters = {
+        env->process_string(),
+        env->require_string(),
+        env->internal_binding_string(),
+        env->primordials_string(),
+        FIXED_ONE_BYTE_STRING(isolate, "entryFilename"),
+        FIXED_ONE_BYTE_STRING(isolate, "entryMain")};
+    std::vector<Local<Value>> arguments = {
+        env->process_object(),
+        env->native_module_require(),
+        env->internal_binding_loader(),
+        env->primordials(),
+        ToV8Value(context, entry_file).ToLocalChecked(),
+        entry_main};
+    if (ExecuteBootstrapper(
+            env, "internal/main/mksnapshot", &parameters, &arguments)
+            .IsEmpty()) {
+      if (try_catch.HasCaught() && !try_catch.HasTerminated())
+        PrintCaughtException(isolate, context, try_catch);
+      return 1;
+    }
+  }
+  SpinEventLoopForSnapshot(env);
+
+  Local<Function> serialize_callback = env->snapshot_serialize_callback();
+  if (!serialize_callback.IsEmpty()) {
+    env->set_snapshot_serialize_callback(Local<Function>());
+    {
+      InternalCallbackScope callback_scope(
+          env,
+          Object::New(isolate),
+          { 1, 0 },
+          InternalCallbackScope::kSkipAsyncHooks);
+      TryCatch try_catch(isolate);
+      if (serialize_callback->Call(context, Undefined(isolate), 0, nullptr)
+              .IsEmpty()) {
+        if (try_catch.HasCaught() && !try_catch.HasTerminated())
+          PrintCaughtException(isolate, context, try_catch);
+        return 1;
+      }
+    }
+    SpinEventLoopForSnapshot(env);
+  }
+
+  if (env->is_stopping()) return 1;
+
+  // Collect the objects that the script no longer references, so that
+  // the BaseObjects of completed requests do not end up in the snapshot.
+  isolate->LowMemoryNotification();
+  per_process::v8_platform.Platform()->DrainTasks(isolate);
+  return 0;
+}
+
+int SnapshotBuilder::Generate(SnapshotData* out,
+                              const std::vector<std::string> args,
+                              const std::vector<std::string> exec_args,
+                              const std::string& entry_file) {
+  Isolate* isolate = Isolate::Allocate();
+  per_process::v8_platform.Platform()->RegisterIsolate(isolate,
+                                                       uv_default_loop());
+  std::unique_ptr<NodeMainInstance> main_instance;
+  int exit_code = 0;
+
+  {
+    const std::vector<intptr_t>& external_references =
+        NodeMainInstance::CollectExternalReferences();
+    SnapshotCreator creator(isolate, external_references.data());
+    Environment* env;
+    {
+      main_instance =
+          NodeMainInstance::Create(isolate,
+                                   uv_default_loop(),
+                                   per_process::v8_platform.Platform(),
+                                   args,
+                                   exec_args);
+
+      HandleScope scope(isolate);
+      creator.SetDefaultContext(Context::New(isolate));
+      out->isolate_data_indexes =
+          main_instance->isolate_data()->Serialize(&creator);
+
+      Local<Context> context = NewContext(isolate);
+      Context::Scope context_scope(context);
+
+      env = new Environment(main_instance->isolate_data(),
+                            context,
+                            args,
+                            exec_args,
+                            nullptr,
+                            node::EnvironmentFlags::kDefaultFlags,
+                            {});
+      env->RunBootstrapping().ToLocalChecked();
+      if (!entry_file.empty()) {
+        exit_code = RunEntryScript(env, entry_file);
+      }
+      if (per_process::enabled_debug_list.enabled(DebugCategory::MKSNAPSHOT)) {
+        env->PrintAllBaseObjects();
+        printf("Environment = %p\n", env);
+      }
+      if (exit_code == 0 && !env->PrepareForSerialization(&creator)) {
+        exit_code = 1;
+      }
+      if (exit_code == 0) {
+        out->env_info = env->Serialize(&creator);
+        size_t index = creator.AddContext(
+            context, {SerializeNodeContextInternalFields, env});
+        CHECK_EQ(index, NodeMainInstance::kNodeContextIndex);
+      }
+    }
+
+    // Must be out of HandleScope
+    StartupData blob =
+        creator.CreateBlob(SnapshotCreator::FunctionCodeHandling::kClear);
+    if (exit_code == 0) {
+      CHECK(blob.CanBeRehashed());
+      out->blob.assign(blob.data, blob.data + blob.raw_size);
+      out->v8_snapshot_blob_data.data = out->blob.data();
+      out->v8_snapshot_blob_data.raw_size = blob.raw_size;
+    }
+    // Must be done while the snapshot creator isolate is entered i.e. the
+    // creator is still alive.
+    FreeEnvironment(env);
+    main_instance->Dispose();
+    delete[] blob.data;
+  }
+
+  per_process::v8_platform.Platform()->UnregisterIsolate(isolate);
+  return exit_code;
+}
+
+std::string SnapshotBuilder::GenerateAsSource(
+    const std::vector<std::string> args,
+    const std::vector<std::string> exec_args) {
+  SnapshotData data;
+  CHECK_EQ(Generate(&data, args, exec_args), 0);
+  return FormatBlob(data);
+}
+
+int BuildSnapshot(const std::vector<std::string>& args,
+                  const std::vector<std::string>& exec_args) {
+  if (args.size() < 2) {
+    fprintf(stderr, "--build-snapshot must be used with an entry point script."
+                    "\nUsage: node --build-snapshot /path/to/entry.js\n");
+    return 9;
+  }
+  std::string snapshot_blob_path = per_process::cli_options->snapshot_blob;
+  if (snapshot_blob_path.empty()) snapshot_blob_path = "snapshot.blob";
+
+  SnapshotData data;
+  int exit_code = SnapshotBuilder::Generate(&data, args, exec_args, args[1]);
+  if (exit_code != 0) return exit_code;
+
+  FILE* fp = fopen(snapshot_blob_path.c_str(), "wb");
+  if (fp == nullptr) {
+    fprintf(stderr, "Cannot open %s for writing\n", snapshot_blob_path.c_str());
+    return 1;
+  }
+  bool written = data.ToFile(fp);
+  if (fclose(fp) != 0) written = false;
+  if (!written) {
+    fprintf(stderr, "Cannot write the snapshot to %s\n",
+            snapshot_blob_path.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+namespace mksnapshot {
+
+static void SetSerializeCallback(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(env->snapshot_serialize_callback().IsEmpty());
+  CHECK(args[0]->IsFunction());
+  env->set_snapshot_serialize_callback(args[0].As<Function>());
+}
+
+static void SetDeserializeMainFunction(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(env->snapshot_deserialize_main().IsEmpty());
+  CHECK(args[0]->IsFunction());
+  env->set_snapshot_deserialize_main(args[0].As<Function>());
+}
+
+static void Initialize(Local<Object> target,
+                       Local<Value> unused,
+                       Local<Context> context,
+                       void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  env->SetMethod(target, "setSerializeCallback", SetSerializeCallback);
+  env->SetMethod(
+      target, "setDeserializeMainFunction", SetDeserializeMainFunction);
+}
+
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(SetSerializeCallback);
+  registry->Register(SetDeserializeMainFunction);
+}
+
+}  // namespace mksnapshot
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(mksnapshot, node::mksnapshot::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(mksnapshot,
+                               node::mksnapshot::RegisterExternalReferences)
@@ -0,0 +1,169 @@
+#ifndef SRC_NODE_SNAPSHOTABLE_H_
+#define SRC_NODE_SNAPSHOTABLE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "base_object.h"
+#include "env.h"
+#include "util.h"
+
+namespace node {
+
+class Environment;
+struct EnvSerializeInfo;
+
+#define SERIALIZABLE_OBJECT_TYPES(V)                                           \
+  V(fs_binding_data, fs::BindingData)                                          \
+  V(v8_binding_data, v8_utils::BindingData)
+
+enum class EmbedderObjectType : uint8_t {
+  k_default = 0,
+#define V(PropertyName, NativeType) k_##PropertyName,
+  SERIALIZABLE_OBJECT_TYPES(V)
+#undef V
+};
+
+// When serializing an embedder object, we'll serialize the native states
+// into a chunk that can be mapped into a subclass of InternalFieldInfoBase,
+// and pass it into the V8 callback as the payload of StartupData.
+// The memory chunk looks like this:
+//
+// [   type   ] - EmbedderObjectType (a uint8_t)
+// [  length  ] - a size_t
+// [    ...   ] - custom bytes of size |length - header size|
+struct InternalFieldInfoBase {
+  EmbedderObjectType type;
+  size_t length;
+
+  InternalFieldInfoBase() = delete;
+
+  template <typename T>
+  static T* New(EmbedderObjectType type) {
+    static_assert(std::is_base_of<InternalFieldInfoBase, T>::value,
+                  "T must be a subclass of InternalFieldInfoBase");
+    return static_cast<T*>(New(type, sizeof(T)));
+  }
+
+  static InternalFieldInfoBase* New(EmbedderObjectType type, size_t length) {
+    // V8 takes ownership of the payload and releases it with delete[].
+    InternalFieldInfoBase* result =
+        reinterpret_cast<InternalFieldInfoBase*>(new char[length]);
+    result->type = type;
+    result->length = length;
+    return result;
+  }
+
+  InternalFieldInfoBase* Copy() const {
+    InternalFieldInfoBase* result =
+        reinterpret_cast<InternalFieldInfoBase*>(new char[length]);
+    memcpy(result, this, length);
+    return result;
+  }
+
+  void Delete() {
+    delete[] reinterpret_cast<char*>(this);
+  }
+};
+
+// An interface for snapshotable native objects to inherit from.
+// Use the SERIALIZABLE_OBJECT_METHODS() macro in the class to define
+// the following methods to implement:
+//
+// - PrepareForSerialization(): This would be run prior to context
+//   serialization. Use this method to e.g. release references that
+//   can not be moved across snapshots, or add the JS values that the object
+//   needs into the snapshot with the SnapshotCreator and remember the
+//   returned indexes.
+// - Serialize(): This would be called during context serialization,
+//   once for each embedder field of the object.
+//   Allocate and construct an InternalFieldInfoBase object that contains
+//   data that can be used to deserialize native states.
+// - Deserialize(): This would be called after the context is
+//   deserialized and the object graph is complete, once for each
+//   embedder field of the object. Use this to restore native states
+//   in the object.
+class SnapshotableObject : public BaseObject {
+ public:
+  SnapshotableObject(Environment* env,
+                     v8::Local<v8::Object> wrap,
+                     EmbedderObjectType type = EmbedderObjectType::k_default);
+  const char* GetTypeNameChars() const;
+
+  virtual void PrepareForSerialization(v8::Local<v8::Context> context,
+                                       v8::SnapshotCreator* creator) = 0;
+  virtual InternalFieldInfoBase* Serialize(int index) = 0;
+  bool is_snapshotable() const override { return true; }
+  // We'll make sure that the type is set in the constructor
+  EmbedderObjectType type() const { return type_; }
+
+ private:
+  EmbedderObjectType type_;
+};
+
+#define SERIALIZABLE_OBJECT_METHODS()                                          \
+  void PrepareForSerialization(v8::Local<v8::Context> context,                 \
+                               v8::SnapshotCreator* creator) override;         \
+  InternalFieldInfoBase* Serialize(int index) override;                        \
+  static void Deserialize(v8::Local<v8::Context> context,                      \
+                          v8::Local<v8::Object> holder,                        \
+                          int index,                                           \
+                          InternalFieldInfoBase* info);
+
+v8::StartupData SerializeNodeContextInternalFields(v8::Local<v8::Object> holder,
+                                                   int index,
+                                                   void* env);
+void DeserializeNodeInternalFields(v8::Local<v8::Object> holder,
+                                   int index,
+                                   v8::StartupData payload,
+                                   void* env);
+
+// Everything needed to start an isolate from a snapshot that is not
+// embedded into the binary, i.e. the one written by --build-snapshot and
+// read back with --snapshot-blob.
+struct SnapshotData {
+  std::vector<char> blob;
+  std::vector<size_t> isolate_data_indexes;
+  EnvSerializeInfo env_info;
+
+  // Keeps pointing into |blob|, so this can be passed to V8 as long as the
+  // SnapshotData is alive.
+  v8::StartupData v8_snapshot_blob_data { nullptr, 0 };
+
+  // Returns false if the file could not be written.
+  bool ToFile(FILE* out) const;
+  // Returns false and prints the reason to stderr if the file could not be
+  // parsed or was produced by a different Node.js binary.
+  static bool FromFile(SnapshotData* out, FILE* in);
+};
+
+class SnapshotBuilder {
+ public:
+  // Creates the snapshot of the built-in bootstrap. If |entry_file| is not
+  // empty, it is run after the bootstrap and the resulting heap is captured
+  // instead. Returns 0 on success, or the exit code to use otherwise.
+  static int Generate(SnapshotData* out,
+                      const std::vector<std::string> args,
+                      const std::vector<std::string> exec_args,
+                      const std::string& entry_file = std::string());
+
+  // Generates the snapshot of the built-in bootstrap as C++ source that
+  // is compiled into the binary, see tools/snapshot/node_mksnapshot.cc.
+  static std::string GenerateAsSource(const std::vector<std::string> args,
+                                      const std::vector<std::string> exec_args);
+};
+
+// Implements `node --build-snapshot entry.js`.
+int BuildSnapshot(const std::vector<std::string>& args,
+                  const std::vector<std::string>& exec_args);
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_SNAPSHOTABLE_H_
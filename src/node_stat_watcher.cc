@@ -24,6 +24,7 @@
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "node_file-inl.h"
+#include "node_external_reference.h"
 #include "util-inl.h"
 
 #include <cstring>
@@ -60,6 +61,11 @@ void StatWatcher::Initialize(Environment* env, Local<Object> target) {
               t->GetFunction(env->context()).ToLocalChecked()).Check();
 }
 
+void StatWatcher::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(StatWatcher::New);
+  registry->Register(StatWatcher::Start);
+}
 
 StatWatcher::StatWatcher(fs::BindingData* binding_data,
                          Local<Object> wrap,
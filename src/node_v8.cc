@@ -19,18 +19,22 @@
 // OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
-#include "node.h"
+#include "node_v8.h"
 #include "base_object-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
+#include "node.h"
+#include "node_external_reference.h"
 #include "util-inl.h"
 #include "v8.h"
 
 namespace node {
+namespace v8_utils {
 
 using v8::Array;
 using v8::Context;
 using v8::FunctionCallbackInfo;
+using v8::HandleScope;
 using v8::HeapCodeStatistics;
 using v8::HeapSpaceStatistics;
 using v8::HeapStatistics;
@@ -39,6 +43,7 @@ using v8::Isolate;
 using v8::Local;
 using v8::Object;
 using v8::ScriptCompiler;
+using v8::SnapshotCreator;
 using v8::String;
 using v8::Uint32;
 using v8::V8;
@@ -85,35 +90,72 @@ static const size_t kHeapCodeStatisticsPropertiesCount =
     HEAP_CODE_STATISTICS_PROPERTIES(V);
 #undef V
 
-class BindingData : public BaseObject {
- public:
-  BindingData(Environment* env, Local<Object> obj)
-      : BaseObject(env, obj),
-        heap_statistics_buffer(env->isolate(), kHeapStatisticsPropertiesCount),
-        heap_space_statistics_buffer(env->isolate(),
-                                     kHeapSpaceStatisticsPropertiesCount),
-        heap_code_statistics_buffer(env->isolate(),
-                                    kHeapCodeStatisticsPropertiesCount) {}
-
-  static constexpr FastStringKey binding_data_name { "v8" };
-
-  AliasedFloat64Array heap_statistics_buffer;
-  AliasedFloat64Array heap_space_statistics_buffer;
-  AliasedFloat64Array heap_code_statistics_buffer;
-
-  void MemoryInfo(MemoryTracker* tracker) const override {
-    tracker->TrackField("heap_statistics_buffer", heap_statistics_buffer);
-    tracker->TrackField("heap_space_statistics_buffer",
-                        heap_space_statistics_buffer);
-    tracker->TrackField("heap_code_statistics_buffer",
-                        heap_code_statistics_buffer);
+BindingData::BindingData(Environment* env,
+                         Local<Object> obj,
+                         const InternalFieldInfo* info)
+    : SnapshotableObject(env, obj, EmbedderObjectType::k_v8_binding_data),
+      heap_statistics_buffer(
+          env->isolate(),
+          kHeapStatisticsPropertiesCount,
+          info == nullptr ? nullptr : &info->heap_statistics_buffer),
+      heap_space_statistics_buffer(
+          env->isolate(),
+          kHeapSpaceStatisticsPropertiesCount,
+          info == nullptr ? nullptr : &info->heap_space_statistics_buffer),
+      heap_code_statistics_buffer(
+          env->isolate(),
+          kHeapCodeStatisticsPropertiesCount,
+          info == nullptr ? nullptr : &info->heap_code_statistics_buffer) {
+  if (info != nullptr) {
+    heap_statistics_buffer.Deserialize(env->context());
+    heap_space_statistics_buffer.Deserialize(env->context());
+    heap_code_statistics_buffer.Deserialize(env->context());
   }
-  SET_SELF_SIZE(BindingData)
-  SET_MEMORY_INFO_NAME(BindingData)
-};
+}
+
+void BindingData::PrepareForSerialization(Local<Context> context,
+                                          SnapshotCreator* creator) {
+  heap_statistics_buffer_index_ =
+      heap_statistics_buffer.Serialize(context, creator);
+  heap_space_statistics_buffer_index_ =
+      heap_space_statistics_buffer.Serialize(context, creator);
+  heap_code_statistics_buffer_index_ =
+      heap_code_statistics_buffer.Serialize(context, creator);
+}
+
+InternalFieldInfoBase* BindingData::Serialize(int index) {
+  DCHECK_EQ(index, BaseObject::kSlot);
+  InternalFieldInfo* info =
+      InternalFieldInfoBase::New<InternalFieldInfo>(type());
+  info->heap_statistics_buffer = heap_statistics_buffer_index_;
+  info->heap_space_statistics_buffer = heap_space_statistics_buffer_index_;
+  info->heap_code_statistics_buffer = heap_code_statistics_buffer_index_;
+  return info;
+}
+
+void BindingData::Deserialize(Local<Context> context,
+                              Local<Object> holder,
+                              int index,
+                              InternalFieldInfoBase* info) {
+  DCHECK_EQ(index, BaseObject::kSlot);
+  HandleScope scope(context->GetIsolate());
+  Environment* env = Environment::GetCurrent(context);
+  BindingData* binding = env->AddBindingData<BindingData>(
+      context, holder, static_cast<InternalFieldInfo*>(info));
+  CHECK_NOT_NULL(binding);
+}
+
+void BindingData::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("heap_statistics_buffer", heap_statistics_buffer);
+  tracker->TrackField("heap_space_statistics_buffer",
+                      heap_space_statistics_buffer);
+  tracker->TrackField("heap_code_statistics_buffer",
+                      heap_code_statistics_buffer);
+}
 
 // TODO(addaleax): Remove once we're on C++17.
 constexpr FastStringKey BindingData::binding_data_name;
+constexpr FastStringKey BindingData::type_name;
 
 void CachedDataVersionTag(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -256,6 +298,16 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "setFlagsFromString", SetFlagsFromString);
 }
 
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(CachedDataVersionTag);
+  registry->Register(UpdateHeapStatisticsBuffer);
+  registry->Register(UpdateHeapCodeStatisticsBuffer);
+  registry->Register(UpdateHeapSpaceStatisticsBuffer);
+  registry->Register(SetFlagsFromString);
+}
+
+}  // namespace v8_utils
 }  // namespace node
 
-NODE_MODULE_CONTEXT_AWARE_INTERNAL(v8, node::Initialize)
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(v8, node::v8_utils::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(v8, node::v8_utils::RegisterExternalReferences)
@@ -0,0 +1,53 @@
+#ifndef SRC_NODE_V8_H_
+#define SRC_NODE_V8_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "aliased_buffer.h"
+#include "base_object.h"
+#include "node_snapshotable.h"
+#include "util.h"
+#include "v8.h"
+
+namespace node {
+class Environment;
+
+namespace v8_utils {
+class BindingData : public SnapshotableObject {
+ public:
+  // The snapshot indexes of the JS arrays of a deserialized BindingData.
+  struct InternalFieldInfo : public InternalFieldInfoBase {
+    AliasedBufferInfo heap_statistics_buffer;
+    AliasedBufferInfo heap_space_statistics_buffer;
+    AliasedBufferInfo heap_code_statistics_buffer;
+  };
+
+  BindingData(Environment* env,
+              v8::Local<v8::Object> obj,
+              const InternalFieldInfo* info = nullptr);
+
+  SERIALIZABLE_OBJECT_METHODS()
+  static constexpr FastStringKey binding_data_name{"v8"};
+  static constexpr FastStringKey type_name{"node::v8_utils::BindingData"};
+
+  AliasedFloat64Array heap_statistics_buffer;
+  AliasedFloat64Array heap_space_statistics_buffer;
+  AliasedFloat64Array heap_code_statistics_buffer;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_SELF_SIZE(BindingData)
+  SET_MEMORY_INFO_NAME(BindingData)
+
+ private:
+  AliasedBufferInfo heap_statistics_buffer_index_ = 0;
+  AliasedBufferInfo heap_space_statistics_buffer_index_ = 0;
+  AliasedBufferInfo heap_code_statistics_buffer_index_ = 0;
+};
+
+}  // namespace v8_utils
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_V8_H_
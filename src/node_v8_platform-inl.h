@@ -135,7 +135,10 @@ struct V8Platform {
                                 std::make_move_iterator(categories.end())),
           std::unique_ptr<tracing::AsyncTraceWriter>(
               new tracing::NodeTraceWriter(
-                  per_process::cli_options->trace_event_file_pattern)),
+                  per_process::cli_options->trace_event_file_pattern,
+                  per_process::cli_options->trace_event_format == "binary" ?
+                      tracing::NodeTraceWriter::Format::kBinary :
+                      tracing::NodeTraceWriter::Format::kJSON)),
           tracing::Agent::kUseDefaultCategories);
     }
   }
@@ -27,6 +27,14 @@ QuicBufferChunk::QuicBufferChunk(uv_buf_t buf, DoneCB done)
     done_ = std::move(done);
 }
 
+QuicBufferChunk::QuicBufferChunk(
+    uv_buf_t buf,
+    std::shared_ptr<v8::BackingStore> store,
+    DoneCB done)
+    : QuicBufferChunk(buf, std::move(done)) {
+  store_ = std::move(store);
+}
+
 QuicBufferChunk::~QuicBufferChunk() {
   CHECK(done_called_);
 }
@@ -86,9 +94,12 @@ size_t QuicBuffer::Cancel(int status) {
   return t;
 }
 
-void QuicBuffer::Push(uv_buf_t buf, DoneCB done) {
+void QuicBuffer::Push(
+    uv_buf_t buf,
+    std::shared_ptr<v8::BackingStore> store,
+    DoneCB done) {
   std::unique_ptr<QuicBufferChunk> chunk =
-      std::make_unique<QuicBufferChunk>(buf, done);
+      std::make_unique<QuicBufferChunk>(buf, std::move(store), std::move(done));
   Push(std::move(chunk));
 }
 }  // namespace quic
@@ -8,14 +8,149 @@
 #include <utility>
 
 namespace node {
+
+using v8::BackingStore;
+
 namespace quic {
 
+namespace {
+
+// A pool of memory for QuicBufferChunk instances. The chunks are carved out
+// of slabs of kChunksPerSlab, each of which keeps a free list of its own.
+// Slabs that have free chunks are kept in a doubly linked list from which
+// new chunks are allocated; once all chunks of a slab are free again, the
+// slab is released unless fewer than kMaxEmptySlabs empty slabs are left.
+class QuicBufferChunkPool final {
+ public:
+  QuicBufferChunkPool() = default;
+  QuicBufferChunkPool(const QuicBufferChunkPool&) = delete;
+  QuicBufferChunkPool& operator=(const QuicBufferChunkPool&) = delete;
+
+  ~QuicBufferChunkPool() {
+    // Only empty slabs are released. Slabs that have all of their chunks in
+    // use are not on the list, and slabs that are partly used are on it but
+    // are left alone because chunks still alive point into them.
+    while (available_ != nullptr) {
+      Slab* slab = available_;
+      available_ = slab->next;
+      if (slab->used == 0)
+        delete slab;
+    }
+  }
+
+  void* Allocate() {
+    if (available_ == nullptr) {
+      Link(new Slab());
+      empty_slabs_++;
+    }
+    Slab* slab = available_;
+    Block* block = slab->free;
+    slab->free = block->next_free;
+    if (slab->used++ == 0)
+      empty_slabs_--;
+    if (slab->free == nullptr)
+      Unlink(slab);
+    return block->storage;
+  }
+
+  void Free(void* ptr) {
+    Block* block = reinterpret_cast<Block*>(
+        static_cast<char*>(ptr) - offsetof(Block, storage));
+    Slab* slab = block->slab;
+    if (slab->free == nullptr)
+      Link(slab);
+    block->next_free = slab->free;
+    slab->free = block;
+    if (--slab->used > 0)
+      return;
+    if (empty_slabs_ < kMaxEmptySlabs) {
+      empty_slabs_++;
+    } else {
+      Unlink(slab);
+      delete slab;
+    }
+  }
+
+ private:
+  static constexpr size_t kChunksPerSlab = 64;
+  static constexpr size_t kMaxEmptySlabs = 4;
+
+  struct Slab;
+
+  struct Block {
+    Slab* slab;
+    Block* next_free;
+    alignas(alignof(QuicBufferChunk)) char storage[sizeof(QuicBufferChunk)];
+  };
+
+  struct Slab {
+    Slab() {
+      for (size_t n = 0; n < kChunksPerSlab; n++) {
+        blocks[n].slab = this;
+        blocks[n].next_free = n + 1 < kChunksPerSlab ? &blocks[n + 1] : nullptr;
+      }
+      free = &blocks[0];
+    }
+
+    Block blocks[kChunksPerSlab];
+    Block* free = nullptr;
+    size_t used = 0;
+    Slab* prev = nullptr;
+    Slab* next = nullptr;
+  };
+
+  void Link(Slab* slab) {
+    slab->prev = nullptr;
+    slab->next = available_;
+    if (available_ != nullptr)
+      available_->prev = slab;
+    available_ = slab;
+  }
+
+  void Unlink(Slab* slab) {
+    if (slab->prev != nullptr)
+      slab->prev->next = slab->next;
+    else
+      available_ = slab->next;
+    if (slab->next != nullptr)
+      slab->next->prev = slab->prev;
+    slab->prev = slab->next = nullptr;
+  }
+
+  Slab* available_ = nullptr;
+  size_t empty_slabs_ = 0;
+};
+
+// QuicBuffers are only ever used on the thread of the Environment they
+// belong to, so each thread gets a pool of its own.
+thread_local QuicBufferChunkPool chunk_pool;
+
+}  // namespace
+
+void* QuicBufferChunk::operator new(size_t size) {
+  CHECK_EQ(size, sizeof(QuicBufferChunk));
+  return chunk_pool.Allocate();
+}
+
+void QuicBufferChunk::operator delete(void* ptr) {
+  if (ptr != nullptr)
+    chunk_pool.Free(ptr);
+}
+
 void QuicBufferChunk::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("buf", data_buf_);
   tracker->TrackField("next", next_);
 }
 
 size_t QuicBuffer::Push(uv_buf_t* bufs, size_t nbufs, DoneCB done) {
+  return Push(bufs, nullptr, nbufs, std::move(done));
+}
+
+size_t QuicBuffer::Push(
+    uv_buf_t* bufs,
+    std::shared_ptr<BackingStore>* stores,
+    size_t nbufs,
+    DoneCB done) {
   size_t len = 0;
   if (UNLIKELY(nbufs == 0)) {
     done(0);
@@ -25,14 +160,14 @@ size_t QuicBuffer::Push(uv_buf_t* bufs, size_t nbufs, DoneCB done) {
   size_t n = 0;
   while (nbufs > 1) {
     if (!is_empty(bufs[n])) {
-      Push(bufs[n]);
+      Push(bufs[n], stores != nullptr ? std::move(stores[n]) : nullptr);
       len += bufs[n].len;
     }
     n++;
     nbufs--;
   }
   if (!is_empty(bufs[n])) {
-    Push(bufs[n], done);
+    Push(bufs[n], stores != nullptr ? std::move(stores[n]) : nullptr, done);
     len += bufs[n].len;
   }
   // Special case if all the bufs were empty.
@@ -10,7 +10,9 @@
 #include "node_internals.h"
 #include "util.h"
 #include "uv.h"
+#include "v8.h"
 
+#include <memory>
 #include <vector>
 
 namespace node {
@@ -73,6 +75,13 @@ using DoneCB = std::function<void(int)>;
 // with a single write callback. For each uv_buf_t DoWrite gets, a
 // corresponding QuicBufferChunk is added to the QuicBuffer, with the
 // callback associated with the final chunk added to the list.
+//
+// QuicBufferChunks are created and freed at a high rate when many streams
+// are active, so they are allocated from a per-thread pool of slabs rather
+// than individually. When the data of a chunk lives in a JavaScript
+// ArrayBuffer, the chunk holds a reference to its v8::BackingStore, so that
+// the memory stays valid until the data is acknowledged even if the
+// ArrayBuffer is detached or garbage collected in the meantime.
 
 
 // A QuicBufferChunk contains the actual buffered data
@@ -105,8 +114,19 @@ class QuicBufferChunk final : public MemoryRetainer {
   // longer being used.
   inline QuicBufferChunk(uv_buf_t buf_, DoneCB done_);
 
+  // In this variant, the QuicBufferChunk keeps the BackingStore
+  // the buffer points into alive until the QuicBufferChunk is
+  // destroyed.
+  inline QuicBufferChunk(
+      uv_buf_t buf_,
+      std::shared_ptr<v8::BackingStore> store,
+      DoneCB done_);
+
   inline ~QuicBufferChunk() override;
 
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   // Invokes the done callback associated with the QuicBufferChunk.
   inline void Done(int status);
 
@@ -140,6 +160,7 @@ class QuicBufferChunk final : public MemoryRetainer {
 
  private:
   std::vector<uint8_t> data_buf_;
+  std::shared_ptr<v8::BackingStore> store_;
   uv_buf_t buf_;
   DoneCB done_ = default_done;
   size_t length_ = 0;
@@ -179,6 +200,15 @@ class QuicBuffer final : public bob::SourceImpl<ngtcp2_vec>,
       size_t nbufs,
       DoneCB done = QuicBufferChunk::default_done);
 
+  // Like Push() above, but each uv_buf_t points into the
+  // corresponding entry of stores, which are retained until
+  // the data is consumed.
+  size_t Push(
+      uv_buf_t* bufs,
+      std::shared_ptr<v8::BackingStore>* stores,
+      size_t nbufs,
+      DoneCB done = QuicBufferChunk::default_done);
+
   // Pushes a single QuicBufferChunk into the linked list
   void Push(std::unique_ptr<QuicBufferChunk> chunk);
 
@@ -217,7 +247,10 @@ class QuicBuffer final : public bob::SourceImpl<ngtcp2_vec>,
   inline static bool is_empty(uv_buf_t buf);
   size_t Consume(int status, size_t amount);
   bool Pop(int status = 0);
-  inline void Push(uv_buf_t buf, DoneCB done = nullptr);
+  inline void Push(
+      uv_buf_t buf,
+      std::shared_ptr<v8::BackingStore> store,
+      DoneCB done = nullptr);
 
   std::unique_ptr<QuicBufferChunk> root_;
   QuicBufferChunk* head_ = nullptr;  // Current Read Position
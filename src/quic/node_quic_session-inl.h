@@ -391,12 +391,32 @@ void QuicSession::SelectPreferredAddress(
 
 // This variant of SendPacket is used by QuicApplication
 // instances to transmit a packet and update the network
-// path used at the same time.
+// path used at the same time. The packets are batched and
+// only sent once SendPendingPackets() is called, which
+// happens when the path changes or the batch is full.
 bool QuicSession::SendPacket(
   std::unique_ptr<QuicPacket> packet,
   const ngtcp2_path_storage& path) {
+  if (!pending_packets_.empty() &&
+      (SocketAddress(path.path.local.addr) != pending_local_address_ ||
+       SocketAddress(path.path.remote.addr) != pending_remote_address_) &&
+      !SendPendingPackets()) {
+    return false;
+  }
   UpdateEndpoint(path.path);
-  return SendPacket(std::move(packet));
+
+  CHECK(!is_in_draining_period());
+  if (packet->length() == 0)
+    return true;
+
+  if (pending_packets_.empty()) {
+    pending_local_address_ = path.path.local.addr;
+    pending_remote_address_ = path.path.remote.addr;
+  }
+  RecordPacketSent(packet->length());
+  pending_packets_.emplace_back(std::move(packet));
+  return pending_packets_.size() < kMaxPacketBatchSize ||
+         SendPendingPackets();
 }
 
 // Set the transport parameters received from the remote peer
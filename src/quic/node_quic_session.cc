@@ -1373,6 +1373,12 @@ bool QuicApplication::SendPendingData() {
   int err;
 
   for (;;) {
+    // If the packet was sent previously, then packet will have been reset.
+    if (!packet) {
+      packet = CreateStreamDataPacket();
+      pos = packet->data();
+    }
+
     ssize_t ndatalen;
     StreamData stream_data;
     err = GetStreamData(&stream_data);
@@ -1381,6 +1387,16 @@ bool QuicApplication::SendPendingData() {
       return false;
     }
 
+    // A new packet with stream data is only started when the pacer permits
+    // it, otherwise the pacing timer will call SendPendingData() again. The
+    // stream stays scheduled since its data has not been committed. Packets
+    // without stream data, such as acknowledgements, are not delayed.
+    if (pos == packet->data() &&
+        stream_data.count > 0 &&
+        session()->IsPacingLimited()) {
+      break;
+    }
+
     // If stream_data.id is -1, then we're not serializing any data for any
     // specific stream. We still need to process QUIC session packets tho.
     if (stream_data.id > -1)
@@ -1389,12 +1405,6 @@ bool QuicApplication::SendPendingData() {
     else
       Debug(session(), "Serializing session packets");
 
-    // If the packet was sent previously, then packet will have been reset.
-    if (!packet) {
-      packet = CreateStreamDataPacket();
-      pos = packet->data();
-    }
-
     ssize_t nwrite = WriteVStream(&path, pos, &ndatalen, stream_data);
 
     if (nwrite <= 0) {
@@ -1626,6 +1636,7 @@ QuicSession::QuicSession(
     hostname_(hostname),
     idle_(socket->env(), [this]() { OnIdleTimeout(); }),
     retransmit_(socket->env(), [this]() { OnRetransmitTimeout(); }),
+    pacer_(socket->env(), [this]() { OnPacingTimeout(); }),
     dcid_(dcid),
     state_(env()->isolate()),
     quic_state_(socket->quic_state()) {
@@ -1648,6 +1659,7 @@ QuicSession::QuicSession(
 
   idle_.Unref();
   retransmit_.Unref();
+  pacer_.Unref();
 
   // TODO(@jasnell): memory accounting
   // env_->isolate()->AdjustAmountOfExternalAllocatedMemory(kExternalSize);
@@ -1664,12 +1676,13 @@ QuicSession::~QuicSession() {
   if (listener_ == listener())
     RemoveListener(listener_);
 
-  // Stop and free the idle and retransmission timers if they are active.
-  // In a clean shutdown, using Close(), these will have already been
-  // stopped, but if Close() was not called and we're being destroyed
+  // Stop and free the idle, retransmission and pacing timers if they are
+  // active. In a clean shutdown, using Close(), these will have already
+  // been stopped, but if Close() was not called and we're being destroyed
   // in GC, for instance, we need to make sure they get stopped here.
   idle_.Stop();
   retransmit_.Stop();
+  pacer_.Stop();
 
   DebugStats();
 }
@@ -1900,9 +1913,12 @@ void QuicSession::Destroy() {
   // All existing streams should have already been destroyed
   CHECK(streams_.empty());
 
-  // Stop and free the idle and retransmission timers if they are active.
+  // Stop and free the idle, retransmission and pacing timers if they are
+  // active.
   idle_.Stop();
   retransmit_.Stop();
+  pacer_.Stop();
+  pending_packets_.clear();
 
   // The QuicSession instances are kept alive using
   // BaseObjectPtr. The only persistent BaseObjectPtr
@@ -2440,8 +2456,7 @@ bool QuicSession::SendPacket(std::unique_ptr<QuicPacket> packet) {
   if (packet->length() == 0)
     return true;
 
-  IncrementStat(&QuicSessionStats::bytes_sent, packet->length());
-  RecordTimestamp(&QuicSessionStats::sent_at);
+  RecordPacketSent(packet->length());
 //  ScheduleRetransmit();
 
   Debug(this, "Sending %" PRIu64 " bytes to %s from %s",
@@ -2463,13 +2478,104 @@ bool QuicSession::SendPacket(std::unique_ptr<QuicPacket> packet) {
   return true;
 }
 
+bool QuicSession::SendPendingPackets() {
+  if (pending_packets_.empty())
+    return true;
+
+  // The QuicSession may have been closed while the packets were
+  // being serialized.
+  if (is_destroyed() || is_in_draining_period()) {
+    pending_packets_.clear();
+    return true;
+  }
+
+  Debug(this, "Sending %" PRIu64 " packets to %s from %s",
+        pending_packets_.size(),
+        remote_address_,
+        local_address_);
+
+  int err = socket()->SendPackets(
+      local_address_,
+      remote_address_,
+      &pending_packets_,
+      BaseObjectPtr<QuicSession>(this));
+  pending_packets_.clear();
+
+  if (err != 0) {
+    set_last_error(QUIC_ERROR_SESSION, err);
+    return false;
+  }
+
+  return true;
+}
+
+void QuicSession::RecordPacketSent(size_t length) {
+  IncrementStat(&QuicSessionStats::bytes_sent, length);
+  RecordTimestamp(&QuicSessionStats::sent_at);
+  pacing_tokens_ -= length;
+}
+
+// Packets are paced out at a rate of cwnd / smoothed RTT times a gain
+// factor that leaves room for the congestion window to grow: twice
+// the window per round trip during slow start and 5/4 of it during
+// congestion avoidance. Because libuv timers only have millisecond
+// resolution, the pacer allows a burst of up to kPacingGranularity
+// worth of packets (but at least kPacingMinBurst) after a wait.
+bool QuicSession::IsPacingLimited() {
+  if (socket()->has_option_disable_pacing())
+    return false;
+
+  ngtcp2_conn_stat stat;
+  ngtcp2_conn_get_conn_stat(connection(), &stat);
+  uint64_t rtt = stat.smoothed_rtt > 0 ? stat.smoothed_rtt : stat.initial_rtt;
+  if (rtt == 0 || stat.cwnd == 0)
+    return false;
+
+  // The rate is in bytes per nanosecond.
+  double rate = static_cast<double>(stat.cwnd) / rtt;
+  rate *= stat.cwnd < stat.ssthresh ? 2.0 : 1.25;
+  double burst = std::max(
+      static_cast<double>(kPacingMinBurst * max_pktlen_),
+      rate * kPacingGranularity);
+
+  uint64_t now = uv_hrtime();
+  if (pacing_refilled_at_ == 0) {
+    pacing_tokens_ = burst;
+  } else {
+    pacing_tokens_ = std::min(
+        burst,
+        pacing_tokens_ + (now - pacing_refilled_at_) * rate);
+  }
+  pacing_refilled_at_ = now;
+
+  if (pacing_tokens_ >= max_pktlen_)
+    return false;
+
+  // delay is in nanoseconds, timeout in milliseconds.
+  uint64_t delay = (max_pktlen_ - pacing_tokens_) / rate;
+  uint64_t timeout = (delay + NGTCP2_MILLISECONDS - 1) / NGTCP2_MILLISECONDS;
+  if (timeout == 0) timeout = 1;
+  Debug(this, "Pacing limited, scheduling the pacing timer for %" PRIu64,
+        timeout);
+  IncrementStat(&QuicSessionStats::pacing_delay_count);
+  pacer_.Update(timeout);
+  return true;
+}
+
+void QuicSession::OnPacingTimeout() {
+  if (is_destroyed())
+    return;
+  SendPendingData();
+}
+
 // Sends any pending handshake or session packet data.
 void QuicSession::SendPendingData() {
   if (is_unable_to_send_packets())
     return;
 
   Debug(this, "Sending pending data");
-  if (!application_->SendPendingData()) {
+  bool sent = application_->SendPendingData();
+  if (!SendPendingPackets() || !sent) {
     Debug(this, "Error sending QUIC application data");
     HandleError();
   }
@@ -2673,6 +2779,7 @@ void QuicSession::UpdateClosingTimer() {
       is_server() ? (ngtcp2_conn_get_pto(connection()) / 1000000ULL) * 3 : 0;
   Debug(this, "Setting closing timeout to %" PRIu64, timeout);
   retransmit_.Stop();
+  pacer_.Stop();
   idle_.Update(timeout, 0);
   idle_.Ref();
 }
@@ -2749,6 +2856,8 @@ void QuicSession::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("hostname", hostname_);
   tracker->TrackField("idle", idle_);
   tracker->TrackField("retransmit", retransmit_);
+  tracker->TrackField("pacer", pacer_);
+  tracker->TrackField("pending_packets", pending_packets_);
   tracker->TrackField("streams", streams_);
   tracker->TrackFieldWithSize("current_ngtcp2_memory", current_ngtcp2_memory_);
   tracker->TrackField("conn_closebuf", conn_closebuf_);
@@ -203,6 +203,7 @@ enum QuicSessionStateFields {
     "Path Validation Failure Count")                                           \
   V(MAX_BYTES_IN_FLIGHT, max_bytes_in_flight, "Max Bytes In Flight")           \
   V(BLOCK_COUNT, block_count, "Block Count")                                   \
+  V(PACING_DELAY_COUNT, pacing_delay_count, "Pacing Delay Count")             \
   V(MIN_RTT, min_rtt, "Minimum RTT")                                           \
   V(LATEST_RTT, latest_rtt, "Latest RTT")                                      \
   V(SMOOTHED_RTT, smoothed_rtt, "Smoothed RTT")                                \
@@ -1003,10 +1004,18 @@ class QuicSession final : public AsyncWrap,
 
   inline void ShutdownStream(int64_t stream_id, uint64_t code);
 
+  // Packets passed to this variant of SendPacket are collected and
+  // passed on to the QuicSocket together once SendPendingData() is done,
+  // or once kMaxPacketBatchSize of them are pending.
   inline bool SendPacket(
       std::unique_ptr<QuicPacket> packet,
       const ngtcp2_path_storage& path);
 
+  // Returns true if the pacer does not permit another packet to be sent
+  // yet, in which case the pacing timer is scheduled to call
+  // SendPendingData() again once it does.
+  bool IsPacingLimited();
+
   inline uint64_t max_data_left() const;
 
   inline uint64_t max_local_streams_uni() const;
@@ -1267,6 +1276,14 @@ class QuicSession final : public AsyncWrap,
 
   bool SendPacket(std::unique_ptr<QuicPacket> packet);
 
+  // Passes the packets collected by SendPacket(packet, path)
+  // to the QuicSocket.
+  bool SendPendingPackets();
+
+  void RecordPacketSent(size_t length);
+
+  void OnPacingTimeout();
+
   void StreamClose(int64_t stream_id, uint64_t app_error_code);
 
   void StreamReset(
@@ -1479,6 +1496,20 @@ class QuicSession final : public AsyncWrap,
 
   TimerWrapHandle idle_;
   TimerWrapHandle retransmit_;
+  TimerWrapHandle pacer_;
+
+  // The pacer spreads the packets of a congestion window out over a round
+  // trip rather than sending them in a single burst, which the bottleneck
+  // queue would otherwise have to absorb. It is a token bucket that is
+  // refilled at a rate derived from the congestion window and smoothed
+  // RTT reported by ngtcp2's congestion controller; pacing_tokens_ is the
+  // number of bytes that may be sent right away.
+  double pacing_tokens_ = 0;
+  uint64_t pacing_refilled_at_ = 0;
+
+  std::vector<std::unique_ptr<QuicPacket>> pending_packets_;
+  SocketAddress pending_local_address_{};
+  SocketAddress pending_remote_address_{};
 
   QuicCID scid_;
   QuicCID dcid_;
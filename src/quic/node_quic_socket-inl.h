@@ -42,6 +42,13 @@ int QuicEndpoint::Send(
   return ret;
 }
 
+size_t QuicEndpoint::TrySendDatagrams(
+    uv_buf_t* bufs,
+    size_t count,
+    const sockaddr* addr) {
+  return udp_->TrySendDatagrams(bufs, count, addr);
+}
+
 int QuicEndpoint::ReceiveStart() {
   return udp_->RecvStart();
 }
@@ -902,12 +902,24 @@ int QuicSocket::SendPacket(
     return 0;
   }
 
+  auto endpoint = bound_endpoints_.find(local_addr);
+  CHECK_NE(endpoint, bound_endpoints_.end());
+  return DispatchPacket(
+      endpoint->second.get(),
+      remote_addr,
+      std::move(packet),
+      session);
+}
+
+int QuicSocket::DispatchPacket(
+    QuicEndpoint* endpoint,
+    const SocketAddress& remote_addr,
+    std::unique_ptr<QuicPacket> packet,
+    BaseObjectPtr<QuicSession> session) {
   last_created_send_wrap_ = nullptr;
   uv_buf_t buf = packet->buf();
 
-  auto endpoint = bound_endpoints_.find(local_addr);
-  CHECK_NE(endpoint, bound_endpoints_.end());
-  int err = endpoint->second->Send(&buf, 1, remote_addr.data());
+  int err = endpoint->Send(&buf, 1, remote_addr.data());
 
   if (err != 0) {
     if (err > 0) err = 0;
@@ -921,6 +933,58 @@ int QuicSocket::SendPacket(
   return err;
 }
 
+int QuicSocket::SendPackets(
+    const SocketAddress& local_addr,
+    const SocketAddress& remote_addr,
+    std::vector<std::unique_ptr<QuicPacket>>* packets,
+    BaseObjectPtr<QuicSession> session) {
+  std::vector<uv_buf_t> bufs;
+  bufs.reserve(packets->size());
+  for (auto it = packets->begin(); it != packets->end();) {
+    if ((*it)->length() == 0) {
+      it = packets->erase(it);
+    } else if (UNLIKELY(is_diagnostic_packet_loss(tx_loss_))) {
+      Debug(this, "Simulating transmitted packet loss");
+      it = packets->erase(it);
+    } else {
+      bufs.push_back((*it)->buf());
+      ++it;
+    }
+  }
+
+  if (bufs.empty())
+    return 0;
+
+  Debug(this, "Sending %" PRIu64 " packets to %s from %s",
+        bufs.size(),
+        remote_addr,
+        local_addr);
+
+  auto endpoint = bound_endpoints_.find(local_addr);
+  CHECK_NE(endpoint, bound_endpoints_.end());
+  size_t sent = endpoint->second->TrySendDatagrams(
+      bufs.data(),
+      bufs.size(),
+      remote_addr.data());
+  CHECK_LE(sent, packets->size());
+
+  for (size_t n = 0; n < sent; n++)
+    OnSend(0, (*packets)[n].get());
+  if (sent > 1)
+    IncrementStat(&QuicSocketStats::packets_sent_batched, sent);
+
+  for (size_t n = sent; n < packets->size(); n++) {
+    int err = DispatchPacket(
+        endpoint->second.get(),
+        remote_addr,
+        std::move((*packets)[n]),
+        session);
+    if (err != 0)
+      return err;
+  }
+  return 0;
+}
+
 void QuicSocket::OnSend(int status, QuicPacket* packet) {
   if (status == 0) {
     Debug(this, "Sent %" PRIu64 " bytes (label: %s)",
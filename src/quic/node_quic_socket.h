@@ -39,7 +39,8 @@ constexpr size_t DEFAULT_MAX_SOCKETADDRESS_LRU_SIZE = 1000;
 constexpr size_t DEFAULT_MAX_RETRY_LIMIT = 10;
 
 #define QUICSOCKET_OPTIONS(V)                                                  \
-    V(VALIDATE_ADDRESS, validate_address)
+    V(VALIDATE_ADDRESS, validate_address)                                     \
+    V(DISABLE_PACING, disable_pacing)
 
 #define V(id, _) QUICSOCKET_OPTIONS_##id,
 enum QuicSocketOptions : uint32_t {
@@ -80,7 +81,8 @@ enum QuicSocketStateFields {
   V(SERVER_SESSIONS, server_sessions, "Server Sessions")                       \
   V(CLIENT_SESSIONS, client_sessions, "Client Sessions")                       \
   V(STATELESS_RESET_COUNT, stateless_reset_count, "Stateless Reset Count")     \
-  V(SERVER_BUSY_COUNT, server_busy_count, "Server Busy Count")
+  V(SERVER_BUSY_COUNT, server_busy_count, "Server Busy Count")                 \
+  V(PACKETS_SENT_BATCHED, packets_sent_batched, "Packets Sent Batched")
 
 #define V(name, _, __) IDX_QUIC_SOCKET_STATS_##name,
 enum QuicSocketStatsIdx : int {
@@ -270,6 +272,11 @@ class QuicEndpoint final : public BaseObject,
       size_t len,
       const sockaddr* addr);
 
+  inline size_t TrySendDatagrams(
+      uv_buf_t* bufs,
+      size_t count,
+      const sockaddr* addr);
+
   void IncrementPendingCallbacks() { pending_callbacks_++; }
   void DecrementPendingCallbacks() { pending_callbacks_--; }
   bool has_pending_callbacks() const { return pending_callbacks_ > 0; }
@@ -371,6 +378,16 @@ class QuicSocket : public AsyncWrap,
       std::unique_ptr<QuicPacket> packet,
       BaseObjectPtr<QuicSession> session = BaseObjectPtr<QuicSession>());
 
+  // Sends a batch of packets to the same remote address. Where the
+  // platform supports it, the packets are passed to the kernel using a
+  // single system call; those that cannot be sent synchronously are sent
+  // one at a time using SendPacket().
+  int SendPackets(
+      const SocketAddress& local_addr,
+      const SocketAddress& remote_addr,
+      std::vector<std::unique_ptr<QuicPacket>>* packets,
+      BaseObjectPtr<QuicSession> session = BaseObjectPtr<QuicSession>());
+
 #define V(id, name)                                                            \
   bool has_option_##name() const {                                             \
     return options_ & (1 << QUICSOCKET_OPTIONS_##id); }
@@ -470,6 +487,14 @@ class QuicSocket : public AsyncWrap,
       size_t suggested_size,
       uv_buf_t* buf);
 
+  // Hands a single packet to the endpoint, which either sends it
+  // synchronously or queues it in libuv.
+  int DispatchPacket(
+      QuicEndpoint* endpoint,
+      const SocketAddress& remote_addr,
+      std::unique_ptr<QuicPacket> packet,
+      BaseObjectPtr<QuicSession> session);
+
   void OnSend(int status, QuicPacket* packet);
 
   inline void set_validated_address(const SocketAddress& addr);
@@ -23,6 +23,8 @@
 namespace node {
 
 using v8::Array;
+using v8::ArrayBufferView;
+using v8::BackingStore;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -219,12 +221,16 @@ int QuicStream::DoWrite(
   // in the sense of providing back-pressure, but
   // also means that writes will be significantly
   // less performant unless written in batches.
-  streambuf_.Push(
-      bufs,
-      nbufs,
-      [req_wrap, strong_ref](int status) {
-        req_wrap->Done(status);
-      });
+  auto done = [req_wrap, strong_ref](int status) {
+    req_wrap->Done(status);
+  };
+  // When called from WriteViews(), the chunks also hold a reference to the
+  // memory they point into, so it is safe to retain them beyond this call
+  // even when the WriteWrap does not keep the JS buffers alive.
+  if (pinned_stores_.size() == nbufs)
+    streambuf_.Push(bufs, pinned_stores_.data(), nbufs, std::move(done));
+  else
+    streambuf_.Push(bufs, nbufs, std::move(done));
 
   // If end() was called on the JS side, the write_ended flag
   // will have been set. This allows us to know early if this
@@ -241,6 +247,32 @@ int QuicStream::DoWrite(
   return 0;
 }
 
+int QuicStream::WriteViews(
+    Local<Object> req_wrap_obj,
+    Local<Array> chunks) {
+  Environment* env = this->env();
+  size_t count = chunks->Length();
+  MaybeStackBuffer<uv_buf_t, 16> bufs(count);
+
+  CHECK(pinned_stores_.empty());
+  pinned_stores_.reserve(count);
+  for (size_t n = 0; n < count; n++) {
+    Local<Value> chunk = chunks->Get(env->context(), n).ToLocalChecked();
+    CHECK(chunk->IsArrayBufferView());
+    Local<ArrayBufferView> view = chunk.As<ArrayBufferView>();
+    std::shared_ptr<BackingStore> store = view->Buffer()->GetBackingStore();
+    bufs[n] = uv_buf_init(
+        static_cast<char*>(store->Data()) + view->ByteOffset(),
+        view->ByteLength());
+    pinned_stores_.emplace_back(std::move(store));
+  }
+
+  StreamWriteResult res = Write(*bufs, count, nullptr, req_wrap_obj);
+  pinned_stores_.clear();
+  SetWriteResult(res);
+  return res.err;
+}
+
 bool QuicStream::IsAlive() {
   return !is_destroyed() && !IsClosing();
 }
@@ -446,6 +478,15 @@ void QuicStreamDestroy(const FunctionCallbackInfo<Value>& args) {
   stream->Destroy(&error);
 }
 
+void QuicStreamWriteViews(const FunctionCallbackInfo<Value>& args) {
+  QuicStream* stream;
+  ASSIGN_OR_RETURN_UNWRAP(&stream, args.Holder());
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsArray());
+  args.GetReturnValue().Set(
+      stream->WriteViews(args[0].As<Object>(), args[1].As<Array>()));
+}
+
 void QuicStreamReset(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   QuicStream* stream;
@@ -535,6 +576,7 @@ void QuicStream::Initialize(
   streamt->SetInternalFieldCount(StreamBase::kInternalFieldCount);
   streamt->Set(env->owner_symbol(), Null(env->isolate()));
   env->SetProtoMethod(stream, "destroy", QuicStreamDestroy);
+  env->SetProtoMethod(stream, "writeViews", QuicStreamWriteViews);
   env->SetProtoMethod(stream, "resetStream", QuicStreamReset);
   env->SetProtoMethod(stream, "stopSending", QuicStreamStopSending);
   env->SetProtoMethod(stream, "id", QuicStreamGetID);
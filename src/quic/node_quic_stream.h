@@ -14,6 +14,7 @@
 #include "util-inl.h"
 #include "v8.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -281,6 +282,13 @@ class QuicStream : public AsyncWrap,
       size_t nbufs,
       uv_stream_t* send_handle) override;
 
+  // Writes the ArrayBufferViews in chunks without copying them. The
+  // backing stores of the views are retained by streambuf_ until the
+  // data has been acknowledged, so unlike with Writev() the WriteWrap
+  // does not need to keep the chunks alive.
+  int WriteViews(v8::Local<v8::Object> req_wrap_obj,
+                 v8::Local<v8::Array> chunks);
+
   // Returns false if the header cannot be added. This will
   // typically only happen if a maximimum number of headers
   // has been reached.
@@ -375,6 +383,8 @@ class QuicStream : public AsyncWrap,
 
   BaseObjectWeakPtr<QuicSession> session_;
   QuicBuffer streambuf_;
+  // The backing stores of the buffers passed to DoWrite() by WriteViews().
+  std::vector<std::shared_ptr<v8::BackingStore>> pinned_stores_;
 
   int64_t stream_id_ = 0;
   int64_t push_id_ = 0;
@@ -26,8 +26,11 @@ namespace quic {
 // are exposed to javascript as constants (see node_quic.cc)
 
 constexpr size_t kMaxSizeT = std::numeric_limits<size_t>::max();
+constexpr size_t kMaxPacketBatchSize = 16;
 constexpr size_t kMaxValidateAddressLru = 10;
 constexpr size_t kMinInitialQuicPktSize = 1200;
+constexpr size_t kPacingMinBurst = 10;
+constexpr uint64_t kPacingGranularity = 2 * NGTCP2_MILLISECONDS;
 constexpr size_t kScidLen = NGTCP2_MAX_CIDLEN;
 constexpr size_t kTokenRandLen = 16;
 constexpr size_t kTokenSecretLen = 16;
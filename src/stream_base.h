@@ -15,6 +15,7 @@ namespace node {
 
 // Forward declarations
 class Environment;
+class ExternalReferenceRegistry;
 class ShutdownWrap;
 class WriteWrap;
 class StreamBase;
@@ -307,6 +308,7 @@ class StreamBase : public StreamResource {
 
   static void AddMethods(Environment* env,
                          v8::Local<v8::FunctionTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   virtual bool IsAlive() = 0;
   virtual bool IsClosing() = 0;
@@ -389,11 +391,12 @@ class StreamBase : public StreamResource {
     kNumStreamBaseStateFields
   };
 
+  void SetWriteResult(const StreamWriteResult& res);
+
  private:
   Environment* env_;
   EmitToJSStreamListener default_listener_;
 
-  void SetWriteResult(const StreamWriteResult& res);
   static void AddMethod(Environment* env,
                         v8::Local<v8::Signature> sig,
                         enum v8::PropertyAttribute attributes,
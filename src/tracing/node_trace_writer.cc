@@ -1,15 +1,20 @@
 #include "tracing/node_trace_writer.h"
 
+#include "tracing/trace_event.h"
 #include "util-inl.h"
 
 #include <fcntl.h>
 #include <cstring>
+#include <type_traits>
 
 namespace node {
 namespace tracing {
 
-NodeTraceWriter::NodeTraceWriter(const std::string& log_file_pattern)
-    : log_file_pattern_(log_file_pattern) {}
+constexpr char NodeTraceWriter::kBinaryMagic[8];
+
+NodeTraceWriter::NodeTraceWriter(const std::string& log_file_pattern,
+                                 Format format)
+    : log_file_pattern_(log_file_pattern), format_(format) {}
 
 void NodeTraceWriter::InitializeOnThread(uv_loop_t* loop) {
   CHECK_NULL(tracing_loop_);
@@ -96,8 +101,116 @@ void NodeTraceWriter::OpenNewFileForStreaming() {
   }
 }
 
+namespace {
+
+// All integers are written in little-endian byte order, independent of the
+// host.
+template <typename T>
+inline void AppendLE(std::string* out, T value) {
+  static_assert(std::is_integral<T>::value, "T must be an integer");
+  using U = typename std::make_unsigned<T>::type;
+  U bits = static_cast<U>(value);
+  char bytes[sizeof(T)];
+  for (size_t i = 0; i < sizeof(T); ++i)
+    bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+  out->append(bytes, sizeof(T));
+}
+
+inline void AppendString(std::string* out, const char* str, size_t length) {
+  AppendLE<uint32_t>(out, static_cast<uint32_t>(length));
+  out->append(str, length);
+}
+
+inline void AppendString(std::string* out, const char* str) {
+  AppendString(out, str, str == nullptr ? 0 : strlen(str));
+}
+
+}  // anonymous namespace
+
+// Every record is:
+//
+// [ u32 size of the rest of the record ]
+// [ u8 phase ][ u8 num_args ][ u32 flags ][ i32 pid ][ i32 tid ]
+// [ i64 ts ][ i64 tts ][ i64 dur ][ i64 tdur ][ u64 id ][ u64 bind_id ]
+// [ str category ][ str name ][ str scope ]
+// [ str arg name ][ u8 arg type ][ arg value ] x num_args
+//
+// where str is a u32 length followed by that many bytes. Numeric argument
+// values are stored as their raw 8 bytes, strings and convertables (which
+// are already formatted as JSON) as str.
+void NodeTraceWriter::AppendBinaryTraceEvent(TraceObject* trace_event) {
+  size_t start = binary_buffer_.size();
+  AppendLE<uint32_t>(&binary_buffer_, 0);  // Patched below.
+  AppendLE<uint8_t>(&binary_buffer_, trace_event->phase());
+  AppendLE<uint8_t>(&binary_buffer_, trace_event->num_args());
+  AppendLE<uint32_t>(&binary_buffer_, trace_event->flags());
+  AppendLE<int32_t>(&binary_buffer_, trace_event->pid());
+  AppendLE<int32_t>(&binary_buffer_, trace_event->tid());
+  AppendLE<int64_t>(&binary_buffer_, trace_event->ts());
+  AppendLE<int64_t>(&binary_buffer_, trace_event->tts());
+  AppendLE<int64_t>(&binary_buffer_, trace_event->duration());
+  AppendLE<int64_t>(&binary_buffer_, trace_event->cpu_duration());
+  AppendLE<uint64_t>(&binary_buffer_, trace_event->id());
+  AppendLE<uint64_t>(&binary_buffer_, trace_event->bind_id());
+  AppendString(&binary_buffer_,
+               v8::platform::tracing::TracingController::GetCategoryGroupName(
+                   trace_event->category_enabled_flag()));
+  AppendString(&binary_buffer_, trace_event->name());
+  AppendString(&binary_buffer_, trace_event->scope());
+
+  const char** arg_names = trace_event->arg_names();
+  const uint8_t* arg_types = trace_event->arg_types();
+  TraceObject::ArgValue* arg_values = trace_event->arg_values();
+  std::unique_ptr<v8::ConvertableToTraceFormat>* arg_convertables =
+      trace_event->arg_convertables();
+  for (int i = 0; i < trace_event->num_args(); ++i) {
+    AppendString(&binary_buffer_, arg_names[i]);
+    AppendLE<uint8_t>(&binary_buffer_, arg_types[i]);
+    switch (arg_types[i]) {
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        std::string json;
+        arg_convertables[i]->AppendAsTraceFormat(&json);
+        AppendString(&binary_buffer_, json.data(), json.size());
+        break;
+      }
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        AppendString(&binary_buffer_, arg_values[i].as_string == nullptr ?
+                         "nullptr" : arg_values[i].as_string);
+        break;
+      default:
+        // bool, uint, int, double and pointer values all share the same
+        // 8 bytes of the union.
+        AppendLE<uint64_t>(&binary_buffer_, arg_values[i].as_uint);
+        break;
+    }
+  }
+
+  uint32_t size = static_cast<uint32_t>(
+      binary_buffer_.size() - start - sizeof(uint32_t));
+  for (size_t i = 0; i < sizeof(size); ++i)
+    binary_buffer_[start + i] = static_cast<char>((size >> (8 * i)) & 0xff);
+}
+
+bool NodeTraceWriter::IsWritingFile() const {
+  return format_ == Format::kBinary ? binary_file_started_
+                                    : json_trace_writer_ != nullptr;
+}
+
 void NodeTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
   Mutex::ScopedLock scoped_lock(stream_mutex_);
+  if (format_ == Format::kBinary) {
+    if (total_traces_ == 0) {
+      OpenNewFileForStreaming();
+      binary_buffer_.append(kBinaryMagic, sizeof(kBinaryMagic));
+      AppendLE<uint32_t>(&binary_buffer_, kBinaryVersion);
+      binary_file_started_ = true;
+    }
+    ++total_traces_;
+    AppendBinaryTraceEvent(trace_event);
+    return;
+  }
+
   // If this is the first trace event, open a new file for streaming.
   if (total_traces_ == 0) {
     OpenNewFileForStreaming();
@@ -123,11 +236,16 @@ void NodeTraceWriter::FlushPrivate() {
       // Destroying the member JSONTraceWriter object appends "]}" to
       // stream_ - in other words, ending a JSON file.
       json_trace_writer_.reset();
+      binary_file_started_ = false;
+    }
+    if (format_ == Format::kBinary) {
+      str.swap(binary_buffer_);
+    } else {
+      // str() makes a copy of the contents of the stream.
+      str = stream_.str();
+      stream_.str("");
+      stream_.clear();
     }
-    // str() makes a copy of the contents of the stream.
-    str = stream_.str();
-    stream_.str("");
-    stream_.clear();
   }
   {
     Mutex::ScopedLock request_scoped_lock(request_mutex_);
@@ -143,7 +261,7 @@ void NodeTraceWriter::Flush(bool blocking) {
     // protects json_trace_writer_, and without request_mutex_ there might be
     // a time window in which the stream state changes?
     Mutex::ScopedLock stream_mutex_lock(stream_mutex_);
-    if (!json_trace_writer_)
+    if (!IsWritingFile())
       return;
   }
   int request_id = ++num_write_requests_;
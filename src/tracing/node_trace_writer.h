@@ -2,6 +2,7 @@
 #define SRC_TRACING_NODE_TRACE_WRITER_H_
 
 #include <sstream>
+#include <string>
 #include <queue>
 
 #include "libplatform/v8-tracing.h"
@@ -16,7 +17,17 @@ using v8::platform::tracing::TraceWriter;
 
 class NodeTraceWriter : public AsyncTraceWriter {
  public:
-  explicit NodeTraceWriter(const std::string& log_file_pattern);
+  enum class Format {
+    // The Trace Event JSON format that Chrome understands.
+    kJSON,
+    // A stream of length-prefixed binary records that is much cheaper to
+    // produce, see tools/trace-events-to-json.js for the layout and for
+    // converting it into JSON.
+    kBinary
+  };
+
+  explicit NodeTraceWriter(const std::string& log_file_pattern,
+                           Format format = Format::kJSON);
   ~NodeTraceWriter() override;
 
   void InitializeOnThread(uv_loop_t* loop) override;
@@ -25,6 +36,10 @@ class NodeTraceWriter : public AsyncTraceWriter {
 
   static const int kTracesPerFile = 1 << 19;
 
+  static constexpr char kBinaryMagic[8] =
+      { 'N', 'O', 'D', 'E', 'T', 'R', 'C', '\0' };
+  static const uint32_t kBinaryVersion = 1;
+
  private:
   struct WriteRequest {
     std::string str;
@@ -37,6 +52,8 @@ class NodeTraceWriter : public AsyncTraceWriter {
   void WriteToFile(std::string&& str, int highest_request_id);
   void WriteSuffix();
   void FlushPrivate();
+  bool IsWritingFile() const;
+  void AppendBinaryTraceEvent(TraceObject* trace_event);
   static void ExitSignalCb(uv_async_t* signal);
 
   uv_loop_t* tracing_loop_ = nullptr;
@@ -64,8 +81,14 @@ class NodeTraceWriter : public AsyncTraceWriter {
   int total_traces_ = 0;
   int file_num_ = 0;
   std::string log_file_pattern_;
+  Format format_;
   std::ostringstream stream_;
   std::unique_ptr<TraceWriter> json_trace_writer_;
+  // Serialized records when using Format::kBinary. There is no suffix to
+  // write at the end of a file, so this only tracks whether a file has been
+  // started.
+  std::string binary_buffer_;
+  bool binary_file_started_ = false;
   bool exited_ = false;
 };
 
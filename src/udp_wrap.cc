@@ -84,6 +84,12 @@ UDPWrapBase::~UDPWrapBase() {
   set_listener(nullptr);
 }
 
+size_t UDPWrapBase::TrySendDatagrams(uv_buf_t* bufs,
+                                     size_t nbufs,
+                                     const sockaddr* addr) {
+  return 0;
+}
+
 UDPListener* UDPWrapBase::listener() const {
   CHECK_NOT_NULL(listener_);
   return listener_;
@@ -609,6 +615,58 @@ ssize_t UDPWrap::Send(uv_buf_t* bufs_ptr,
 }
 
 
+size_t UDPWrap::TrySendDatagrams(uv_buf_t* bufs,
+                                 size_t nbufs,
+                                 const sockaddr* addr) {
+#ifdef __linux__
+  // Datagrams that are queued in libuv have to go out first.
+  if (IsHandleClosing() ||
+      UNLIKELY(env()->options()->test_udp_no_try_send) ||
+      uv_udp_get_send_queue_count(&handle_) > 0) {
+    return 0;
+  }
+
+  uv_os_fd_t fd;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(&handle_), &fd) != 0)
+    return 0;
+
+  static constexpr size_t kMaxDatagrams = 32;
+  mmsghdr msgs[kMaxDatagrams];
+  iovec iov[kMaxDatagrams];
+  socklen_t addrlen = 0;
+  if (addr != nullptr) {
+    addrlen = addr->sa_family == AF_INET6 ?
+        sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+  }
+
+  size_t sent = 0;
+  while (sent < nbufs) {
+    size_t count = std::min(nbufs - sent, kMaxDatagrams);
+    memset(msgs, 0, sizeof(msgs[0]) * count);
+    for (size_t i = 0; i < count; i++) {
+      iov[i].iov_base = bufs[sent + i].base;
+      iov[i].iov_len = bufs[sent + i].len;
+      msgs[i].msg_hdr.msg_name = const_cast<sockaddr*>(addr);
+      msgs[i].msg_hdr.msg_namelen = addrlen;
+      msgs[i].msg_hdr.msg_iov = &iov[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int ret;
+    do {
+      ret = sendmmsg(fd, msgs, count, 0);
+    } while (ret == -1 && errno == EINTR);
+    if (ret <= 0)
+      break;
+    sent += ret;
+    if (static_cast<size_t>(ret) < count)
+      break;
+  }
+  return sent;
+#else
+  return 0;
+#endif  // __linux__
+}
+
 ReqWrap<uv_udp_send_t>* UDPWrap::CreateSendWrap(size_t msg_size) {
   SendWrap* req_wrap = new SendWrap(env(),
                                     current_send_req_wrap_,
@@ -96,6 +96,14 @@ class UDPWrapBase {
                        size_t nbufs,
                        const sockaddr* addr) = 0;
 
+  // Send each of the nbufs buffers as a datagram of its own, using a single
+  // system call where the platform supports it. Returns the number of
+  // datagrams that were sent synchronously; the remaining ones need to be
+  // passed to Send(). Never fails, errors are left to Send() to report.
+  virtual size_t TrySendDatagrams(uv_buf_t* bufs,
+                                  size_t nbufs,
+                                  const sockaddr* addr);
+
   virtual SocketAddress GetPeerName() = 0;
   virtual SocketAddress GetSockName() = 0;
 
@@ -166,6 +174,9 @@ class UDPWrap final : public HandleWrap,
   ssize_t Send(uv_buf_t* bufs,
                size_t nbufs,
                const sockaddr* addr) override;
+  size_t TrySendDatagrams(uv_buf_t* bufs,
+                          size_t nbufs,
+                          const sockaddr* addr) override;
 
   SocketAddress GetPeerName() override;
   SocketAddress GetSockName() override;
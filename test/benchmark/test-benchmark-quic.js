@@ -0,0 +1,9 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasQuic)
+  common.skip('missing quic');
+
+const runBenchmark = require('../common/benchmark');
+
+runBenchmark('quic');
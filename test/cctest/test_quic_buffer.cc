@@ -204,3 +204,68 @@ TEST(QuicBuffer, QuicBufferChunk) {
   buffer.Consume(50);
   ASSERT_TRUE(IsEqual(buffer.length(), 0));
 }
+
+TEST(QuicBuffer, ManyChunks) {
+  // Enough chunks to span multiple slabs of the chunk pool, which have to
+  // be reused when the chunks are pushed a second time.
+  static constexpr size_t kCount = 1000;
+  char data[kCount];
+  memset(&data, 0, node::arraysize(data));
+
+  for (int round = 0; round < 2; round++) {
+    QuicBuffer buffer;
+    size_t count = 0;
+    for (size_t n = 0; n < kCount; n++) {
+      uv_buf_t buf = uv_buf_init(data + n, 1);
+      buffer.Push(&buf, 1, [&](int status) {
+        EXPECT_EQ(0, status);
+        count++;
+      });
+    }
+    ASSERT_TRUE(IsEqual(buffer.length(), kCount));
+
+    buffer.Seek(kCount);
+    buffer.Consume(kCount / 2);
+    ASSERT_TRUE(IsEqual(count, kCount / 2));
+    buffer.Consume(kCount / 2);
+    ASSERT_TRUE(IsEqual(count, kCount));
+    ASSERT_TRUE(IsEqual(buffer.length(), 0));
+  }
+}
+
+TEST(QuicBuffer, BackingStore) {
+  static char data[100];
+  bool freed = false;
+
+  std::shared_ptr<v8::BackingStore> store =
+      v8::ArrayBuffer::NewBackingStore(
+          data,
+          node::arraysize(data),
+          [](void* data, size_t length, void* deleter_data) {
+            *static_cast<bool*>(deleter_data) = true;
+          },
+          &freed);
+
+  // The second buffer points into the middle of the backing store.
+  uv_buf_t bufs[] {
+    uv_buf_init(data, 50),
+    uv_buf_init(data + 50, 50)
+  };
+  std::shared_ptr<v8::BackingStore> stores[] { store, store };
+  store.reset();
+
+  QuicBuffer buffer;
+  bool done = false;
+  buffer.Push(bufs, stores, 2, [&](int status) { done = true; });
+  ASSERT_TRUE(IsEqual(buffer.length(), 100));
+
+  // The QuicBuffer keeps the backing store alive until all of the
+  // data pointing into it has been consumed.
+  buffer.Seek(100);
+  buffer.Consume(50);
+  ASSERT_FALSE(freed);
+  ASSERT_FALSE(done);
+  buffer.Consume(50);
+  ASSERT_TRUE(freed);
+  ASSERT_TRUE(done);
+}
@@ -65,6 +65,9 @@ function _validateContent(report, fields = []) {
   if (report.uvthreadResourceUsage)
     sections.push('uvthreadResourceUsage');
 
+  if (report.asyncCallbacks)
+    sections.push('asyncCallbacks');
+
   checkForUnknownFields(report, sections);
   sections.forEach((section) => {
     assert(report.hasOwnProperty(section));
@@ -283,6 +286,24 @@ function _validateContent(report, fields = []) {
     assert.strictEqual(typeof sharedObject, 'string');
   });
 
+  // Verify the format of the asyncCallbacks section.
+  if (report.asyncCallbacks) {
+    assert(Array.isArray(report.asyncCallbacks));
+    report.asyncCallbacks.forEach((monitor) => {
+      for (const stats of Object.values(monitor)) {
+        checkForUnknownFields(stats, ['count', 'totalTime', 'min', 'max',
+                                      'mean', 'p99']);
+        assert(Number.isSafeInteger(stats.count));
+        assert(stats.count > 0);
+        assert(Number.isSafeInteger(stats.totalTime));
+        assert.strictEqual(typeof stats.min, 'number');
+        assert.strictEqual(typeof stats.max, 'number');
+        assert.strictEqual(typeof stats.mean, 'number');
+        assert.strictEqual(typeof stats.p99, 'number');
+      }
+    });
+  }
+
   // Verify the format of the workers section.
   assert(Array.isArray(report.workers));
   report.workers.forEach((worker) => _validateContent(worker));
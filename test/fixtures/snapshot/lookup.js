@@ -0,0 +1,50 @@
+'use strict';
+
+// Entry point for `node --build-snapshot` that does some work at build
+// time and checks the state once the snapshot is deserialized.
+// The entry point script is run with require, __filename and __dirname.
+
+const fs = require('fs');
+const path = require('path');
+const v8 = require('v8');
+const { EventEmitter } = require('events');
+
+const words = fs.readFileSync(path.join(__dirname, 'words.txt'), 'utf8')
+  .split('\n')
+  .filter(Boolean);
+const index = new Map(words.map((word, i) => [word, i]));
+const emitter = new EventEmitter();
+let deserialized = 0;
+let cache = new Map([['built', true]]);
+
+if (!v8.startupSnapshot.isBuildingSnapshot())
+  throw new Error('Expected to be building a snapshot');
+
+v8.startupSnapshot.addSerializeCallback((data) => {
+  if (data !== 'serialize-data')
+    throw new Error(`Unexpected serialize data ${data}`);
+  cache = null;
+}, 'serialize-data');
+
+v8.startupSnapshot.addDeserializeCallback((data) => {
+  deserialized++;
+  cache = new Map([['deserialized', data]]);
+}, 'deserialize-data');
+
+emitter.on('lookup', (word) => {
+  process.stdout.write(`${word}=${index.get(word)}\n`);
+});
+
+v8.startupSnapshot.setDeserializeMainFunction(() => {
+  const result = {
+    isBuildingSnapshot: v8.startupSnapshot.isBuildingSnapshot(),
+    deserialized,
+    cache: cache.get('deserialized'),
+    words: words.length,
+    heapStatistics: v8.getHeapStatistics().total_heap_size > 0,
+    stat: fs.statSync(__filename).isFile(),
+  };
+  process.stdout.write(`${JSON.stringify(result)}\n`);
+  for (const word of process.argv.slice(2))
+    emitter.emit('lookup', word);
+});
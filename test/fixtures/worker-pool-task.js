@@ -0,0 +1,18 @@
+'use strict';
+
+module.exports = async ({ op, value }) => {
+  switch (op) {
+    case 'double':
+      return value * 2;
+    case 'throw':
+      throw new Error(value);
+    case 'exit':
+      process.exit(value);
+      break;
+    case 'sleep':
+      await new Promise((resolve) => setTimeout(resolve, value));
+      return value;
+    case 'buffer':
+      return value.byteLength;
+  }
+};
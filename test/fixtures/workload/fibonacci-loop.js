@@ -0,0 +1,22 @@
+'use strict';
+function fib(n) {
+  if (n === 0 || n === 1) return n;
+  return fib(n - 1) + fib(n - 2);
+}
+
+// Keeps the CPU busy for about `duration` milliseconds while letting the
+// event loop turn between the iterations.
+const duration = parseInt(process.argv[2]) || 500;
+const signal = process.argv[3];
+const end = Date.now() + duration;
+let signaled = false;
+function work() {
+  fib(20);
+  if (signal !== undefined && !signaled && Date.now() > end - duration / 2) {
+    signaled = true;
+    process.kill(process.pid, signal);
+  }
+  if (Date.now() < end)
+    setImmediate(work);
+}
+work();
@@ -22,7 +22,6 @@ const expectedModules = new Set([
   'Internal Binding native_module',
   'Internal Binding options',
   'Internal Binding process_methods',
-  'Internal Binding report',
   'Internal Binding string_decoder',
   'Internal Binding symbols',
   'Internal Binding task_queue',
@@ -31,7 +30,6 @@ const expectedModules = new Set([
   'Internal Binding types',
   'Internal Binding url',
   'Internal Binding util',
-  'Internal Binding worker',
   'NativeModule buffer',
   'NativeModule events',
   'NativeModule fs',
@@ -49,8 +47,6 @@ const expectedModules = new Set([
   'NativeModule internal/fixed_queue',
   'NativeModule internal/fs/dir',
   'NativeModule internal/fs/utils',
-  'NativeModule internal/fs/promises',
-  'NativeModule internal/fs/rimraf',
   'NativeModule internal/idna',
   'NativeModule internal/linkedlist',
   'NativeModule internal/modules/run_main',
@@ -72,23 +68,11 @@ const expectedModules = new Set([
   'NativeModule internal/process/execution',
   'NativeModule internal/process/per_thread',
   'NativeModule internal/process/promises',
-  'NativeModule internal/process/report',
   'NativeModule internal/process/signal',
   'NativeModule internal/process/task_queues',
   'NativeModule internal/process/warning',
   'NativeModule internal/querystring',
   'NativeModule internal/source_map/source_map_cache',
-  'NativeModule internal/streams/buffer_list',
-  'NativeModule internal/streams/destroy',
-  'NativeModule internal/streams/duplex',
-  'NativeModule internal/streams/end-of-stream',
-  'NativeModule internal/streams/legacy',
-  'NativeModule internal/streams/passthrough',
-  'NativeModule internal/streams/pipeline',
-  'NativeModule internal/streams/readable',
-  'NativeModule internal/streams/state',
-  'NativeModule internal/streams/transform',
-  'NativeModule internal/streams/writable',
   'NativeModule internal/timers',
   'NativeModule internal/url',
   'NativeModule internal/util',
@@ -101,7 +85,6 @@ const expectedModules = new Set([
   'NativeModule internal/worker/io',
   'NativeModule internal/worker/js_transferable',
   'NativeModule path',
-  'NativeModule stream',
   'NativeModule timers',
   'NativeModule url',
   'NativeModule util',
@@ -129,6 +112,7 @@ if (!common.isMainThread) {
     'NativeModule internal/streams/state',
     'NativeModule internal/worker',
     'NativeModule internal/worker/io',
+    'NativeModule internal/worker/stdio',
     'NativeModule stream',
     'NativeModule worker_threads',
   ].forEach(expectedModules.add.bind(expectedModules));
@@ -0,0 +1,100 @@
+'use strict';
+
+// Tests that --experimental-code-cache-dir stores the code cache of user
+// CommonJS and ES modules and uses it in later runs.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const cacheDir = path.join(tmpdir.path, 'cache');
+const cjs = path.join(tmpdir.path, 'entry.js');
+const esm = path.join(tmpdir.path, 'dep.mjs');
+
+fs.writeFileSync(esm, 'export function add(a, b) { return a + b; }\n');
+fs.writeFileSync(cjs, `
+function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+console.log(fib(10));
+import('./dep.mjs').then(({ add }) => console.log(add(1, 2)));
+`);
+
+function run(...args) {
+  const child = spawnSync(process.execPath, [
+    ...args, `--experimental-code-cache-dir=${cacheDir}`, cjs,
+  ], {
+    cwd: tmpdir.path,
+    env: { ...process.env, NODE_DEBUG_NATIVE: 'CODE_CACHE' },
+    encoding: 'utf8',
+  });
+  assert.strictEqual(child.status, 0, child.stderr);
+  assert.strictEqual(child.stdout, '55\n3\n');
+  return child.stderr;
+}
+
+function cacheFiles() {
+  const files = [];
+  for (const dir of fs.readdirSync(cacheDir))
+    files.push(...fs.readdirSync(path.join(cacheDir, dir)));
+  return files.sort();
+}
+
+{
+  // The first run creates the caches.
+  const stderr = run();
+  assert.match(stderr, /Will create cache for .*entry\.js/);
+  assert.match(stderr, /Will create cache for .*dep\.mjs/);
+  assert.match(stderr, /Wrote \d+ bytes of cache for .*entry\.js/);
+  assert.match(stderr, /Wrote \d+ bytes of cache for .*dep\.mjs/);
+  assert.deepStrictEqual(cacheFiles().map((f) => path.extname(f)),
+                         ['.cache', '.cache']);
+}
+
+{
+  // The second run consumes them and does not write anything.
+  const stderr = run();
+  assert.match(stderr, /Read \d+ bytes of cache for .*entry\.js/);
+  assert.match(stderr, /Read \d+ bytes of cache for .*dep\.mjs/);
+  assert.doesNotMatch(stderr, /Wrote \d+ bytes/);
+}
+
+{
+  // A change to the source invalidates the cache of that module only.
+  fs.appendFileSync(esm, 'export const x = 1;\n');
+  const stderr = run();
+  assert.match(stderr, /Read \d+ bytes of cache for .*entry\.js/);
+  assert.match(stderr, /cache for .*dep\.mjs was created for a different/i);
+  assert.match(stderr, /Wrote \d+ bytes of cache for .*dep\.mjs/);
+  assert.doesNotMatch(stderr, /Wrote \d+ bytes of cache for .*entry\.js/);
+}
+
+{
+  // The cache is still written when the process exits early.
+  fs.appendFileSync(cjs, 'process.exit(0);\n');
+  const stderr = spawnSync(process.execPath, [
+    `--experimental-code-cache-dir=${cacheDir}`, cjs,
+  ], {
+    env: { ...process.env, NODE_DEBUG_NATIVE: 'CODE_CACHE' },
+    encoding: 'utf8',
+  }).stderr;
+  assert.match(stderr, /Wrote \d+ bytes of cache for .*entry\.js/);
+}
+
+{
+  // A corrupted cache is ignored and replaced.
+  for (const dir of fs.readdirSync(cacheDir)) {
+    for (const file of fs.readdirSync(path.join(cacheDir, dir)))
+      fs.writeFileSync(path.join(cacheDir, dir, file), 'garbage');
+  }
+  const stderr = spawnSync(process.execPath, [
+    `--experimental-code-cache-dir=${cacheDir}`, cjs,
+  ], {
+    env: { ...process.env, NODE_DEBUG_NATIVE: 'CODE_CACHE' },
+    encoding: 'utf8',
+  }).stderr;
+  assert.match(stderr, /Truncated cache for .*entry\.js/);
+  assert.match(stderr, /Wrote \d+ bytes of cache for .*entry\.js/);
+}
@@ -0,0 +1,117 @@
+'use strict';
+
+// Tests the non-cryptographic checksums crc32c, xxh64 and xxh3, which are
+// implemented by Node.js rather than by OpenSSL.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const big = Buffer.alloc(100000);
+for (let i = 0; i < big.length; i++)
+  big[i] = i & 0xff;
+
+const vectors = [
+  ['', {
+    crc32c: '00000000',
+    xxh64: 'ef46db3751d8e999',
+    xxh3: '2d06800538d394c2',
+  }],
+  ['123456789', {
+    crc32c: 'e3069283',
+    xxh64: '8cb841db40e6ae83',
+    xxh3: '72dcb18b67a17dff',
+  }],
+  ['some data to hash', {
+    crc32c: '01b21df7',
+    xxh64: '3e2a5c5616c08fee',
+    xxh3: 'c41a012ecc067598',
+  }],
+  ['a'.repeat(200), {
+    crc32c: '50137e73',
+    xxh64: '942e9189f34eebbe',
+    xxh3: 'ac2bd404bce6c995',
+  }],
+  ['€'.repeat(1000), {
+    crc32c: '5df4a12c',
+    xxh64: '399dcc2e87313e88',
+    xxh3: 'c819b257cc69aebd',
+  }],
+  [big, {
+    crc32c: 'ec719d7d',
+    xxh64: 'f7a005162637d2fa',
+    xxh3: '39cf9d035d60ad58',
+  }],
+];
+
+for (const [input, expected] of vectors) {
+  const data = Buffer.from(input);
+  for (const algorithm of ['crc32c', 'xxh64', 'xxh3']) {
+    assert.strictEqual(crypto.hash(algorithm, input), expected[algorithm]);
+    assert.strictEqual(crypto.hash(algorithm, new Uint8Array(data)),
+                       expected[algorithm]);
+    assert.deepStrictEqual(crypto.hash(algorithm, data, 'buffer'),
+                           Buffer.from(expected[algorithm], 'hex'));
+    assert.strictEqual(
+      crypto.createHash(algorithm).update(input).digest('hex'),
+      expected[algorithm]);
+
+    // Updates of all sizes give the same result, and copies continue from
+    // the state of the original.
+    for (const size of [1, 3, 31, 64, 255, 257, 1025]) {
+      const hash = crypto.createHash(algorithm);
+      let copy;
+      for (let i = 0; i < data.length; i += size) {
+        hash.update(data.subarray(i, i + size));
+        if (copy === undefined && i + size >= data.length / 2)
+          copy = hash.copy();
+      }
+      assert.strictEqual(hash.digest('hex'), expected[algorithm]);
+      if (copy !== undefined) {
+        const offset = Math.ceil((data.length / 2) / size) * size;
+        copy.update(data.subarray(offset));
+        assert.strictEqual(copy.digest('hex'), expected[algorithm]);
+      }
+    }
+  }
+}
+
+{
+  const inputs = vectors.map(([input]) => input);
+  for (const algorithm of ['crc32c', 'xxh64', 'xxh3']) {
+    const expected = vectors.map(([, digests]) => digests[algorithm]);
+    assert.deepStrictEqual(crypto.hashBatch(algorithm, inputs), expected);
+    crypto.hashBatch(algorithm, inputs, common.mustSucceed((digests) => {
+      assert.deepStrictEqual(digests, expected);
+    }));
+    crypto.hashBatch(algorithm, inputs, 'buffer',
+                     common.mustSucceed((digests) => {
+                       assert.deepStrictEqual(
+                         digests,
+                         expected.map((digest) => Buffer.from(digest, 'hex')));
+                     }));
+  }
+}
+
+{
+  // The output length of a checksum is fixed.
+  assert.strictEqual(
+    crypto.createHash('crc32c', { outputLength: 4 }).digest('hex'),
+    '00000000');
+  assert.throws(() => crypto.createHash('xxh3', { outputLength: 16 }), {
+    code: 'ERR_CRYPTO_INVALID_DIGEST'
+  });
+
+  // Checksums are not cryptographic hash functions.
+  assert(!crypto.getHashes().includes('xxh3'));
+
+  assert.throws(() => crypto.hash('xxh3', 1), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => crypto.hashBatch('crc32c', [Buffer.alloc(1), null]), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
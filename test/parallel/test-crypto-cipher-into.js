@@ -0,0 +1,244 @@
+'use strict';
+
+// Tests cipher.updateInto(), cipher.finalInto(), crypto.aeadSeal() and
+// crypto.aeadOpen(), which write their output into existing buffers.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const key = crypto.randomBytes(32);
+const iv = crypto.randomBytes(12);
+const iv16 = crypto.randomBytes(16);
+const plaintext = crypto.randomBytes(1000);
+
+function legacySeal(algorithm, key, iv, data, aad, authTagLength = 16) {
+  const cipher = crypto.createCipheriv(algorithm, key, iv, { authTagLength });
+  if (aad !== undefined)
+    cipher.setAAD(aad, { plaintextLength: data.length });
+  return Buffer.concat([
+    cipher.update(data), cipher.final(), cipher.getAuthTag(),
+  ]);
+}
+
+{
+  // updateInto() and finalInto() produce the same output as update() and
+  // final(), for block modes with padding too.
+  for (const algorithm of ['aes-256-cbc', 'aes-256-ctr']) {
+    const reference = crypto.createCipheriv(algorithm, key, iv16);
+    const ciphertext = Buffer.concat([
+      reference.update(plaintext), reference.final(),
+    ]);
+
+    const cipher = crypto.createCipheriv(algorithm, key, iv16);
+    const output = Buffer.alloc(plaintext.length + 32);
+    let written = 0;
+    for (let i = 0; i < plaintext.length; i += 300) {
+      written += cipher.updateInto(plaintext.subarray(i, i + 300), output,
+                                   written);
+    }
+    written += cipher.finalInto(output, written);
+    assert.deepStrictEqual(output.subarray(0, written), ciphertext);
+
+    const decipher = crypto.createDecipheriv(algorithm, key, iv16);
+    const decrypted = Buffer.alloc(ciphertext.length + 16);
+    let n = decipher.updateInto(ciphertext, decrypted);
+    n += decipher.finalInto(decrypted, n);
+    assert.deepStrictEqual(decrypted.subarray(0, n), plaintext);
+  }
+}
+
+{
+  // In-place encryption and decryption with a stream mode.
+  const data = Buffer.from(plaintext);
+  const cipher = crypto.createCipheriv('aes-256-gcm', key, iv);
+  assert.strictEqual(cipher.updateInto(data, data), data.length);
+  assert.strictEqual(cipher.finalInto(data, data.length), 0);
+  assert.deepStrictEqual(
+    Buffer.concat([data, cipher.getAuthTag()]),
+    legacySeal('aes-256-gcm', key, iv, plaintext));
+
+  const decipher = crypto.createDecipheriv('aes-256-gcm', key, iv);
+  decipher.setAuthTag(cipher.getAuthTag());
+  assert.strictEqual(decipher.updateInto(data, data), data.length);
+  assert.strictEqual(decipher.finalInto(data, data.length), 0);
+  assert.deepStrictEqual(data, plaintext);
+}
+
+{
+  // The output must be large enough.
+  const cipher = crypto.createCipheriv('aes-256-cbc', key, iv16);
+  assert.throws(() => cipher.updateInto(plaintext, Buffer.alloc(1000)), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => cipher.updateInto(plaintext, Buffer.alloc(2000), 2001), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => cipher.updateInto('string', Buffer.alloc(100)), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => cipher.updateInto(plaintext, []), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => cipher.finalInto(Buffer.alloc(15)), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.strictEqual(cipher.finalInto(Buffer.alloc(16)), 16);
+  assert.throws(() => cipher.finalInto(Buffer.alloc(16)), {
+    code: 'ERR_CRYPTO_INVALID_STATE',
+  });
+}
+
+{
+  // aeadSeal() and aeadOpen() are compatible with Cipheriv and Decipheriv.
+  const aad = Buffer.from('additional data');
+  const cases = [
+    ['aes-128-gcm', key.slice(0, 16), iv, 16],
+    ['aes-256-gcm', key, iv, 12],
+    ['aes-256-ccm', key, iv.slice(0, 12), 16],
+    ['chacha20-poly1305', key, iv, 16],
+  ];
+  if (crypto.getCiphers().includes('aes-256-ocb'))
+    cases.push(['aes-256-ocb', key, iv, 16]);
+
+  for (const [algorithm, key, iv, authTagLength] of cases) {
+    for (const withAAD of [false, true]) {
+      const options = { authTagLength };
+      if (withAAD)
+        options.aad = aad;
+      const sealed = crypto.aeadSeal(algorithm, key, iv, plaintext, options);
+      assert.deepStrictEqual(
+        sealed,
+        legacySeal(algorithm, key, iv, plaintext, options.aad, authTagLength));
+      assert.deepStrictEqual(
+        crypto.aeadOpen(algorithm, key, iv, sealed, options), plaintext);
+
+      // Tampering with the ciphertext, the tag or the AAD is detected.
+      for (const index of [0, sealed.length - 1]) {
+        const tampered = Buffer.from(sealed);
+        tampered[index] ^= 1;
+        assert.throws(
+          () => crypto.aeadOpen(algorithm, key, iv, tampered, options), {
+            message: /Unsupported state or unable to authenticate data/,
+          });
+      }
+      assert.throws(() => crypto.aeadOpen(algorithm, key, iv, sealed, {
+        authTagLength, aad: Buffer.from('other data'),
+      }), /Unsupported state or unable to authenticate data/);
+    }
+  }
+}
+
+if (crypto.getCiphers().includes('aes-256-ocb')) {
+  // In OCB mode, which has a block size of 16, the last partial block is
+  // only written by final(). The output still fits into a buffer of exactly
+  // the size of the input and the tag.
+  for (const length of [0, 15, 16, 20, 33]) {
+    const data = plaintext.subarray(0, length);
+    const sealed = crypto.aeadSeal('aes-256-ocb', key, iv, data,
+                                   { authTagLength: 16 });
+    assert.deepStrictEqual(
+      sealed, legacySeal('aes-256-ocb', key, iv, data, undefined, 16));
+
+    const output = Buffer.alloc(length + 16);
+    assert.strictEqual(
+      crypto.aeadSeal('aes-256-ocb', key, iv, data,
+                      { authTagLength: 16, output }),
+      length + 16);
+    assert.deepStrictEqual(output, sealed);
+    assert.throws(() => crypto.aeadSeal('aes-256-ocb', key, iv, data, {
+      authTagLength: 16, output: Buffer.alloc(length + 15),
+    }), { code: 'ERR_OUT_OF_RANGE' });
+
+    const opened = Buffer.alloc(length);
+    assert.strictEqual(
+      crypto.aeadOpen('aes-256-ocb', key, iv, sealed,
+                      { authTagLength: 16, output: opened }),
+      length);
+    assert.deepStrictEqual(opened, data);
+  }
+}
+
+{
+  // In-place sealing and opening with an output buffer.
+  const buffer = Buffer.alloc(plaintext.length + 16 + 8);
+  plaintext.copy(buffer, 8);
+  const data = buffer.subarray(8, 8 + plaintext.length);
+  const sealed = crypto.aeadSeal('aes-256-gcm', key, iv, plaintext);
+
+  assert.strictEqual(
+    crypto.aeadSeal('aes-256-gcm', key, iv, data,
+                    { output: buffer, outputOffset: 8 }),
+    plaintext.length + 16);
+  assert.deepStrictEqual(buffer.subarray(8), sealed);
+
+  assert.strictEqual(
+    crypto.aeadOpen('aes-256-gcm', key, iv, buffer.subarray(8),
+                    { output: buffer, outputOffset: 8 }),
+    plaintext.length);
+  assert.deepStrictEqual(data, plaintext);
+
+  // The plaintext is not left in the output if authentication fails.
+  const tampered = Buffer.from(sealed);
+  tampered[tampered.length - 1] ^= 1;
+  const output = Buffer.alloc(plaintext.length);
+  assert.throws(() => crypto.aeadOpen('aes-256-gcm', key, iv, tampered,
+                                      { output }),
+                /unable to authenticate data/);
+  assert.deepStrictEqual(output, Buffer.alloc(plaintext.length));
+}
+
+{
+  // Other inputs are accepted as well.
+  const sealed = crypto.aeadSeal('aes-256-gcm', crypto.createSecretKey(key),
+                                 iv, 'text', { aad: 'aad' });
+  assert.strictEqual(
+    crypto.aeadOpen('aes-256-gcm', key, iv,
+                    new Uint8Array(sealed).buffer, { aad: 'aad' }).toString(),
+    'text');
+  assert.strictEqual(
+    crypto.aeadSeal('aes-256-gcm', key, iv, Buffer.alloc(0)).length, 16);
+}
+
+{
+  // Invalid arguments.
+  assert.throws(() => crypto.aeadSeal('aes-256-cbc', key, iv, plaintext), {
+    code: 'ERR_CRYPTO_UNSUPPORTED_OPERATION',
+  });
+  assert.throws(() => crypto.aeadSeal('nope', key, iv, plaintext), {
+    code: 'ERR_CRYPTO_UNKNOWN_CIPHER',
+  });
+  assert.throws(() => crypto.aeadSeal(1, key, iv, plaintext), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => crypto.aeadSeal('aes-256-gcm', key.slice(1), iv,
+                                      plaintext), {
+    code: 'ERR_CRYPTO_INVALID_KEYLEN',
+  });
+  assert.throws(() => crypto.aeadSeal('aes-256-gcm', key, iv, plaintext,
+                                      { authTagLength: 5 }), {
+    code: 'ERR_CRYPTO_INVALID_AUTH_TAG',
+  });
+  assert.throws(() => crypto.aeadSeal('aes-256-gcm', key, iv, plaintext,
+                                      { output: Buffer.alloc(1015) }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => crypto.aeadSeal('aes-256-gcm', key, iv, plaintext,
+                                      { output: Buffer.alloc(1016),
+                                        outputOffset: 1 }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => crypto.aeadOpen('aes-256-gcm', key, iv,
+                                      Buffer.alloc(15)), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+
+  // The shared handles are still usable after errors.
+  assert.deepStrictEqual(
+    crypto.aeadOpen('aes-256-gcm', key, iv,
+                    crypto.aeadSeal('aes-256-gcm', key, iv, plaintext)),
+    plaintext);
+}
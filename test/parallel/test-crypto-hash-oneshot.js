@@ -0,0 +1,74 @@
+'use strict';
+// Tests crypto.hash() and crypto.hashBatch().
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+function digest(algorithm, data, encoding) {
+  return crypto.createHash(algorithm).update(data).digest(encoding);
+}
+
+const inputs = [
+  '',
+  'abc',
+  'üñíçødé',
+  Buffer.from('buffer input'),
+  new Uint16Array([1, 2, 3]),
+  new DataView(new ArrayBuffer(16)),
+];
+
+for (const algorithm of ['sha1', 'sha256', 'sha512', 'md5', 'sha3-256',
+                         'shake128', 'RSA-SHA256']) {
+  for (const input of inputs) {
+    assert.strictEqual(crypto.hash(algorithm, input),
+                       digest(algorithm, input, 'hex'));
+    assert.strictEqual(crypto.hash(algorithm, input, 'base64'),
+                       digest(algorithm, input, 'base64'));
+    assert.deepStrictEqual(crypto.hash(algorithm, input, 'buffer'),
+                           digest(algorithm, input));
+  }
+
+  assert.deepStrictEqual(
+    crypto.hashBatch(algorithm, inputs),
+    inputs.map((input) => digest(algorithm, input, 'hex')));
+  assert.deepStrictEqual(
+    crypto.hashBatch(algorithm, inputs, 'buffer'),
+    inputs.map((input) => digest(algorithm, input)));
+}
+
+assert.deepStrictEqual(crypto.hashBatch('sha256', []), []);
+
+// Repeated calls use the cached digest and do not affect each other.
+for (let i = 0; i < 3; i++) {
+  assert.strictEqual(crypto.hash('sha1', 'some data to hash'),
+                     '3d22ca807ad75c9ff3ca07c4e6c396b7d99f7206');
+}
+
+assert.throws(() => crypto.hash('unknown', 'data'), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST',
+  name: 'TypeError',
+});
+for (const algorithm of [undefined, null, 1, {}]) {
+  assert.throws(() => crypto.hash(algorithm, 'data'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+for (const data of [undefined, null, 1, {}, new ArrayBuffer(8)]) {
+  assert.throws(() => crypto.hash('sha256', data), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => crypto.hashBatch('sha256', ['a', data]), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    message: /"inputs\[1\]"/,
+  });
+}
+assert.throws(() => crypto.hashBatch('sha256', 'a'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => crypto.hash('sha256', 'data', 'unknown'), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
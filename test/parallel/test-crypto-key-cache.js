@@ -0,0 +1,99 @@
+'use strict';
+
+// Keys that are passed as strings or buffers are parsed once and then served
+// from a cache.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+
+const privatePem = fixtures.readKey('rsa_private_2048.pem', 'ascii');
+const publicPem = fixtures.readKey('rsa_public_2048.pem', 'ascii');
+const encryptedPem = fixtures.readKey('rsa_private_encrypted.pem', 'ascii');
+const data = Buffer.from('some data to sign');
+
+function delta(before) {
+  const after = crypto.getKeyCacheStatistics();
+  return {
+    hits: after.hits - before.hits,
+    misses: after.misses - before.misses,
+  };
+}
+
+{
+  const stats = crypto.getKeyCacheStatistics();
+  assert.deepStrictEqual(Object.keys(stats),
+                         ['hits', 'misses', 'evictions', 'size', 'capacity']);
+  assert(stats.capacity > 0);
+  assert(stats.size <= stats.capacity);
+}
+
+{
+  // Repeated use of the same PEM string only parses it once, and the cached
+  // keys produce the same results.
+  let before = crypto.getKeyCacheStatistics();
+  const signature = crypto.sign('sha256', data, privatePem);
+  assert.deepStrictEqual(delta(before), { hits: 0, misses: 1 });
+
+  before = crypto.getKeyCacheStatistics();
+  assert.deepStrictEqual(crypto.sign('sha256', data, privatePem), signature);
+  assert.deepStrictEqual(
+    crypto.createSign('sha256').update(data).sign(privatePem), signature);
+  assert.deepStrictEqual(delta(before), { hits: 2, misses: 0 });
+
+  before = crypto.getKeyCacheStatistics();
+  assert(crypto.verify('sha256', data, publicPem, signature));
+  assert(crypto.verify('sha256', data, publicPem, signature));
+  assert(crypto.verify('sha256', data, Buffer.from(publicPem), signature));
+  assert.deepStrictEqual(delta(before), { hits: 2, misses: 1 });
+
+  // createPublicKey() shares the cache, but a different encoding of the same
+  // key is a different entry.
+  before = crypto.getKeyCacheStatistics();
+  const der = crypto.createPublicKey(publicPem)
+    .export({ format: 'der', type: 'spki' });
+  assert(crypto.verify('sha256', data,
+                       { key: der, format: 'der', type: 'spki' }, signature));
+  assert.deepStrictEqual(delta(before), { hits: 1, misses: 1 });
+}
+
+{
+  // Keys are cached per passphrase, and failures are not cached.
+  const options = { key: encryptedPem, passphrase: 'password' };
+  const signature = crypto.sign('sha256', data, options);
+  let before = crypto.getKeyCacheStatistics();
+  assert.deepStrictEqual(crypto.sign('sha256', data, options), signature);
+  assert.deepStrictEqual(delta(before), { hits: 1, misses: 0 });
+
+  before = crypto.getKeyCacheStatistics();
+  for (let i = 0; i < 2; i++) {
+    assert.throws(() => crypto.sign('sha256', data, {
+      key: encryptedPem, passphrase: 'wrong',
+    }), /bad decrypt/);
+  }
+  assert.throws(() => crypto.sign('sha256', data, encryptedPem), {
+    code: 'ERR_MISSING_PASSPHRASE',
+  });
+  assert.deepStrictEqual(delta(before), { hits: 0, misses: 3 });
+}
+
+{
+  // The least recently used keys are evicted once the cache is full.
+  const { capacity } = crypto.getKeyCacheStatistics();
+  const before = crypto.getKeyCacheStatistics();
+  for (let i = 0; i < capacity + 2; i++) {
+    const { privateKey, publicKey } = crypto.generateKeyPairSync('ed25519', {
+      privateKeyEncoding: { format: 'pem', type: 'pkcs8' },
+      publicKeyEncoding: { format: 'pem', type: 'spki' },
+    });
+    const signature = crypto.sign(null, data, privateKey);
+    assert(crypto.verify(null, data, publicKey, signature));
+  }
+  const after = crypto.getKeyCacheStatistics();
+  assert.strictEqual(after.size, capacity);
+  assert(after.evictions - before.evictions >= capacity + 4);
+}
@@ -0,0 +1,82 @@
+'use strict';
+
+// Once less than a quarter of the pool for small synchronous random requests
+// is left, a spare pool is filled in the thread pool. When the pool is used
+// up, the spare is swapped in without a synchronous refill. Check that this
+// happens, and that no bytes are handed out twice across the swap.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+const crypto = require('crypto');
+
+const kPoolSize = 16 * 1024;
+const kChunkSize = 1024;
+const kChunksPerPool = kPoolSize / kChunkSize;
+// The spare is filled once less than a quarter of the pool is left.
+const kChunksBeforeRefill = kChunksPerPool * 3 / 4 + 1;
+
+// The RandomBytesJobs that fill the pools. Only the asynchronous ones have
+// an ondone callback.
+const jobs = [];
+const completed = new Set();
+async_hooks.createHook({
+  init(asyncId, type, triggerAsyncId, resource) {
+    if (type === 'RANDOMBYTESREQUEST')
+      jobs.push({ asyncId, resource });
+  },
+  after(asyncId) {
+    completed.add(asyncId);
+  },
+}).enable();
+
+const seen = new Set();
+function take(count) {
+  for (let i = 0; i < count; i++) {
+    const hex = crypto.randomBytes(kChunkSize).toString('hex');
+    assert(!seen.has(hex));
+    seen.add(hex);
+  }
+}
+
+function isAsync(job) {
+  return typeof job.resource.ondone === 'function';
+}
+
+function waitFor(job, callback) {
+  if (completed.has(job.asyncId))
+    return callback();
+  setImmediate(waitFor, job, callback);
+}
+
+// The first request fills the pool synchronously.
+take(1);
+assert.strictEqual(jobs.length, 1);
+assert(!isAsync(jobs[0]));
+
+// Running low starts filling the spare asynchronously.
+take(kChunksBeforeRefill - 2);
+assert.strictEqual(jobs.length, 1);
+take(1);
+assert.strictEqual(jobs.length, 2);
+assert(isAsync(jobs[1]));
+
+waitFor(jobs[1], common.mustCall(() => {
+  // Use up the pool and continue with the spare, which needs no job.
+  take(kChunksPerPool - kChunksBeforeRefill + 1);
+  assert.strictEqual(jobs.length, 2);
+
+  // The next spare is filled asynchronously again.
+  take(kChunksBeforeRefill - 1);
+  assert.strictEqual(jobs.length, 3);
+  assert(isAsync(jobs[2]));
+
+  // Without yielding to the event loop, the spare cannot be ready yet, so
+  // using up the pool falls back to a synchronous refill.
+  take(kChunksPerPool - kChunksBeforeRefill + 1);
+  assert.strictEqual(jobs.length, 4);
+  assert(!isAsync(jobs[3]));
+}));
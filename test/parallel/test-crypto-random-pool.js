@@ -0,0 +1,85 @@
+'use strict';
+
+// Small synchronous requests for random data are served from a pool that is
+// refilled in bulk. Check that the bytes are handed out correctly and never
+// handed out twice, also across refills of the pool.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+{
+  // Enough requests to go through the pool several times.
+  const seen = new Set();
+  for (let i = 0; i < 10000; i++) {
+    const id = crypto.randomBytes(16).toString('hex');
+    assert.strictEqual(id.length, 32);
+    assert(!seen.has(id));
+    seen.add(id);
+  }
+}
+
+{
+  for (const size of [1, 6, 1023, 1024, 1025]) {
+    const buf = crypto.randomBytes(size);
+    assert.strictEqual(buf.length, size);
+    assert.strictEqual(buf.byteOffset, 0);
+  }
+  assert.strictEqual(crypto.randomBytes(0).length, 0);
+}
+
+{
+  // randomFillSync() only writes the requested range, also for views that
+  // do not start at the beginning of their buffer.
+  const ab = new ArrayBuffer(64);
+  const view = new Uint32Array(ab, 8, 8);
+  crypto.randomFillSync(view, 2, 4);
+  const bytes = new Uint8Array(ab);
+  assert(bytes.subarray(0, 16).every((b) => b === 0));
+  assert(bytes.subarray(32).every((b) => b === 0));
+  assert(bytes.subarray(16, 32).some((b) => b !== 0));
+
+  const ab2 = new ArrayBuffer(32);
+  crypto.randomFillSync(ab2, 8, 8);
+  const bytes2 = new Uint8Array(ab2);
+  assert(bytes2.subarray(0, 8).every((b) => b === 0));
+  assert(bytes2.subarray(16).every((b) => b === 0));
+  assert(bytes2.subarray(8, 16).some((b) => b !== 0));
+
+  const dv = new DataView(new ArrayBuffer(40), 4, 32);
+  crypto.randomFillSync(dv);
+  const bytes3 = new Uint8Array(dv.buffer);
+  assert(bytes3.subarray(0, 4).every((b) => b === 0));
+  assert(bytes3.subarray(36).every((b) => b === 0));
+}
+
+{
+  // Sizes that are not served from the pool still work.
+  const buf = crypto.randomBytes(64 * 1024);
+  assert.strictEqual(buf.length, 64 * 1024);
+  assert(buf.some((b) => b !== 0));
+}
+
+{
+  // randomInt() shares the pool.
+  const values = new Set();
+  for (let i = 0; i < 5000; i++) {
+    const n = crypto.randomInt(2 ** 40);
+    assert(n >= 0 && n < 2 ** 40);
+    values.add(n);
+  }
+  assert(values.size > 4990);
+}
+
+{
+  // Asynchronous requests are not affected and still complete after the
+  // pool has been refilled in the background.
+  for (let i = 0; i < 2000; i++)
+    crypto.randomBytes(16);
+  crypto.randomBytes(16, common.mustSucceed((buf) => {
+    assert.strictEqual(buf.length, 16);
+  }));
+}
@@ -0,0 +1,163 @@
+'use strict';
+// Tests crypto.signBatch(), crypto.verifyBatch() and the asynchronous
+// crypto.hashBatch().
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+
+const inputs = [];
+for (let i = 0; i < 50; i++)
+  inputs.push(Buffer.from(`input ${i}`));
+
+const p256 = crypto.generateKeyPairSync('ec', { namedCurve: 'P-256' });
+const p384 = crypto.generateKeyPairSync('ec', { namedCurve: 'P-384' });
+
+const keys = [
+  {
+    algorithm: 'sha256',
+    privateKey: fixtures.readKey('rsa_private.pem'),
+    publicKey: fixtures.readKey('rsa_public.pem'),
+  },
+  {
+    algorithm: 'sha256',
+    privateKey: {
+      key: fixtures.readKey('rsa_private.pem'),
+      padding: crypto.constants.RSA_PKCS1_PSS_PADDING,
+      saltLength: 32,
+    },
+    publicKey: {
+      key: fixtures.readKey('rsa_public.pem'),
+      padding: crypto.constants.RSA_PKCS1_PSS_PADDING,
+      saltLength: 32,
+    },
+  },
+  {
+    algorithm: 'sha256',
+    privateKey: p256.privateKey,
+    publicKey: p256.publicKey,
+  },
+  {
+    algorithm: 'sha384',
+    privateKey: {
+      key: p384.privateKey,
+      dsaEncoding: 'ieee-p1363',
+    },
+    publicKey: {
+      key: p384.publicKey.export({ type: 'spki', format: 'pem' }),
+      dsaEncoding: 'ieee-p1363',
+    },
+  },
+  {
+    algorithm: null,
+    privateKey: fixtures.readKey('ed25519_private.pem'),
+    // A public key can be derived from the private key.
+    publicKey: crypto.createPrivateKey(fixtures.readKey('ed25519_private.pem')),
+  },
+];
+
+for (const { algorithm, privateKey, publicKey } of keys) {
+  const signatures = crypto.signBatch(algorithm, inputs, privateKey);
+  assert.strictEqual(signatures.length, inputs.length);
+  for (let i = 0; i < inputs.length; i++) {
+    assert(Buffer.isBuffer(signatures[i]));
+    assert(crypto.verify(algorithm, inputs[i], publicKey, signatures[i]));
+  }
+  if (typeof privateKey === 'object' &&
+      privateKey.dsaEncoding === 'ieee-p1363') {
+    assert.strictEqual(signatures[0].length, 96);
+  }
+
+  const expected = inputs.map((input, i) => i % 3 !== 0);
+  const tampered = signatures.map((signature, i) => {
+    return i % 3 === 0 ? crypto.sign(algorithm, Buffer.from('x'), privateKey) :
+      signature;
+  });
+  assert.deepStrictEqual(
+    crypto.verifyBatch(algorithm, inputs, publicKey, tampered), expected);
+
+  crypto.signBatch(algorithm, inputs, privateKey, common.mustSucceed((res) => {
+    assert.strictEqual(res.length, inputs.length);
+    crypto.verifyBatch(algorithm, inputs, publicKey, res,
+                       common.mustSucceed((results) => {
+                         assert(results.every((result) => result === true));
+                       }));
+  }));
+  crypto.verifyBatch(algorithm, inputs, publicKey, tampered,
+                     common.mustSucceed((results) => {
+                       assert.deepStrictEqual(results, expected);
+                     }));
+}
+
+// Empty batches complete as well.
+assert.deepStrictEqual(
+  crypto.signBatch('sha256', [], fixtures.readKey('rsa_private.pem')), []);
+crypto.verifyBatch('sha256', [], fixtures.readKey('rsa_public.pem'), [],
+                   common.mustSucceed((results) => {
+                     assert.deepStrictEqual(results, []);
+                   }));
+
+// Errors are reported once for the whole batch.
+crypto.signBatch('sha256', inputs, {
+  key: fixtures.readKey('rsa_private.pem'),
+  padding: crypto.constants.RSA_PKCS1_PSS_PADDING,
+  saltLength: 1e6,
+}, common.mustCall((err, signatures) => {
+  assert(err instanceof Error);
+  assert.strictEqual(signatures, undefined);
+}));
+
+{
+  const privateKey = fixtures.readKey('rsa_private.pem');
+  const publicKey = fixtures.readKey('rsa_public.pem');
+
+  assert.throws(() => crypto.signBatch('sha256', 'data', privateKey), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => crypto.signBatch('sha256', [Buffer.alloc(1), 'x'],
+                                       privateKey), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    message: /"inputs\[1\]"/,
+  });
+  assert.throws(() => crypto.signBatch('sha256', inputs), {
+    code: 'ERR_CRYPTO_SIGN_KEY_REQUIRED',
+  });
+  assert.throws(() => crypto.signBatch('sha256', inputs, privateKey, 1), {
+    code: 'ERR_INVALID_CALLBACK',
+  });
+  assert.throws(() => crypto.signBatch('sha256', inputs,
+                                       crypto.createPublicKey(publicKey)), {
+    code: 'ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE',
+  });
+  assert.throws(() => crypto.signBatch('foo', inputs, privateKey), {
+    code: 'ERR_CRYPTO_INVALID_DIGEST',
+  });
+  assert.throws(() => crypto.verifyBatch('sha256', inputs, publicKey, []), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+  assert.throws(() => crypto.signBatch('sha256', inputs, {
+    key: fixtures.readKey('dsa_private.pem'),
+    dsaEncoding: 'ieee-p1363',
+  }), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+}
+
+{
+  // hashBatch() with a callback hashes in the thread pool.
+  const data = ['', 'abc', Buffer.from('buffer'), ...inputs];
+  const expected = crypto.hashBatch('sha256', data);
+  crypto.hashBatch('sha256', data, common.mustSucceed((digests) => {
+    assert.deepStrictEqual(digests, expected);
+  }));
+  crypto.hashBatch('sha512', data, 'buffer', common.mustSucceed((digests) => {
+    assert.deepStrictEqual(digests, crypto.hashBatch('sha512', data, 'buffer'));
+  }));
+  assert.throws(() => crypto.hashBatch('sha256', data, 'hex', 1), {
+    code: 'ERR_INVALID_CALLBACK',
+  });
+}
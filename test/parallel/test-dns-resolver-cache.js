@@ -0,0 +1,128 @@
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const assert = require('assert');
+const dgram = require('dgram');
+const { Resolver } = require('dns').promises;
+
+const server = dgram.createSocket('udp4');
+let queries = 0;
+
+server.on('message', (msg, { address, port }) => {
+  queries++;
+  const parsed = dnstools.parseDNSPacket(msg);
+  const domain = parsed.questions[0].domain;
+
+  if (domain === 'missing.example.org') {
+    server.send(dnstools.writeDNSPacket({
+      id: parsed.id,
+      flags: 0x8183,  // NXDOMAIN
+      questions: parsed.questions,
+      answers: [],
+    }), port, address);
+    return;
+  }
+
+  server.send(dnstools.writeDNSPacket({
+    id: parsed.id,
+    questions: parsed.questions,
+    answers: [{
+      type: 'A',
+      domain,
+      address: '1.2.3.4',
+      ttl: domain === 'uncacheable.example.org' ? 0 : 60,
+    }],
+  }), port, address);
+});
+
+function createResolver(options) {
+  const resolver = new Resolver(options);
+  resolver.setServers([`127.0.0.1:${server.address().port}`]);
+  return resolver;
+}
+
+async function countQueries(fn) {
+  const before = queries;
+  await fn();
+  return queries - before;
+}
+
+server.bind(0, common.mustCall(async () => {
+  // Caching is disabled by default.
+  {
+    const resolver = createResolver();
+    assert.strictEqual(await countQueries(async () => {
+      await resolver.resolve4('example.org');
+      await resolver.resolve4('example.org');
+    }), 2);
+    assert.deepStrictEqual(resolver.getCacheStats(),
+                           { hits: 0, misses: 0, staleHits: 0, size: 0 });
+  }
+
+  // Answers are cached per name and type, and include the original TTLs.
+  {
+    const resolver = createResolver({ cache: true });
+    assert.strictEqual(await countQueries(async () => {
+      const first = await resolver.resolve4('example.org', { ttl: true });
+      const second = await resolver.resolve4('EXAMPLE.org', { ttl: true });
+      assert.deepStrictEqual(first, [{ address: '1.2.3.4', ttl: 60 }]);
+      assert.deepStrictEqual(second, first);
+    }), 1);
+    assert.deepStrictEqual(resolver.getCacheStats(),
+                           { hits: 1, misses: 1, staleHits: 0, size: 1 });
+
+    resolver.clearCache();
+    assert.strictEqual(resolver.getCacheStats().size, 0);
+    assert.strictEqual(await countQueries(async () => {
+      await resolver.resolve4('example.org');
+    }), 1);
+
+    // Changing the servers invalidates all cached answers.
+    resolver.setServers([`127.0.0.1:${server.address().port}`]);
+    assert.strictEqual(resolver.getCacheStats().size, 0);
+  }
+
+  // Records with a TTL of 0 are not cached.
+  {
+    const resolver = createResolver({ cache: true });
+    assert.strictEqual(await countQueries(async () => {
+      await resolver.resolve4('uncacheable.example.org');
+      await resolver.resolve4('uncacheable.example.org');
+    }), 2);
+    assert.strictEqual(resolver.getCacheStats().size, 0);
+  }
+
+  // Negative answers are only cached when negativeTtl is set.
+  for (const [negativeTtl, expected] of [[0, 2], [30, 1]]) {
+    const resolver = createResolver({ cache: { negativeTtl } });
+    assert.strictEqual(await countQueries(async () => {
+      for (let i = 0; i < 2; i++) {
+        await assert.rejects(resolver.resolve4('missing.example.org'),
+                             { code: 'ENOTFOUND' });
+      }
+    }), expected);
+  }
+
+  // The least recently used entry is evicted first.
+  {
+    const resolver = createResolver({ cache: { maxEntries: 1 } });
+    assert.strictEqual(await countQueries(async () => {
+      await resolver.resolve4('a.example.org');
+      await resolver.resolve4('b.example.org');
+      await resolver.resolve4('a.example.org');
+    }), 3);
+    assert.strictEqual(resolver.getCacheStats().size, 1);
+  }
+
+  server.close();
+}));
+
+assert.throws(() => new Resolver({ cache: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => new Resolver({ cache: { maxEntries: 0 } }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => new Resolver({ cache: { staleTtl: -1 } }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
@@ -0,0 +1,105 @@
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const assert = require('assert');
+const dgram = require('dgram');
+const dns = require('dns');
+const { getSystemErrorName, promisify } = require('util');
+
+const addresses = {
+  A: [{ type: 'A', address: '1.2.3.4', ttl: 60 }],
+  AAAA: [{ type: 'AAAA', address: '::42', ttl: 60 }],
+};
+
+const server = dgram.createSocket('udp4');
+
+server.on('message', (msg, { address, port }) => {
+  const parsed = dnstools.parseDNSPacket(msg);
+  const { domain, type } = parsed.questions[0];
+
+  if (!domain.startsWith('example.org') && !domain.startsWith('v4.example')) {
+    server.send(dnstools.writeDNSPacket({
+      id: parsed.id,
+      flags: 0x8183,  // NXDOMAIN
+      questions: parsed.questions,
+      answers: [],
+    }), port, address);
+    return;
+  }
+
+  const answers = type === 'AAAA' && domain.startsWith('v4.') ?
+    [] : addresses[type];
+  server.send(dnstools.writeDNSPacket({
+    id: parsed.id,
+    questions: parsed.questions,
+    answers: answers.map((answer) => ({ domain, ...answer })),
+  }), port, address);
+});
+
+server.bind(0, common.mustCall(async () => {
+  const resolver = new dns.Resolver();
+  resolver.setServers([`127.0.0.1:${server.address().port}`]);
+  const lookup = resolver.lookup.bind(resolver);
+  const promiseResolver = new dns.promises.Resolver();
+  promiseResolver.setServers(resolver.getServers());
+
+  lookup('example.org', common.mustSucceed((address, family) => {
+    assert.strictEqual(address, '1.2.3.4');
+    assert.strictEqual(family, 4);
+  }));
+
+  lookup('example.org', { family: 6 }, common.mustSucceed((address, family) => {
+    assert.strictEqual(address, '::42');
+    assert.strictEqual(family, 6);
+  }));
+
+  lookup('example.org', { all: true }, common.mustSucceed((results) => {
+    assert.deepStrictEqual(results, [
+      { address: '1.2.3.4', family: 4 },
+      { address: '::42', family: 6 },
+    ]);
+  }));
+
+  // NXDOMAIN is reported like getaddrinfo(3) reports it.
+  lookup('missing.invalid', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOTFOUND');
+    assert.strictEqual(getSystemErrorName(err.errno), 'EAI_NONAME');
+    assert.strictEqual(err.syscall, 'getaddrinfo');
+    assert.strictEqual(err.hostname, 'missing.invalid');
+  }));
+
+  // IP addresses are returned without a query.
+  lookup('127.0.0.1', common.mustSucceed((address, family) => {
+    assert.strictEqual(address, '127.0.0.1');
+    assert.strictEqual(family, 4);
+  }));
+
+  assert.deepStrictEqual(
+    await promiseResolver.lookup('v4.example.org', {
+      family: 6,
+      hints: dns.V4MAPPED,
+    }),
+    { address: '::ffff:1.2.3.4', family: 6 });
+
+  assert.deepStrictEqual(
+    await promiseResolver.lookup('example.org', {
+      family: 6,
+      hints: dns.V4MAPPED | dns.ALL,
+      all: true,
+    }),
+    [
+      { address: '::42', family: 6 },
+      { address: '::ffff:1.2.3.4', family: 6 },
+    ]);
+
+  await assert.rejects(promiseResolver.lookup('missing.invalid'), {
+    code: 'ENOTFOUND',
+    syscall: 'getaddrinfo',
+  });
+
+  // Promisified, it resolves to the same shape as dns.lookup().
+  assert.deepStrictEqual(await promisify(lookup)('example.org'),
+                         { address: '1.2.3.4', family: 4 });
+
+  server.close();
+}));
@@ -0,0 +1,21 @@
+'use strict';
+
+// Tests that NODE_DEBUG_NATIVE=CODE_CACHE lists the built-in modules that
+// are compiled, and that a trivial script does not compile modules that it
+// does not use.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+const child = spawnSync(process.execPath, ['-e', '0'], {
+  env: { ...process.env, NODE_DEBUG_NATIVE: 'CODE_CACHE' },
+  encoding: 'utf8',
+});
+assert.strictEqual(child.status, 0, child.stderr);
+assert.match(
+  child.stderr,
+  /Compiled internal\/main\/eval_string with(out)? code cache in \d+ us/);
+
+for (const id of ['stream', 'internal/fs/promises', 'internal/process/report'])
+  assert.doesNotMatch(child.stderr, new RegExp(`Compiled ${id} `));
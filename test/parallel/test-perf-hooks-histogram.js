@@ -0,0 +1,106 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { createHistogram } = require('perf_hooks');
+const { Worker, MessageChannel } = require('worker_threads');
+const { inspect } = require('util');
+
+{
+  const h = createHistogram();
+  assert.strictEqual(h.count, 0);
+  assert.strictEqual(h.max, 0);
+  assert.strictEqual(h.exceeds, 0);
+
+  h.record(1);
+  h.record(2n);
+  h.record(3);
+  assert.strictEqual(h.count, 3);
+  assert.strictEqual(h.min, 1);
+  assert.strictEqual(h.max, 3);
+  assert.strictEqual(h.mean, 2);
+  assert.strictEqual(h.percentile(50), 2);
+  assert.strictEqual(h.percentiles.get(100), 3);
+  assert.match(inspect(h), /^Histogram /);
+
+  h.reset();
+  assert.strictEqual(h.count, 0);
+  assert.strictEqual(h.max, 0);
+}
+
+{
+  // Values above `highest` are not recorded.
+  const h = createHistogram({ highest: 10 });
+  h.record(5);
+  h.record(100);
+  assert.strictEqual(h.count, 1);
+  assert.strictEqual(h.exceeds, 1);
+  h.reset();
+  assert.strictEqual(h.exceeds, 0);
+}
+
+{
+  const h = createHistogram();
+  [0, -1, 1.5, Number.MAX_SAFE_INTEGER + 1, 0n, 2n ** 64n].forEach((i) => {
+    assert.throws(() => h.record(i), { code: 'ERR_OUT_OF_RANGE' });
+  });
+  ['1', null, undefined, {}].forEach((i) => {
+    assert.throws(() => h.record(i), { code: 'ERR_INVALID_ARG_TYPE' });
+  });
+
+  [null, 'a', 1].forEach((i) => {
+    assert.throws(() => createHistogram(i),
+                  { code: 'ERR_INVALID_ARG_TYPE' });
+  });
+  assert.throws(() => createHistogram({ lowest: 0 }),
+                { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => createHistogram({ lowest: 10, highest: 15 }),
+                { code: 'ERR_OUT_OF_RANGE' });
+  [0, 6, 1.5].forEach((figures) => {
+    assert.throws(() => createHistogram({ figures }),
+                  { code: 'ERR_OUT_OF_RANGE' });
+  });
+  assert.throws(() => new (Object.getPrototypeOf(h).constructor)(),
+                { code: 'ERR_OPERATION_FAILED' });
+}
+
+{
+  // A histogram received through a MessagePort shares the recorded data.
+  const h = createHistogram();
+  const { port1, port2 } = new MessageChannel();
+  port2.onmessage = common.mustCall(({ data }) => {
+    assert.strictEqual(Object.getPrototypeOf(data),
+                       Object.getPrototypeOf(h));
+    data.record(10);
+    assert.strictEqual(h.count, 1);
+    assert.strictEqual(h.max, 10);
+    port2.close();
+  });
+  port1.postMessage(h);
+}
+
+{
+  // Several Workers can record into the same histogram concurrently.
+  const h = createHistogram();
+  const kWorkers = 4;
+  const kValues = 10000;
+  let exited = 0;
+  for (let i = 0; i < kWorkers; i++) {
+    const worker = new Worker(`
+      const { workerData: { h, n } } = require('worker_threads');
+      for (let i = 1; i <= n; i++)
+        h.record(i);
+    `, { eval: true, workerData: { h, n: kValues } });
+    worker.on('exit', common.mustCall((code) => {
+      assert.strictEqual(code, 0);
+      if (++exited < kWorkers) return;
+      assert.strictEqual(h.count, (kWorkers + 1) * kValues);
+      assert.strictEqual(h.min, 1);
+      assert(Math.abs(h.max - kValues) <= kValues / 1000);
+      assert.strictEqual(h.exceeds, 0);
+    }));
+  }
+  for (let i = 1; i <= kValues; i++)
+    h.record(i);
+  assert(h.count >= kValues);
+}
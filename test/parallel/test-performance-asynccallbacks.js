@@ -0,0 +1,88 @@
+// Flags: --expose-gc
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const helper = require('../common/report');
+const { monitorAsyncCallbacks } = require('perf_hooks');
+
+{
+  const monitor = monitorAsyncCallbacks();
+  assert.deepStrictEqual(monitor.stats(), {});
+  assert(monitor.enable());
+  assert(!monitor.enable());
+  assert(monitor.disable());
+  assert(!monitor.disable());
+}
+
+{
+  // Reports only contain the section while a monitor is enabled.
+  const report = process.report.getReport();
+  assert.strictEqual(report.asyncCallbacks, undefined);
+}
+
+{
+  const monitor = monitorAsyncCallbacks();
+  const disabled = monitorAsyncCallbacks();
+  monitor.enable();
+
+  fs.stat(__filename, common.mustCall(() => {
+    const server = net.createServer(common.mustCall((socket) => {
+      socket.end('hello');
+    }));
+    server.listen(0, common.mustCall(() => {
+      const client = net.connect(server.address().port);
+      client.resume();
+      client.on('close', common.mustCall(() => {
+        server.close();
+        setImmediate(common.mustCall(check));
+      }));
+    }));
+  }));
+
+  function check() {
+    const stats = monitor.stats();
+    for (const type of ['FSREQCALLBACK', 'TCPSERVERWRAP', 'TCPWRAP']) {
+      const entry = stats[type];
+      assert(entry, `${type} missing from ${Object.keys(stats)}`);
+      assert(entry.count > 0);
+      assert(entry.totalTime > 0);
+      assert(entry.min > 0);
+      assert(entry.max >= entry.min);
+      assert(entry.totalTime >= entry.max);
+      assert(entry.mean >= entry.min && entry.mean <= entry.max);
+      assert.strictEqual(typeof entry.stddev, 'number');
+      assert(entry.percentiles instanceof Map);
+      assert(entry.percentiles.size > 0);
+    }
+    assert.strictEqual(stats.FSREQCALLBACK.count, 1);
+
+    const report = process.report.getReport();
+    helper.validateContent(report);
+    assert.strictEqual(report.asyncCallbacks.length, 1);
+    assert.strictEqual(report.asyncCallbacks[0].FSREQCALLBACK.count, 1);
+    assert.strictEqual(report.asyncCallbacks[0].TCPWRAP.count,
+                       stats.TCPWRAP.count);
+
+    // Monitors that are not enabled do not record anything.
+    assert.deepStrictEqual(disabled.stats(), {});
+
+    monitor.reset();
+    assert.deepStrictEqual(monitor.stats(), {});
+    monitor.disable();
+    fs.stat(__filename, common.mustCall(() => {
+      assert.deepStrictEqual(monitor.stats(), {});
+    }));
+  }
+}
+
+{
+  // Monitors that are garbage collected while enabled do not crash.
+  let monitor = monitorAsyncCallbacks();
+  monitor.enable();
+  monitor = null;
+  global.gc();
+  fs.stat(__filename, common.mustCall());
+}
@@ -75,6 +75,13 @@ const { createQuicSocket } = require('net');
   });
 });
 
+// Test invalid QuicSocket disablePacing argument option
+[1, NaN, 1n, null, {}, []].forEach((disablePacing) => {
+  assert.throws(() => createQuicSocket({ disablePacing }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+});
+
 
 // Test invalid QuicSocket retryTokenTimeout option
 [0, 61, NaN].forEach((retryTokenTimeout) => {
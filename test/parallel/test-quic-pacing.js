@@ -0,0 +1,101 @@
+// Flags: --no-warnings
+'use strict';
+
+// Tests that stream data larger than the initial congestion window is
+// transmitted intact both with the packets paced out and, when the
+// disablePacing option is set, sent as soon as they are serialized.
+// The packets travel through a relay that delays them, so that the round
+// trip time is long enough for the pacer to have to delay sends. On Linux,
+// packets that are serialized together are sent in batches, unless
+// --test-udp-no-try-send is set, which this test runs itself with as well.
+
+const common = require('../common');
+if (!common.hasQuic)
+  common.skip('missing quic');
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const dgram = require('dgram');
+const { key, cert, ca } = require('../common/quic');
+const { createQuicSocket } = require('net');
+const { once } = require('events');
+
+const noTrySend = process.execArgv.includes('--test-udp-no-try-send');
+
+const kData = Buffer.alloc(1024 * 1024);
+for (let i = 0; i < kData.length; i++)
+  kData[i] = i & 0xff;
+
+const options = { key, cert, ca, alpn: 'zzz' };
+
+// Forwards the packets between the client and the server after `delay`
+// milliseconds in each direction.
+async function createRelay(serverPort, delay) {
+  const relay = dgram.createSocket('udp4');
+  let client;
+  relay.on('message', (msg, rinfo) => {
+    let port = serverPort;
+    let address = common.localhostIPv4;
+    if (rinfo.port === serverPort) {
+      ({ port, address } = client);
+    } else {
+      client = rinfo;
+    }
+    setTimeout(() => relay.send(msg, port, address), delay);
+  });
+  relay.bind(0, common.localhostIPv4);
+  await once(relay, 'listening');
+  return relay;
+}
+
+async function test(disablePacing) {
+  const client = createQuicSocket({ client: options, disablePacing });
+  const server = createQuicSocket({ server: options, disablePacing });
+
+  server.on('session', common.mustCall(async (session) => {
+    const stream = await session.openStream({ halfOpen: true });
+    stream.end(kData);
+    await once(stream, 'close');
+    if (disablePacing)
+      assert.strictEqual(session.pacingDelayCount, 0);
+    else
+      assert(session.pacingDelayCount > 0);
+  }));
+
+  await server.listen();
+  const relay = await createRelay(server.endpoints[0].address.port, 20);
+
+  const req = await client.connect({
+    address: common.localhostIPv4,
+    port: relay.address().port,
+  });
+
+  const [stream] = await once(req, 'stream');
+  const chunks = [];
+  for await (const chunk of stream)
+    chunks.push(chunk);
+  assert.deepStrictEqual(Buffer.concat(chunks), kData);
+
+  if (common.isLinux && !noTrySend)
+    assert(server.packetsSentBatched > 0);
+  else
+    assert.strictEqual(server.packetsSentBatched, 0);
+
+  await req.close();
+  await Promise.all([client.close(), server.close()]);
+  relay.close();
+}
+
+(async function() {
+  await test(false);
+  await test(true);
+})().then(common.mustCall());
+
+if (!noTrySend) {
+  const child = spawnSync(process.execPath, [
+    '--no-warnings',
+    '--test-udp-no-try-send',
+    __filename,
+  ], { stdio: 'inherit' });
+  assert.strictEqual(child.status, 0);
+}
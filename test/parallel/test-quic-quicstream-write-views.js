@@ -0,0 +1,94 @@
+// Flags: --no-warnings
+'use strict';
+
+// Tests that Buffers and Uint8Arrays viewing parts of a larger ArrayBuffer
+// written to a QuicStream, one at a time or corked into a single writev, are
+// transmitted intact. Strings are converted to Buffers before they are
+// written, so they take the same zero-copy path. The ArrayBuffer is detached
+// once the chunks have been handed to the stream, which verifies that the
+// stream keeps their memory alive until the data has been acknowledged.
+
+const common = require('../common');
+if (!common.hasQuic)
+  common.skip('missing quic');
+
+const assert = require('assert');
+const { key, cert, ca } = require('../common/quic');
+const { createQuicSocket } = require('net');
+const { MessageChannel } = require('worker_threads');
+const { once } = require('events');
+
+const options = { key, cert, ca, alpn: 'zzz' };
+
+function makeChunks(backing) {
+  const bytes = new Uint8Array(backing);
+  for (let i = 0; i < bytes.length; i++)
+    bytes[i] = i & 0xff;
+  return [
+    Buffer.from(backing, 1000, 10000),
+    new Uint8Array(backing, 30000, 4096),
+    Buffer.from('hello'),
+    new Uint8Array(backing, 50000, 123),
+  ];
+}
+
+// Without cork(), only the first chunk is handed to the stream right away;
+// the others wait in the Writable until the first has been acknowledged.
+function chunksToWrite(backing, cork) {
+  const chunks = makeChunks(backing);
+  return cork ? chunks : chunks.slice(0, 1);
+}
+
+function expected(cork) {
+  const chunks = chunksToWrite(new ArrayBuffer(64 * 1024), cork);
+  return Buffer.concat(chunks.map((chunk) => {
+    return Buffer.from(chunk.buffer, chunk.byteOffset, chunk.byteLength);
+  }).concat([Buffer.from('world')]));
+}
+
+function detach(arrayBuffer) {
+  const { port1 } = new MessageChannel();
+  port1.postMessage(arrayBuffer, [arrayBuffer]);
+  port1.close();
+  assert.strictEqual(arrayBuffer.byteLength, 0);
+}
+
+async function test(cork) {
+  const client = createQuicSocket({ client: options });
+  const server = createQuicSocket({ server: options });
+
+  server.on('session', common.mustCall(async (session) => {
+    const stream = await session.openStream({ halfOpen: true });
+    const backing = new ArrayBuffer(64 * 1024);
+    if (cork)
+      stream.cork();
+    for (const chunk of chunksToWrite(backing, cork))
+      stream.write(chunk);
+    if (cork)
+      stream.uncork();
+    detach(backing);
+    stream.write('world');
+    stream.end();
+  }));
+
+  await server.listen();
+
+  const req = await client.connect({
+    address: common.localhostIPv4,
+    port: server.endpoints[0].address.port,
+  });
+
+  const [stream] = await once(req, 'stream');
+  const chunks = [];
+  for await (const chunk of stream)
+    chunks.push(chunk);
+  assert.deepStrictEqual(Buffer.concat(chunks), expected(cork));
+
+  await req.close();
+  await Promise.all([client.close(), server.close()]);
+}
+
+(async function() {
+  await test(false);
+  await test(true);
+})().then(common.mustCall());
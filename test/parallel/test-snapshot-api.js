@@ -0,0 +1,79 @@
+'use strict';
+
+// Tests building a startup snapshot from an application with
+// --build-snapshot and starting from it with --snapshot-blob.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const v8 = require('v8');
+const tmpdir = require('../common/tmpdir');
+const fixtures = require('../common/fixtures');
+
+tmpdir.refresh();
+
+{
+  // The API can only be used while building a snapshot.
+  assert.strictEqual(v8.startupSnapshot.isBuildingSnapshot(), false);
+  for (const method of ['addSerializeCallback',
+                        'addDeserializeCallback',
+                        'setDeserializeMainFunction']) {
+    assert.throws(() => v8.startupSnapshot[method](() => {}), {
+      code: 'ERR_NOT_BUILDING_SNAPSHOT',
+      name: 'Error'
+    });
+  }
+}
+
+const blobPath = path.join(tmpdir.path, 'lookup.blob');
+const entry = fixtures.path('snapshot', 'lookup.js');
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', blobPath, '--build-snapshot', entry,
+  ], { cwd: tmpdir.path });
+  assert.strictEqual(child.stderr.toString(), '');
+  assert.strictEqual(child.status, 0);
+  assert(fs.statSync(blobPath).size > 0);
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', blobPath, 'gamma', 'alpha',
+  ], { cwd: tmpdir.path });
+  assert.strictEqual(child.stderr.toString(), '');
+  assert.strictEqual(child.status, 0);
+  const lines = child.stdout.toString().trim().split('\n');
+  assert.deepStrictEqual(JSON.parse(lines[0]), {
+    isBuildingSnapshot: false,
+    deserialized: 1,
+    cache: 'deserialize-data',
+    words: 4,
+    heapStatistics: true,
+    stat: true,
+  });
+  assert.deepStrictEqual(lines.slice(1), ['gamma=2', 'alpha=0']);
+}
+
+{
+  // Modules whose state cannot be captured are rejected.
+  const script = path.join(tmpdir.path, 'unsupported.js');
+  fs.writeFileSync(script, 'require("net");');
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', path.join(tmpdir.path, 'unsupported.blob'),
+    '--build-snapshot', script,
+  ], { cwd: tmpdir.path });
+  assert.notStrictEqual(child.status, 0);
+  assert.match(child.stderr.toString(), /ERR_NOT_SUPPORTED_IN_SNAPSHOT/);
+}
+
+{
+  // A blob that was not produced by --build-snapshot is rejected.
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', entry,
+  ], { cwd: tmpdir.path });
+  assert.strictEqual(child.status, 1);
+  assert.match(child.stderr.toString(), /not a Node\.js snapshot blob/);
+}
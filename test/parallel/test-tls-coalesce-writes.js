@@ -0,0 +1,180 @@
+'use strict';
+
+// With the coalesceWrites option, the small writes of a tick are encrypted
+// together, and stay in order with larger writes.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const options = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+};
+
+{
+  // All writes of a tick arrive in a single record, which the server reads
+  // at once.
+  const server = tls.createServer(options, common.mustCall((socket) => {
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      assert.strictEqual(chunks.length, 1);
+      assert.strictEqual(chunks[0].toString(), 'abcdefghij'.repeat(100));
+      server.close();
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+      coalesceWrites: true,
+    }, common.mustCall(() => {
+      for (let i = 0; i < 100; i++)
+        client.write('abcdefghij', common.mustCall());
+      client.end();
+    }));
+  }));
+}
+
+{
+  // Small writes from the server are coalesced as well, and are written
+  // before larger writes that follow them.
+  const large = Buffer.alloc(100000, 'x');
+  const expected = Buffer.concat([
+    Buffer.from('a'.repeat(50)),
+    large,
+    Buffer.from('b'.repeat(50)),
+  ]);
+
+  const server = tls.createServer({
+    ...options,
+    coalesceWrites: true,
+  }, common.mustCall((socket) => {
+    for (let i = 0; i < 50; i++)
+      socket.write('a');
+    socket.write(large);
+    for (let i = 0; i < 50; i++)
+      socket.write(Buffer.from('b'));
+    socket.end();
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+    });
+    const chunks = [];
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), expected);
+      server.close();
+    }));
+  }));
+}
+
+{
+  // Writes before, during and after a renegotiation arrive in order, on both
+  // sides. Renegotiation was dropped after TLS 1.2.
+  const expected = 'a'.repeat(50) + 'b'.repeat(50) + 'c'.repeat(50);
+
+  const server = tls.createServer({
+    ...options,
+    maxVersion: 'TLSv1.2',
+    coalesceWrites: true,
+  }, common.mustCall((socket) => {
+    let received = '';
+    socket.setEncoding('utf8');
+    socket.on('data', (chunk) => {
+      received += chunk;
+      // Echo each character in a write of its own.
+      for (const c of chunk)
+        socket.write(c);
+    });
+    socket.on('end', common.mustCall(() => {
+      assert.strictEqual(received, expected);
+      socket.end();
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+      maxVersion: 'TLSv1.2',
+      coalesceWrites: true,
+    }, common.mustCall(() => {
+      for (let i = 0; i < 50; i++)
+        client.write('a');
+      const ok = client.renegotiate({}, common.mustSucceed(() => {
+        for (let i = 0; i < 50; i++)
+          client.write('c');
+        client.end();
+      }));
+      assert.strictEqual(ok, true);
+      for (let i = 0; i < 50; i++)
+        client.write('b');
+    }));
+
+    let echoed = '';
+    client.setEncoding('utf8');
+    client.on('data', (chunk) => echoed += chunk);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(echoed, expected);
+      server.close();
+    }));
+  }));
+}
+
+{
+  // Coalesced writes are subject to backpressure: when the peer does not
+  // read, write() eventually returns false and 'drain' follows once the peer
+  // catches up.
+  const chunk = Buffer.alloc(1000, 'x');
+  let written = 0;
+
+  const server = tls.createServer({
+    ...options,
+    coalesceWrites: true,
+  }, common.mustCall((socket) => {
+    function write() {
+      for (let i = 0; i < 16; i++) {
+        written += chunk.length;
+        if (!socket.write(chunk)) {
+          socket.once('drain', common.mustCall(() => socket.end()));
+          client.resume();
+          return;
+        }
+      }
+      assert(written < 64 * 1024 * 1024);
+      setImmediate(write);
+    }
+    write();
+  }));
+
+  let client;
+  server.listen(0, common.mustCall(() => {
+    client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+    });
+    client.pause();
+    let received = 0;
+    client.on('data', (data) => received += data.length);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(received, written);
+      server.close();
+    }));
+  }));
+}
+
+for (const coalesceWrites of [1, 'yes', null]) {
+  assert.throws(() => tls.createServer({ coalesceWrites }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
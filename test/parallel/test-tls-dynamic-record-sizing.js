@@ -0,0 +1,63 @@
+'use strict';
+
+// With the dynamicRecordSizing option, small records are used until the
+// threshold is reached. Each record arrives as a chunk of its own.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const initialRecordSize = 1000;
+const threshold = 50000;
+const chunk = Buffer.alloc(10000, 'x');
+
+const server = tls.createServer({
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+  dynamicRecordSizing: { initialRecordSize, threshold },
+}, common.mustCall((socket) => {
+  for (let i = 0; i < 10; i++)
+    socket.write(chunk);
+  socket.end();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false,
+  });
+  let received = 0;
+  let largest = 0;
+  client.on('data', (data) => {
+    if (received < threshold)
+      assert(data.length <= initialRecordSize);
+    else
+      largest = Math.max(largest, data.length);
+    received += data.length;
+  });
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(received, 10 * chunk.length);
+    assert(largest > initialRecordSize);
+    server.close();
+  }));
+}));
+
+assert.throws(() => tls.createServer({ dynamicRecordSizing: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+for (const initialRecordSize of [100, 16385, 1.5]) {
+  assert.throws(() => tls.createServer({
+    dynamicRecordSizing: { initialRecordSize }
+  }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+assert.throws(() => tls.createServer({
+  dynamicRecordSizing: { idleTimeout: 0 }
+}), {
+  code: 'ERR_OUT_OF_RANGE'
+});
@@ -0,0 +1,64 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// Tests that --trace-event-format=binary writes the same events as the JSON
+// format, once converted with tools/trace-events-to-json.js.
+
+const { convert } = require('../../tools/trace-events-to-json.js');
+
+if (!common.isMainThread)
+  common.skip('process.chdir is not available in Workers');
+
+const CODE = `
+  const { performance } = require('perf_hooks');
+  performance.mark('A');
+  performance.mark('B');
+  performance.measure('A to B', 'A', 'B');
+`;
+
+tmpdir.refresh();
+process.chdir(tmpdir.path);
+
+function run(format) {
+  const file = path.join(tmpdir.path, `${format}.log`);
+  const proc = cp.spawnSync(process.execPath, [
+    '--trace-event-categories', 'node.perf.usertiming',
+    '--trace-event-format', format,
+    '--trace-event-file-pattern', file,
+    '-e', CODE,
+  ]);
+  assert.strictEqual(proc.status, 0, proc.stderr.toString());
+  assert(fs.existsSync(file));
+  return { pid: proc.pid, data: fs.readFileSync(file) };
+}
+
+function userTimingEvents(json) {
+  return JSON.parse(json).traceEvents
+    .filter((trace) => trace.cat !== '__metadata')
+    .map(({ ph, cat, name }) => ({ ph, cat, name }));
+}
+
+const json = run('json');
+const binary = run('binary');
+
+assert.strictEqual(binary.data.toString('latin1', 0, 8), 'NODETRC\0');
+const converted = [...convert(binary.data)].join('');
+assert.deepStrictEqual(userTimingEvents(converted),
+                       userTimingEvents(json.data.toString()));
+assert.strictEqual(userTimingEvents(converted).length, 4);
+for (const trace of JSON.parse(converted).traceEvents)
+  assert.strictEqual(trace.pid, binary.pid);
+
+{
+  const proc = cp.spawnSync(process.execPath, [
+    '--trace-event-format', 'xml', '-e', '0',
+  ]);
+  assert.notStrictEqual(proc.status, 0);
+  assert.match(proc.stderr.toString(),
+               /invalid value for --trace-event-format/);
+}
@@ -0,0 +1,207 @@
+'use strict';
+
+// Tests subtle.digestStream() and subtle.encryptStream(), which take their
+// input from an iterable of chunks.
+
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { Readable } = require('stream');
+const { getRandomValues, subtle } = require('crypto').webcrypto;
+
+const data = getRandomValues(new Uint8Array(100000));
+
+// Splits data into chunks of varying sizes that are not multiples of the
+// AES block size.
+function split(data, sizes = [1, 7, 16, 1000, 4099]) {
+  const chunks = [];
+  for (let i = 0, n = 0; i < data.length; n++) {
+    const size = sizes[n % sizes.length];
+    chunks.push(data.subarray(i, i + size));
+    i += size;
+  }
+  return chunks;
+}
+
+async function* generate(chunks) {
+  for (const chunk of chunks)
+    yield chunk;
+}
+
+async function collect(iterable) {
+  const results = [];
+  for await (const result of iterable) {
+    assert(result instanceof ArrayBuffer);
+    results.push(Buffer.from(result));
+  }
+  return Buffer.concat(results);
+}
+
+async function testDigest() {
+  for (const name of ['SHA-1', 'SHA-256', 'SHA-384', 'SHA-512']) {
+    const expected = Buffer.from(await subtle.digest(name, data));
+    const sources = [
+      split(data),
+      generate(split(data)),
+      Readable.from(split(data)),
+      [data.buffer],
+    ];
+    for (const source of sources) {
+      const digest = await subtle.digestStream({ name }, source);
+      assert(digest instanceof ArrayBuffer);
+      assert.deepStrictEqual(Buffer.from(digest), expected);
+    }
+    assert.deepStrictEqual(
+      Buffer.from(await subtle.digestStream(name, [])),
+      Buffer.from(await subtle.digest(name, new Uint8Array(0))));
+  }
+
+  await assert.rejects(subtle.digestStream('SHA-256', 'data'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  await assert.rejects(subtle.digestStream('SHA-256', [1]), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  await assert.rejects(subtle.digestStream('MD5', []), {
+    name: 'NotSupportedError'
+  });
+
+  // Errors of the source are passed on.
+  async function* failing() {
+    yield data;
+    throw new Error('boom');
+  }
+  await assert.rejects(subtle.digestStream('SHA-256', failing()), {
+    message: 'boom'
+  });
+}
+
+async function testEncrypt() {
+  for (const length of [128, 256]) {
+    const gcmKey = await subtle.generateKey({ name: 'AES-GCM', length },
+                                            false, ['encrypt']);
+    const iv = getRandomValues(new Uint8Array(12));
+    const additionalData = getRandomValues(new Uint8Array(20));
+    for (const algorithm of [
+      { name: 'AES-GCM', iv },
+      { name: 'AES-GCM', iv, additionalData, tagLength: 96 },
+    ]) {
+      const expected = Buffer.from(
+        await subtle.encrypt(algorithm, gcmKey, data));
+      assert.deepStrictEqual(
+        await collect(subtle.encryptStream(algorithm, gcmKey, split(data))),
+        expected);
+      assert.deepStrictEqual(
+        await collect(subtle.encryptStream(algorithm, gcmKey,
+                                           Readable.from(split(data)))),
+        expected);
+      // Only the authentication tag is produced for an empty source.
+      assert.deepStrictEqual(
+        await collect(subtle.encryptStream(algorithm, gcmKey, [])),
+        Buffer.from(await subtle.encrypt(algorithm, gcmKey,
+                                         new Uint8Array(0))));
+    }
+
+    const ctrKey = await subtle.generateKey({ name: 'AES-CTR', length },
+                                            false, ['encrypt']);
+    const counter = getRandomValues(new Uint8Array(16));
+    for (const algorithm of [
+      { name: 'AES-CTR', counter, length: 64 },
+      { name: 'AES-CTR', counter, length: 128 },
+    ]) {
+      assert.deepStrictEqual(
+        await collect(subtle.encryptStream(algorithm, ctrKey,
+                                           generate(split(data)))),
+        Buffer.from(await subtle.encrypt(algorithm, ctrKey, data)));
+    }
+
+    // The counter wraps around in the middle of a chunk, and at the end of
+    // one.
+    const wrapping = new Uint8Array(16);
+    wrapping[14] = 0xff;
+    wrapping[15] = 0xfd;
+    const small = data.subarray(0, 100);
+    for (const sizes of [[7], [48, 52]]) {
+      const algorithm = { name: 'AES-CTR', counter: wrapping, length: 8 };
+      assert.deepStrictEqual(
+        await collect(subtle.encryptStream(algorithm, ctrKey,
+                                           split(small, sizes))),
+        Buffer.from(await subtle.encrypt(algorithm, ctrKey, small)));
+    }
+
+    // With a length of 60 bits or more, the counter still wraps around
+    // instead of carrying into the fixed bits of the counter block, starting
+    // one block before the wrap.
+    for (const length of [60, 64, 100]) {
+      const counter = getRandomValues(new Uint8Array(16));
+      for (let bit = 0; bit < length; bit++)
+        counter[15 - (bit >> 3)] |= 1 << (bit & 7);
+      const algorithm = { name: 'AES-CTR', counter, length };
+      assert.deepStrictEqual(
+        await collect(subtle.encryptStream(algorithm, ctrKey,
+                                           split(small, [7]))),
+        Buffer.from(await subtle.encrypt(algorithm, ctrKey, small)));
+    }
+
+    // Counter values are not reused.
+    await assert.rejects(
+      collect(subtle.encryptStream({ name: 'AES-CTR', counter, length: 1 },
+                                   ctrKey, split(data.subarray(0, 33)))),
+      { message: /failed/ });
+  }
+
+  const key = await subtle.generateKey({ name: 'AES-GCM', length: 128 },
+                                       false, ['encrypt']);
+  const iv = getRandomValues(new Uint8Array(12));
+
+  // Chunks that are modified once they have been handed over do not affect
+  // the output.
+  async function* overwriting(chunks) {
+    for (const chunk of chunks) {
+      yield chunk;
+      chunk.fill(0);
+    }
+  }
+  assert.deepStrictEqual(
+    await collect(subtle.encryptStream({ name: 'AES-GCM', iv }, key,
+                                       overwriting(split(data.slice())))),
+    Buffer.from(await subtle.encrypt({ name: 'AES-GCM', iv }, key, data)));
+  assert.deepStrictEqual(
+    Buffer.from(await subtle.digestStream('SHA-256',
+                                          overwriting(split(data.slice())))),
+    Buffer.from(await subtle.digest('SHA-256', data)));
+
+  assert.throws(() => subtle.encryptStream({ name: 'AES-GCM', iv }, key, 1), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => subtle.encryptStream({ name: 'AES-GCM', iv }, {}, []), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => subtle.encryptStream({ name: 'AES-CTR', iv }, key, []), {
+    name: 'InvalidAccessError'
+  });
+  assert.throws(() => subtle.encryptStream({ name: 'AES-GCM', iv,
+                                             tagLength: 8 }, key, []), {
+    name: 'OperationError'
+  });
+
+  const decryptKey = await subtle.generateKey(
+    { name: 'AES-GCM', length: 128 }, false, ['decrypt']);
+  assert.throws(() => subtle.encryptStream({ name: 'AES-GCM', iv },
+                                           decryptKey, []), {
+    name: 'InvalidAccessError'
+  });
+
+  const cbcKey = await subtle.generateKey({ name: 'AES-CBC', length: 128 },
+                                          false, ['encrypt']);
+  assert.throws(() => subtle.encryptStream({ name: 'AES-CBC', iv }, cbcKey,
+                                           []), {
+    name: 'NotSupportedError'
+  });
+}
+
+testDigest().then(common.mustCall());
+testEncrypt().then(common.mustCall());
@@ -0,0 +1,70 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const {
+  MessageChannel, Worker, receiveMessageOnPort
+} = require('worker_threads');
+
+// Large messages are serialized into buffers that are recycled between the
+// two ports of a channel. Make sure that re-using them never mixes up the
+// contents of messages that are in flight at the same time.
+
+function charFor(i) {
+  return String.fromCharCode(97 + i % 26);
+}
+
+function makePayload(i, size) {
+  return {
+    index: i,
+    text: charFor(i).repeat(size),
+    bytes: new Uint8Array(size).fill(i)
+  };
+}
+
+function checkPayload(payload, i, size) {
+  assert.strictEqual(payload.index, i);
+  assert.strictEqual(payload.text.length, size);
+  assert.strictEqual(payload.text, charFor(i).repeat(size));
+  assert.strictEqual(payload.bytes.length, size);
+  assert(payload.bytes.every((b) => b === (i & 0xff)));
+}
+
+{
+  const { port1, port2 } = new MessageChannel();
+  const sizes = [16, 128 * 1024, 1024 * 1024, 200 * 1024, 16, 3 * 1024 * 1024];
+
+  // Queue up several messages before reading any of them.
+  for (let i = 0; i < sizes.length; i++)
+    port1.postMessage(makePayload(i, sizes[i]));
+
+  for (let i = 0; i < sizes.length; i++)
+    checkPayload(receiveMessageOnPort(port2).message, i, sizes[i]);
+  assert.strictEqual(receiveMessageOnPort(port2), undefined);
+
+  // Send and receive alternately so that buffers are actually re-used.
+  for (let i = 0; i < 20; i++) {
+    const size = (i % 4 + 1) * 256 * 1024;
+    port1.postMessage(makePayload(i, size));
+    checkPayload(receiveMessageOnPort(port2).message, i, size);
+  }
+
+  port1.close();
+}
+
+{
+  const w = new Worker(`
+    const { parentPort } = require('worker_threads');
+    parentPort.on('message', (msg) => parentPort.postMessage(msg));
+  `, { eval: true });
+
+  const count = 10;
+  const size = 512 * 1024;
+  let received = 0;
+  w.on('message', common.mustCall((msg) => {
+    checkPayload(msg, received, size);
+    if (++received === count) w.terminate();
+  }, count));
+
+  for (let i = 0; i < count; i++)
+    w.postMessage(makePayload(i, size));
+}
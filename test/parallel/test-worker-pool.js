@@ -0,0 +1,111 @@
+'use strict';
+const common = require('../common');
+const fixtures = require('../common/fixtures');
+const assert = require('assert');
+const { Pool } = require('worker_threads');
+
+const taskPath = fixtures.path('worker-pool-task.js');
+
+assert.throws(() => new Pool(taskPath, { size: 0 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => new Pool(taskPath, { maxQueue: -1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => new Pool(taskPath, { eval: true }), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+
+(async function() {
+  const pool = new Pool(taskPath, { size: 2, maxQueue: 4 });
+  assert.strictEqual(pool.size, 2);
+  assert.strictEqual(pool.threads.length, 2);
+
+  // Results are passed back, and errors are re-thrown on the main thread.
+  const results = await Promise.all(
+    [1, 2, 3, 4, 5, 6].map((value) => pool.run({ op: 'double', value })));
+  assert.deepStrictEqual(results, [2, 4, 6, 8, 10, 12]);
+  await assert.rejects(pool.run({ op: 'throw', value: 'boom' }), {
+    message: 'boom'
+  });
+
+  // Transferred ArrayBuffers are detached on the main thread.
+  const buffer = new ArrayBuffer(16);
+  assert.strictEqual(
+    await pool.run({ op: 'buffer', value: buffer },
+                   { transferList: [buffer] }), 16);
+  assert.strictEqual(buffer.byteLength, 0);
+
+  // Tasks that are still queued can be cancelled.
+  {
+    const ac = new AbortController();
+    const running = [
+      pool.run({ op: 'sleep', value: 50 }),
+      pool.run({ op: 'sleep', value: 50 }),
+    ];
+    const queued = pool.run({ op: 'double', value: 1 }, { signal: ac.signal });
+    assert.strictEqual(pool.queueSize, 1);
+    ac.abort();
+    await assert.rejects(queued, { name: 'AbortError' });
+    assert.strictEqual(pool.queueSize, 0);
+    await Promise.all(running);
+  }
+
+  // Tasks that are already running are not cancelled.
+  {
+    const ac = new AbortController();
+    const running = pool.run({ op: 'sleep', value: 50 },
+                             { signal: ac.signal });
+    assert.strictEqual(pool.queueSize, 0);
+    ac.abort();
+    assert.strictEqual(await running, 50);
+  }
+
+  // Backpressure: run() rejects once maxQueue tasks are waiting.
+  {
+    const tasks = [];
+    for (let i = 0; i < 6; i++)
+      tasks.push(pool.run({ op: 'sleep', value: 10 }));
+    assert.strictEqual(pool.queueSize, 4);
+    await assert.rejects(pool.run({ op: 'double', value: 1 }), {
+      code: 'ERR_WORKER_POOL_QUEUE_FULL'
+    });
+    pool.once('drain', common.mustCall());
+    await Promise.all(tasks);
+  }
+
+  // A thread that exits is replaced.
+  await assert.rejects(pool.run({ op: 'exit', value: 1 }), {
+    code: 'ERR_WORKER_NOT_RUNNING'
+  });
+  assert.strictEqual(await pool.run({ op: 'double', value: 21 }), 42);
+
+  await pool.close();
+  await assert.rejects(pool.run({ op: 'double', value: 1 }), {
+    code: 'ERR_WORKER_POOL_CLOSED'
+  });
+})().then(common.mustCall());
+
+// Threads that fail to load the module are not replaced, and the tasks are
+// rejected with the error once no thread is left.
+(async function() {
+  const pool = new Pool(fixtures.path('worker-pool-throw.js'), { size: 2 });
+  const tasks = [1, 2, 3, 4].map((value) => {
+    return pool.run({ op: 'double', value });
+  });
+  for (const task of tasks)
+    await assert.rejects(task, { message: 'failed to load' });
+  await assert.rejects(pool.run({ op: 'double', value: 1 }), {
+    message: 'failed to load'
+  });
+  await pool.close();
+})().then(common.mustCall());
+
+(async function() {
+  const pool = new Pool(fixtures.path('worker-pool-not-function.js'),
+                        { size: 1 });
+  await assert.rejects(pool.run({ op: 'double', value: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  await pool.close();
+})().then(common.mustCall());
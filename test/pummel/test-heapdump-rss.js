@@ -0,0 +1,58 @@
+'use strict';
+
+// Tests that writing a heap snapshot to a file descriptor does not buffer
+// the serialized snapshot, by comparing the growth of the peak RSS with the
+// one of reading it from v8.getHeapSnapshot().
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const v8 = require('v8');
+const tmpdir = require('../common/tmpdir');
+
+if (process.argv[2] === 'child') {
+  // Fill the heap with enough objects to make the snapshot large.
+  const retained = [];
+  for (let i = 0; i < 1e6; i++)
+    retained.push({ index: i, name: `object ${i}` });
+
+  const before = process.resourceUsage().maxRSS;
+  if (process.argv[3] === 'fd') {
+    const fd = fs.openSync(process.argv[4], 'w');
+    v8.writeHeapSnapshot(undefined, { fd });
+    fs.closeSync(fd);
+    console.log(process.resourceUsage().maxRSS - before);
+  } else {
+    const chunks = [];
+    const stream = v8.getHeapSnapshot();
+    stream.on('data', (chunk) => chunks.push(chunk));
+    stream.on('end', () => {
+      console.log(process.resourceUsage().maxRSS - before);
+    });
+  }
+  return;
+}
+
+tmpdir.refresh();
+
+function getRSSGrowth(mode) {
+  const file = path.join(tmpdir.path, `${mode}.heapsnapshot`);
+  const child = spawnSync(process.execPath, [
+    '--max-old-space-size=2048', __filename, 'child', mode, file,
+  ], { encoding: 'utf8' });
+  assert.strictEqual(child.status, 0, child.stderr);
+  return +child.stdout;
+}
+
+const fdGrowth = getRSSGrowth('fd');
+const streamGrowth = getRSSGrowth('stream');
+const size = fs.statSync(path.join(tmpdir.path, 'fd.heapsnapshot')).size;
+console.log(`Snapshot size: ${size >> 10} KB, peak RSS growth: ` +
+            `${fdGrowth} KB with a file descriptor, ` +
+            `${streamGrowth} KB with v8.getHeapSnapshot()`);
+// Both include the memory used by V8 for the snapshot itself, only the
+// latter also holds the serialized snapshot.
+assert(fdGrowth < streamGrowth);
+assert(streamGrowth - fdGrowth > (size >> 10) / 2);
@@ -0,0 +1,91 @@
+'use strict';
+
+// This tests that --cpu-prof-window and --cpu-prof-signal write one
+// aggregated profile per window.
+
+const common = require('../common');
+const fixtures = require('../common/fixtures');
+common.skipIfInspectorDisabled();
+
+const assert = require('assert');
+const fs = require('fs');
+const { spawnSync } = require('child_process');
+
+const tmpdir = require('../common/tmpdir');
+const {
+  getCpuProfiles,
+  kCpuProfInterval,
+  env,
+  getFrames
+} = require('../common/cpu-prof');
+
+function verifyProfiles(output, profiles) {
+  let hitCount = 0;
+  for (const file of profiles) {
+    const profile = JSON.parse(fs.readFileSync(file, 'utf8'));
+    // Only the aggregated call tree is kept.
+    assert.strictEqual(profile.samples, undefined);
+    assert.strictEqual(profile.timeDeltas, undefined);
+    assert(profile.endTime >= profile.startTime);
+    assert.strictEqual(profile.nodes[0].callFrame.functionName, '(root)');
+    const ids = new Set(profile.nodes.map((node) => node.id));
+    for (const node of profile.nodes) {
+      for (const child of node.children)
+        assert(ids.has(child));
+    }
+    const { frames } = getFrames(file, 'fibonacci-loop.js');
+    for (const frame of frames)
+      hitCount += frame.hitCount;
+  }
+  if (hitCount === 0)
+    console.log(output.stderr.toString());
+  assert(hitCount > 0);
+}
+
+{
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof',
+    '--cpu-prof-interval',
+    kCpuProfInterval,
+    '--cpu-prof-window',
+    '100',
+    fixtures.path('workload', 'fibonacci-loop.js'),
+    '1000',
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  const profiles = getCpuProfiles(tmpdir.path);
+  assert(profiles.length > 1, `Got ${profiles.length} profiles`);
+  verifyProfiles(output, profiles);
+}
+
+if (!common.isWindows) {
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof',
+    '--cpu-prof-interval',
+    kCpuProfInterval,
+    '--cpu-prof-signal',
+    'SIGUSR2',
+    fixtures.path('workload', 'fibonacci-loop.js'),
+    '500',
+    'SIGUSR2',
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  // One profile when the signal is received, and one before exit.
+  const profiles = getCpuProfiles(tmpdir.path);
+  assert.strictEqual(profiles.length, 2);
+  verifyProfiles(output, profiles);
+}
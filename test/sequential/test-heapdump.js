@@ -8,6 +8,7 @@ if (!common.isMainThread)
 const { writeHeapSnapshot, getHeapSnapshot } = require('v8');
 const assert = require('assert');
 const fs = require('fs');
+const zlib = require('zlib');
 const tmpdir = require('../common/tmpdir');
 
 tmpdir.refresh();
@@ -34,6 +35,71 @@ process.chdir(tmpdir.path);
   });
 });
 
+{
+  const fd = fs.openSync('fd.heapdump', 'w');
+  assert.strictEqual(writeHeapSnapshot('ignored', { fd }), undefined);
+  fs.closeSync(fd);
+  assert(!fs.existsSync('ignored'));
+  JSON.parse(fs.readFileSync('fd.heapdump', 'utf8'));
+}
+
+// Errors while opening or writing the file are thrown.
+{
+  assert.throws(() => writeHeapSnapshot('missing/dir.heapdump'), {
+    code: 'ENOENT',
+    syscall: 'open',
+  });
+
+  const fd = fs.openSync('fd.heapdump', 'r');
+  assert.throws(() => writeHeapSnapshot(undefined, { fd }), {
+    syscall: 'write',
+  });
+  fs.closeSync(fd);
+}
+
+if (common.isLinux) {
+  assert.throws(() => writeHeapSnapshot('/dev/full'), {
+    code: 'ENOSPC',
+    syscall: 'write',
+  });
+
+  const fd = fs.openSync('/dev/full', 'w');
+  assert.throws(() => writeHeapSnapshot(undefined, { fd, compress: true }), {
+    code: 'ENOSPC',
+    syscall: 'write',
+  });
+  fs.closeSync(fd);
+}
+
+{
+  writeHeapSnapshot('compressed.heapdump.gz', { compress: true });
+  const data = zlib.gunzipSync(fs.readFileSync('compressed.heapdump.gz'));
+  assert(JSON.parse(data.toString()).snapshot.meta);
+
+  const heapdump = writeHeapSnapshot(undefined, { compress: true });
+  assert.match(heapdump, /\.heapsnapshot\.gz$/);
+  zlib.gunzipSync(fs.readFileSync(heapdump));
+}
+
+[1, true, null, 'fd'].forEach((i) => {
+  assert.throws(() => writeHeapSnapshot(undefined, i), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError'
+  });
+});
+
+[-1, 1.5, 2 ** 31].forEach((fd) => {
+  assert.throws(() => writeHeapSnapshot(undefined, { fd }), {
+    code: 'ERR_OUT_OF_RANGE',
+    name: 'RangeError'
+  });
+});
+
+assert.throws(() => writeHeapSnapshot(undefined, { compress: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  name: 'TypeError'
+});
+
 {
   let data = '';
   const snapshot = getHeapSnapshot();
@@ -0,0 +1,117 @@
+'use strict';
+
+// Tests that --metrics-endpoint serves runtime metrics in the OpenMetrics
+// text format, also while the main thread is blocked.
+
+const common = require('../common');
+const assert = require('assert');
+const { spawn, spawnSync } = require('child_process');
+const http = require('http');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const script = `
+process.stdin.on('data', () => {
+  const end = Date.now() + 5000;
+  while (Date.now() < end);
+  console.log('unblocked');
+  process.exit(0);
+});
+console.log('ready');
+`;
+
+function get(target, path) {
+  return new Promise((resolve, reject) => {
+    http.get({ ...target, path }, (res) => {
+      let body = '';
+      res.setEncoding('utf8');
+      res.on('data', (chunk) => body += chunk);
+      res.on('end', () => resolve({ res, body }));
+    }).on('error', reject);
+  });
+}
+
+function parse(body) {
+  const samples = new Map();
+  for (const line of body.split('\n')) {
+    if (line === '' || line.startsWith('#')) continue;
+    const [name, value] = line.split(' ');
+    samples.set(name, Number(value));
+  }
+  return samples;
+}
+
+async function test(endpoint, target) {
+  const child = spawn(process.execPath,
+                      [`--metrics-endpoint=${endpoint}`, '-e', script]);
+  let stdout = '';
+  child.stdout.setEncoding('utf8');
+  await new Promise((resolve) => {
+    child.stdout.on('data', (chunk) => {
+      stdout += chunk;
+      if (stdout.includes('ready')) resolve();
+    });
+  });
+
+  {
+    const { res, body } = await get(target, '/metrics');
+    assert.strictEqual(res.statusCode, 200);
+    assert.strictEqual(
+      res.headers['content-type'],
+      'application/openmetrics-text; version=1.0.0; charset=utf-8');
+    assert.match(body, /^# TYPE nodejs_heap_size_bytes gauge$/m);
+    assert.match(body, /^# TYPE nodejs_gc_duration_seconds summary$/m);
+    assert(body.endsWith('# EOF\n'));
+
+    const samples = parse(body);
+    assert(samples.get('nodejs_heap_used_bytes') > 0);
+    assert(samples.get('nodejs_heap_size_bytes') >=
+           samples.get('nodejs_heap_used_bytes'));
+    assert(samples.get('nodejs_heap_space_used_bytes{space="old_space"}') > 0);
+    assert(samples.has('nodejs_gc_duration_seconds_count{kind="scavenge"}'));
+    const utilization = samples.get('nodejs_eventloop_utilization');
+    assert(utilization >= 0 && utilization <= 1);
+    assert(samples.get('nodejs_active_handles') > 0);
+    assert(samples.get('process_resident_memory_bytes') > 0);
+    assert(samples.get('nodejs_metrics_snapshot_age_seconds') < 1);
+  }
+
+  {
+    const { res } = await get(target, '/unknown');
+    assert.strictEqual(res.statusCode, 404);
+  }
+
+  // Scrapes are still answered while the main thread is blocked, with the
+  // values collected before.
+  child.stdin.write('block');
+  await new Promise((resolve) => setTimeout(resolve, 1000));
+  const { res, body } = await get(target, '/metrics');
+  assert.strictEqual(res.statusCode, 200);
+  assert(!stdout.includes('unblocked'));
+  assert(parse(body).get('nodejs_metrics_snapshot_age_seconds') >= 0.5);
+
+  const [code] = await new Promise((resolve) => {
+    child.on('exit', (...args) => resolve(args));
+  });
+  assert.strictEqual(code, 0);
+  assert(stdout.includes('unblocked'));
+}
+
+(async () => {
+  await test(`unix:${common.PIPE}`, { socketPath: common.PIPE });
+  await test(`127.0.0.1:${common.PORT}`,
+             { host: '127.0.0.1', port: common.PORT });
+})().then(common.mustCall());
+
+{
+  // An endpoint that cannot be bound does not prevent the application from
+  // running.
+  const child = spawnSync(process.execPath, [
+    '--metrics-endpoint=invalid', '-p', '42',
+  ], { encoding: 'utf8' });
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(child.stdout, '42\n');
+  assert.match(child.stderr,
+               /^Starting metrics server on invalid failed: /);
+}
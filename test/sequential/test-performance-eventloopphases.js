@@ -0,0 +1,83 @@
+// Flags: --expose-gc --expose-internals
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const { monitorEventLoopPhases } = require('perf_hooks');
+const { sleep } = require('internal/util');
+
+const phases = ['timers', 'poll', 'pollWait', 'check', 'other'];
+
+{
+  const monitor = monitorEventLoopPhases();
+  assert.deepStrictEqual(Object.keys(monitor), phases);
+  assert(monitor.enable());
+  assert(!monitor.enable());
+  monitor.reset();
+  assert(monitor.disable());
+  assert(!monitor.disable());
+}
+
+{
+  // Time spent in each phase ends up in the histogram of that phase.
+  const monitor = monitorEventLoopPhases();
+  monitor.enable();
+  let m = 3;
+  function blockInEveryPhase() {
+    setTimeout(common.mustCall(() => {
+      sleep(50);
+      fs.stat(__filename, common.mustCall(() => {
+        sleep(50);
+        setImmediate(common.mustCall(() => {
+          sleep(50);
+          if (--m > 0) {
+            blockInEveryPhase();
+          } else {
+            setTimeout(common.mustCall(check), 20);
+          }
+        }));
+      }));
+    }), 10);
+  }
+
+  function check() {
+    monitor.disable();
+    for (const phase of phases) {
+      const histogram = monitor[phase];
+      assert(histogram.max > 0, `${phase}: ${histogram.max}`);
+      assert(histogram.max >= histogram.min);
+      assert.strictEqual(histogram.exceeds, 0);
+    }
+    for (const phase of ['timers', 'poll', 'check'])
+      assert(monitor[phase].max >= 50e6, `${phase}: ${monitor[phase].max}`);
+    // The 10 ms timer lets the loop block in poll.
+    assert(monitor.pollWait.max >= 5e6, `${monitor.pollWait.max}`);
+
+    // Nothing is recorded while the monitor is disabled.
+    const max = monitor.timers.max;
+    monitor.reset();
+    assert.strictEqual(monitor.timers.max, 0);
+    setTimeout(common.mustCall(() => {
+      sleep(20);
+      setImmediate(common.mustCall(() => {
+        for (const phase of phases)
+          assert.strictEqual(monitor[phase].max, 0);
+        assert(max >= 50e6);
+      }));
+    }), 1);
+  }
+  blockInEveryPhase();
+}
+
+{
+  // Monitors that are garbage collected while enabled do not crash.
+  let monitor = monitorEventLoopPhases();
+  monitor.enable();
+  monitor = null;
+  global.gc();
+  setImmediate(common.mustCall(() => {
+    global.gc();
+    setImmediate(common.mustCall());
+  }));
+}
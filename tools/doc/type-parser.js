@@ -171,6 +171,10 @@ const customTypesMap = {
 
   'os.constants.dlopen': 'os.html#os_dlopen_constants',
 
+  'AsyncCallbackMonitor':
+    'perf_hooks.html#perf_hooks_class_asynccallbackmonitor',
+  'EventLoopPhaseMonitor':
+    'perf_hooks.html#perf_hooks_class_eventloopphasemonitor',
   'Histogram': 'perf_hooks.html#perf_hooks_class_histogram',
   'PerformanceEntry': 'perf_hooks.html#perf_hooks_class_performanceentry',
   'PerformanceNodeTiming':
@@ -179,6 +183,8 @@ const customTypesMap = {
     'perf_hooks.html#perf_hooks_class_perf_hooks_performanceobserver',
   'PerformanceObserverEntryList':
     'perf_hooks.html#perf_hooks_class_performanceobserverentrylist',
+  'RecordableHistogram':
+    'perf_hooks.html#perf_hooks_class_recordablehistogram_extends_histogram',
   'QuicEndpoint': 'quic.html#quic_class_quicendpoint',
   'QuicSession': 'quic.html#quic_class_quicserversession_extends_quicsession',
   'QuicSocket': 'quic.html#quic_net_createquicsocket_options',
@@ -212,6 +218,7 @@ const customTypesMap = {
   'vm.SourceTextModule': 'vm.html#vm_class_vm_sourcetextmodule',
 
   'MessagePort': 'worker_threads.html#worker_threads_class_messageport',
+  'Worker': 'worker_threads.html#worker_threads_class_worker',
 
   'zlib options': 'zlib.html#zlib_class_options',
 };
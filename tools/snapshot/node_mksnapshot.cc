@@ -7,7 +7,7 @@
 
 #include "libplatform/libplatform.h"
 #include "node_internals.h"
-#include "snapshot_builder.h"
+#include "node_snapshotable.h"
 #include "util-inl.h"
 #include "v8.h"
 
@@ -51,7 +51,7 @@ int main(int argc, char* argv[]) {
 
   {
     std::string snapshot =
-        node::SnapshotBuilder::Generate(result.args, result.exec_args);
+        node::SnapshotBuilder::GenerateAsSource(result.args, result.exec_args);
     out << snapshot;
     out.close();
   }
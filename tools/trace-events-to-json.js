@@ -0,0 +1,225 @@
+'use strict';
+
+// Usage: node trace-events-to-json.js <binary trace file> [<output file>]
+//
+// Converts a trace file written with `--trace-event-format=binary` into the
+// Trace Event JSON format that is written by default, which can be loaded
+// into chrome://tracing or other tools that support it.
+//
+// The binary file starts with the 8 bytes 'NODETRC\0' and a u32 format
+// version, followed by one record per trace event. All integers are
+// little-endian. Each record is:
+//
+//   u32 size of the rest of the record
+//   u8 phase, u8 num_args, u32 flags, i32 pid, i32 tid,
+//   i64 ts, i64 tts, i64 dur, i64 tdur, u64 id, u64 bind_id,
+//   str category, str name, str scope,
+//   num_args times: str name, u8 type, value
+//
+// where str is a u32 byte length followed by UTF-8 bytes. Values of type
+// string (6, 7) and convertable (8, already formatted as JSON) are str,
+// all other values are 8 bytes.
+
+const fs = require('fs');
+
+const kMagic = 'NODETRC\0';
+const kVersion = 1;
+
+const TRACE_EVENT_FLAG_HAS_ID = 1 << 1;
+const TRACE_EVENT_FLAG_FLOW_IN = 1 << 8;
+const TRACE_EVENT_FLAG_FLOW_OUT = 1 << 9;
+
+const TRACE_VALUE_TYPE_BOOL = 1;
+const TRACE_VALUE_TYPE_UINT = 2;
+const TRACE_VALUE_TYPE_INT = 3;
+const TRACE_VALUE_TYPE_DOUBLE = 4;
+const TRACE_VALUE_TYPE_POINTER = 5;
+const TRACE_VALUE_TYPE_STRING = 6;
+const TRACE_VALUE_TYPE_COPY_STRING = 7;
+const TRACE_VALUE_TYPE_CONVERTABLE = 8;
+
+class Reader {
+  constructor(buffer, offset, end) {
+    this.buffer = buffer;
+    this.offset = offset;
+    this.end = end;
+  }
+
+  check(size) {
+    if (this.offset + size > this.end)
+      throw new Error(`Truncated record at offset ${this.offset}`);
+  }
+
+  u8() {
+    this.check(1);
+    return this.buffer.readUInt8(this.offset++);
+  }
+
+  u32() {
+    this.check(4);
+    const value = this.buffer.readUInt32LE(this.offset);
+    this.offset += 4;
+    return value;
+  }
+
+  i32() {
+    this.check(4);
+    const value = this.buffer.readInt32LE(this.offset);
+    this.offset += 4;
+    return value;
+  }
+
+  i64() {
+    this.check(8);
+    const value = this.buffer.readBigInt64LE(this.offset);
+    this.offset += 8;
+    return value;
+  }
+
+  u64() {
+    this.check(8);
+    const value = this.buffer.readBigUInt64LE(this.offset);
+    this.offset += 8;
+    return value;
+  }
+
+  f64() {
+    this.check(8);
+    const value = this.buffer.readDoubleLE(this.offset);
+    this.offset += 8;
+    return value;
+  }
+
+  str() {
+    const length = this.u32();
+    this.check(length);
+    const value = this.buffer.toString('utf8', this.offset,
+                                       this.offset + length);
+    this.offset += length;
+    return value;
+  }
+}
+
+function formatDouble(value) {
+  if (Number.isNaN(value))
+    return '"NaN"';
+  if (!Number.isFinite(value))
+    return value < 0 ? '"-Infinity"' : '"Infinity"';
+  return JSON.stringify(value);
+}
+
+function readArgValue(reader, type) {
+  switch (type) {
+    case TRACE_VALUE_TYPE_BOOL:
+      return reader.u64() !== 0n ? 'true' : 'false';
+    case TRACE_VALUE_TYPE_UINT:
+      return `${reader.u64()}`;
+    case TRACE_VALUE_TYPE_INT:
+      return `${reader.i64()}`;
+    case TRACE_VALUE_TYPE_DOUBLE:
+      return formatDouble(reader.f64());
+    case TRACE_VALUE_TYPE_POINTER:
+      return `"0x${reader.u64().toString(16)}"`;
+    case TRACE_VALUE_TYPE_STRING:
+    case TRACE_VALUE_TYPE_COPY_STRING:
+      return JSON.stringify(reader.str());
+    case TRACE_VALUE_TYPE_CONVERTABLE:
+      return reader.str();
+    default:
+      throw new Error(`Unknown argument type ${type}`);
+  }
+}
+
+// Returns the JSON text of a single trace event, with the same fields as
+// the ones written by V8's JSONTraceWriter.
+function readEvent(reader) {
+  const phase = String.fromCharCode(reader.u8());
+  const numArgs = reader.u8();
+  const flags = reader.u32();
+  const pid = reader.i32();
+  const tid = reader.i32();
+  const ts = reader.i64();
+  const tts = reader.i64();
+  const dur = reader.i64();
+  const tdur = reader.i64();
+  const id = reader.u64();
+  const bindId = reader.u64();
+  const cat = reader.str();
+  const name = reader.str();
+  const scope = reader.str();
+
+  let json = `{"pid":${pid},"tid":${tid},"ts":${ts},"tts":${tts},` +
+             `"ph":${JSON.stringify(phase)},"cat":${JSON.stringify(cat)},` +
+             `"name":${JSON.stringify(name)},"dur":${dur},"tdur":${tdur}`;
+  if (flags & (TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT)) {
+    json += `,"bind_id":"0x${bindId.toString(16)}"`;
+    if (flags & TRACE_EVENT_FLAG_FLOW_IN)
+      json += ',"flow_in":true';
+    if (flags & TRACE_EVENT_FLAG_FLOW_OUT)
+      json += ',"flow_out":true';
+  }
+  if (flags & TRACE_EVENT_FLAG_HAS_ID) {
+    if (scope !== '')
+      json += `,"scope":${JSON.stringify(scope)}`;
+    json += `,"id":"0x${id.toString(16)}"`;
+  }
+
+  const args = [];
+  for (let i = 0; i < numArgs; i++) {
+    const argName = reader.str();
+    const type = reader.u8();
+    args.push(`${JSON.stringify(argName)}:${readArgValue(reader, type)}`);
+  }
+  return `${json},"args":{${args.join(',')}}}`;
+}
+
+function* convert(buffer) {
+  if (buffer.length < 12 || buffer.toString('latin1', 0, 8) !== kMagic)
+    throw new Error('Not a binary trace events file');
+  const version = buffer.readUInt32LE(8);
+  if (version !== kVersion)
+    throw new Error(`Unsupported binary trace events version ${version}`);
+
+  yield '{"traceEvents":[';
+  let offset = 12;
+  let first = true;
+  while (offset < buffer.length) {
+    if (offset + 4 > buffer.length)
+      throw new Error(`Truncated record at offset ${offset}`);
+    const size = buffer.readUInt32LE(offset);
+    const end = offset + 4 + size;
+    if (end > buffer.length)
+      throw new Error(`Truncated record at offset ${offset}`);
+    const event = readEvent(new Reader(buffer, offset + 4, end));
+    yield first ? event : `,${event}`;
+    first = false;
+    offset = end;
+  }
+  yield ']}';
+}
+
+function main([input, output]) {
+  if (input === undefined) {
+    console.error('Usage: node trace-events-to-json.js <input> [<output>]');
+    process.exitCode = 1;
+    return;
+  }
+  const buffer = fs.readFileSync(input);
+  const fd = output === undefined ? 1 : fs.openSync(output, 'w');
+  let pending = '';
+  for (const chunk of convert(buffer)) {
+    pending += chunk;
+    if (pending.length >= 1 << 16) {
+      fs.writeSync(fd, pending);
+      pending = '';
+    }
+  }
+  fs.writeSync(fd, pending);
+  if (output !== undefined)
+    fs.closeSync(fd);
+}
+
+module.exports = { convert };
+
+if (require.main === module)
+  main(process.argv.slice(2));